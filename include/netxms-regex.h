@@ -37,6 +37,9 @@
 #define _pcre_exec_w            pcre16_exec
 #define _pcre_fullinfo_w        pcre16_fullinfo
 #define _pcre_free_w            pcre16_free
+#define PCRE_STUDY_DATA_W       pcre16_extra
+#define _pcre_study_w           pcre16_study
+#define _pcre_free_study_w      pcre16_free_study
 #else
 #define PCRE_WCHAR              PCRE_UCHAR32
 #define PCREW                   pcre32
@@ -45,6 +48,9 @@
 #define _pcre_exec_w            pcre32_exec
 #define _pcre_fullinfo_w        pcre32_fullinfo
 #define _pcre_free_w            pcre32_free
+#define PCRE_STUDY_DATA_W       pcre32_extra
+#define _pcre_study_w           pcre32_study
+#define _pcre_free_study_w      pcre32_free_study
 #endif
 
 #ifdef UNICODE
@@ -54,6 +60,9 @@
 #define _pcre_exec_t            _pcre_exec_w
 #define _pcre_fullinfo_t        _pcre_fullinfo_w
 #define _pcre_free_t            _pcre_free_w
+#define PCRE_STUDY_DATA         PCRE_STUDY_DATA_W
+#define _pcre_study_t           _pcre_study_w
+#define _pcre_free_study_t      _pcre_free_study_w
 #else   /* UNICODE */
 #define PCRE_TCHAR              char
 #define PCRE                    pcre
@@ -61,6 +70,9 @@
 #define _pcre_exec_t            pcre_exec
 #define _pcre_fullinfo_t        pcre_fullinfo
 #define _pcre_free_t            pcre_free
+#define PCRE_STUDY_DATA         pcre_extra
+#define _pcre_study_t           pcre_study
+#define _pcre_free_study_t      pcre_free_study
 #endif
 
 #define PCRE_COMMON_FLAGS_W     (PCRE_UNICODE_FLAGS | PCRE_DOTALL | PCRE_BSR_UNICODE | PCRE_NEWLINE_ANY)
@@ -54,6 +54,7 @@
 #define AGENT_PROTOCOL_VERSION   2
 #define MAX_RUNTIME_PARAM_NAME   1024  /* maximum possible parameter name in runtime (i.e. with arguments) */
 #define MAX_RESULT_LENGTH        256
+#define MAX_MULTIPLE_METRICS     256   /* maximum number of metrics in single multiple metrics request */
 #define MAX_CMD_LEN              256
 #define COMMAND_TIMEOUT          60
 #define MAX_SUBAGENT_NAME        64
@@ -266,6 +267,9 @@ struct PolicyChangeNotification
 #define DCIDESC_AGENT_LOCALDB_STATUS                 _T("Agent local database: status")
 #define DCIDESC_AGENT_LOCALDB_TOTAL_QUERIES          _T("Agent local database: total queries executed")
 #define DCIDESC_AGENT_LOG_STATUS                     _T("Agent log status")
+#define DCIDESC_AGENT_METRICLOOKUP_AVERAGETIME       _T("Average metric handler lookup time (microseconds)")
+#define DCIDESC_AGENT_METRICLOOKUP_REQUESTS          _T("Number of metric handler lookups (approximate)")
+#define DCIDESC_AGENT_METRICLOOKUP_WILDCARDMATCHES   _T("Number of wildcard matches performed during metric handler lookups")
 #define DCIDESC_AGENT_NOTIFICATIONPROC_QUEUESIZE     _T("Agent notification processor queue size")
 #define DCIDESC_AGENT_PROCESSEDREQUESTS              _T("Number of requests processed by agent")
 #define DCIDESC_AGENT_PROXY_ACTIVESESSIONS           _T("Number of active proxy sessions")
@@ -668,6 +668,7 @@ typedef struct
 #define CMD_EXECUTE_DASBOARD_SCRIPT       0x01D0
 #define CMD_UPDATE_PEER_INTERFACE         0x01D1
 #define CMD_CLEAR_PEER_INTERFACE          0x01D2
+#define CMD_GET_MULTIPLE_PARAMETERS       0x01D3
 
 #define CMD_RS_LIST_REPORTS               0x1100
 #define CMD_RS_GET_REPORT_DEFINITION      0x1101
@@ -1537,6 +1538,7 @@ typedef struct
 #define VID_PATH_CHECK_NODE_ID      ((uint32_t)855)
 #define VID_PATH_CHECK_INTERFACE_ID ((uint32_t)856)
 #define VID_TIME_SYNC_ALLOWED       ((uint32_t)857)
+#define VID_BULK_DATA_PUSH          ((uint32_t)858)
 
 // Base variabe for single threshold in message
 #define VID_THRESHOLD_BASE          ((uint32_t)0x00800000)
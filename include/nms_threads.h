@@ -902,6 +902,7 @@ ThreadPool LIBNETXMS_EXPORTABLE *ThreadPoolCreate(const TCHAR *name, int minThre
 void LIBNETXMS_EXPORTABLE ThreadPoolDestroy(ThreadPool *p);
 void LIBNETXMS_EXPORTABLE ThreadPoolExecute(ThreadPool *p, ThreadPoolWorkerFunction f, void *arg);
 void LIBNETXMS_EXPORTABLE ThreadPoolExecuteSerialized(ThreadPool *p, const TCHAR *key, ThreadPoolWorkerFunction f, void *arg);
+void LIBNETXMS_EXPORTABLE ThreadPoolExecuteSerialized(ThreadPool *p, uint64_t key, ThreadPoolWorkerFunction f, void *arg);
 void LIBNETXMS_EXPORTABLE ThreadPoolScheduleAbsolute(ThreadPool *p, time_t runTime, ThreadPoolWorkerFunction f, void *arg);
 void LIBNETXMS_EXPORTABLE ThreadPoolScheduleAbsoluteMs(ThreadPool *p, int64_t runTime, ThreadPoolWorkerFunction f, void *arg);
 void LIBNETXMS_EXPORTABLE ThreadPoolScheduleRelative(ThreadPool *p, uint32_t delay, ThreadPoolWorkerFunction f, void *arg);
@@ -910,8 +911,11 @@ bool LIBNETXMS_EXPORTABLE ThreadPoolGetInfo(const TCHAR *name, ThreadPoolInfo *i
 ThreadPool LIBNETXMS_EXPORTABLE *ThreadPoolGetByName(const TCHAR *name);
 int LIBNETXMS_EXPORTABLE ThreadPoolGetSerializedRequestCount(ThreadPool *p, const TCHAR *key);
 uint32_t LIBNETXMS_EXPORTABLE ThreadPoolGetSerializedRequestMaxWaitTime(ThreadPool *p, const TCHAR *key);
+int LIBNETXMS_EXPORTABLE ThreadPoolGetSerializedRequestCount(ThreadPool *p, uint64_t key);
+uint32_t LIBNETXMS_EXPORTABLE ThreadPoolGetSerializedRequestMaxWaitTime(ThreadPool *p, uint64_t key);
 StringList LIBNETXMS_EXPORTABLE *ThreadPoolGetAllPools();
 void LIBNETXMS_EXPORTABLE ThreadPoolSetResizeParameters(int responsiveness, uint32_t waitTimeHWM, uint32_t waitTimeLWM);
+void LIBNETXMS_EXPORTABLE ThreadPoolSetWorkStealingMode(bool enable);
 
 /**
  * Wrapper for ThreadPoolExecute for function without arguments
@@ -937,6 +941,14 @@ static inline void ThreadPoolExecuteSerialized(ThreadPool *p, const TCHAR *key,
    ThreadPoolExecuteSerialized(p, key, ThreadPoolExecute_NoArg_Wrapper, (void *)f);
 }
 
+/**
+ * Wrapper for ThreadPoolExecuteSerialized for function without arguments (integer key)
+ */
+static inline void ThreadPoolExecuteSerialized(ThreadPool *p, uint64_t key, void (*f)())
+{
+   ThreadPoolExecuteSerialized(p, key, ThreadPoolExecute_NoArg_Wrapper, (void *)f);
+}
+
 /**
  * Wrapper for ThreadPoolScheduleAbsolute for function without arguments
  */
@@ -1010,6 +1022,14 @@ template <typename T> static inline void ThreadPoolExecuteSerialized(ThreadPool
    ThreadPoolExecuteSerialized(p, key, (ThreadPoolWorkerFunction)f, (void *)arg);
 }
 
+/**
+ * Wrapper for ThreadPoolExecuteSerialized to use pointer to given type as argument (integer key)
+ */
+template <typename T> static inline void ThreadPoolExecuteSerialized(ThreadPool *p, uint64_t key, void (*f)(T *), T *arg)
+{
+   ThreadPoolExecuteSerialized(p, key, (ThreadPoolWorkerFunction)f, (void *)arg);
+}
+
 /**
  * Wrapper for ThreadPoolExecuteSerialized to use smart pointer to given type as argument
  */
@@ -1018,6 +1038,14 @@ template <typename T> static inline void ThreadPoolExecuteSerialized(ThreadPool
    ThreadPoolExecuteSerialized(p, key, __ThreadPoolExecute_SharedPtr_Wrapper<T>, new __ThreadPoolExecute_SharedPtr_WrapperData<T>(arg, f));
 }
 
+/**
+ * Wrapper for ThreadPoolExecuteSerialized to use smart pointer to given type as argument (integer key)
+ */
+template <typename T> static inline void ThreadPoolExecuteSerialized(ThreadPool *p, uint64_t key, void (*f)(const shared_ptr<T>&), const shared_ptr<T>& arg)
+{
+   ThreadPoolExecuteSerialized(p, key, __ThreadPoolExecute_SharedPtr_Wrapper<T>, new __ThreadPoolExecute_SharedPtr_WrapperData<T>(arg, f));
+}
+
 /**
  * Wrapper for ThreadPoolScheduleAbsolute to use pointer to given type as argument
  */
@@ -1108,6 +1136,14 @@ template <typename T, typename B> static inline void ThreadPoolExecuteSerialized
    ThreadPoolExecuteSerialized(p, key, __ThreadPoolExecute_Wrapper_0<B>, new __ThreadPoolExecute_WrapperData_0<B>(object, f));
 }
 
+/**
+ * Execute serialized task as soon as possible (use class member without arguments, integer key)
+ */
+template <typename T, typename B> static inline void ThreadPoolExecuteSerialized(ThreadPool *p, uint64_t key, T *object, void (B::*f)())
+{
+   ThreadPoolExecuteSerialized(p, key, __ThreadPoolExecute_Wrapper_0<B>, new __ThreadPoolExecute_WrapperData_0<B>(object, f));
+}
+
 /**
  * Execute task with delay (use class member without arguments)
  */
@@ -1157,6 +1193,14 @@ template <typename T, typename B> static inline void ThreadPoolExecuteSerialized
    ThreadPoolExecuteSerialized(p, key, __ThreadPoolExecute_SharedPtr_Wrapper_0<B>, new __ThreadPoolExecute_SharedPtr_WrapperData_0<B>(object, f));
 }
 
+/**
+ * Execute serialized task as soon as possible (use class member without arguments) using smart pointer to object (integer key)
+ */
+template <typename T, typename B> static inline void ThreadPoolExecuteSerialized(ThreadPool *p, uint64_t key, const shared_ptr<T>& object, void (B::*f)())
+{
+   ThreadPoolExecuteSerialized(p, key, __ThreadPoolExecute_SharedPtr_Wrapper_0<B>, new __ThreadPoolExecute_SharedPtr_WrapperData_0<B>(object, f));
+}
+
 /**
  * Execute task with delay (use class member without arguments) using smart pointer to object
  */
@@ -1208,6 +1252,14 @@ template <typename T, typename B, typename R> static inline void ThreadPoolExecu
    ThreadPoolExecuteSerialized(p, key, __ThreadPoolExecute_Wrapper_1<B, R>, new __ThreadPoolExecute_WrapperData_1<B, R>(object, f, arg));
 }
 
+/**
+ * Execute serialized task as soon as possible (use class member with one argument, integer key)
+ */
+template <typename T, typename B, typename R> static inline void ThreadPoolExecuteSerialized(ThreadPool *p, uint64_t key, T *object, void (B::*f)(R), R arg)
+{
+   ThreadPoolExecuteSerialized(p, key, __ThreadPoolExecute_Wrapper_1<B, R>, new __ThreadPoolExecute_WrapperData_1<B, R>(object, f, arg));
+}
+
 /**
  * Execute task with delay (use class member with one argument)
  */
@@ -1258,6 +1310,14 @@ template <typename T, typename B, typename R> static inline void ThreadPoolExecu
    ThreadPoolExecuteSerialized(p, key, __ThreadPoolExecute_SharedPtr_Wrapper_1<B, R>, new __ThreadPoolExecute_SharedPtr_WrapperData_1<B, R>(object, f, arg));
 }
 
+/**
+ * Execute serialized task as soon as possible (use class member with one argument) using smart pointer to object (integer key)
+ */
+template <typename T, typename B, typename R> static inline void ThreadPoolExecuteSerialized(ThreadPool *p, uint64_t key, const shared_ptr<T>& object, void (B::*f)(R), R arg)
+{
+   ThreadPoolExecuteSerialized(p, key, __ThreadPoolExecute_SharedPtr_Wrapper_1<B, R>, new __ThreadPoolExecute_SharedPtr_WrapperData_1<B, R>(object, f, arg));
+}
+
 /**
  * Execute task with delay (use class member with one argument) using smart pointer to object
  */
@@ -1308,6 +1368,14 @@ template <typename R1, typename R2> static inline void ThreadPoolExecuteSerializ
    ThreadPoolExecuteSerialized(p, key, __ThreadPoolExecute_Wrapper_2F<R1, R2>, new __ThreadPoolExecute_WrapperData_2F<R1, R2>(f, arg1, arg2));
 }
 
+/**
+ * Execute serialized task as soon as possible (function with two arguments, integer key)
+ */
+template <typename R1, typename R2> static inline void ThreadPoolExecuteSerialized(ThreadPool *p, uint64_t key, void (*f)(R1, R2), R1 arg1, R2 arg2)
+{
+   ThreadPoolExecuteSerialized(p, key, __ThreadPoolExecute_Wrapper_2F<R1, R2>, new __ThreadPoolExecute_WrapperData_2F<R1, R2>(f, arg1, arg2));
+}
+
 /**
  * Wrapper data for ThreadPoolExecute (class method with two arguments)
  */
@@ -1352,6 +1420,14 @@ template <typename T, typename B, typename R1, typename R2> static inline void T
    ThreadPoolExecuteSerialized(p, key, __ThreadPoolExecute_Wrapper_2<B, R1, R2>, new __ThreadPoolExecute_WrapperData_2<B, R1, R2>(object, f, arg1, arg2));
 }
 
+/**
+ * Execute serialized task as soon as possible (use class member with two argumenta, integer key)
+ */
+template <typename T, typename B, typename R1, typename R2> static inline void ThreadPoolExecuteSerialized(ThreadPool *p, uint64_t key, T *object, void (B::*f)(R1, R2), R1 arg1, R2 arg2)
+{
+   ThreadPoolExecuteSerialized(p, key, __ThreadPoolExecute_Wrapper_2<B, R1, R2>, new __ThreadPoolExecute_WrapperData_2<B, R1, R2>(object, f, arg1, arg2));
+}
+
 /**
  * Execute task with delay (use class member with two arguments)
  */
@@ -1403,6 +1479,14 @@ template <typename T, typename B, typename R1, typename R2> static inline void T
    ThreadPoolExecuteSerialized(p, key, __ThreadPoolExecute_SharedPtr_Wrapper_2<B, R1, R2>, new __ThreadPoolExecute_SharedPtr_WrapperData_2<B, R1, R2>(object, f, arg1, arg2));
 }
 
+/**
+ * Execute serialized task as soon as possible (use class member with two arguments) using smart pointer to object (integer key)
+ */
+template <typename T, typename B, typename R1, typename R2> static inline void ThreadPoolExecuteSerialized(ThreadPool *p, uint64_t key, const shared_ptr<T>& object, void (B::*f)(R1, R2), R1 arg1, R2 arg2)
+{
+   ThreadPoolExecuteSerialized(p, key, __ThreadPoolExecute_SharedPtr_Wrapper_2<B, R1, R2>, new __ThreadPoolExecute_SharedPtr_WrapperData_2<B, R1, R2>(object, f, arg1, arg2));
+}
+
 /**
  * Execute task with delay (use class member with two arguments) using smart pointer to object
  */
@@ -1491,6 +1575,14 @@ template <typename R1, typename R2, typename R3> static inline void ThreadPoolEx
    ThreadPoolExecuteSerialized(p, key, __ThreadPoolExecute_Wrapper_3F<R1, R2, R3>, new __ThreadPoolExecute_WrapperData_3F<R1, R2, R3>(f, arg1, arg2, arg3));
 }
 
+/**
+ * Execute serialized task as soon as possible (use function with three arguments, integer key)
+ */
+template <typename R1, typename R2, typename R3> static inline void ThreadPoolExecuteSerialized(ThreadPool *p, uint64_t key, void (*f)(R1, R2, R3), R1 arg1, R2 arg2, R3 arg3)
+{
+   ThreadPoolExecuteSerialized(p, key, __ThreadPoolExecute_Wrapper_3F<R1, R2, R3>, new __ThreadPoolExecute_WrapperData_3F<R1, R2, R3>(f, arg1, arg2, arg3));
+}
+
 /**
  * Execute task with delay (use function with three arguments)
  */
@@ -1581,6 +1673,14 @@ template <typename R1, typename R2, typename R3, typename R4> static inline void
    ThreadPoolExecuteSerialized(p, key, __ThreadPoolExecute_Wrapper_4F<R1, R2, R3, R4>, new __ThreadPoolExecute_WrapperData_4F<R1, R2, R3, R4>(f, arg1, arg2, arg3, arg4));
 }
 
+/**
+ * Execute serialized task as soon as possible (use function with four arguments, integer key)
+ */
+template <typename R1, typename R2, typename R3, typename R4> static inline void ThreadPoolExecuteSerialized(ThreadPool *p, uint64_t key, void (*f)(R1, R2, R3, R4), R1 arg1, R2 arg2, R3 arg3, R4 arg4)
+{
+   ThreadPoolExecuteSerialized(p, key, __ThreadPoolExecute_Wrapper_4F<R1, R2, R3, R4>, new __ThreadPoolExecute_WrapperData_4F<R1, R2, R3, R4>(f, arg1, arg2, arg3, arg4));
+}
+
 /**
  * Execute task with delay (use function with four arguments)
  */
@@ -1615,6 +1715,14 @@ static inline void ThreadPoolExecuteSerialized(ThreadPool *p, const TCHAR *key,
    ThreadPoolExecuteSerialized(p, key, __ThreadPoolExecute_Callable_Wrapper, new std::function<void ()>(f));
 }
 
+/**
+ * Wrapper for ThreadPoolExecuteSerialized to use std::function (integer key)
+ */
+static inline void ThreadPoolExecuteSerialized(ThreadPool *p, uint64_t key, const std::function<void ()>& f)
+{
+   ThreadPoolExecuteSerialized(p, key, __ThreadPoolExecute_Callable_Wrapper, new std::function<void ()>(f));
+}
+
 /**
  * Wrapper for ThreadPoolScheduleAbsolute to use std::function
  */
@@ -5658,8 +5658,35 @@ void LIBNETXMS_EXPORTABLE nxlog_set_debug_level_tag(const char *definition);
 int LIBNETXMS_EXPORTABLE nxlog_get_debug_level();
 int LIBNETXMS_EXPORTABLE nxlog_get_debug_level_tag(const TCHAR *tag);
 int LIBNETXMS_EXPORTABLE nxlog_get_debug_level_tag_object(const TCHAR *tag, UINT32 objectId);
+int LIBNETXMS_EXPORTABLE nxlog_resolve_debug_level_tag(const TCHAR *tag, std::atomic<uint64_t> *cache);
 void LIBNETXMS_EXPORTABLE nxlog_reset_debug_level_tags();
 
+/**
+ * Debug level generation (changed on every debug level or debug tag update)
+ */
+extern LIBNETXMS_EXPORTABLE_VAR(VolatileCounter g_nxlogDebugLevelGeneration);
+
+/**
+ * Get debug level for tag using per-call-site cache. Cache holds generation in upper 32 bits
+ * and resolved debug level in lower 32 bits; it is revalidated only when generation changes.
+ */
+static inline int nxlog_get_debug_level_tag_cached(const TCHAR *tag, std::atomic<uint64_t> *cache)
+{
+   uint64_t state = cache->load(std::memory_order_relaxed);
+   if (static_cast<uint32_t>(state >> 32) == static_cast<uint32_t>(g_nxlogDebugLevelGeneration))
+      return static_cast<int32_t>(state & 0xFFFFFFFF);
+   return nxlog_resolve_debug_level_tag(tag, cache);
+}
+
+/**
+ * Write debug message with tag, using per-call-site debug level cache. Tag should be constant for given call site.
+ */
+#define nxlog_debug_tag_cached(tag, level, ...) do { \
+   static std::atomic<uint64_t> _debugLevelCache(0); \
+   if ((level) <= nxlog_get_debug_level_tag_cached((tag), &_debugLevelCache)) \
+      nxlog_debug_tag((tag), (level), __VA_ARGS__); \
+} while(0)
+
 /**
  * Debug tag information
  */
@@ -216,6 +216,9 @@ bool LIBNXDB_EXPORTABLE DBRollback(DB_HANDLE hConn);
 StringList LIBNXDB_EXPORTABLE *DBGetTableList(DB_HANDLE hdb);
 int LIBNXDB_EXPORTABLE DBIsTableExist(DB_HANDLE conn, const TCHAR *table);
 
+bool LIBNXDB_EXPORTABLE DBIsBulkLoadSupported(DB_DRIVER driver);
+bool LIBNXDB_EXPORTABLE DBBulkLoad(DB_HANDLE hConn, const TCHAR *table, const TCHAR *columns, int numColumns, int numRows, const TCHAR **values);
+
 bool LIBNXDB_EXPORTABLE DBGetSchemaVersion(DB_HANDLE conn, int32_t *major, int32_t *minor);
 int LIBNXDB_EXPORTABLE DBGetSyntax(DB_HANDLE conn, const TCHAR *fallback = nullptr);
 void LIBNXDB_EXPORTABLE DBSetSyntaxReader(bool (*reader)(DB_HANDLE, TCHAR *));
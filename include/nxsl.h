@@ -128,6 +128,20 @@ struct NXSL_FileHeader
  */
 #include <nxsl_classes.h>
 
+/**
+ * Regular expression cache statistics
+ */
+struct NXSL_RegexCacheStats
+{
+   uint64_t hits;
+   uint64_t misses;
+   uint64_t evictions;
+   uint64_t compilationErrors;
+   uint32_t size;
+   uint32_t pinned;
+   uint32_t capacity;
+};
+
 /**
  * Functions
  */
@@ -135,5 +149,6 @@ NXSL_Program LIBNXSL_EXPORTABLE *NXSLCompile(const TCHAR *source, NXSL_Environme
 NXSL_VM LIBNXSL_EXPORTABLE *NXSLCompileAndCreateVM(const TCHAR *source, NXSL_Environment *env, NXSL_CompilationDiagnostic *diag);
 StringBuffer LIBNXSL_EXPORTABLE NXSLConvertToV5(const TCHAR *source);
 TCHAR LIBNXSL_EXPORTABLE *NXSLLoadFile(const TCHAR *fileName);
+void LIBNXSL_EXPORTABLE NXSLGetRegexCacheStats(NXSL_RegexCacheStats *stats);
 
 #endif
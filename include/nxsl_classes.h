@@ -343,6 +343,25 @@ struct NXSL_ExtMethod
       m_methods->set(#name, m); \
    }
 
+/**
+ * External attribute structure
+ */
+struct NXSL_ExtAttribute
+{
+   NXSL_Value *(*handler)(NXSL_Object *object, NXSL_VM *vm);
+};
+
+#define NXSL_ATTRIBUTE_DEFINITION(clazz, name) \
+   static NXSL_Value *A_##clazz##_##name (NXSL_Object *object, NXSL_VM *vm)
+
+#define NXSL_REGISTER_ATTRIBUTE(clazz, name) NXSL_REGISTER_ATTRIBUTE_ALIAS(clazz, name, name)
+
+#define NXSL_REGISTER_ATTRIBUTE_ALIAS(clazz, alias, name) { \
+      NXSL_ExtAttribute *a = new NXSL_ExtAttribute; \
+      a->handler = A_##clazz##_##name; \
+      m_attributeHandlers->set(#alias, a); \
+   }
+
 /**
  * Handle class attribute request. It is supposed to be used within getAttr methhod with standard parameter naming.
  */
@@ -364,6 +383,7 @@ class LIBNXSL_EXPORTABLE NXSL_Class
 
 protected:
    HashMap<NXSL_Identifier, NXSL_ExtMethod> *m_methods;
+   HashMap<NXSL_Identifier, NXSL_ExtAttribute> *m_attributeHandlers;
 
    void setName(const TCHAR *name);
    const StringList& getClassHierarchy() const { return m_classHierarchy; }
@@ -1217,6 +1237,9 @@ class LIBNXSL_EXPORTABLE NXSL_Program : public NXSL_ValueManager
    NXSL_ValueHashMap<NXSL_Identifier> m_constants;
    StructArray<NXSL_Function> m_functions;
    StringMap m_metadata;
+   bool m_regexLiteralsPinned;
+
+   void pinRegexLiterals(bool pin);
 
 public:
    NXSL_Program(size_t valueRegionSize = 0, size_t identifierRegionSize = 0);
@@ -1282,6 +1305,7 @@ class LIBNXSL_EXPORTABLE NXSL_Library
 private:
    ObjectArray<NXSL_LibraryScript> *m_scriptList;
    Mutex m_mutex;
+   VolatileCounter m_changeCounter;
 
    void deleteInternal(int nIndex);
 
@@ -1292,6 +1316,8 @@ class LIBNXSL_EXPORTABLE NXSL_Library
    void lock() { m_mutex.lock(); }
    void unlock() { m_mutex.unlock(); }
 
+   uint32_t getChangeCounter() const { return static_cast<uint32_t>(m_changeCounter); }
+
    bool addScript(NXSL_LibraryScript *script);
    void deleteScript(const TCHAR *name);
    void deleteScript(uint32_t id);
@@ -1519,6 +1545,7 @@ class LIBNXSL_EXPORTABLE NXSL_VM : public NXSL_ValueManager
    json_t *getErrorJson() const;
    const TCHAR *getAssertMessage() const { return CHECK_NULL_EX(m_assertMessage); }
    NXSL_Value *getResult() { return m_pRetValue; }
+   void clearResult() { destroyValue(m_pRetValue); m_pRetValue = nullptr; }
    const TCHAR *getMetadataEntry(const TCHAR *key) const { return m_metadata.get(key); }
    const StringMap& getMetadata() const { return m_metadata; }
 
@@ -63,6 +63,11 @@
  */
 #define SNMP_DEFAULT_MSG_MAX_SIZE   ((size_t)65507)
 
+/**
+ * Default max-repetitions value for GETBULK requests used by SnmpWalk
+ */
+#define SNMP_DEFAULT_BULK_MAX_REPETITIONS   25
+
 //
 // OID comparision results
 //
@@ -947,6 +952,16 @@ class LIBNXSNMP_EXPORTABLE SNMP_PDU
    SNMP_Variable *getVariable(int index) { return m_variables.get(index); }
    SNMP_Version getVersion() const { return m_version; }
    SNMP_ErrorCode getErrorCode() const { return static_cast<SNMP_ErrorCode>(m_errorCode); }
+   uint32_t getErrorIndex() const { return m_errorIndex; }
+
+   /**
+    * Set non-repeaters and max-repetitions for GETBULK request (encoded in place of error status and error index)
+    */
+   void setBulkParameters(uint32_t nonRepeaters, uint32_t maxRepetitions)
+   {
+      m_errorCode = nonRepeaters;
+      m_errorIndex = maxRepetitions;
+   }
 
    void setTrapId(const SNMP_ObjectId& id) { setTrapId(id.value(), id.length()); }
    void setTrapId(const uint32_t *value, size_t length);
@@ -1000,8 +1015,11 @@ class LIBNXSNMP_EXPORTABLE SNMP_Transport
 	bool m_reliable;
 	SNMP_Version m_snmpVersion;
 	SNMP_Codepage m_codepage;
+   int m_bulkMaxRepetitions;
+   std::function<void (int)> m_bulkCapabilityUpdateHandler;
 
 	uint32_t doEngineIdDiscovery(SNMP_PDU *originalRequest, uint32_t timeout, int numRetries);
+   virtual bool isAsyncRequestSupported(SNMP_PDU *request);
 
 public:
    SNMP_Transport();
@@ -1016,6 +1034,7 @@ class LIBNXSNMP_EXPORTABLE SNMP_Transport
 
    uint32_t doRequest(SNMP_PDU *request, SNMP_PDU **response, uint32_t timeout, int numRetries, bool engineIdDiscoveryOnly = false);
    uint32_t doRequest(SNMP_PDU *request, SNMP_PDU **response);
+   virtual void doRequestAsync(SNMP_PDU *request, std::function<void (uint32_t, SNMP_PDU*)> callback, uint32_t timeout = 0, int numRetries = 0);
    uint32_t sendTrap(SNMP_PDU *trap, uint32_t timeout = INFINITE, int numRetries = 1);
 
 	void setSecurityContext(SNMP_SecurityContext *ctx);
@@ -1034,8 +1053,18 @@ class LIBNXSNMP_EXPORTABLE SNMP_Transport
 	SNMP_Version getSnmpVersion() const { return m_snmpVersion; }
 
    void setCodepage(const char* codepage) { strlcpy(m_codepage.codepage, codepage, 16); }
+
+   /**
+    * Max-repetitions for GETBULK requests used by walk (0 to use GETNEXT only)
+    */
+   int getBulkMaxRepetitions() const { return (m_snmpVersion != SNMP_VERSION_1) ? m_bulkMaxRepetitions : 0; }
+   void setBulkMaxRepetitions(int maxRepetitions) { m_bulkMaxRepetitions = maxRepetitions; }
+   void setBulkCapabilityUpdateHandler(std::function<void (int)> handler) { m_bulkCapabilityUpdateHandler = handler; }
+   void updateBulkMaxRepetitions(int maxRepetitions);
 };
 
+struct SNMP_EngineRequest;
+
 /**
  * UDP SNMP transport
  */
@@ -1050,11 +1079,16 @@ class LIBNXSNMP_EXPORTABLE SNMP_UDPTransport : public SNMP_Transport
    size_t m_dwBufferPos;
    BYTE *m_pBuffer;
    UINT16 m_port;
+   bool m_sharedEngine;
+   shared_ptr<SNMP_EngineRequest> m_pendingRequest;
 
    size_t preParsePDU();
    int recvData(UINT32 dwTimeout, struct sockaddr *pSender, socklen_t *piAddrSize);
+   int recvDataFromEngine(uint32_t timeout, struct sockaddr *sender, socklen_t *addrSize);
    void clearBuffer();
 
+   virtual bool isAsyncRequestSupported(SNMP_PDU *request) override;
+
 public:
    SNMP_UDPTransport();
    SNMP_UDPTransport(SOCKET hSocket);
@@ -1066,6 +1100,7 @@ class LIBNXSNMP_EXPORTABLE SNMP_UDPTransport : public SNMP_Transport
    virtual InetAddress getPeerIpAddress() override;
    virtual uint16_t getPort() override;
    virtual bool isProxyTransport() override;
+   virtual void doRequestAsync(SNMP_PDU *request, std::function<void (uint32_t, SNMP_PDU*)> callback, uint32_t timeout = 0, int numRetries = 0) override;
 
    uint32_t createUDPTransport(const TCHAR *hostName, uint16_t port = SNMP_DEFAULT_PORT);
    uint32_t createUDPTransport(const InetAddress& hostAddr, uint16_t port = SNMP_DEFAULT_PORT);
@@ -1271,10 +1306,15 @@ void LIBNXSNMP_EXPORTABLE SnmpSetDefaultTimeout(uint32_t timeout);
 uint32_t LIBNXSNMP_EXPORTABLE SnmpGetDefaultTimeout();
 void LIBNXSNMP_EXPORTABLE SnmpSetDefaultRetryCount(int numRetries);
 int LIBNXSNMP_EXPORTABLE SnmpGetDefaultRetryCount();
+bool LIBNXSNMP_EXPORTABLE SnmpStartRequestEngine(int numSockets);
+void LIBNXSNMP_EXPORTABLE SnmpStopRequestEngine();
 uint32_t LIBNXSNMP_EXPORTABLE SnmpGet(SNMP_Version version, SNMP_Transport *transport, const SNMP_ObjectId& oid, void *value, size_t bufferSize, uint32_t flags);
 uint32_t LIBNXSNMP_EXPORTABLE SnmpGet(SNMP_Version version, SNMP_Transport *transport, const TCHAR *oidStr, const uint32_t *oidBinary, size_t oidLen, void *value, size_t bufferSize, uint32_t flags);
 uint32_t LIBNXSNMP_EXPORTABLE SnmpGetEx(SNMP_Transport *transport, const TCHAR *oidStr, const uint32_t *oidBinary, size_t oidLen,
       void *value, size_t bufferSize, uint32_t flags, uint32_t *dataLen = nullptr, const char *codepage = nullptr);
+uint32_t LIBNXSNMP_EXPORTABLE SnmpGetMultiple(SNMP_Transport *transport, const SNMP_ObjectId *oids, int count, SNMP_Variable **values, uint32_t *rcc, int *maxVarbinds);
+void LIBNXSNMP_EXPORTABLE SnmpGetMultipleAsync(SNMP_Transport *transport, const SNMP_ObjectId *oids, int count, int maxVarbinds,
+         std::function<void (uint32_t, SNMP_Variable**, uint32_t*, int)> callback);
 bool LIBNXSNMP_EXPORTABLE CheckSNMPIntegerValue(SNMP_Transport *snmpTransport, const TCHAR *oid, int32_t value);
 bool LIBNXSNMP_EXPORTABLE CheckSNMPIntegerValue(SNMP_Transport *snmpTransport, std::initializer_list<uint32_t> oid, int32_t value);
 uint32_t LIBNXSNMP_EXPORTABLE SnmpWalk(SNMP_Transport *transport, const TCHAR *rootOid, std::function<uint32_t (SNMP_Variable*)> handler, bool logErrors = false, bool failOnShutdown = false);
@@ -71,6 +71,20 @@ class WelfordVariance
       update(static_cast<double>(v));
    }
 
+   /**
+    * Merge statistics calculated separately for another set of samples (using Chan's parallel algorithm)
+    */
+   void merge(int64_t samples, double mean, double ss)
+   {
+      if (samples <= 0)
+         return;
+      int64_t total = m_samples + samples;
+      double delta = mean - m_mean;
+      m_mean += delta * samples / total;
+      m_ss += ss + delta * delta * static_cast<double>(m_samples) * samples / total;
+      m_samples = total;
+   }
+
    /**
     * Reset
     */
@@ -21,6 +21,7 @@
 **/
 
 #include "nxagentd.h"
+#include "datasender.h"
 
 #define DEBUG_TAG _T("dc")
 
@@ -29,6 +30,11 @@
  */
 #define STALLED_DATA_CHECK_INTERVAL    3600000
 
+/**
+ * Timeout in milliseconds for server acknowledgement of data sent by data sender
+ */
+#define DATA_SENDER_TIMEOUT            5000
+
 /**
  * Externals
  */
@@ -48,6 +54,8 @@ extern Mutex g_proxyListLock;
 
 extern uint32_t g_dcReconciliationBlockSize;
 extern uint32_t g_dcReconciliationTimeout;
+extern uint32_t g_dcSenderBatchSize;
+extern uint32_t g_dcSenderWindowSize;
 extern uint32_t g_dcWriterFlushInterval;
 extern uint32_t g_dcWriterMaxTransactionSize;
 extern uint32_t g_dcMinCollectorPoolSize;
@@ -1181,44 +1189,272 @@ static void ReconciliationThread()
 static Queue s_dataSenderQueue;
 
 /**
- * Data sender
+ * Batch of collected values sent to server and waiting for acknowledgement
  */
-static void DataSender()
+struct DataSenderBatch
 {
-   nxlog_debug_tag(DEBUG_TAG, 1, _T("Data sender thread started"));
-   while(true)
+   shared_ptr<CommSession> session;
+   uint64_t serverId;
+   uint32_t requestId;
+   ObjectArray<DataElement> elements;
+
+   DataSenderBatch(const shared_ptr<CommSession>& _session, uint64_t _serverId) : session(_session), elements(64, 64, Ownership::True)
    {
-      DataElement *e = static_cast<DataElement*>(s_dataSenderQueue.getOrBlock());
-      if (e == INVALID_POINTER_VALUE)
+      serverId = _serverId;
+      requestId = 0;
+   }
+};
+
+/**
+ * Get sync status object for given server, creating new one if needed. Caller must hold server sync status lock.
+ */
+static ServerSyncStatus *GetServerSyncStatus(uint64_t serverId)
+{
+   ServerSyncStatus *status = s_serverSyncStatus.get(serverId);
+   if (status == nullptr)
+   {
+      status = new ServerSyncStatus(serverId);
+      s_serverSyncStatus.set(serverId, status);
+   }
+   return status;
+}
+
+/**
+ * Check if there are values for given server waiting in local database queue
+ */
+static bool HasQueuedData(uint64_t serverId)
+{
+   s_serverSyncStatusLock.lock();
+   bool queued = (GetServerSyncStatus(serverId)->queueSize > 0);
+   s_serverSyncStatusLock.unlock();
+   return queued;
+}
+
+/**
+ * Put data element into local database queue for later reconciliation. Caller must hold server sync status lock.
+ */
+static inline void QueueForReconciliation(ServerSyncStatus *status, DataElement *e)
+{
+   status->queueSize++;
+   s_databaseWriterQueue.put(e);
+}
+
+/**
+ * Wait for acknowledgement of oldest batch in flight and move values not accepted by server to local database queue.
+ * If batch was not fully accepted (or acknowledgement timed out), later batches in flight are moved to local queue as well.
+ */
+static void CompleteOldestBatch(ObjectArray<DataSenderBatch> *inFlight)
+{
+   DataSenderBatch *batch = inFlight->get(0);
+
+   uint32_t rcc;
+   BYTE status[MAX_BULK_DATA_BLOCK_SIZE];
+   memset(status, BULK_DATA_REC_RETRY, MAX_BULK_DATA_BLOCK_SIZE);
+   do
+   {
+      NXCPMessage *response = batch->session->waitForMessage(CMD_REQUEST_COMPLETED, batch->requestId, DATA_SENDER_TIMEOUT);
+      if (response == nullptr)
+      {
+         rcc = ERR_REQUEST_TIMEOUT;
          break;
+      }
+      rcc = response->getFieldAsUInt32(VID_RCC);
+      if (rcc == ERR_SUCCESS)
+      {
+         response->getFieldAsBinary(VID_STATUS, status, MAX_BULK_DATA_BLOCK_SIZE);
+      }
+      else if (rcc == ERR_INTERNAL_ERROR)
+      {
+         // Server cannot accept data for some reason and retry is not feasible
+         memset(status, BULK_DATA_REC_FAILURE, MAX_BULK_DATA_BLOCK_SIZE);
+      }
+      delete response;
+   } while(rcc == ERR_PROCESSING);
 
-      s_serverSyncStatusLock.lock();
-      ServerSyncStatus *status = s_serverSyncStatus.get(e->getServerId());
-      if (status == nullptr)
+   uint32_t requestId = batch->requestId;
+   int count = batch->elements.size();
+   s_serverSyncStatusLock.lock();
+   ServerSyncStatus *syncStatus = GetServerSyncStatus(batch->serverId);
+   int requeueCount = CompleteDataSenderBatch<DataSenderBatch, DataElement>(inFlight, status,
+      [syncStatus] (DataElement *e) -> void
       {
-         status = new ServerSyncStatus(e->getServerId());
-         s_serverSyncStatus.set(e->getServerId(), status);
+         QueueForReconciliation(syncStatus, e);
+      });
+   s_serverSyncStatusLock.unlock();
+
+   // After retry all further values for this server go through local queue until it is empty, so pipelining stops
+   if (requeueCount > 0)
+      nxlog_debug_tag(DEBUG_TAG, 5, _T("DataSender: batch %u with %d values not fully accepted by server (rcc=%u), %d values moved to local queue including later batches in flight"), requestId, count, rcc, requeueCount);
+   else
+      nxlog_debug_tag(DEBUG_TAG, 7, _T("DataSender: batch %u with %d values acknowledged by server"), requestId, count);
+}
+
+/**
+ * Send batch of values to server without waiting for acknowledgement. Will block if acknowledgement window is full.
+ */
+static void SendBatch(DataSenderBatch *batch, ObjectArray<DataSenderBatch> *inFlight)
+{
+   while(inFlight->size() >= static_cast<int>(g_dcSenderWindowSize))
+      CompleteOldestBatch(inFlight);
+
+   // Values should not bypass local queue if some earlier batch was rejected
+   bool sent = false;
+   if (!HasQueuedData(batch->serverId))
+   {
+      NXCPMessage msg(CMD_DCI_DATA, batch->session->generateRequestId(), batch->session->getProtocolVersion());
+      msg.setField(VID_BULK_RECONCILIATION, true);
+      msg.setField(VID_BULK_DATA_PUSH, true);
+      msg.setField(VID_NUM_ELEMENTS, static_cast<int16_t>(batch->elements.size()));
+      msg.setField(VID_TIMEOUT, DATA_SENDER_TIMEOUT);
+
+      uint32_t fieldId = VID_ELEMENT_LIST_BASE;
+      for(int i = 0; i < batch->elements.size(); i++, fieldId += 10)
+         batch->elements.get(i)->fillReconciliationMessage(&msg, fieldId);
+
+      if (batch->session->sendMessage(&msg))
+      {
+         batch->requestId = msg.getId();
+         sent = true;
       }
+   }
 
-      if (status->queueSize == 0)
+   if (sent)
+   {
+      inFlight->add(batch);
+   }
+   else
+   {
+      batch->elements.setOwner(Ownership::False);
+      s_serverSyncStatusLock.lock();
+      ServerSyncStatus *status = GetServerSyncStatus(batch->serverId);
+      for(int i = 0; i < batch->elements.size(); i++)
+         QueueForReconciliation(status, batch->elements.get(i));
+      s_serverSyncStatusLock.unlock();
+      delete batch;
+   }
+}
+
+/**
+ * Send collected values for single server. Items are sent in batches if server supports it, tables are always sent one by one.
+ */
+static void SendServerData(uint64_t serverId, ObjectArray<DataElement> *elements, ObjectArray<DataSenderBatch> *inFlight)
+{
+   if (HasQueuedData(serverId))
+   {
+      s_serverSyncStatusLock.lock();
+      ServerSyncStatus *status = GetServerSyncStatus(serverId);
+      for(int i = 0; i < elements->size(); i++)
+         QueueForReconciliation(status, elements->get(i));
+      s_serverSyncStatusLock.unlock();
+      return;
+   }
+
+   shared_ptr<CommSession> session = static_pointer_cast<CommSession>(FindServerSession(SessionComparator_Sender, &serverId));
+   bool bulkMode = (session != nullptr) && session->isBulkDataPushSupported();
+
+   DataSenderBatch *batch = nullptr;
+   bool failure = false;
+   for(int i = 0; i < elements->size(); i++)
+   {
+      DataElement *e = elements->get(i);
+      if (bulkMode && (e->getType() == DCO_TYPE_ITEM))
       {
-         if (!e->sendToServer(false))
+         if (batch == nullptr)
+            batch = new DataSenderBatch(session, serverId);
+         batch->elements.add(e);
+         if (batch->elements.size() == static_cast<int>(g_dcSenderBatchSize))
          {
-            status->queueSize++;
-            s_databaseWriterQueue.put(e);
-            e = nullptr;
+            SendBatch(batch, inFlight);
+            batch = nullptr;
          }
       }
+      else if (!failure && e->sendToServer(false))
+      {
+         delete e;
+      }
       else
       {
-         status->queueSize++;
-         s_databaseWriterQueue.put(e);
-         e = nullptr;
+         failure = true;
+         s_serverSyncStatusLock.lock();
+         QueueForReconciliation(GetServerSyncStatus(serverId), e);
+         s_serverSyncStatusLock.unlock();
+      }
+   }
+   if (batch != nullptr)
+      SendBatch(batch, inFlight);
+}
+
+/**
+ * Data sender. Takes all values available in sender queue (up to configured batch size), sends them to server(s)
+ * in bulk mode and keeps up to configured number of batches in flight while waiting for acknowledgements.
+ */
+static void DataSender()
+{
+   nxlog_debug_tag(DEBUG_TAG, 1, _T("Data sender thread started (batch size %u, window size %u)"), g_dcSenderBatchSize, g_dcSenderWindowSize);
+
+   ObjectArray<DataSenderBatch> inFlight(16, 16, Ownership::True);
+   ObjectArray<DataElement> elements(256, 256, Ownership::False);
+   bool shutdown = false;
+   while(!shutdown)
+   {
+      DataElement *e;
+      if (inFlight.isEmpty())
+      {
+         e = static_cast<DataElement*>(s_dataSenderQueue.getOrBlock());
+      }
+      else
+      {
+         e = static_cast<DataElement*>(s_dataSenderQueue.get());
+         if (e == nullptr)
+         {
+            // Nothing new to send, use idle time for processing acknowledgements
+            CompleteOldestBatch(&inFlight);
+            continue;
+         }
+      }
+      if (e == INVALID_POINTER_VALUE)
+         break;
+
+      elements.add(e);
+      while(elements.size() < static_cast<int>(g_dcSenderBatchSize))
+      {
+         e = static_cast<DataElement*>(s_dataSenderQueue.get());
+         if (e == nullptr)
+            break;
+         if (e == INVALID_POINTER_VALUE)
+         {
+            shutdown = true;
+            break;
+         }
+         elements.add(e);
       }
-      s_serverSyncStatusLock.unlock();
 
-      delete e;
+      // Split values by server preserving original order
+      for(int i = 0; i < elements.size(); i++)
+      {
+         e = elements.get(i);
+         if (e == nullptr)
+            continue;
+
+         uint64_t serverId = e->getServerId();
+         ObjectArray<DataElement> serverElements(elements.size() - i, 16, Ownership::False);
+         for(int j = i; j < elements.size(); j++)
+         {
+            DataElement *se = elements.get(j);
+            if ((se != nullptr) && (se->getServerId() == serverId))
+            {
+               serverElements.add(se);
+               elements.replace(j, nullptr);
+            }
+         }
+         SendServerData(serverId, &serverElements, &inFlight);
+      }
+      elements.clear();
    }
+
+   while(!inFlight.isEmpty())
+      CompleteOldestBatch(&inFlight);
+
    nxlog_debug_tag(DEBUG_TAG, 1, _T("Data sender thread stopped"));
 }
 
@@ -1721,6 +1957,28 @@ void StartLocalDataCollector()
       g_dcReconciliationTimeout = 900000;
    }
 
+   if (g_dcSenderBatchSize < 1)
+   {
+      nxlog_debug_tag(DEBUG_TAG, 1, _T("Invalid data sender batch size %d, resetting to 1"), g_dcSenderBatchSize);
+      g_dcSenderBatchSize = 1;
+   }
+   else if (g_dcSenderBatchSize > MAX_BULK_DATA_BLOCK_SIZE)
+   {
+      nxlog_debug_tag(DEBUG_TAG, 1, _T("Invalid data sender batch size %d, resetting to %d"), g_dcSenderBatchSize, MAX_BULK_DATA_BLOCK_SIZE);
+      g_dcSenderBatchSize = MAX_BULK_DATA_BLOCK_SIZE;
+   }
+
+   if (g_dcSenderWindowSize < 1)
+   {
+      nxlog_debug_tag(DEBUG_TAG, 1, _T("Invalid data sender window size %d, resetting to 1"), g_dcSenderWindowSize);
+      g_dcSenderWindowSize = 1;
+   }
+   else if (g_dcSenderWindowSize > 64)
+   {
+      nxlog_debug_tag(DEBUG_TAG, 1, _T("Invalid data sender window size %d, resetting to 64"), g_dcSenderWindowSize);
+      g_dcSenderWindowSize = 64;
+   }
+
    LoadState();
 
    g_dataCollectorPool = ThreadPoolCreate(_T("DATACOLL"), g_dcMinCollectorPoolSize, g_dcMaxCollectorPoolSize);
@@ -0,0 +1,78 @@
+/*
+** NetXMS multiplatform core agent
+** Copyright (C) 2003-2024 Raden Solutions
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** File: datasender.h
+**
+**/
+
+#ifndef _datasender_h_
+#define _datasender_h_
+
+/**
+ * Complete oldest batch in acknowledgement window (batch at position 0) using per-value status received from server.
+ * Values accepted by server are destroyed, values with retry status are passed to requeue callback. If any value
+ * was not accepted, all later batches for same server still in flight are revoked and all their values are passed
+ * to requeue callback as well (in original order), so that newer values never reach server before older ones.
+ * Batch type should provide fields "serverId" and "elements" (object array of values). Returns number of requeued values.
+ */
+template<typename B, typename E> int CompleteDataSenderBatch(ObjectArray<B> *inFlight, const BYTE *status, const std::function<void (E*)>& requeue)
+{
+   B *batch = inFlight->get(0);
+   int retryCount = 0;
+   batch->elements.setOwner(Ownership::False);
+   for(int i = 0; i < batch->elements.size(); i++)
+   {
+      E *e = batch->elements.get(i);
+      if (status[i] == BULK_DATA_REC_RETRY)
+      {
+         requeue(e);
+         retryCount++;
+      }
+      else
+      {
+         delete e;
+      }
+   }
+
+   uint64_t serverId = batch->serverId;
+   inFlight->remove(0);
+
+   if (retryCount == 0)
+      return 0;
+
+   // Server may have accepted later batches already, but their values will be sent again after retried ones
+   int requeueCount = retryCount;
+   for(int i = 0; i < inFlight->size();)
+   {
+      B *b = inFlight->get(i);
+      if (b->serverId != serverId)
+      {
+         i++;
+         continue;
+      }
+
+      b->elements.setOwner(Ownership::False);
+      for(int j = 0; j < b->elements.size(); j++)
+         requeue(b->elements.get(j));
+      requeueCount += b->elements.size();
+      inFlight->remove(i);
+   }
+   return requeueCount;
+}
+
+#endif
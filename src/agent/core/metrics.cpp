@@ -106,6 +106,20 @@ static VolatileCounter s_processedRequests = 0;
 static VolatileCounter s_failedRequests = 0;
 static VolatileCounter s_unsupportedRequests = 0;
 
+/**
+ * Only every N-th metric lookup in each thread is timed and counted (counter is increased by N)
+ */
+#define LOOKUP_SAMPLING_INTERVAL 64
+
+/**
+ * Metric lookup statistics
+ */
+static VolatileCounter64 s_lookupCount = 0;
+static VolatileCounter64 s_timedLookupCount = 0;
+static VolatileCounter64 s_lookupTime = 0;   // Total time of timed lookups in nanoseconds
+static VolatileCounter64 s_lookupWildcardMatches = 0;
+static thread_local uint32_t s_lookupSequence = 0;
+
 /**
  * Handler for parameters which always returns string constant
  */
@@ -430,6 +444,7 @@ static LONG H_MetricList(const TCHAR *cmd, const TCHAR *arg, StringList *value,
 static LONG H_PushMetricList(const TCHAR *cmd, const TCHAR *arg, StringList *value, AbstractCommSession *session);
 static LONG H_ListOfLists(const TCHAR *cmd, const TCHAR *arg, StringList *value, AbstractCommSession *session);
 static LONG H_TableList(const TCHAR *cmd, const TCHAR *arg, StringList *value, AbstractCommSession *session);
+static LONG H_MetricLookupStats(const TCHAR *cmd, const TCHAR *arg, TCHAR *value, AbstractCommSession *session);
 
 /**
  * Standard agent's parameters
@@ -464,6 +479,9 @@ static NETXMS_SUBAGENT_PARAM s_standardParams[] =
    { _T("Agent.LocalDatabase.Status"), H_ComponentStatus, _T("D"), DCI_DT_UINT, DCIDESC_AGENT_LOCALDB_STATUS },
    { _T("Agent.LocalDatabase.TotalQueries"), H_LocalDatabaseCounters, _T("T"), DCI_DT_COUNTER64, DCIDESC_AGENT_LOCALDB_TOTAL_QUERIES },
    { _T("Agent.LogFile.Status"), H_ComponentStatus, _T("L"), DCI_DT_UINT, DCIDESC_AGENT_LOG_STATUS },
+   { _T("Agent.MetricLookup.AverageTime"), H_MetricLookupStats, _T("A"), DCI_DT_FLOAT, DCIDESC_AGENT_METRICLOOKUP_AVERAGETIME },
+   { _T("Agent.MetricLookup.Requests"), H_MetricLookupStats, _T("R"), DCI_DT_COUNTER64, DCIDESC_AGENT_METRICLOOKUP_REQUESTS },
+   { _T("Agent.MetricLookup.WildcardMatches"), H_MetricLookupStats, _T("W"), DCI_DT_COUNTER64, DCIDESC_AGENT_METRICLOOKUP_WILDCARDMATCHES },
    { _T("Agent.NotificationProcessor.QueueSize"), H_NotificationStats, nullptr, DCI_DT_UINT, DCIDESC_AGENT_NOTIFICATIONPROC_QUEUESIZE },
    { _T("Agent.ProcessedRequests"), H_UIntPtr, (TCHAR *)&s_processedRequests, DCI_DT_COUNTER32, DCIDESC_AGENT_PROCESSEDREQUESTS },
    { _T("Agent.Proxy.ActiveSessions"), H_AgentProxyStats, _T("A"), DCI_DT_UINT, DCIDESC_AGENT_PROXY_ACTIVESESSIONS },
@@ -604,6 +622,171 @@ static StructArray<NETXMS_SUBAGENT_PUSHPARAM> s_pushMetrics(0, 64);
 static StructArray<NETXMS_SUBAGENT_LIST> s_lists(s_standardLists, sizeof(s_standardLists) / sizeof(NETXMS_SUBAGENT_LIST), 16);
 static StructArray<NETXMS_SUBAGENT_TABLE> s_tables(s_standardTables, sizeof(s_standardTables) / sizeof(NETXMS_SUBAGENT_TABLE), 16);
 
+/**
+ * Get monotonic clock time in nanoseconds (used for lookup time measurement)
+ */
+static inline int64_t GetMonotonicClockTimeNs()
+{
+#if defined(_WIN32)
+   LARGE_INTEGER counter, frequency;
+   QueryPerformanceCounter(&counter);
+   QueryPerformanceFrequency(&frequency);
+   return static_cast<int64_t>(static_cast<double>(counter.QuadPart) * 1000000000.0 / static_cast<double>(frequency.QuadPart));
+#elif defined(__sun)
+   return static_cast<int64_t>(gethrtime());
+#else
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return static_cast<int64_t>(ts.tv_sec) * _LL(1000000000) + static_cast<int64_t>(ts.tv_nsec);
+#endif
+}
+
+/**
+ * Dispatch index for metric, list, and table handlers. Names without wildcards are looked up
+ * in hash map, names like Name(*) are looked up by literal part before opening bracket, and
+ * only remaining patterns are checked with wildcard matching on each request. If more than one
+ * handler matches, one registered first is returned, same as with linear scan.
+ */
+template<typename T> class DispatchIndex
+{
+private:
+   const StructArray<T> *m_elements;
+   int m_indexedCount;
+   StringObjectMap<IntegerArray<int32_t>> m_names;
+   StringObjectMap<IntegerArray<int32_t>> m_prefixes;
+   IntegerArray<int32_t> m_patterns;
+
+   static void addToBucket(StringObjectMap<IntegerArray<int32_t>> *map, const TCHAR *key, int32_t index)
+   {
+      IntegerArray<int32_t> *bucket = map->get(key);
+      if (bucket == nullptr)
+      {
+         bucket = new IntegerArray<int32_t>(4, 4);
+         map->set(key, bucket);
+      }
+      bucket->add(index);
+   }
+
+   int32_t matchCandidates(const IntegerArray<int32_t> *candidates, const TCHAR *name, int32_t best, int *matches) const
+   {
+      for(int i = 0; i < candidates->size(); i++)
+      {
+         int32_t index = candidates->get(i);
+         if ((best != -1) && (index > best))
+            break;
+         (*matches)++;
+         if (MatchString(m_elements->get(index)->name, name, false))
+            return index;
+      }
+      return best;
+   }
+
+public:
+   DispatchIndex(const StructArray<T> *elements) : m_names(Ownership::True), m_prefixes(Ownership::True), m_patterns(16, 16)
+   {
+      m_elements = elements;
+      m_indexedCount = 0;
+      update();
+   }
+
+   /**
+    * Add elements registered since last update to index. Existing elements are updated in place
+    * and never removed, so their positions and names remain valid.
+    */
+   void update()
+   {
+      for(; m_indexedCount < m_elements->size(); m_indexedCount++)
+      {
+         const TCHAR *name = m_elements->get(m_indexedCount)->name;
+         const TCHAR *wildcard = _tcspbrk(name, _T("*?"));
+         if (wildcard == nullptr)
+         {
+            addToBucket(&m_names, name, m_indexedCount);
+            continue;
+         }
+
+         const TCHAR *bracket = _tcschr(name, _T('('));
+         if ((bracket != nullptr) && (bracket < wildcard))
+         {
+            TCHAR prefix[MAX_PARAM_NAME];
+            _tcslcpy(prefix, name, std::min(static_cast<size_t>(bracket - name) + 1, static_cast<size_t>(MAX_PARAM_NAME)));
+            addToBucket(&m_prefixes, prefix, m_indexedCount);
+         }
+         else
+         {
+            m_patterns.add(m_indexedCount);
+         }
+      }
+   }
+
+   /**
+    * Find handler for given metric name
+    */
+   T *find(const TCHAR *name) const
+   {
+      bool timed = (++s_lookupSequence % LOOKUP_SAMPLING_INTERVAL == 0);
+      int64_t startTime = timed ? GetMonotonicClockTimeNs() : 0;
+
+      int32_t best = -1;
+      int matches = 0;
+      const IntegerArray<int32_t> *candidates = m_names.get(name);
+      if (candidates != nullptr)
+         best = candidates->get(0);
+
+      const TCHAR *bracket = _tcschr(name, _T('('));
+      if (bracket != nullptr)
+      {
+         candidates = m_prefixes.get(name, bracket - name);
+         if (candidates != nullptr)
+            best = matchCandidates(candidates, name, best, &matches);
+      }
+
+      best = matchCandidates(&m_patterns, name, best, &matches);
+
+      if (matches > 0)
+         InterlockedAdd64(&s_lookupWildcardMatches, matches);
+      if (timed)
+      {
+         InterlockedAdd64(&s_lookupTime, GetMonotonicClockTimeNs() - startTime);
+         InterlockedIncrement64(&s_timedLookupCount);
+         InterlockedAdd64(&s_lookupCount, LOOKUP_SAMPLING_INTERVAL);
+      }
+      return (best != -1) ? m_elements->get(best) : nullptr;
+   }
+};
+
+/**
+ * Dispatch indexes
+ */
+static DispatchIndex<NETXMS_SUBAGENT_PARAM> s_metricIndex(&s_metrics);
+static DispatchIndex<NETXMS_SUBAGENT_LIST> s_listIndex(&s_lists);
+static DispatchIndex<NETXMS_SUBAGENT_TABLE> s_tableIndex(&s_tables);
+
+/**
+ * Handler for metric lookup statistics
+ */
+static LONG H_MetricLookupStats(const TCHAR *cmd, const TCHAR *arg, TCHAR *value, AbstractCommSession *session)
+{
+   switch(*arg)
+   {
+      case 'A':
+      {
+         int64_t count = s_timedLookupCount;
+         ret_double(value, (count > 0) ? static_cast<double>(s_lookupTime) / static_cast<double>(count) / 1000.0 : 0, 3);
+         break;
+      }
+      case 'R':
+         ret_uint64(value, s_lookupCount);
+         break;
+      case 'W':
+         ret_uint64(value, s_lookupWildcardMatches);
+         break;
+      default:
+         return SYSINFO_RC_UNSUPPORTED;
+   }
+   return SYSINFO_RC_SUCCESS;
+}
+
 /**
  * Handler for metrics list
  */
@@ -724,6 +907,7 @@ void AddMetric(const TCHAR *name, LONG (*handler)(const TCHAR*, const TCHAR*, TC
       np.dataType = dataType;
       _tcslcpy(np.description, description, MAX_DB_STRING);
       s_metrics.add(np);
+      s_metricIndex.update();
    }
 }
 
@@ -754,6 +938,7 @@ void AddList(const TCHAR *name, LONG (*handler)(const TCHAR*, const TCHAR*, Stri
       np.handler = handler;
       np.arg = arg;
       s_lists.add(np);
+      s_listIndex.update();
    }
 }
 
@@ -793,6 +978,7 @@ void AddTable(const TCHAR *name, LONG (* handler)(const TCHAR *, const TCHAR *,
       np.numColumns = numColumns;
       np.columns = columns;
       s_tables.add(np);
+      s_tableIndex.update();
       nxlog_debug(7, _T("Table %s added (%d predefined columns, instance columns \"%s\")"), name, numColumns, instanceColumns);
    }
 }
@@ -992,46 +1178,42 @@ uint32_t GetMetricValue(const TCHAR *param, TCHAR *value, AbstractCommSession *s
    uint32_t errorCode = ERR_UNKNOWN_METRIC;
 
    session->debugPrintf(5, _T("Requesting metric \"%s\""), param);
-   for(int i = 0; i < s_metrics.size(); i++)
-	{
-      NETXMS_SUBAGENT_PARAM *p = s_metrics.get(i);
-      if (MatchString(p->name, param, FALSE))
+   NETXMS_SUBAGENT_PARAM *p = s_metricIndex.find(param);
+   if (p != nullptr)
+   {
+      LONG rc = p->handler(param, p->arg, value, session);
+      switch(rc)
       {
-         LONG rc = p->handler(param, p->arg, value, session);
-         switch(rc)
-         {
-            case SYSINFO_RC_SUCCESS:
-               errorCode = ERR_SUCCESS;
-               InterlockedIncrement(&s_processedRequests);
-               break;
-            case SYSINFO_RC_ACCESS_DENIED:
-               errorCode = ERR_ACCESS_DENIED;
-               InterlockedIncrement(&s_failedRequests);
-               break;
-            case SYSINFO_RC_ERROR:
-               errorCode = ERR_INTERNAL_ERROR;
-               InterlockedIncrement(&s_failedRequests);
-               break;
-            case SYSINFO_RC_NO_SUCH_INSTANCE:
-               errorCode = ERR_NO_SUCH_INSTANCE;
-               InterlockedIncrement(&s_failedRequests);
-               break;
-            case SYSINFO_RC_UNSUPPORTED:
-               errorCode = ERR_UNSUPPORTED_METRIC;
-               InterlockedIncrement(&s_unsupportedRequests);
-               break;
-            case SYSINFO_RC_UNKNOWN:
-               errorCode = ERR_UNKNOWN_METRIC;
-               break;
-            default:
-               nxlog_write(NXLOG_ERROR, _T("Internal error: unexpected return code %d in GetMetricValue(\"%s\")"), rc, param);
-               errorCode = ERR_INTERNAL_ERROR;
-               InterlockedIncrement(&s_failedRequests);
-               break;
-         }
-         break;
+         case SYSINFO_RC_SUCCESS:
+            errorCode = ERR_SUCCESS;
+            InterlockedIncrement(&s_processedRequests);
+            break;
+         case SYSINFO_RC_ACCESS_DENIED:
+            errorCode = ERR_ACCESS_DENIED;
+            InterlockedIncrement(&s_failedRequests);
+            break;
+         case SYSINFO_RC_ERROR:
+            errorCode = ERR_INTERNAL_ERROR;
+            InterlockedIncrement(&s_failedRequests);
+            break;
+         case SYSINFO_RC_NO_SUCH_INSTANCE:
+            errorCode = ERR_NO_SUCH_INSTANCE;
+            InterlockedIncrement(&s_failedRequests);
+            break;
+         case SYSINFO_RC_UNSUPPORTED:
+            errorCode = ERR_UNSUPPORTED_METRIC;
+            InterlockedIncrement(&s_unsupportedRequests);
+            break;
+         case SYSINFO_RC_UNKNOWN:
+            errorCode = ERR_UNKNOWN_METRIC;
+            break;
+         default:
+            nxlog_write(NXLOG_ERROR, _T("Internal error: unexpected return code %d in GetMetricValue(\"%s\")"), rc, param);
+            errorCode = ERR_INTERNAL_ERROR;
+            InterlockedIncrement(&s_failedRequests);
+            break;
       }
-	}
+   }
 
    if (errorCode == ERR_UNKNOWN_METRIC)
    {
@@ -1109,43 +1291,39 @@ uint32_t GetListValue(const TCHAR *param, StringList *value, AbstractCommSession
 {
    uint32_t errorCode = ERR_UNKNOWN_METRIC;
    session->debugPrintf(5, _T("Requesting list \"%s\""), param);
-   for(int i = 0; i < s_lists.size(); i++)
-	{
-      NETXMS_SUBAGENT_LIST *list = s_lists.get(i);
-      if (MatchString(list->name, param, false))
+   NETXMS_SUBAGENT_LIST *list = s_listIndex.find(param);
+   if (list != nullptr)
+   {
+      LONG rc = list->handler(param, list->arg, value, session);
+      switch(rc)
       {
-         LONG rc = list->handler(param, list->arg, value, session);
-         switch(rc)
-         {
-            case SYSINFO_RC_SUCCESS:
-               errorCode = ERR_SUCCESS;
-               InterlockedIncrement(&s_processedRequests);
-               break;
-            case SYSINFO_RC_ACCESS_DENIED:
-               errorCode = ERR_ACCESS_DENIED;
-               InterlockedIncrement(&s_failedRequests);
-               break;
-            case SYSINFO_RC_ERROR:
-               errorCode = ERR_INTERNAL_ERROR;
-               InterlockedIncrement(&s_failedRequests);
-               break;
-            case SYSINFO_RC_NO_SUCH_INSTANCE:
-               errorCode = ERR_NO_SUCH_INSTANCE;
-               InterlockedIncrement(&s_failedRequests);
-               break;
-            case SYSINFO_RC_UNSUPPORTED:
-               errorCode = ERR_UNSUPPORTED_METRIC;
-               InterlockedIncrement(&s_unsupportedRequests);
-               break;
-            default:
-               nxlog_write(NXLOG_ERROR, _T("Internal error: unexpected return code %d in GetListValue(\"%s\")"), rc, param);
-               errorCode = ERR_INTERNAL_ERROR;
-               InterlockedIncrement(&s_failedRequests);
-               break;
-         }
-         break;
+         case SYSINFO_RC_SUCCESS:
+            errorCode = ERR_SUCCESS;
+            InterlockedIncrement(&s_processedRequests);
+            break;
+         case SYSINFO_RC_ACCESS_DENIED:
+            errorCode = ERR_ACCESS_DENIED;
+            InterlockedIncrement(&s_failedRequests);
+            break;
+         case SYSINFO_RC_ERROR:
+            errorCode = ERR_INTERNAL_ERROR;
+            InterlockedIncrement(&s_failedRequests);
+            break;
+         case SYSINFO_RC_NO_SUCH_INSTANCE:
+            errorCode = ERR_NO_SUCH_INSTANCE;
+            InterlockedIncrement(&s_failedRequests);
+            break;
+         case SYSINFO_RC_UNSUPPORTED:
+            errorCode = ERR_UNSUPPORTED_METRIC;
+            InterlockedIncrement(&s_unsupportedRequests);
+            break;
+         default:
+            nxlog_write(NXLOG_ERROR, _T("Internal error: unexpected return code %d in GetListValue(\"%s\")"), rc, param);
+            errorCode = ERR_INTERNAL_ERROR;
+            InterlockedIncrement(&s_failedRequests);
+            break;
       }
-	}
+   }
 
 	if (errorCode == ERR_UNKNOWN_METRIC)
    {
@@ -1175,53 +1353,49 @@ uint32_t GetTableValue(const TCHAR *param, Table *value, AbstractCommSession *se
 {
    uint32_t errorCode = ERR_UNKNOWN_METRIC;
    session->debugPrintf(5, _T("Requesting table \"%s\""), param);
-   for(int i = 0; i < s_tables.size(); i++)
-	{
-      NETXMS_SUBAGENT_TABLE *t = s_tables.get(i);
-      if (MatchString(t->name, param, FALSE))
+   NETXMS_SUBAGENT_TABLE *t = s_tableIndex.find(param);
+   if (t != nullptr)
+   {
+      // pre-fill table columns if specified in table definition
+      if (t->numColumns > 0)
       {
-         // pre-fill table columns if specified in table definition
-         if (t->numColumns > 0)
+         for(int c = 0; c < t->numColumns; c++)
          {
-            for(int c = 0; c < t->numColumns; c++)
-            {
-               NETXMS_SUBAGENT_TABLE_COLUMN *col = &t->columns[c];
-               value->addColumn(col->name, col->dataType, col->displayName, col->isInstance);
-            }
+            NETXMS_SUBAGENT_TABLE_COLUMN *col = &t->columns[c];
+            value->addColumn(col->name, col->dataType, col->displayName, col->isInstance);
          }
+      }
 
-         LONG rc = t->handler(param, t->arg, value, session);
-         switch(rc)
-         {
-            case SYSINFO_RC_SUCCESS:
-               errorCode = ERR_SUCCESS;
-               InterlockedIncrement(&s_processedRequests);
-               break;
-            case SYSINFO_RC_ACCESS_DENIED:
-               errorCode = ERR_ACCESS_DENIED;
-               InterlockedIncrement(&s_failedRequests);
-               break;
-            case SYSINFO_RC_ERROR:
-               errorCode = ERR_INTERNAL_ERROR;
-               InterlockedIncrement(&s_failedRequests);
-               break;
-            case SYSINFO_RC_NO_SUCH_INSTANCE:
-               errorCode = ERR_NO_SUCH_INSTANCE;
-               InterlockedIncrement(&s_failedRequests);
-               break;
-            case SYSINFO_RC_UNSUPPORTED:
-               errorCode = ERR_UNSUPPORTED_METRIC;
-               InterlockedIncrement(&s_unsupportedRequests);
-               break;
-            default:
-               nxlog_write(NXLOG_ERROR, _T("Internal error: unexpected return code %d in GetTableValue(\"%s\")"), rc, param);
-               errorCode = ERR_INTERNAL_ERROR;
-               InterlockedIncrement(&s_failedRequests);
-               break;
-         }
-         break;
+      LONG rc = t->handler(param, t->arg, value, session);
+      switch(rc)
+      {
+         case SYSINFO_RC_SUCCESS:
+            errorCode = ERR_SUCCESS;
+            InterlockedIncrement(&s_processedRequests);
+            break;
+         case SYSINFO_RC_ACCESS_DENIED:
+            errorCode = ERR_ACCESS_DENIED;
+            InterlockedIncrement(&s_failedRequests);
+            break;
+         case SYSINFO_RC_ERROR:
+            errorCode = ERR_INTERNAL_ERROR;
+            InterlockedIncrement(&s_failedRequests);
+            break;
+         case SYSINFO_RC_NO_SUCH_INSTANCE:
+            errorCode = ERR_NO_SUCH_INSTANCE;
+            InterlockedIncrement(&s_failedRequests);
+            break;
+         case SYSINFO_RC_UNSUPPORTED:
+            errorCode = ERR_UNSUPPORTED_METRIC;
+            InterlockedIncrement(&s_unsupportedRequests);
+            break;
+         default:
+            nxlog_write(NXLOG_ERROR, _T("Internal error: unexpected return code %d in GetTableValue(\"%s\")"), rc, param);
+            errorCode = ERR_INTERNAL_ERROR;
+            InterlockedIncrement(&s_failedRequests);
+            break;
       }
-	}
+   }
 
    if (errorCode == ERR_UNKNOWN_METRIC)
    {
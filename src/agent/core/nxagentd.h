@@ -327,6 +327,7 @@ class CommSession : public AbstractCommSession
    bool m_acceptFileUpdates;
    bool m_ipv6Aware;
    bool m_bulkReconciliationSupported;
+   bool m_bulkDataPushSupported;
    bool m_allowCompression;   // allow compression for structured messages
    bool m_acceptKeepalive;    // true if server will respond to keepalive messages
    bool m_stopCommandProcessing;
@@ -347,6 +348,7 @@ class CommSession : public AbstractCommSession
    void getConfig(NXCPMessage *pMsg);
    void updateConfig(NXCPMessage *pRequest, NXCPMessage *pMsg);
    void getParameter(NXCPMessage *request, NXCPMessage *response);
+   void getMultipleParameters(NXCPMessage *request, NXCPMessage *response);
    void getList(NXCPMessage *request, NXCPMessage *response);
    void getTable(NXCPMessage *request, NXCPMessage *response);
    void action(NXCPMessage *request, NXCPMessage *response);
@@ -401,6 +403,7 @@ class CommSession : public AbstractCommSession
    virtual bool canAcceptTraps() override { return m_acceptTraps; }
    virtual bool canAcceptFileUpdates() override { return m_acceptFileUpdates; }
    virtual bool isBulkReconciliationSupported() override { return m_bulkReconciliationSupported; }
+   bool isBulkDataPushSupported() const { return m_bulkDataPushSupported; }
    virtual bool isIPv6Aware() override { return m_ipv6Aware; }
 
    virtual const TCHAR *getDebugTag() const override { return m_debugTag; }
@@ -116,6 +116,7 @@ CommSession::CommSession(const shared_ptr<AbstractCommChannel>& channel, const I
    m_pendingRequests = 0;
    m_ipv6Aware = false;
    m_bulkReconciliationSupported = false;
+   m_bulkDataPushSupported = false;
    m_disconnected = false;
    m_allowCompression = false;
    m_acceptKeepalive = false;
@@ -623,6 +624,9 @@ void CommSession::processCommand(NXCPMessage *request)
          case CMD_GET_PARAMETER:
             getParameter(request, &response);
             break;
+         case CMD_GET_MULTIPLE_PARAMETERS:
+            getMultipleParameters(request, &response);
+            break;
          case CMD_GET_LIST:
             getList(request, &response);
             break;
@@ -739,13 +743,15 @@ void CommSession::processCommand(NXCPMessage *request)
             // Servers before 2.0 use VID_ENABLED
             m_ipv6Aware = request->isFieldExist(VID_IPV6_SUPPORT) ? request->getFieldAsBoolean(VID_IPV6_SUPPORT) : request->getFieldAsBoolean(VID_ENABLED);
             m_bulkReconciliationSupported = request->getFieldAsBoolean(VID_BULK_RECONCILIATION);
+            m_bulkDataPushSupported = request->getFieldAsBoolean(VID_BULK_DATA_PUSH);
             m_allowCompression = request->getFieldAsBoolean(VID_ENABLE_COMPRESSION);
             m_acceptKeepalive = request->getFieldAsBoolean(VID_ACCEPT_KEEPALIVE);
             response.setField(VID_RCC, ERR_SUCCESS);
             response.setField(VID_FLAGS, static_cast<uint16_t>((m_controlServer ? 0x01 : 0x00) | (m_masterServer ? 0x02 : 0x00)));
-            debugPrintf(4, _T("Server capabilities: IPv6: %s; bulk reconciliation: %s; compression: %s"),
+            debugPrintf(4, _T("Server capabilities: IPv6: %s; bulk reconciliation: %s; bulk data push: %s; compression: %s"),
                         m_ipv6Aware ? _T("yes") : _T("no"),
                         m_bulkReconciliationSupported ? _T("yes") : _T("no"),
+                        m_bulkDataPushSupported ? _T("yes") : _T("no"),
                         m_allowCompression ? _T("yes") : _T("no"));
             break;
          case CMD_SET_SERVER_ID:
@@ -954,6 +960,108 @@ void CommSession::getParameter(NXCPMessage *request, NXCPMessage *response)
       response->setField(VID_VALUE, value);
 }
 
+/**
+ * Max number of additional threads used for evaluation of single multiple metrics request
+ */
+#define MAX_MULTIPLE_METRICS_HELPERS   8
+
+/**
+ * Number of metrics per additional evaluation thread
+ */
+#define METRICS_PER_HELPER             16
+
+/**
+ * Shared state of multiple metrics request
+ */
+struct MultipleMetricsRequest
+{
+   StringList names;
+   TCHAR *values;
+   uint32_t *rcc;
+   AbstractCommSession *session;
+   VolatileCounter nextIndex;
+   VolatileCounter completed;
+   Condition done;
+
+   MultipleMetricsRequest(const NXCPMessage& request, int count, AbstractCommSession *_session) : done(true)
+   {
+      // Names are truncated to same length as in single metric request
+      TCHAR name[MAX_RUNTIME_PARAM_NAME];
+      uint32_t fieldId = VID_PARAM_LIST_BASE;
+      for(int i = 0; i < count; i++)
+      {
+         request.getFieldAsString(fieldId++, name, MAX_RUNTIME_PARAM_NAME);
+         names.add(name);
+      }
+      values = MemAllocArrayNoInit<TCHAR>(names.size() * MAX_RESULT_LENGTH);
+      rcc = MemAllocArrayNoInit<uint32_t>(names.size());
+      session = _session;
+      nextIndex = 0;
+      completed = 0;
+   }
+
+   ~MultipleMetricsRequest()
+   {
+      MemFree(values);
+      MemFree(rcc);
+   }
+};
+
+/**
+ * Evaluate metrics from multiple metrics request until there are no unclaimed metrics left.
+ * Session object is only accessed while evaluating claimed metric, and request originator
+ * waits for all claimed metrics to complete, so it is safe for helper to start late.
+ */
+static void EvaluateMetrics(const shared_ptr<MultipleMetricsRequest>& request)
+{
+   int count = request->names.size();
+   while(true)
+   {
+      int index = InterlockedIncrement(&request->nextIndex) - 1;
+      if (index >= count)
+         break;
+      request->rcc[index] = GetMetricValue(request->names.get(index), &request->values[index * MAX_RESULT_LENGTH], request->session);
+      if (InterlockedIncrement(&request->completed) == count)
+         request->done.set();
+   }
+}
+
+/**
+ * Get values for multiple metrics. Metrics are evaluated in parallel if request is large enough.
+ * Requests with more than MAX_MULTIPLE_METRICS metrics are rejected (server splits larger sets).
+ */
+void CommSession::getMultipleParameters(NXCPMessage *request, NXCPMessage *response)
+{
+   int count = request->getFieldAsInt32(VID_NUM_PARAMETERS);
+   if ((count < 0) || (count > MAX_MULTIPLE_METRICS))
+   {
+      debugPrintf(4, _T("Multiple metrics request rejected: invalid number of metrics (%d)"), count);
+      response->setField(VID_RCC, ERR_BAD_ARGUMENTS);
+      return;
+   }
+
+   auto r = make_shared<MultipleMetricsRequest>(*request, count, this);
+   if (count > 0)
+   {
+      int helpers = std::min(count / METRICS_PER_HELPER, MAX_MULTIPLE_METRICS_HELPERS);
+      for(int i = 0; i < helpers; i++)
+         ThreadPoolExecute(g_commThreadPool, EvaluateMetrics, r);
+      EvaluateMetrics(r);
+      r->done.wait(INFINITE);
+   }
+
+   response->setField(VID_RCC, ERR_SUCCESS);
+   response->setField(VID_NUM_PARAMETERS, static_cast<uint32_t>(count));
+   uint32_t fieldId = VID_PARAM_LIST_BASE;
+   for(int i = 0; i < count; i++, fieldId += 2)
+   {
+      response->setField(fieldId, r->rcc[i]);
+      if (r->rcc[i] == ERR_SUCCESS)
+         response->setField(fieldId + 1, &r->values[i * MAX_RESULT_LENGTH]);
+   }
+   debugPrintf(7, _T("Multiple metrics request: %d metrics processed"), count);
+}
+
 /**
  * Get list of values
  */
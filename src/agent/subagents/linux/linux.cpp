@@ -108,6 +108,7 @@ static bool SubAgentInit(Config *config)
    StartCpuUsageCollector();
    StartIoStatCollector();
    InitDrbdCollector();
+   InitProcessSnapshot(config);
    return true;
 }
 
@@ -257,6 +257,8 @@ void StopDrbdCollector();
 
 void ReadCPUVendorId();
 
+void InitProcessSnapshot(Config *config);
+
 uint64_t GetTotalMemorySize();
 
 /**
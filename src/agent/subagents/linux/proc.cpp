@@ -62,7 +62,9 @@ struct FileDescriptor
 };
 
 /**
- * Process entry
+ * Process entry. Fields parsed from /proc/<pid>/stat are filled when snapshot is taken,
+ * user name, command line, and open handles are read on first access. Lazily loaded fields
+ * are read without lock and published with compare-exchange (first published value wins).
  */
 struct Process
 {
@@ -71,7 +73,6 @@ struct Process
    uint32_t parent;      // PID of parent process
    uint32_t group;       // Group ID
    char state;           // Process state
-   char user[MAX_USER_NAME_LEN];   // Process owner user
    long threads;         // Number of threads
    unsigned long ktime;  // Number of ticks spent in kernel mode
    unsigned long utime;  // Number of ticks spent in user mode
@@ -79,17 +80,19 @@ struct Process
    long rss;             // Process's resident set size in pages
    unsigned long minflt; // Number of minor page faults
    unsigned long majflt; // Number of major page faults
-   ObjectArray<FileDescriptor> *fd;
-   char *cmdLine; // Process command line
+   std::atomic<char*> user;   // Process owner user (nullptr if not loaded yet)
+   std::atomic<ObjectArray<FileDescriptor>*> fd;
+   std::atomic<char*> cmdLine; // Process command line
+   std::atomic<bool> handlesLoaded;
+   std::atomic<bool> cmdLineLoaded;
 
-   Process(uint32_t _pid, const char *_name, char *_user, char *_cmdLine)
+   Process(uint32_t _pid, const char *_name) : user(nullptr), fd(nullptr), cmdLine(nullptr), handlesLoaded(false), cmdLineLoaded(false)
    {
       pid = _pid;
       strlcpy(name, _name, MAX_PROCESS_NAME_LEN);
       parent = 0;
       group = 0;
       state = '?';
-      strlcpy(user, CHECK_NULL_EX_A(_user), MAX_USER_NAME_LEN);
       threads = 0;
       ktime = 0;
       utime = 0;
@@ -97,14 +100,13 @@ struct Process
       rss = 0;
       minflt = 0;
       majflt = 0;
-      fd = nullptr;
-      cmdLine = _cmdLine;
    }
 
    ~Process()
    {
-      delete fd;
-      MemFree(cmdLine);
+      MemFree(user.load());
+      delete fd.load();
+      MemFree(cmdLine.load());
    }
 };
 
@@ -137,29 +139,123 @@ static ObjectArray<FileDescriptor> *ReadProcessHandles(const char *path)
 }
 
 /**
- * Read process information from /proc system
- * Parameters:
- *    plist    - array to fill, can be NULL
- *    procNameFilter - If not NULL, only processes with matched name will
- *               be counted and read. If cmdLineFilter is NULL, then exact
- *               match required to pass filter; otherwise procNameFilter can
- *               be a regular expression.
- *    cmdLineFilter - If not NULL, only processes with command line matched to
- *              regular expression will be counted and read.
- *    procUser - If not NULL, only processes run by this user will be counted.
- * Return value: number of matched processes or -1 in case of error.
+ * Read name of process owner from /proc/<pid>/status
+ */
+static void ReadProcessUser(uint32_t pid, char *userName)
+{
+   char fileName[64];
+   snprintf(fileName, 64, "/proc/%u/status", pid);
+   int hFile = _open(fileName, O_RDONLY);
+   if (hFile == -1)
+      return;
+
+   char statusBuffer[8192];
+   ssize_t bytes = _read(hFile, statusBuffer, sizeof(statusBuffer) - 1);
+   if (bytes > 0)
+   {
+      statusBuffer[bytes] = 0;
+      char *puid = strstr(statusBuffer, "Uid:");
+      if (puid != nullptr)
+      {
+         puid += 4;
+         while((*puid == '\t') || (*puid == ' '))
+            puid++;
+         uint32_t uid = strtoul(puid, nullptr, 10);
+
+         passwd pbuffer, *userInfo;
+         char pwbuffer[512];
+         getpwuid_r(uid, &pbuffer, pwbuffer, sizeof(pwbuffer), &userInfo);
+         if (userInfo != nullptr)
+            strlcpy(userName, userInfo->pw_name, MAX_USER_NAME_LEN);
+      }
+   }
+   _close(hFile);
+}
+
+/**
+ * Read process command line from /proc/<pid>/cmdline
  */
-static int ProcRead(ObjectArray<Process> *plist, const char *procNameFilter, const char *cmdLineFilter, const char *procUserFilter, bool readHandles, bool readCmdLine)
+static char *ReadProcessCommandLine(uint32_t pid)
 {
-   nxlog_debug_tag(DEBUG_TAG, 6, _T("ProcRead(%p, \"%hs\",\"%hs\",\"%hs\")"), plist, CHECK_NULL_A(procNameFilter), CHECK_NULL_A(cmdLineFilter), CHECK_NULL_A(procUserFilter));
+   char fileName[64];
+   snprintf(fileName, 64, "/proc/%u/cmdline", pid);
+   int hFile = _open(fileName, O_RDONLY);
+   if (hFile == -1)
+      return nullptr;
+
+   size_t len = 0, pos = 0;
+   char *processCmdLine = MemAllocStringA(4096);
+   while (true)
+   {
+      ssize_t bytes = _read(hFile, &processCmdLine[pos], 4096);
+      if (bytes < 0)
+         bytes = 0;
+      len += bytes;
+      if (bytes < 4096)
+      {
+         processCmdLine[len] = 0;
+         break;
+      }
+      pos += bytes;
+      processCmdLine = MemRealloc(processCmdLine, pos + 4096);
+   }
+   _close(hFile);
+   if (len > 0)
+   {
+      // got a valid record in format: argv[0]\x00argv[1]\x00...
+      // Note: to behave identicaly on different platforms,
+      // full command line including argv[0] should be matched
+      // replace 0x00 with spaces
+      for (size_t j = 0; j < len - 1; j++)
+      {
+         if (processCmdLine[j] == 0)
+         {
+            processCmdLine[j] = ' ';
+         }
+      }
+   }
+   return processCmdLine;
+}
+
+/**
+ * Snapshot of running processes
+ */
+class ProcessSnapshot
+{
+private:
+   ObjectArray<Process> m_processes;
+   int64_t m_timestamp;
+
+public:
+   ProcessSnapshot() : m_processes(256, 256, Ownership::True)
+   {
+      m_timestamp = GetMonotonicClockTime();
+   }
+
+   bool read();
+
+   int size() const { return m_processes.size(); }
+   Process *get(int index) const { return m_processes.get(index); }
+   int64_t getTimestamp() const { return m_timestamp; }
+
+   const char *getUser(Process *p);
+   const char *getCommandLine(Process *p);
+   const ObjectArray<FileDescriptor> *getHandles(Process *p);
+
+   int select(ObjectArray<Process> *plist, const char *procNameFilter, const char *cmdLineFilter, const char *procUserFilter);
+};
 
+/**
+ * Read list of processes from /proc file system. Only /proc/<pid>/stat is read for each process.
+ */
+bool ProcessSnapshot::read()
+{
    DIR *dir = opendir("/proc");
    if (dir == nullptr)
-      return -1;
+      return false;
 
    char fileName[MAX_PATH] = "/proc/";
 
-   int count = 0;
    struct dirent *d;
    while ((d = readdir(dir)) != nullptr)
    {
@@ -172,190 +268,229 @@ static int ProcRead(ObjectArray<Process> *plist, const char *procNameFilter, con
          continue;
 
       strcpy(&fileName[6], d->d_name);
-      strcat(fileName, "/");
-      size_t fileNamePos = strlen(fileName);
+      strcat(fileName, "/stat");
 
-      // Read stat file
-      char szProcStat[1024], *pProcStat = nullptr, *pProcName = nullptr;
-      bool procNameMatch = false;
-      strcpy(&fileName[fileNamePos], "stat");
       int hFile = _open(fileName, O_RDONLY);
-      if (hFile != -1)
-      {
-         ssize_t bytes = _read(hFile, szProcStat, sizeof(szProcStat) - 1);
-         if (bytes > 0)
-         {
-            szProcStat[bytes] = 0;
-            uint32_t tmp;
-            if (sscanf(szProcStat, "%u ", &tmp) == 1) // Skip PID
-            {
-               char *procNamePos = strchr(szProcStat, '(');
-               if (procNamePos != nullptr)
-               {
-                  pProcStat = strrchr(procNamePos, ')');
-                  if (pProcStat != nullptr)
-                  {
-                     pProcName = procNamePos + 1;
-                     *pProcStat = 0;
-                     pProcStat++;
-                  }
-                  if (pProcName != nullptr)
-                  {
-                     if ((procNameFilter != nullptr) && (*procNameFilter != 0))
-                     {
-                        if (cmdLineFilter == nullptr) // use old style compare
-                           procNameMatch = (strcmp(pProcName, procNameFilter) == 0);
-                        else
-                           procNameMatch = RegexpMatchA(pProcName, procNameFilter, false);
-                     }
-                     else
-                     {
-                        procNameMatch = true;
-                     }
-                  }
-               }
-            }
-         }
-         _close(hFile);
-      }
+      if (hFile == -1)
+         continue;
 
-      if (!procNameMatch)
+      char szProcStat[1024];
+      ssize_t bytes = _read(hFile, szProcStat, sizeof(szProcStat) - 1);
+      _close(hFile);
+      if (bytes <= 0)
          continue;
 
-      // Read status file
-      passwd pbuffer, *userInfo;
-      char pwbuffer[512];
-      char *userName = nullptr;
-      strcpy(&fileName[fileNamePos], "status");
-      hFile = _open(fileName, O_RDONLY);
-      if (hFile != -1)
-      {
-         char statusBuffer[8192];
-         ssize_t bytes = _read(hFile, statusBuffer, sizeof(statusBuffer) - 1);
-         if (bytes > 0)
-         {
-            statusBuffer[bytes] = 0;
-            char *puid = strstr(statusBuffer, "Uid:");
-            if (puid != nullptr)
-            {
-               puid += 4;
-               while((*puid == '\t') || (*puid == ' '))
-                  puid++;
-               uint32_t uid = strtoul(puid, &eptr, 10);
-
-               getpwuid_r(uid, &pbuffer, pwbuffer, sizeof(pwbuffer), &userInfo);
-               if (userInfo != nullptr)
-               {
-                  userName = userInfo->pw_name;
-               }
-            }
-         }
-         _close(hFile);
-      }
+      szProcStat[bytes] = 0;
+      uint32_t tmp;
+      if (sscanf(szProcStat, "%u ", &tmp) != 1) // Skip PID
+         continue;
 
-      // Check if user name matches pattern
-      if ((procUserFilter != nullptr) && (*procUserFilter != 0)  && !RegexpMatchA(CHECK_NULL_EX_A(userName), procUserFilter, true))
+      char *pProcName = strchr(szProcStat, '(');
+      if (pProcName == nullptr)
          continue;
+      pProcName++;
 
-      char *processCmdLine = nullptr;
-      if (readCmdLine || ((cmdLineFilter != nullptr) && (*cmdLineFilter != 0)))
+      char *pProcStat = strrchr(pProcName, ')');
+      if (pProcStat != nullptr)
       {
-         strcpy(&fileName[fileNamePos], "cmdline");
-         hFile = _open(fileName, O_RDONLY);
-         if (hFile != -1)
-         {
-            size_t len = 0, pos = 0;
-            processCmdLine = MemAllocStringA(4096);
-            while (true)
-            {
-               ssize_t bytes = _read(hFile, &processCmdLine[pos], 4096);
-               if (bytes < 0)
-                  bytes = 0;
-               len += bytes;
-               if (bytes < 4096)
-               {
-                  processCmdLine[len] = 0;
-                  break;
-               }
-               pos += bytes;
-               processCmdLine = MemRealloc(processCmdLine, pos + 4096);
-            }
-            _close(hFile);
-            if (len > 0)
-            {
-               // got a valid record in format: argv[0]\x00argv[1]\x00...
-               // Note: to behave identicaly on different platforms,
-               // full command line including argv[0] should be matched
-               // replace 0x00 with spaces
-               for (size_t j = 0; j < len - 1; j++)
-               {
-                  if (processCmdLine[j] == 0)
-                  {
-                     processCmdLine[j] = ' ';
-                  }
-               }
-            }
-         }
+         *pProcStat = 0;
+         pProcStat++;
+      }
 
-         if ((cmdLineFilter != nullptr) && (*cmdLineFilter != 0))
+      auto p = new Process(pid, pProcName);
+      // Parse rest of /proc/pid/stat file
+      if (pProcStat != nullptr)
+      {
+         if (sscanf(pProcStat, " %c %d %d %*d %*d %*d %*u %lu %*u %lu %*u %lu %lu %*u %*u %*d %*d %ld %*d %*u %lu %ld ",
+                    &p->state, &p->parent, &p->group, &p->minflt, &p->majflt,
+                    &p->utime, &p->ktime, &p->threads, &p->vmsize, &p->rss) != 10)
          {
-            if (!RegexpMatchA(CHECK_NULL_EX_A(processCmdLine), cmdLineFilter, true))
-            {
-               MemFree(processCmdLine);
-               continue;
-            }
-            if (!readCmdLine)
-               MemFreeAndNull(processCmdLine);
+            nxlog_debug_tag(DEBUG_TAG, 5, _T("Error parsing /proc/%u/stat"), pid);
          }
       }
+      m_processes.add(p);
+   }
+   closedir(dir);
+
+   nxlog_debug_tag(DEBUG_TAG, 6, _T("ProcessSnapshot::read(): %d processes read"), m_processes.size());
+   return true;
+}
 
-      if ((plist != nullptr) && (pProcName != nullptr))
+/**
+ * Get process owner user name (will read it from /proc/<pid>/status on first access)
+ */
+const char *ProcessSnapshot::getUser(Process *p)
+{
+   char *user = p->user.load(std::memory_order_acquire);
+   if (user == nullptr)
+   {
+      char buffer[MAX_USER_NAME_LEN] = "";
+      ReadProcessUser(p->pid, buffer);
+      char *loadedUser = MemCopyStringA(buffer);
+      if (p->user.compare_exchange_strong(user, loadedUser, std::memory_order_acq_rel, std::memory_order_acquire))
+         user = loadedUser;
+      else
+         MemFree(loadedUser);   // Already loaded by another thread
+   }
+   return user;
+}
+
+/**
+ * Get process command line (will read it from /proc/<pid>/cmdline on first access)
+ */
+const char *ProcessSnapshot::getCommandLine(Process *p)
+{
+   if (!p->cmdLineLoaded.load(std::memory_order_acquire))
+   {
+      char *cmdLine = ReadProcessCommandLine(p->pid);
+      char *expected = nullptr;
+      if (!p->cmdLine.compare_exchange_strong(expected, cmdLine, std::memory_order_acq_rel))
+         MemFree(cmdLine);   // Already loaded by another thread
+      p->cmdLineLoaded.store(true, std::memory_order_release);
+   }
+   return p->cmdLine.load(std::memory_order_acquire);
+}
+
+/**
+ * Get open handles for process (will read them from /proc/<pid>/fd on first access)
+ */
+const ObjectArray<FileDescriptor> *ProcessSnapshot::getHandles(Process *p)
+{
+   if (!p->handlesLoaded.load(std::memory_order_acquire))
+   {
+      char path[64];
+      snprintf(path, 64, "/proc/%u/fd", p->pid);
+      ObjectArray<FileDescriptor> *fd = ReadProcessHandles(path);
+      ObjectArray<FileDescriptor> *expected = nullptr;
+      if (!p->fd.compare_exchange_strong(expected, fd, std::memory_order_acq_rel))
+         delete fd;   // Already loaded by another thread
+      p->handlesLoaded.store(true, std::memory_order_release);
+   }
+   return p->fd.load(std::memory_order_acquire);
+}
+
+/**
+ * Select processes matching given filters
+ * Parameters:
+ *    plist    - array to fill (should not own objects), can be NULL
+ *    procNameFilter - If not NULL, only processes with matched name will
+ *               be counted and read. If cmdLineFilter is NULL, then exact
+ *               match required to pass filter; otherwise procNameFilter can
+ *               be a regular expression.
+ *    cmdLineFilter - If not NULL, only processes with command line matched to
+ *              regular expression will be counted and read.
+ *    procUser - If not NULL, only processes run by this user will be counted.
+ * Return value: number of matched processes.
+ */
+int ProcessSnapshot::select(ObjectArray<Process> *plist, const char *procNameFilter, const char *cmdLineFilter, const char *procUserFilter)
+{
+   int count = 0;
+   for(int i = 0; i < m_processes.size(); i++)
+   {
+      Process *p = m_processes.get(i);
+
+      if ((procNameFilter != nullptr) && (*procNameFilter != 0))
       {
-         auto p = new Process(pid, pProcName, userName, processCmdLine);
-         // Parse rest of /proc/pid/stat file
-         if (pProcStat != nullptr)
+         if (cmdLineFilter == nullptr) // use old style compare
          {
-            if (sscanf(pProcStat, " %c %d %d %*d %*d %*d %*u %lu %*u %lu %*u %lu %lu %*u %*u %*d %*d %ld %*d %*u %lu %ld ",
-                       &p->state, &p->parent, &p->group, &p->minflt, &p->majflt,
-                       &p->utime, &p->ktime, &p->threads, &p->vmsize, &p->rss) != 10)
-            {
-               nxlog_debug_tag(DEBUG_TAG, 5, _T("Error parsing /proc/%u/stat"), pid);
-            }
+            if (strcmp(p->name, procNameFilter))
+               continue;
          }
-         if (readHandles)
+         else if (!RegexpMatchA(p->name, procNameFilter, false))
          {
-            strcpy(&fileName[fileNamePos], "fd");
-            p->fd = ReadProcessHandles(fileName);
+            continue;
          }
-         plist->add(p);
       }
 
+      // Check if user name matches pattern
+      if ((procUserFilter != nullptr) && (*procUserFilter != 0) && !RegexpMatchA(getUser(p), procUserFilter, true))
+         continue;
+
+      if ((cmdLineFilter != nullptr) && (*cmdLineFilter != 0) && !RegexpMatchA(CHECK_NULL_EX_A(getCommandLine(p)), cmdLineFilter, true))
+         continue;
+
+      if (plist != nullptr)
+         plist->add(p);
       count++;
    }
-   closedir(dir);
    return count;
 }
 
 /**
- * Handler for System.ProcessCount
+ * Current process snapshot
  */
-LONG H_SystemProcessCount(const TCHAR *param, const TCHAR *arg, TCHAR *value, AbstractCommSession *session)
+static shared_ptr<ProcessSnapshot> s_snapshot;
+static RWLock s_snapshotLock;
+static Mutex s_snapshotUpdateLock(MutexType::FAST);
+
+/**
+ * Process snapshot freshness interval in milliseconds (0 to read new snapshot on each request)
+ */
+static uint32_t s_snapshotInterval = 1000;
+
+/**
+ * Initialize process snapshot settings
+ */
+void InitProcessSnapshot(Config *config)
+{
+   s_snapshotInterval = config->getValueAsUInt(_T("/Linux/ProcessSnapshotInterval"), s_snapshotInterval);
+   nxlog_debug_tag(DEBUG_TAG, 3, _T("Process snapshot freshness interval set to %u milliseconds"), s_snapshotInterval);
+}
+
+/**
+ * Get current process snapshot (will take new snapshot if current one is older than freshness interval).
+ * Returns nullptr if /proc cannot be read.
+ */
+static shared_ptr<ProcessSnapshot> GetProcessSnapshot()
 {
-   int count = CountFilesInDirectoryA("/proc", [](const dirent *d) {
-      const char *p = d->d_name;
-      while(*p != 0)
+   if (s_snapshotInterval == 0)
+   {
+      auto snapshot = make_shared<ProcessSnapshot>();
+      return snapshot->read() ? snapshot : shared_ptr<ProcessSnapshot>();
+   }
+
+   s_snapshotLock.readLock();
+   shared_ptr<ProcessSnapshot> snapshot = s_snapshot;
+   s_snapshotLock.unlock();
+   if ((snapshot != nullptr) && (GetMonotonicClockTime() - snapshot->getTimestamp() < s_snapshotInterval))
+      return snapshot;
+
+   s_snapshotUpdateLock.lock();
+
+   // Snapshot could be updated by another thread while this one was waiting for update lock
+   s_snapshotLock.readLock();
+   snapshot = s_snapshot;
+   s_snapshotLock.unlock();
+
+   if ((snapshot == nullptr) || (GetMonotonicClockTime() - snapshot->getTimestamp() >= s_snapshotInterval))
+   {
+      snapshot = make_shared<ProcessSnapshot>();
+      if (snapshot->read())
       {
-         if ((*p < '0') || (*p > '9'))
-            return false;
-         p++;
+         s_snapshotLock.writeLock();
+         s_snapshot = snapshot;
+         s_snapshotLock.unlock();
       }
-      return true;
-   });
+      else
+      {
+         snapshot.reset();
+      }
+   }
+
+   s_snapshotUpdateLock.unlock();
+   return snapshot;
+}
 
-   if (count < 0)
+/**
+ * Handler for System.ProcessCount
+ */
+LONG H_SystemProcessCount(const TCHAR *param, const TCHAR *arg, TCHAR *value, AbstractCommSession *session)
+{
+   shared_ptr<ProcessSnapshot> snapshot = GetProcessSnapshot();
+   if (snapshot == nullptr)
       return SYSINFO_RC_ERROR;
 
-   ret_int(value, count);
+   ret_int(value, snapshot->size());
    return SYSINFO_RC_SUCCESS;
 }
 
@@ -372,11 +507,11 @@ LONG H_ProcessCount(const TCHAR *pszParam, const TCHAR *pArg, TCHAR *pValue, Abs
       AgentGetParameterArgA(pszParam, 3, userFilter, sizeof(userFilter));
    }
 
-   int count = ProcRead(nullptr, procNameFilter, (*pArg == _T('E')) ? cmdLineFilter : nullptr, (*pArg == _T('E')) ? userFilter : nullptr, false, false);
-   if (count == -1)
+   shared_ptr<ProcessSnapshot> snapshot = GetProcessSnapshot();
+   if (snapshot == nullptr)
       return SYSINFO_RC_ERROR;
 
-   ret_int(pValue, count);
+   ret_int(pValue, snapshot->select(nullptr, procNameFilter, (*pArg == _T('E')) ? cmdLineFilter : nullptr, (*pArg == _T('E')) ? userFilter : nullptr));
    return SYSINFO_RC_SUCCESS;
 }
 
@@ -385,19 +520,15 @@ LONG H_ProcessCount(const TCHAR *pszParam, const TCHAR *pArg, TCHAR *pValue, Abs
  */
 LONG H_ThreadCount(const TCHAR *param, const TCHAR *arg, TCHAR *value, AbstractCommSession *session)
 {
-   int i, sum, count, ret = SYSINFO_RC_ERROR;
-   ObjectArray<Process> procList(128, 128, Ownership::True);
-
-   count = ProcRead(&procList, nullptr, nullptr, nullptr, false, false);
-   if (count >= 0)
-   {
-      for (i = 0, sum = 0; i < procList.size(); i++)
-         sum += procList.get(i)->threads;
-      ret_int(value, sum);
-      ret = SYSINFO_RC_SUCCESS;
-   }
+   shared_ptr<ProcessSnapshot> snapshot = GetProcessSnapshot();
+   if (snapshot == nullptr)
+      return SYSINFO_RC_ERROR;
 
-   return ret;
+   int sum = 0;
+   for (int i = 0; i < snapshot->size(); i++)
+      sum += snapshot->get(i)->threads;
+   ret_int(value, sum);
+   return SYSINFO_RC_SUCCESS;
 }
 
 /**
@@ -405,22 +536,19 @@ LONG H_ThreadCount(const TCHAR *param, const TCHAR *arg, TCHAR *value, AbstractC
  */
 LONG H_HandleCount(const TCHAR *param, const TCHAR *arg, TCHAR *value, AbstractCommSession *session)
 {
-   int i, sum, count, ret = SYSINFO_RC_ERROR;
-   ObjectArray<Process> procList(128, 128, Ownership::True);
+   shared_ptr<ProcessSnapshot> snapshot = GetProcessSnapshot();
+   if (snapshot == nullptr)
+      return SYSINFO_RC_ERROR;
 
-   count = ProcRead(&procList, nullptr, nullptr, nullptr, true, false);
-   if (count >= 0)
+   int sum = 0;
+   for (int i = 0; i < snapshot->size(); i++)
    {
-      for (i = 0, sum = 0; i < procList.size(); i++)
-      {
-         if (procList.get(i)->fd != NULL)
-            sum += procList.get(i)->fd->size();
-      }
-      ret_int(value, sum);
-      ret = SYSINFO_RC_SUCCESS;
+      const ObjectArray<FileDescriptor> *fd = snapshot->getHandles(snapshot->get(i));
+      if (fd != nullptr)
+         sum += fd->size();
    }
-
-   return ret;
+   ret_int(value, sum);
+   return SYSINFO_RC_SUCCESS;
 }
 
 /**
@@ -495,14 +623,13 @@ LONG H_ProcessDetails(const TCHAR *param, const TCHAR *arg, TCHAR *value, Abstra
    AgentGetParameterArgA(param, 4, userFilter, sizeof(userFilter));
    TrimA(cmdLineFilter);
 
-   ObjectArray<Process> procList(128, 128, Ownership::True);
-   count = ProcRead(&procList, procNameFilter, (cmdLineFilter[0] != 0) ? cmdLineFilter : nullptr,
-                    (userFilter[0] != 0) ? userFilter : nullptr, CAST_FROM_POINTER(arg, int) == PROCINFO_HANDLES, false);
-   nxlog_debug_tag(DEBUG_TAG, 5, _T("H_ProcessDetails(\"%hs\"): ProcRead() returns %d"), param, count);
-   if (count == -1)
+   shared_ptr<ProcessSnapshot> snapshot = GetProcessSnapshot();
+   if (snapshot == nullptr)
       return SYSINFO_RC_ERROR;
-   if (count == -2)
-      return SYSINFO_RC_UNSUPPORTED;
+
+   ObjectArray<Process> procList(128, 128, Ownership::False);
+   count = snapshot->select(&procList, procNameFilter, (cmdLineFilter[0] != 0) ? cmdLineFilter : nullptr, (userFilter[0] != 0) ? userFilter : nullptr);
+   nxlog_debug_tag(DEBUG_TAG, 5, _T("H_ProcessDetails(\"%hs\"): %d matching processes"), param, count);
 
    long pageSize = getpagesize();
    long ticksPerSecond = sysconf(_SC_CLK_TCK);
@@ -515,8 +642,11 @@ LONG H_ProcessDetails(const TCHAR *param, const TCHAR *arg, TCHAR *value, Abstra
             currVal = (p->ktime + p->utime) * 1000 / ticksPerSecond;
             break;
          case PROCINFO_HANDLES:
-            currVal = (p->fd != NULL) ? p->fd->size() : 0;
+         {
+            const ObjectArray<FileDescriptor> *fd = snapshot->getHandles(p);
+            currVal = (fd != nullptr) ? fd->size() : 0;
             break;
+         }
          case PROCINFO_KTIME:
             currVal = p->ktime * 1000 / ticksPerSecond;
             break;
@@ -580,23 +710,18 @@ LONG H_ProcessDetails(const TCHAR *param, const TCHAR *arg, TCHAR *value, Abstra
  */
 LONG H_ProcessList(const TCHAR *pszParam, const TCHAR *pArg, StringList *value, AbstractCommSession *session)
 {
-   int nRet = SYSINFO_RC_ERROR;
+   shared_ptr<ProcessSnapshot> snapshot = GetProcessSnapshot();
+   if (snapshot == nullptr)
+      return SYSINFO_RC_ERROR;
 
-   ObjectArray<Process> procList(128, 128, Ownership::True);
-   int nCount = ProcRead(&procList, nullptr, nullptr, nullptr, false, false);
-   if (nCount >= 0)
+   for (int i = 0; i < snapshot->size(); i++)
    {
-      nRet = SYSINFO_RC_SUCCESS;
-
-      for (int i = 0; i < procList.size(); i++)
-      {
-         Process *p = procList.get(i);
-         TCHAR szBuff[128];
-         _sntprintf(szBuff, sizeof(szBuff), _T("%d %hs"), p->pid, p->name);
-         value->add(szBuff);
-      }
+      Process *p = snapshot->get(i);
+      TCHAR szBuff[128];
+      _sntprintf(szBuff, sizeof(szBuff), _T("%d %hs"), p->pid, p->name);
+      value->add(szBuff);
    }
-   return nRet;
+   return SYSINFO_RC_SUCCESS;
 }
 
 /**
@@ -617,41 +742,37 @@ LONG H_ProcessTable(const TCHAR *cmd, const TCHAR *arg, Table *value, AbstractCo
    value->addColumn(_T("PAGE_FAULTS"), DCI_DT_UINT64, _T("Page Faults"));
    value->addColumn(_T("CMDLINE"), DCI_DT_STRING, _T("Command Line"));
 
-   int rc = SYSINFO_RC_ERROR;
+   shared_ptr<ProcessSnapshot> snapshot = GetProcessSnapshot();
+   if (snapshot == nullptr)
+      return SYSINFO_RC_ERROR;
 
-   ObjectArray<Process> procList(128, 128, Ownership::True);
-   int nCount = ProcRead(&procList, nullptr, nullptr, nullptr, true, true);
-   if (nCount >= 0)
+   uint64_t pageSize = getpagesize();
+   uint64_t totalMemory = GetTotalMemorySize();
+   uint64_t ticksPerSecond = sysconf(_SC_CLK_TCK);
+   for (int i = 0; i < snapshot->size(); i++)
    {
-      rc = SYSINFO_RC_SUCCESS;
-
-      uint64_t pageSize = getpagesize();
-      uint64_t totalMemory = GetTotalMemorySize();
-      uint64_t ticksPerSecond = sysconf(_SC_CLK_TCK);
-      for (int i = 0; i < procList.size(); i++)
-      {
-         Process *p = procList.get(i);
-         value->addRow();
-         value->set(0, p->pid);
+      Process *p = snapshot->get(i);
+      const ObjectArray<FileDescriptor> *fd = snapshot->getHandles(p);
+      value->addRow();
+      value->set(0, p->pid);
 #ifdef UNICODE
-         value->setPreallocated(1, WideStringFromMBString(p->name));
-         value->setPreallocated(2, WideStringFromMBString(p->user));
+      value->setPreallocated(1, WideStringFromMBString(p->name));
+      value->setPreallocated(2, WideStringFromMBString(snapshot->getUser(p)));
 #else
-         value->set(1, p->name);
-         value->set(2, p->user);
+      value->set(1, p->name);
+      value->set(2, snapshot->getUser(p));
 #endif
-         value->set(3, static_cast<uint32_t>(p->threads));
-         value->set(4, static_cast<uint32_t>((p->fd != nullptr) ? p->fd->size() : 0));
-         value->set(5, static_cast<uint64_t>(p->ktime) * 1000 / ticksPerSecond);
-         value->set(6, static_cast<uint64_t>(p->utime) * 1000 / ticksPerSecond);
-         value->set(7, static_cast<uint64_t>(p->vmsize));
-         value->set(8, static_cast<uint64_t>(p->rss) * pageSize);
-         value->set(9, static_cast<double>(static_cast<uint64_t>(p->rss) * (pageSize / 1024) * 10000 / totalMemory) / 100, 2);
-         value->set(10, static_cast<uint64_t>(p->minflt) + static_cast<uint64_t>(p->majflt));
-         value->set(11, p->cmdLine);
-      }
+      value->set(3, static_cast<uint32_t>(p->threads));
+      value->set(4, static_cast<uint32_t>((fd != nullptr) ? fd->size() : 0));
+      value->set(5, static_cast<uint64_t>(p->ktime) * 1000 / ticksPerSecond);
+      value->set(6, static_cast<uint64_t>(p->utime) * 1000 / ticksPerSecond);
+      value->set(7, static_cast<uint64_t>(p->vmsize));
+      value->set(8, static_cast<uint64_t>(p->rss) * pageSize);
+      value->set(9, static_cast<double>(static_cast<uint64_t>(p->rss) * (pageSize / 1024) * 10000 / totalMemory) / 100, 2);
+      value->set(10, static_cast<uint64_t>(p->minflt) + static_cast<uint64_t>(p->majflt));
+      value->set(11, snapshot->getCommandLine(p));
    }
-   return rc;
+   return SYSINFO_RC_SUCCESS;
 }
 
 /**
@@ -664,35 +785,31 @@ LONG H_OpenFilesTable(const TCHAR *cmd, const TCHAR *arg, Table *value, Abstract
    value->addColumn(_T("HANDLE"), DCI_DT_UINT, _T("Handle"), true);
    value->addColumn(_T("NAME"), DCI_DT_STRING, _T("Name"));
 
-   int rc = SYSINFO_RC_ERROR;
+   shared_ptr<ProcessSnapshot> snapshot = GetProcessSnapshot();
+   if (snapshot == nullptr)
+      return SYSINFO_RC_ERROR;
 
-   ObjectArray<Process> procList(128, 128, Ownership::True);
-   int nCount = ProcRead(&procList, nullptr, nullptr, nullptr, true, false);
-   if (nCount >= 0)
+   for (int i = 0; i < snapshot->size(); i++)
    {
-      rc = SYSINFO_RC_SUCCESS;
-
-      for (int i = 0; i < procList.size(); i++)
+      Process *p = snapshot->get(i);
+      const ObjectArray<FileDescriptor> *fd = snapshot->getHandles(p);
+      if (fd != nullptr)
       {
-         Process *p = procList.get(i);
-         if (p->fd != nullptr)
+         for (int j = 0; j < fd->size(); j++)
          {
-            for (int j = 0; j < p->fd->size(); j++)
-            {
-               FileDescriptor *f = p->fd->get(j);
-               value->addRow();
-               value->set(0, p->pid);
-               value->set(2, f->handle);
+            FileDescriptor *f = fd->get(j);
+            value->addRow();
+            value->set(0, p->pid);
+            value->set(2, f->handle);
 #ifdef UNICODE
-               value->setPreallocated(1, WideStringFromMBString(p->name));
-               value->setPreallocated(3, WideStringFromMBString(f->name));
+            value->setPreallocated(1, WideStringFromMBString(p->name));
+            value->setPreallocated(3, WideStringFromMBString(f->name));
 #else
-               value->set(1, p->name);
-               value->set(3, f->name);
+            value->set(1, p->name);
+            value->set(3, f->name);
 #endif
-            }
          }
       }
    }
-   return rc;
+   return SYSINFO_RC_SUCCESS;
 }
@@ -176,6 +176,11 @@ private void fillMetricList()
          list.add(new AgentParameter("Server.DBWriter.Requests.IData", "DB writer requests (DCI data)", DataType.COUNTER64));
          list.add(new AgentParameter("Server.DBWriter.Requests.Other", "DB writer requests (other queries)", DataType.COUNTER64));
          list.add(new AgentParameter("Server.DBWriter.Requests.RawData", "DB writer requests (raw DCI data)", DataType.COUNTER64));
+         list.add(new AgentParameter("Server.EventLogWriter.AverageWaitTime", "Event log writer: average event wait time", DataType.UINT32));
+         list.add(new AgentParameter("Server.EventLogWriter.FailedEvents", "Event log writer: total number of events that could not be written", DataType.COUNTER64));
+         list.add(new AgentParameter("Server.EventLogWriter.LoggedEvents", "Event log writer: total number of written events", DataType.COUNTER64));
+         list.add(new AgentParameter("Server.EventLogWriter.MaxWaitTime", "Event log writer: maximum event wait time", DataType.UINT32));
+         list.add(new AgentParameter("Server.EventLogWriter.Transactions", "Event log writer: total number of transactions", DataType.COUNTER64));
          list.add(new AgentParameter("Server.EventProcessor.AverageWaitTime(*)", "Event processor {instance}: average event wait time", DataType.UINT32));
          list.add(new AgentParameter("Server.EventProcessor.Bindings(*)", "Event processor {instance}: active bindings", DataType.UINT32));
          list.add(new AgentParameter("Server.EventProcessor.ProcessedEvents(*)", "Event processor {instance}: total number of processed events", DataType.COUNTER64));
@@ -203,6 +208,11 @@ private void fillMetricList()
          list.add(new AgentParameter("Server.ReceivedSNMPTraps", "SNMP traps received since server start", DataType.COUNTER64));
          list.add(new AgentParameter("Server.ReceivedSyslogMessages", "Syslog messages received since server start", DataType.COUNTER64));
          list.add(new AgentParameter("Server.ReceivedWindowsEvents", "Windows events received since server start", DataType.COUNTER64));
+         list.add(new AgentParameter("Server.SNMPTrapProcessor.AverageProcessingTime", "SNMP trap processor: average trap processing time (milliseconds)", DataType.FLOAT));
+         list.add(new AgentParameter("Server.SNMPTrapProcessor.AverageWaitTime", "SNMP trap processor: average trap wait time (milliseconds)", DataType.FLOAT));
+         list.add(new AgentParameter("Server.SNMPTrapProcessor.MaxProcessingTime", "SNMP trap processor: maximum trap processing time (milliseconds)", DataType.UINT32));
+         list.add(new AgentParameter("Server.SNMPTrapProcessor.MaxWaitTime", "SNMP trap processor: maximum trap wait time (milliseconds)", DataType.UINT32));
+         list.add(new AgentParameter("Server.SNMPTrapProcessor.ProcessedTraps", "SNMP trap processor: total number of processed traps", DataType.COUNTER64));
          list.add(new AgentParameter("Server.SyncerRunTime.Average", "Syncer run time: average", DataType.UINT32));
          list.add(new AgentParameter("Server.SyncerRunTime.Last", "Syncer run time: last", DataType.UINT32));
          list.add(new AgentParameter("Server.SyncerRunTime.Max", "Syncer run time: max", DataType.UINT32));
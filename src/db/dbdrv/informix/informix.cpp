@@ -970,7 +970,8 @@ static DBDriverCallTable s_callTable =
    GetColumnCountUnbuffered,
    GetColumnNameUnbuffered,
    PrepareString,
-   IsTableExist
+   IsTableExist,
+   nullptr  // BulkLoad
 };
 
 DB_DRIVER_ENTRY_POINT("INFORMIX", s_callTable)
@@ -1256,7 +1256,8 @@ static DBDriverCallTable s_callTable =
    GetColumnCountUnbuffered,
    GetColumnNameUnbuffered,
    PrepareString,
-   IsTableExist
+   IsTableExist,
+   nullptr  // BulkLoad
 };
 
 DB_DRIVER_ENTRY_POINT("MARIADB", s_callTable)
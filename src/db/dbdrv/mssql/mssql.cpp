@@ -981,7 +981,8 @@ static DBDriverCallTable s_callTable =
    GetColumnCountUnbuffered,
    GetColumnNameUnbuffered,
    PrepareString,
-   IsTableExist
+   IsTableExist,
+   nullptr  // BulkLoad
 };
 
 DB_DRIVER_ENTRY_POINT("MSSQL", s_callTable)
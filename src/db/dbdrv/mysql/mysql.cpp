@@ -1175,7 +1175,8 @@ static DBDriverCallTable s_callTable =
    GetColumnCountUnbuffered,
    GetColumnNameUnbuffered,
    PrepareString,
-   IsTableExist
+   IsTableExist,
+   nullptr  // BulkLoad
 };
 
 DB_DRIVER_ENTRY_POINT("MYSQL", s_callTable)
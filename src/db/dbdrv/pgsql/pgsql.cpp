@@ -1143,6 +1143,170 @@ static uint32_t Rollback(DBDRV_CONNECTION connection)
    return bRet ? DBERR_SUCCESS : DBERR_OTHER_ERROR;
 }
 
+/**
+ * Size of data block sent to server by single PQputCopyData call
+ */
+#define COPY_BLOCK_SIZE    65536
+
+/**
+ * Writer for COPY data stream in text format
+ */
+class CopyDataWriter
+{
+private:
+   PGconn *m_handle;
+   size_t m_size;
+   bool m_success;
+   char m_block[COPY_BLOCK_SIZE];
+
+public:
+   CopyDataWriter(PGconn *handle)
+   {
+      m_handle = handle;
+      m_size = 0;
+      m_success = true;
+   }
+
+   bool flush()
+   {
+      if (m_success && (m_size > 0))
+         m_success = (PQputCopyData(m_handle, m_block, static_cast<int>(m_size)) == 1);
+      m_size = 0;
+      return m_success;
+   }
+
+   void put(char ch)
+   {
+      if (m_size == COPY_BLOCK_SIZE)
+         flush();
+      m_block[m_size++] = ch;
+   }
+
+   void putValue(const WCHAR *value)
+   {
+      if (value == nullptr)
+      {
+         put('\\');
+         put('N');
+         return;
+      }
+
+      QueryString utf8 = QueryToUTF8(value);
+      for(const char *p = utf8; *p != 0; p++)
+      {
+         switch(*p)
+         {
+            case '\\':
+               put('\\');
+               put('\\');
+               break;
+            case '\t':
+               put('\\');
+               put('t');
+               break;
+            case '\n':
+               put('\\');
+               put('n');
+               break;
+            case '\r':
+               put('\\');
+               put('r');
+               break;
+            default:
+               put(*p);
+               break;
+         }
+      }
+   }
+
+   bool isSuccess() const
+   {
+      return m_success;
+   }
+};
+
+/**
+ * Set error text from connection error message
+ */
+static void SetErrorText(PGconn *handle, PGresult *result, WCHAR *errorText)
+{
+   if (errorText == nullptr)
+      return;
+
+   const char *sqlState = (result != nullptr) ? PQresultErrorField(result, PG_DIAG_SQLSTATE) : nullptr;
+   utf8_to_wchar(CHECK_NULL_EX_A(sqlState), -1, errorText, DBDRV_MAX_ERROR_TEXT);
+   int len = (int)wcslen(errorText);
+   if (len > 0)
+   {
+      errorText[len] = L' ';
+      len++;
+   }
+   utf8_to_wchar(PQerrorMessage(handle), -1, &errorText[len], DBDRV_MAX_ERROR_TEXT - len);
+   errorText[DBDRV_MAX_ERROR_TEXT - 1] = 0;
+   RemoveTrailingCRLFW(errorText);
+}
+
+/**
+ * Load multiple rows into given table using COPY protocol. Values are passed row by row
+ * (numRows * numColumns elements), null pointer is loaded as SQL NULL.
+ */
+static uint32_t BulkLoad(DBDRV_CONNECTION connection, const WCHAR *table, const WCHAR *columns, int numColumns, int numRows, const WCHAR **values, WCHAR *errorText)
+{
+   PG_CONN *conn = static_cast<PG_CONN*>(connection);
+
+   char query[1024];
+   snprintf(query, 1024, "COPY %ls (%ls) FROM STDIN", table, columns);
+
+   conn->mutexQueryLock.lock();
+
+   PGresult *result = PQexec(conn->handle, query);
+   if (PQresultStatus(result) != PGRES_COPY_IN)
+   {
+      SetErrorText(conn->handle, result, errorText);
+      PQclear(result);
+      uint32_t rc = (PQstatus(conn->handle) == CONNECTION_BAD) ? DBERR_CONNECTION_LOST : DBERR_OTHER_ERROR;
+      conn->mutexQueryLock.unlock();
+      return rc;
+   }
+   PQclear(result);
+
+   CopyDataWriter *writer = new CopyDataWriter(conn->handle);
+   const WCHAR **v = values;
+   for(int row = 0; (row < numRows) && writer->isSuccess(); row++)
+   {
+      for(int col = 0; col < numColumns; col++)
+      {
+         if (col > 0)
+            writer->put('\t');
+         writer->putValue(*v++);
+      }
+      writer->put('\n');
+   }
+   bool success = writer->flush();
+   delete writer;
+
+   uint32_t rc = DBERR_SUCCESS;
+   if (PQputCopyEnd(conn->handle, success ? nullptr : "client error") == -1)
+   {
+      SetErrorText(conn->handle, nullptr, errorText);
+      rc = (PQstatus(conn->handle) == CONNECTION_BAD) ? DBERR_CONNECTION_LOST : DBERR_OTHER_ERROR;
+   }
+   while((result = PQgetResult(conn->handle)) != nullptr)
+   {
+      if ((rc == DBERR_SUCCESS) && (PQresultStatus(result) != PGRES_COMMAND_OK))
+      {
+         SetErrorText(conn->handle, result, errorText);
+         rc = (PQstatus(conn->handle) == CONNECTION_BAD) ? DBERR_CONNECTION_LOST : DBERR_OTHER_ERROR;
+      }
+      PQclear(result);
+   }
+   if ((rc == DBERR_SUCCESS) && (errorText != nullptr))
+      *errorText = 0;
+
+   conn->mutexQueryLock.unlock();
+   return rc;
+}
+
 /**
  * Check if table exist
  */
@@ -1204,7 +1368,8 @@ static DBDriverCallTable s_callTable =
    GetColumnCountUnbuffered,
    GetColumnNameUnbuffered,
    PrepareString,
-   IsTableExist
+   IsTableExist,
+   BulkLoad
 };
 
 DB_DRIVER_ENTRY_POINT("PGSQL", s_callTable)
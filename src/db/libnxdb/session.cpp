@@ -1955,6 +1955,82 @@ int LIBNXDB_EXPORTABLE DBIsTableExist(DB_HANDLE conn, const TCHAR *table)
 #endif
 }
 
+/**
+ * Check if bulk load is supported by driver
+ */
+bool LIBNXDB_EXPORTABLE DBIsBulkLoadSupported(DB_DRIVER driver)
+{
+   return driver->m_callTable.BulkLoad != nullptr;
+}
+
+/**
+ * Load multiple rows into given table using driver's bulk load interface. Values array should contain
+ * numRows * numColumns elements ordered row by row; null pointer denotes SQL NULL.
+ */
+bool LIBNXDB_EXPORTABLE DBBulkLoad(DB_HANDLE hConn, const TCHAR *table, const TCHAR *columns, int numColumns, int numRows, const TCHAR **values)
+{
+   if (hConn->m_driver->m_callTable.BulkLoad == nullptr)
+      return false;
+
+   WCHAR wcErrorText[DBDRV_MAX_ERROR_TEXT] = L"";
+#ifdef UNICODE
+   const WCHAR *wcTable = table;
+   const WCHAR *wcColumns = columns;
+   const WCHAR **wcValues = values;
+#else
+   WCHAR *wcTable = WideStringFromMBString(table);
+   WCHAR *wcColumns = WideStringFromMBString(columns);
+   int numValues = numColumns * numRows;
+   WCHAR **wcValues = MemAllocArray<WCHAR*>(numValues);
+   for(int i = 0; i < numValues; i++)
+      wcValues[i] = (values[i] != nullptr) ? WideStringFromMBString(values[i]) : nullptr;
+#endif
+
+   hConn->m_mutexTransLock.lock();
+   int64_t ms = GetMonotonicClockTime();
+
+   uint32_t rc = hConn->m_driver->m_callTable.BulkLoad(hConn->m_connection, wcTable, wcColumns, numColumns, numRows, (const WCHAR**)wcValues, wcErrorText);
+   if ((rc == DBERR_CONNECTION_LOST) && hConn->m_reconnectEnabled)
+   {
+      DBReconnect(hConn);
+      rc = hConn->m_driver->m_callTable.BulkLoad(hConn->m_connection, wcTable, wcColumns, numColumns, numRows, (const WCHAR**)wcValues, wcErrorText);
+   }
+
+   s_perfNonSelectQueries++;
+   s_perfTotalQueries++;
+
+   ms = GetMonotonicClockTime() - ms;
+   if (s_queryTrace)
+   {
+      nxlog_debug_tag(DEBUG_TAG_QUERY, 9, _T("%s bulk load into %s: %d rows [%d ms]"), (rc == DBERR_SUCCESS) ? _T("Successful") : _T("Failed"), table, numRows, (int)ms);
+   }
+   if ((rc == DBERR_SUCCESS) && (static_cast<uint32_t>(ms) > hConn->getQueryExecTimeThreshold()))
+   {
+      nxlog_debug_tag(DEBUG_TAG_QUERY, 3, _T("Long running bulk load into %s: %d rows [%d ms]"), table, numRows, (int)ms);
+      s_perfLongRunningQueries++;
+   }
+
+   hConn->m_mutexTransLock.unlock();
+
+   if (rc != DBERR_SUCCESS)
+   {
+      s_perfFailedQueries++;
+      nxlog_write_tag(NXLOG_ERROR, DEBUG_TAG_DRIVER, _T("Bulk load into %s failed: %ls"), table, wcErrorText);
+      if (hConn->m_driver->m_fpEventHandler != nullptr)
+         hConn->m_driver->m_fpEventHandler(DBEVENT_QUERY_FAILED, wcTable, wcErrorText, rc == DBERR_CONNECTION_LOST, hConn->m_driver->m_context);
+   }
+
+#ifndef UNICODE
+   MemFree(wcTable);
+   MemFree(wcColumns);
+   for(int i = 0; i < numValues; i++)
+      MemFree(wcValues[i]);
+   MemFree(wcValues);
+#endif
+
+   return rc == DBERR_SUCCESS;
+}
+
 /**
  * Get performance counters
  */
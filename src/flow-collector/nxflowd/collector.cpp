@@ -16,7 +16,6 @@ static int s_numTcpSockets = 0;
 static SOCKET *s_tcpSockets = NULL;
 static int s_numUdpSockets = 0;
 static SOCKET *s_udpSockets = NULL;
-static INT64 s_flowId = 1;
 
 
 //
@@ -69,36 +68,137 @@ static INT64 Int64FromData(void *data, int len)
 }
 
 
-//
-// Handler for data record
-//
-
-static struct
+/**
+ * Get unsigned 64bit integer value from data field
+ */
+static uint64_t UInt64FromData(void *data, int len)
 {
-	int ipfixField;
-	const TCHAR *dbField;
-} s_fieldMapping[] =
+	switch(len)
+	{
+		case 1:
+			return *static_cast<uint8_t*>(data);
+		case 2:
+			return *static_cast<uint16_t*>(data);
+		case 4:
+			return *static_cast<uint32_t*>(data);
+		case 8:
+			return *static_cast<uint64_t*>(data);
+		default:
+			return 0;
+	}
+}
+
+/**
+ * Flow aggregation key (5-tuple, interfaces and MAC addresses plus exporter and aggregation interval).
+ * All fields stored in flow record are part of the key, so aggregation never merges distinct flows.
+ * Key is compared as raw memory, so it should be zeroed before use.
+ */
+struct FlowKey
 {
-	{ IPFIX_FT_EXPORTERIPV4ADDRESS, _T("exporter_ip_addr") },
-	{ IPFIX_FT_SOURCEMACADDRESS, _T("source_mac_addr") },
-	{ IPFIX_FT_DESTINATIONMACADDRESS, _T("dest_mac_addr") },
-	{ IPFIX_FT_SOURCEIPV4ADDRESS, _T("source_ip_addr") },
-	{ IPFIX_FT_DESTINATIONIPV4ADDRESS, _T("dest_ip_addr") },
-	{ IPFIX_FT_PROTOCOLIDENTIFIER, _T("ip_proto") },
-	{ IPFIX_FT_SOURCETRANSPORTPORT, _T("source_ip_port") },
-	{ IPFIX_FT_DESTINATIONTRANSPORTPORT, _T("dest_ip_port") },
-	{ IPFIX_FT_OCTETDELTACOUNT, _T("octet_count") },
-	{ IPFIX_FT_PACKETDELTACOUNT, _T("packet_count") },
-	{ IPFIX_FT_INGRESSINTERFACE, _T("ingress_interface") },
-	{ IPFIX_FT_EGRESSINTERFACE, _T("egress_interface") },
-	{ 0, NULL }
+	int64_t interval;
+	uint32_t exporterAddr;
+	uint32_t sourceAddr;
+	uint32_t destAddr;
+	uint32_t ingressInterface;
+	uint32_t egressInterface;
+	uint16_t sourcePort;
+	uint16_t destPort;
+	uint16_t fields;
+	BYTE protocol;
+	BYTE sourceMac[6];
+	BYTE destMac[6];
 };
 
+/**
+ * Aggregated flows
+ */
+static HashMap<FlowKey, FlowRecord> s_aggregatedFlows(Ownership::True);
+
+/**
+ * Statistics
+ */
+VolatileCounter64 g_flowsReceived = 0;
+VolatileCounter64 g_flowsAggregated = 0;
+
+/**
+ * Add flow record to aggregated flows or queue it for writing if aggregation is disabled
+ */
+static void AggregateFlowRecord(const FlowRecord *record)
+{
+	if (g_aggregationInterval == 0)
+	{
+		QueueFlowRecord(record);
+		return;
+	}
+
+	FlowKey key;
+	memset(&key, 0, sizeof(key));
+	key.interval = record->startTime / (static_cast<int64_t>(g_aggregationInterval) * 1000);
+	key.exporterAddr = record->exporterAddr;
+	key.sourceAddr = record->sourceAddr;
+	key.destAddr = record->destAddr;
+	key.sourcePort = record->sourcePort;
+	key.destPort = record->destPort;
+	key.ingressInterface = record->ingressInterface;
+	key.egressInterface = record->egressInterface;
+	key.fields = record->fields;
+	key.protocol = record->protocol;
+	memcpy(key.sourceMac, record->sourceMac, 6);
+	memcpy(key.destMac, record->destMac, 6);
+
+	FlowRecord *aggregate = s_aggregatedFlows.get(key);
+	if (aggregate != nullptr)
+	{
+		if (record->startTime < aggregate->startTime)
+			aggregate->startTime = record->startTime;
+		if (record->endTime > aggregate->endTime)
+			aggregate->endTime = record->endTime;
+		aggregate->octetCount += record->octetCount;
+		aggregate->packetCount += record->packetCount;
+		g_flowsAggregated++;
+	}
+	else
+	{
+		aggregate = new FlowRecord(*record);
+		s_aggregatedFlows.set(key, aggregate);
+	}
+}
+
+/**
+ * Queue aggregated flows for writing. If force is false, only flows from completed intervals are queued.
+ */
+static void FlushAggregatedFlows(bool force)
+{
+	if (s_aggregatedFlows.size() == 0)
+		return;
+
+	// Interval is considered completed after one more interval passed, to allow late records from exporters
+	int64_t intervalLength = static_cast<int64_t>(g_aggregationInterval) * 1000;
+	int64_t lastCompletedInterval = GetCurrentTimeMs() / intervalLength - 2;
+
+	StructArray<FlowKey> completed(0, 1024);
+	s_aggregatedFlows.forEach(
+		[force, lastCompletedInterval, &completed] (const FlowKey& key, FlowRecord *record) -> EnumerationCallbackResult
+		{
+			if (force || (key.interval <= lastCompletedInterval))
+			{
+				QueueFlowRecord(record);
+				completed.add(key);
+			}
+			return _CONTINUE;
+		});
+
+	for(int i = 0; i < completed.size(); i++)
+		s_aggregatedFlows.remove(*completed.get(i));
+}
+
+/**
+ * Handler for data record
+ */
 static int H_DataRecord(ipfixs_node_t *node, ipfixt_node_t *trec, ipfix_datarecord_t *data, void *arg) 
 {
-	StringBuffer fields, values;
-	char buffer[256];
-	INT64 flowStartTime = 0, flowEndTime = 0;
+	FlowRecord record;
+	memset(&record, 0, sizeof(record));
 
 	for(int i = 0; i < trec->ipfixt->nfields; i++)
 	{
@@ -107,69 +207,116 @@ static int H_DataRecord(ipfixs_node_t *node, ipfixt_node_t *trec, ipfix_datareco
 		{
 			case IPFIX_FT_FLOWSTARTSYSUPTIME:
 				if (node->boot_time != 0)
-					flowStartTime = node->boot_time * 1000 + Int64FromData(data->addrs[i], data->lens[i]);
+					record.startTime = node->boot_time * 1000 + Int64FromData(data->addrs[i], data->lens[i]);
 				break;
 			case IPFIX_FT_FLOWENDSYSUPTIME:
 				if (node->boot_time != 0)
-					flowEndTime = node->boot_time * 1000 + Int64FromData(data->addrs[i], data->lens[i]);
+					record.endTime = node->boot_time * 1000 + Int64FromData(data->addrs[i], data->lens[i]);
 				break;
 			case IPFIX_FT_FLOWSTARTSECONDS:
-				flowStartTime = Int64FromData(data->addrs[i], data->lens[i]) * 1000;
+				record.startTime = Int64FromData(data->addrs[i], data->lens[i]) * 1000;
 				break;
 			case IPFIX_FT_FLOWENDSECONDS:
-				flowEndTime = Int64FromData(data->addrs[i], data->lens[i]) * 1000;
+				record.endTime = Int64FromData(data->addrs[i], data->lens[i]) * 1000;
 				break;
 			case IPFIX_FT_FLOWSTARTMILLISECONDS:
-				flowStartTime = Int64FromData(data->addrs[i], data->lens[i]);
+				record.startTime = Int64FromData(data->addrs[i], data->lens[i]);
 				break;
 			case IPFIX_FT_FLOWENDMILLISECONDS:
-				flowEndTime = Int64FromData(data->addrs[i], data->lens[i]);
+				record.endTime = Int64FromData(data->addrs[i], data->lens[i]);
 				break;
 			case IPFIX_FT_FLOWSTARTMICROSECONDS:
-				flowStartTime = Int64FromData(data->addrs[i], data->lens[i]) / 1000;
+				record.startTime = Int64FromData(data->addrs[i], data->lens[i]) / 1000;
 				break;
 			case IPFIX_FT_FLOWENDMICROSECONDS:
-				flowEndTime = Int64FromData(data->addrs[i], data->lens[i]) / 1000;
+				record.endTime = Int64FromData(data->addrs[i], data->lens[i]) / 1000;
 				break;
 			case IPFIX_FT_FLOWSTARTNANOSECONDS:
-				flowStartTime = Int64FromData(data->addrs[i], data->lens[i]) / 1000000;
+				record.startTime = Int64FromData(data->addrs[i], data->lens[i]) / 1000000;
 				break;
 			case IPFIX_FT_FLOWENDNANOSECONDS:
-				flowEndTime = Int64FromData(data->addrs[i], data->lens[i]) / 1000000;
+				record.endTime = Int64FromData(data->addrs[i], data->lens[i]) / 1000000;
 				break;
 			case IPFIX_FT_FLOWSTARTDELTAMICROSECONDS:
 				if (node->export_time != 0)
-					flowStartTime = node->export_time * 1000 + Int64FromData(data->addrs[i], data->lens[i]);
+					record.startTime = node->export_time * 1000 + Int64FromData(data->addrs[i], data->lens[i]);
 				break;
 			case IPFIX_FT_FLOWENDDELTAMICROSECONDS:
 				if (node->export_time != 0)
-					flowEndTime = node->export_time * 1000 + Int64FromData(data->addrs[i], data->lens[i]);
+					record.endTime = node->export_time * 1000 + Int64FromData(data->addrs[i], data->lens[i]);
 				break;
-			default:
-				for(int j = 0; s_fieldMapping[j].dbField != NULL; j++)
+			case IPFIX_FT_EXPORTERIPV4ADDRESS:
+				if (data->lens[i] == 4)
+				{
+					memcpy(&record.exporterAddr, data->addrs[i], 4);
+					record.fields |= FLOW_FIELD_EXPORTER_ADDR;
+				}
+				break;
+			case IPFIX_FT_SOURCEIPV4ADDRESS:
+				if (data->lens[i] == 4)
+				{
+					memcpy(&record.sourceAddr, data->addrs[i], 4);
+					record.fields |= FLOW_FIELD_SOURCE_ADDR;
+				}
+				break;
+			case IPFIX_FT_DESTINATIONIPV4ADDRESS:
+				if (data->lens[i] == 4)
+				{
+					memcpy(&record.destAddr, data->addrs[i], 4);
+					record.fields |= FLOW_FIELD_DEST_ADDR;
+				}
+				break;
+			case IPFIX_FT_SOURCEMACADDRESS:
+				if (data->lens[i] == 6)
 				{
-					if (ftype == s_fieldMapping[j].ipfixField)
-					{
-						fields += _T(",");
-						fields += s_fieldMapping[j].dbField;
-						trec->ipfixt->fields[i].elem->snprint(buffer, sizeof(buffer), data->addrs[i], data->lens[i]);
-						values.appendFormattedString(_T(",'%hs'"), buffer);
-						break;
-					}
+					memcpy(record.sourceMac, data->addrs[i], 6);
+					record.fields |= FLOW_FIELD_SOURCE_MAC;
 				}
 				break;
+			case IPFIX_FT_DESTINATIONMACADDRESS:
+				if (data->lens[i] == 6)
+				{
+					memcpy(record.destMac, data->addrs[i], 6);
+					record.fields |= FLOW_FIELD_DEST_MAC;
+				}
+				break;
+			case IPFIX_FT_PROTOCOLIDENTIFIER:
+				record.protocol = static_cast<BYTE>(UInt64FromData(data->addrs[i], data->lens[i]));
+				record.fields |= FLOW_FIELD_PROTOCOL;
+				break;
+			case IPFIX_FT_SOURCETRANSPORTPORT:
+				record.sourcePort = static_cast<uint16_t>(UInt64FromData(data->addrs[i], data->lens[i]));
+				record.fields |= FLOW_FIELD_SOURCE_PORT;
+				break;
+			case IPFIX_FT_DESTINATIONTRANSPORTPORT:
+				record.destPort = static_cast<uint16_t>(UInt64FromData(data->addrs[i], data->lens[i]));
+				record.fields |= FLOW_FIELD_DEST_PORT;
+				break;
+			case IPFIX_FT_OCTETDELTACOUNT:
+				record.octetCount = UInt64FromData(data->addrs[i], data->lens[i]);
+				record.fields |= FLOW_FIELD_OCTET_COUNT;
+				break;
+			case IPFIX_FT_PACKETDELTACOUNT:
+				record.packetCount = UInt64FromData(data->addrs[i], data->lens[i]);
+				record.fields |= FLOW_FIELD_PACKET_COUNT;
+				break;
+			case IPFIX_FT_INGRESSINTERFACE:
+				record.ingressInterface = static_cast<uint32_t>(UInt64FromData(data->addrs[i], data->lens[i]));
+				record.fields |= FLOW_FIELD_INGRESS_INTERFACE;
+				break;
+			case IPFIX_FT_EGRESSINTERFACE:
+				record.egressInterface = static_cast<uint32_t>(UInt64FromData(data->addrs[i], data->lens[i]));
+				record.fields |= FLOW_FIELD_EGRESS_INTERFACE;
+				break;
+			default:
+				break;
 		}
 	}
 
-	if (!fields.isEmpty() && (flowStartTime != 0) && (flowEndTime != 0))
+	if ((record.fields != 0) && (record.startTime != 0) && (record.endTime != 0))
 	{
-		StringBuffer query = _T("INSERT INTO flows (flow_id,start_time,end_time");
-		query += (const TCHAR *)fields;
-		query.appendFormattedString(_T(") VALUES (") INT64_FMT _T(",") INT64_FMT _T(",") INT64_FMT, s_flowId++, flowStartTime, flowEndTime);
-		query += (const TCHAR *)values;
-		query += _T(")");
-
-		DBQuery(g_dbConnection, query);
+		g_flowsReceived++;
+		AggregateFlowRecord(&record);
 	}
 	return 0;
 }
@@ -197,6 +344,7 @@ static THREAD_RESULT THREAD_CALL CollectorThread(void *arg)
 {
    nxlog_write(NXLOG_INFO, _T("Collector thread started"));
 
+	int64_t lastStatsTime = GetCurrentTimeMs();
 	while(!(g_flags & AF_SHUTDOWN))
 	{
 		if (mpoll_loop(2) < 0)
@@ -204,8 +352,24 @@ static THREAD_RESULT THREAD_CALL CollectorThread(void *arg)
 		   nxlog_write(NXLOG_ERROR, _T("IPFIX polling error"));
 			break;
 		}
+
+		if (g_aggregationInterval != 0)
+			FlushAggregatedFlows(false);
+
+		int64_t now = GetCurrentTimeMs();
+		if (now - lastStatsTime >= 60000)
+		{
+			FlowPipelineStats stats;
+			GetFlowPipelineStats(&stats);
+			nxlog_debug(3, _T("Flow pipeline: received=") UINT64_FMT _T(" aggregated=") UINT64_FMT _T(" queued=") UINT64_FMT _T(" dropped=") UINT64_FMT
+			         _T(" written=") UINT64_FMT _T(" failed=") UINT64_FMT _T(" transactions=") UINT64_FMT _T(" backlog=%u"),
+			         stats.received, stats.aggregated, stats.queued, stats.dropped, stats.written, stats.failed, stats.transactions, stats.backlog);
+			lastStatsTime = now;
+		}
 	}
 
+	FlushAggregatedFlows(true);
+
    nxlog_write(NXLOG_INFO, _T("Collector thread stopped"));
    return THREAD_OK;
 }
@@ -215,12 +379,10 @@ static THREAD_RESULT THREAD_CALL CollectorThread(void *arg)
  */
 bool StartCollector()
 {
-	// Initialize flow ID
-	DB_RESULT hResult = DBSelect(g_dbConnection, _T("SELECT max(flow_id) FROM flows"));
-	if (hResult != NULL)
+	if (!StartFlowWriters())
 	{
-		s_flowId = DBGetFieldInt64(hResult, 0, 0) + 1;
-		DBFreeResult(hResult);
+      nxlog_write(NXLOG_ERROR, _T("Cannot start flow writers"));
+		return false;
 	}
 
 	s_collectorInfo = (ipfix_col_info_t *)malloc(sizeof(ipfix_col_info_t));
@@ -256,6 +418,7 @@ bool StartCollector()
 failure:
 	CloseCollectors();
 	free(s_collectorInfo);
+	StopFlowWriters();
 	return false;
 }
 
@@ -34,6 +34,10 @@ DWORD g_flags = AF_LOG_SQL_ERRORS;
 TCHAR g_listenAddress[MAX_PATH] = _T("0.0.0.0");
 DWORD g_tcpPort = IPFIX_DEFAULT_PORT;
 DWORD g_udpPort = IPFIX_DEFAULT_PORT;
+DWORD g_aggregationInterval = 0;
+DWORD g_writerThreads = 2;
+DWORD g_writerQueueSize = 65536;
+DWORD g_maxRecordsPerTransaction = 1000;
 DB_DRIVER g_dbDriverHandle = NULL;
 DB_HANDLE g_dbConnection = NULL;
 #ifdef _WIN32
@@ -63,6 +67,7 @@ static TCHAR s_dbLogin[MAX_DB_LOGIN] = _T("netxms");
 static TCHAR s_dbPassword[MAX_PASSWORD] = _T("");
 static NX_CFG_TEMPLATE m_cfgTemplate[] =
 {
+   { _T("AggregationInterval"), CT_LONG, 0, 0, 0, 0, &g_aggregationInterval },
    { _T("DBDriver"), CT_STRING, 0, 0, MAX_PATH, 0, s_dbDriver },
    { _T("DBDrvParams"), CT_STRING, 0, 0, MAX_PATH, 0, s_dbDrvParams },
    { _T("DBLogin"), CT_STRING, 0, 0, MAX_DB_LOGIN, 0, s_dbLogin },
@@ -77,6 +82,9 @@ static NX_CFG_TEMPLATE m_cfgTemplate[] =
    { _T("LogFile"), CT_STRING, 0, 0, MAX_PATH, 0, g_logFile },
    { _T("LogFailedSQLQueries"), CT_BOOLEAN_FLAG_32, 0, 0, AF_LOG_SQL_ERRORS, 0, &g_flags },
    { _T("LogFile"), CT_STRING, 0, 0, MAX_PATH, 0, g_logFile },
+   { _T("MaxRecordsPerTransaction"), CT_LONG, 0, 0, 0, 0, &g_maxRecordsPerTransaction },
+   { _T("WriterQueueSize"), CT_LONG, 0, 0, 0, 0, &g_writerQueueSize },
+   { _T("WriterThreads"), CT_LONG, 0, 0, 0, 0, &g_writerThreads },
    { _T(""), CT_END_OF_LIST, 0, 0, 0, 0, NULL }
 };
 
@@ -111,6 +119,14 @@ static bool LoadConfig()
    return success;
 }
 
+/**
+ * Connect to database using configured parameters
+ */
+DB_HANDLE ConnectToDatabase(TCHAR *errorText)
+{
+   return DBConnect(g_dbDriverHandle, s_dbServer, s_dbName, s_dbLogin, s_dbPassword, s_dbSchema, errorText);
+}
+
 /**
  * Initialization
  */
@@ -149,7 +165,7 @@ bool Initialize()
 	TCHAR errorText[DBDRV_MAX_ERROR_TEXT];
 	for(int i = 0; ; i++)
 	{
-		g_dbConnection = DBConnect(g_dbDriverHandle, s_dbServer, s_dbName, s_dbLogin, s_dbPassword, s_dbSchema, errorText);
+		g_dbConnection = ConnectToDatabase(errorText);
 		if ((g_dbConnection != NULL) || (i == 5))
 			break;
 		ThreadSleep(5);
@@ -176,6 +192,7 @@ void Shutdown()
    g_flags |= AF_SHUTDOWN;
 
 	WaitForCollectorThread();
+	StopFlowWriters();
 
 	ipfix_cleanup();
    nxlog_close();
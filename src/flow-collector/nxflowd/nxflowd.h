@@ -40,6 +40,61 @@
 #define AF_SHUTDOWN        0x01000000
 
 
+//
+// Flow record fields
+//
+
+#define FLOW_FIELD_EXPORTER_ADDR       0x0001
+#define FLOW_FIELD_SOURCE_MAC          0x0002
+#define FLOW_FIELD_DEST_MAC            0x0004
+#define FLOW_FIELD_SOURCE_ADDR         0x0008
+#define FLOW_FIELD_DEST_ADDR           0x0010
+#define FLOW_FIELD_PROTOCOL            0x0020
+#define FLOW_FIELD_SOURCE_PORT         0x0040
+#define FLOW_FIELD_DEST_PORT           0x0080
+#define FLOW_FIELD_OCTET_COUNT         0x0100
+#define FLOW_FIELD_PACKET_COUNT        0x0200
+#define FLOW_FIELD_INGRESS_INTERFACE   0x0400
+#define FLOW_FIELD_EGRESS_INTERFACE    0x0800
+
+/**
+ * Decoded flow record. IPv4 addresses are in network byte order.
+ */
+struct FlowRecord
+{
+   int64_t startTime;   // milliseconds since epoch
+   int64_t endTime;     // milliseconds since epoch
+   uint64_t octetCount;
+   uint64_t packetCount;
+   uint32_t exporterAddr;
+   uint32_t sourceAddr;
+   uint32_t destAddr;
+   uint32_t ingressInterface;
+   uint32_t egressInterface;
+   uint16_t sourcePort;
+   uint16_t destPort;
+   uint16_t fields;     // Present fields (FLOW_FIELD_xxx)
+   BYTE protocol;
+   BYTE sourceMac[6];
+   BYTE destMac[6];
+};
+
+/**
+ * Flow pipeline statistics
+ */
+struct FlowPipelineStats
+{
+   uint64_t received;      // Flow records received from exporters
+   uint64_t aggregated;    // Flow records merged into existing aggregated records
+   uint64_t queued;        // Records queued for writing
+   uint64_t dropped;       // Records dropped because writer queues were full
+   uint64_t written;       // Records written to database
+   uint64_t failed;        // Records dropped because of database write errors
+   uint64_t transactions;  // Committed transactions
+   uint32_t backlog;       // Records waiting in writer queues
+};
+
+
 //
 // Functions
 //
@@ -51,6 +106,13 @@ void Main();
 bool StartCollector();
 void WaitForCollectorThread();
 
+DB_HANDLE ConnectToDatabase(TCHAR *errorText);
+
+bool StartFlowWriters();
+void StopFlowWriters();
+void QueueFlowRecord(const FlowRecord *record);
+void GetFlowPipelineStats(FlowPipelineStats *stats);
+
 #ifdef _WIN32
 void InitService();
 void InstallFlowCollectorService(const TCHAR *pszExecName);
@@ -71,9 +133,15 @@ extern DWORD g_flags;
 extern TCHAR g_listenAddress[];
 extern DWORD g_tcpPort;
 extern DWORD g_udpPort;
+extern DWORD g_aggregationInterval;
+extern DWORD g_writerThreads;
+extern DWORD g_writerQueueSize;
+extern DWORD g_maxRecordsPerTransaction;
 extern TCHAR g_configFile[];
 extern TCHAR g_logFile[];
 extern int g_debugLevel;
 extern DB_HANDLE g_dbConnection;
+extern VolatileCounter64 g_flowsReceived;
+extern VolatileCounter64 g_flowsAggregated;
 
 #endif
@@ -0,0 +1,447 @@
+/*
+** nxflowd - NetXMS Flow Collector Daemon
+** Copyright (c) 2009-2024 Raden Solutions
+*/
+
+#include "nxflowd.h"
+#include <nxatomic.h>
+
+/**
+ * Single producer / single consumer lock-free ring of flow records
+ */
+class FlowRing
+{
+private:
+	FlowRecord *m_records;
+	uint32_t m_mask;
+	atomic<uint32_t> m_head;   // Next position to read (updated only by consumer)
+	atomic<uint32_t> m_tail;   // Next position to write (updated only by producer)
+
+public:
+	FlowRing(uint32_t capacity) : m_head(0), m_tail(0)
+	{
+		uint32_t size = 1024;
+		while(size < capacity)
+			size <<= 1;
+		m_records = MemAllocArrayNoInit<FlowRecord>(size);
+		m_mask = size - 1;
+	}
+
+	~FlowRing()
+	{
+		MemFree(m_records);
+	}
+
+	bool put(const FlowRecord *record)
+	{
+		uint32_t tail = m_tail.load(std::memory_order_relaxed);
+		if (tail - m_head.load(std::memory_order_acquire) > m_mask)
+			return false;  // Ring is full
+		m_records[tail & m_mask] = *record;
+		m_tail.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	int get(FlowRecord *buffer, int maxRecords)
+	{
+		uint32_t head = m_head.load(std::memory_order_relaxed);
+		uint32_t count = std::min(m_tail.load(std::memory_order_acquire) - head, static_cast<uint32_t>(maxRecords));
+		for(uint32_t i = 0; i < count; i++)
+			buffer[i] = m_records[(head + i) & m_mask];
+		m_head.store(head + count, std::memory_order_release);
+		return static_cast<int>(count);
+	}
+
+	uint32_t size() const
+	{
+		return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+	}
+};
+
+/**
+ * Prepared statement for specific set of flow fields
+ */
+struct FlowStatement
+{
+	uint16_t fields;
+	DB_STATEMENT hStmt;
+};
+
+/**
+ * Maximum number of different field sets with prepared statement per writer
+ */
+#define MAX_FLOW_STATEMENTS   16
+
+/**
+ * Flow writer
+ */
+struct FlowWriter
+{
+	THREAD thread;
+	FlowRing *ring;
+	DB_HANDLE hdb;
+	FlowStatement statements[MAX_FLOW_STATEMENTS];
+	int numStatements;
+	int id;
+
+	DB_STATEMENT getStatement(uint16_t fields, bool *cached);
+	bool writeRecord(const FlowRecord *r);
+	void writeRowByRow(const FlowRecord *batch, int count);
+	void writeBatch(FlowRecord *batch, int count);
+	void run();
+};
+
+/**
+ * Mapping between flow record fields and database columns
+ */
+static struct
+{
+	uint16_t field;
+	const TCHAR *column;
+} s_columns[] =
+{
+	{ FLOW_FIELD_EXPORTER_ADDR, _T("exporter_ip_addr") },
+	{ FLOW_FIELD_SOURCE_MAC, _T("source_mac_addr") },
+	{ FLOW_FIELD_DEST_MAC, _T("dest_mac_addr") },
+	{ FLOW_FIELD_SOURCE_ADDR, _T("source_ip_addr") },
+	{ FLOW_FIELD_DEST_ADDR, _T("dest_ip_addr") },
+	{ FLOW_FIELD_PROTOCOL, _T("ip_proto") },
+	{ FLOW_FIELD_SOURCE_PORT, _T("source_ip_port") },
+	{ FLOW_FIELD_DEST_PORT, _T("dest_ip_port") },
+	{ FLOW_FIELD_OCTET_COUNT, _T("octet_count") },
+	{ FLOW_FIELD_PACKET_COUNT, _T("packet_count") },
+	{ FLOW_FIELD_INGRESS_INTERFACE, _T("ingress_interface") },
+	{ FLOW_FIELD_EGRESS_INTERFACE, _T("egress_interface") },
+	{ 0, nullptr }
+};
+
+/**
+ * Writers
+ */
+static FlowWriter *s_writers = nullptr;
+static int s_writerCount = 0;
+static int s_nextWriter = 0;
+static bool s_stopWriters = false;
+static VolatileCounter64 s_flowId = 1;
+
+/**
+ * Statistics
+ */
+static VolatileCounter64 s_queuedFlows = 0;
+static VolatileCounter64 s_droppedFlows = 0;
+static VolatileCounter64 s_writtenFlows = 0;
+static VolatileCounter64 s_failedFlows = 0;
+static VolatileCounter64 s_transactions = 0;
+
+/**
+ * Format IPv4 address stored in network byte order
+ */
+static TCHAR *FormatIPv4Address(uint32_t addr, TCHAR *buffer)
+{
+	const BYTE *b = reinterpret_cast<const BYTE*>(&addr);
+	_sntprintf(buffer, 32, _T("%u.%u.%u.%u"), b[0], b[1], b[2], b[3]);
+	return buffer;
+}
+
+/**
+ * Format MAC address the same way as IPFIX library formats byte fields
+ */
+static TCHAR *FormatMACAddress(const BYTE *addr, TCHAR *buffer)
+{
+	_sntprintf(buffer, 32, _T("0x%02x%02x%02x%02x%02x%02x"), addr[0], addr[1], addr[2], addr[3], addr[4], addr[5]);
+	return buffer;
+}
+
+/**
+ * Get prepared statement for given set of fields
+ */
+DB_STATEMENT FlowWriter::getStatement(uint16_t fields, bool *cached)
+{
+	for(int i = 0; i < numStatements; i++)
+	{
+		if (statements[i].fields == fields)
+		{
+			*cached = true;
+			return statements[i].hStmt;
+		}
+	}
+
+	StringBuffer query(_T("INSERT INTO flows (flow_id,start_time,end_time"));
+	int count = 3;
+	for(int i = 0; s_columns[i].column != nullptr; i++)
+	{
+		if (fields & s_columns[i].field)
+		{
+			query.append(_T(','));
+			query.append(s_columns[i].column);
+			count++;
+		}
+	}
+	query.append(_T(") VALUES (?"));
+	for(int i = 1; i < count; i++)
+		query.append(_T(",?"));
+	query.append(_T(')'));
+
+	DB_STATEMENT hStmt = DBPrepare(hdb, query, true);
+	*cached = (hStmt != nullptr) && (numStatements < MAX_FLOW_STATEMENTS);
+	if (*cached)
+	{
+		statements[numStatements].fields = fields;
+		statements[numStatements].hStmt = hStmt;
+		numStatements++;
+	}
+	return hStmt;
+}
+
+/**
+ * Write single flow record
+ */
+bool FlowWriter::writeRecord(const FlowRecord *r)
+{
+	bool cached;
+	DB_STATEMENT hStmt = getStatement(r->fields, &cached);
+	if (hStmt == nullptr)
+		return false;
+
+	TCHAR buffer[12][32];
+	int pos = 1;
+	DBBind(hStmt, pos++, DB_SQLTYPE_BIGINT, static_cast<int64_t>(InterlockedIncrement64(&s_flowId)));
+	DBBind(hStmt, pos++, DB_SQLTYPE_BIGINT, r->startTime);
+	DBBind(hStmt, pos++, DB_SQLTYPE_BIGINT, r->endTime);
+	if (r->fields & FLOW_FIELD_EXPORTER_ADDR)
+		DBBind(hStmt, pos++, DB_SQLTYPE_VARCHAR, FormatIPv4Address(r->exporterAddr, buffer[0]), DB_BIND_STATIC);
+	if (r->fields & FLOW_FIELD_SOURCE_MAC)
+		DBBind(hStmt, pos++, DB_SQLTYPE_VARCHAR, FormatMACAddress(r->sourceMac, buffer[1]), DB_BIND_STATIC);
+	if (r->fields & FLOW_FIELD_DEST_MAC)
+		DBBind(hStmt, pos++, DB_SQLTYPE_VARCHAR, FormatMACAddress(r->destMac, buffer[2]), DB_BIND_STATIC);
+	if (r->fields & FLOW_FIELD_SOURCE_ADDR)
+		DBBind(hStmt, pos++, DB_SQLTYPE_VARCHAR, FormatIPv4Address(r->sourceAddr, buffer[3]), DB_BIND_STATIC);
+	if (r->fields & FLOW_FIELD_DEST_ADDR)
+		DBBind(hStmt, pos++, DB_SQLTYPE_VARCHAR, FormatIPv4Address(r->destAddr, buffer[4]), DB_BIND_STATIC);
+	if (r->fields & FLOW_FIELD_PROTOCOL)
+		DBBind(hStmt, pos++, DB_SQLTYPE_INTEGER, static_cast<uint32_t>(r->protocol));
+	if (r->fields & FLOW_FIELD_SOURCE_PORT)
+		DBBind(hStmt, pos++, DB_SQLTYPE_INTEGER, static_cast<uint32_t>(r->sourcePort));
+	if (r->fields & FLOW_FIELD_DEST_PORT)
+		DBBind(hStmt, pos++, DB_SQLTYPE_INTEGER, static_cast<uint32_t>(r->destPort));
+	if (r->fields & FLOW_FIELD_OCTET_COUNT)
+		DBBind(hStmt, pos++, DB_SQLTYPE_BIGINT, r->octetCount);
+	if (r->fields & FLOW_FIELD_PACKET_COUNT)
+		DBBind(hStmt, pos++, DB_SQLTYPE_BIGINT, r->packetCount);
+	if (r->fields & FLOW_FIELD_INGRESS_INTERFACE)
+		DBBind(hStmt, pos++, DB_SQLTYPE_INTEGER, r->ingressInterface);
+	if (r->fields & FLOW_FIELD_EGRESS_INTERFACE)
+		DBBind(hStmt, pos++, DB_SQLTYPE_INTEGER, r->egressInterface);
+
+	bool success = DBExecute(hStmt);
+
+	// Statements that did not fit into cache are used only once
+	if (!cached)
+		DBFreeStatement(hStmt);
+	return success;
+}
+
+/**
+ * Write flow records one by one without transaction, so failed record does not affect others
+ */
+void FlowWriter::writeRowByRow(const FlowRecord *batch, int count)
+{
+	int written = 0;
+	for(int i = 0; i < count; i++)
+	{
+		const FlowRecord *r = &batch[i];
+		if (writeRecord(r))
+		{
+			written++;
+		}
+		else
+		{
+			TCHAR source[32], dest[32];
+			nxlog_debug(6, _T("Flow writer #%d: cannot write flow record (%s:%u -> %s:%u, protocol %u, start time ") INT64_FMT _T(")"),
+				id, FormatIPv4Address(r->sourceAddr, source), r->sourcePort, FormatIPv4Address(r->destAddr, dest), r->destPort, r->protocol, r->startTime);
+		}
+	}
+	if (written < count)
+		nxlog_write(NXLOG_ERROR, _T("Flow writer #%d: %d of %d flow records dropped because of database write errors"), id, count - written, count);
+	InterlockedAdd64(&s_writtenFlows, written);
+	InterlockedAdd64(&s_failedFlows, count - written);
+}
+
+/**
+ * Write batch of flow records in single transaction. If any record fails, transaction is rolled back
+ * and batch is written again record by record.
+ */
+void FlowWriter::writeBatch(FlowRecord *batch, int count)
+{
+	if (!DBBegin(hdb))
+	{
+		writeRowByRow(batch, count);
+		return;
+	}
+
+	bool success = true;
+	for(int i = 0; (i < count) && success; i++)
+		success = writeRecord(&batch[i]);
+
+	if (success)
+	{
+		if (DBCommit(hdb))
+		{
+			InterlockedAdd64(&s_writtenFlows, count);
+			InterlockedIncrement64(&s_transactions);
+			return;
+		}
+	}
+	else
+	{
+		DBRollback(hdb);
+	}
+
+	nxlog_debug(4, _T("Flow writer #%d: batch of %d records failed, retrying record by record"), id, count);
+	writeRowByRow(batch, count);
+}
+
+/**
+ * Writer thread
+ */
+void FlowWriter::run()
+{
+	nxlog_debug(1, _T("Flow writer #%d started"), id);
+
+	int batchSize = std::max(static_cast<int>(g_maxRecordsPerTransaction), 1);
+	FlowRecord *batch = MemAllocArrayNoInit<FlowRecord>(batchSize);
+	while(true)
+	{
+		int count = ring->get(batch, batchSize);
+		if (count > 0)
+		{
+			writeBatch(batch, count);
+			nxlog_debug(7, _T("Flow writer #%d: %d records written"), id, count);
+			continue;
+		}
+
+		if (s_stopWriters)
+			break;
+		ThreadSleepMs(100);
+	}
+	MemFree(batch);
+
+	nxlog_debug(1, _T("Flow writer #%d stopped"), id);
+}
+
+/**
+ * Writer thread starter
+ */
+static THREAD_RESULT THREAD_CALL FlowWriterThread(void *arg)
+{
+	static_cast<FlowWriter*>(arg)->run();
+	return THREAD_OK;
+}
+
+/**
+ * Queue flow record for writing. Should be called only from collector thread.
+ */
+void QueueFlowRecord(const FlowRecord *record)
+{
+	for(int i = 0; i < s_writerCount; i++)
+	{
+		FlowWriter *writer = &s_writers[s_nextWriter];
+		s_nextWriter = (s_nextWriter + 1) % s_writerCount;
+		if (writer->ring->put(record))
+		{
+			InterlockedIncrement64(&s_queuedFlows);
+			return;
+		}
+	}
+	InterlockedIncrement64(&s_droppedFlows);
+}
+
+/**
+ * Start flow writers
+ */
+bool StartFlowWriters()
+{
+	// Initialize flow ID
+	DB_RESULT hResult = DBSelect(g_dbConnection, _T("SELECT max(flow_id) FROM flows"));
+	if (hResult != nullptr)
+	{
+		s_flowId = DBGetFieldInt64(hResult, 0, 0);
+		DBFreeResult(hResult);
+	}
+
+	s_stopWriters = false;
+	s_writerCount = std::max(static_cast<int>(g_writerThreads), 1);
+	s_writers = new FlowWriter[s_writerCount];
+	for(int i = 0; i < s_writerCount; i++)
+	{
+		FlowWriter *writer = &s_writers[i];
+		writer->id = i + 1;
+		writer->numStatements = 0;
+		writer->ring = new FlowRing(g_writerQueueSize);
+		writer->thread = INVALID_THREAD_HANDLE;
+
+		TCHAR errorText[DBDRV_MAX_ERROR_TEXT];
+		writer->hdb = ConnectToDatabase(errorText);
+		if (writer->hdb == nullptr)
+		{
+			nxlog_write(NXLOG_ERROR, _T("Flow writer #%d cannot establish connection with database (%s)"), writer->id, errorText);
+			s_writerCount = i + 1;
+			StopFlowWriters();
+			return false;
+		}
+	}
+
+	for(int i = 0; i < s_writerCount; i++)
+		s_writers[i].thread = ThreadCreateEx(FlowWriterThread, 0, &s_writers[i]);
+
+	nxlog_debug(1, _T("%d flow writers started (queue size %u, %u records per transaction, aggregation interval %u seconds)"),
+				s_writerCount, g_writerQueueSize, g_maxRecordsPerTransaction, g_aggregationInterval);
+	return true;
+}
+
+/**
+ * Stop flow writers. Records already queued are written before writers stop.
+ */
+void StopFlowWriters()
+{
+	if (s_writers == nullptr)
+		return;
+
+	s_stopWriters = true;
+	for(int i = 0; i < s_writerCount; i++)
+	{
+		FlowWriter *writer = &s_writers[i];
+		ThreadJoin(writer->thread);
+		for(int j = 0; j < writer->numStatements; j++)
+			DBFreeStatement(writer->statements[j].hStmt);
+		if (writer->hdb != nullptr)
+			DBDisconnect(writer->hdb);
+		delete writer->ring;
+	}
+
+	FlowPipelineStats stats;
+	GetFlowPipelineStats(&stats);
+	nxlog_write(NXLOG_INFO, _T("Flow writers stopped (") UINT64_FMT _T(" records written, ") UINT64_FMT _T(" failed, ") UINT64_FMT _T(" dropped)"),
+				stats.written, stats.failed, stats.dropped);
+
+	delete[] s_writers;
+	s_writers = nullptr;
+	s_writerCount = 0;
+}
+
+/**
+ * Get flow pipeline statistics
+ */
+void GetFlowPipelineStats(FlowPipelineStats *stats)
+{
+	stats->received = static_cast<uint64_t>(g_flowsReceived);
+	stats->aggregated = static_cast<uint64_t>(g_flowsAggregated);
+	stats->queued = static_cast<uint64_t>(s_queuedFlows);
+	stats->dropped = static_cast<uint64_t>(s_droppedFlows);
+	stats->written = static_cast<uint64_t>(s_writtenFlows);
+	stats->failed = static_cast<uint64_t>(s_failedFlows);
+	stats->transactions = static_cast<uint64_t>(s_transactions);
+	stats->backlog = 0;
+	for(int i = 0; i < s_writerCount; i++)
+		stats->backlog += s_writers[i].ring->size();
+}
@@ -485,6 +485,7 @@
    public static final int CMD_EXECUTE_DASBOARD_SCRIPT = 0x01D0;
    public static final int CMD_UPDATE_PEER_INTERFACE = 0x01D1;
    public static final int CMD_CLEAR_PEER_INTERFACE = 0x01D2;
+   public static final int CMD_GET_MULTIPLE_PARAMETERS = 0x01D3;
 
 	// CMD_RS_ - Reporting Server related codes
 	public static final int CMD_RS_LIST_REPORTS = 0x1100;
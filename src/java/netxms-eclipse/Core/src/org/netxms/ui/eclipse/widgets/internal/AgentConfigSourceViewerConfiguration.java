@@ -63,6 +63,8 @@ public boolean isWordStart(char c)
       "DataDirectory",  //$NON-NLS-1$
       "DataReconciliationBlockSize",  //$NON-NLS-1$
       "DataReconciliationTimeout",  //$NON-NLS-1$
+      "DataSenderBatchSize",  //$NON-NLS-1$
+      "DataSenderWindowSize",  //$NON-NLS-1$
       "DataWriterFlushInterval",  //$NON-NLS-1$
       "DataWriterMaxTransactionSize",  //$NON-NLS-1$
       "DailyLogFileSuffix",  //$NON-NLS-1$
@@ -82,6 +82,11 @@ static NxLogDebugWriter s_debugWriter = nullptr;
 static volatile DebugTagManager s_tagTree;
 static Mutex s_mutexDebugTagTreeWrite(MutexType::FAST);
 
+/**
+ * Debug level generation. Starts from 1 so zero-initialized call site caches are always invalid.
+ */
+LIBNETXMS_EXPORTABLE_VAR(VolatileCounter g_nxlogDebugLevelGeneration) = 1;
+
 /**
  * Swaps tag tree pointers and waits till reader count drops to 0
  */
@@ -155,6 +160,7 @@ void LIBNETXMS_EXPORTABLE nxlog_set_debug_level(int level)
    SwapAndWait();
    s_tagTree.secondary->setRootDebugLevel(level); // Update the previously active tree
    InterlockedDecrement(&s_tagTree.secondary->m_writers);
+   InterlockedIncrement(&g_nxlogDebugLevelGeneration);
    s_mutexDebugTagTreeWrite.unlock();
 }
 
@@ -186,6 +192,7 @@ void LIBNETXMS_EXPORTABLE nxlog_set_debug_level_tag(const TCHAR *tag, int level)
       s_tagTree.secondary->remove(tag);
    }
    InterlockedDecrement(&s_tagTree.secondary->m_writers);
+   InterlockedIncrement(&g_nxlogDebugLevelGeneration);
    s_mutexDebugTagTreeWrite.unlock();
 }
 
@@ -224,6 +231,7 @@ void LIBNETXMS_EXPORTABLE nxlog_reset_debug_level_tags()
    SwapAndWait();
    s_tagTree.secondary->clear();
    InterlockedDecrement(&s_tagTree.secondary->m_writers);
+   InterlockedIncrement(&g_nxlogDebugLevelGeneration);
    s_mutexDebugTagTreeWrite.unlock();
 }
 
@@ -274,6 +282,18 @@ int LIBNETXMS_EXPORTABLE nxlog_get_debug_level_tag(const TCHAR *tag)
    return level;
 }
 
+/**
+ * Resolve debug level for tag and store it in call site cache together with current generation.
+ * Generation is read before resolving, so concurrent update will cause another resolve on next call.
+ */
+int LIBNETXMS_EXPORTABLE nxlog_resolve_debug_level_tag(const TCHAR *tag, std::atomic<uint64_t> *cache)
+{
+   uint32_t generation = static_cast<uint32_t>(g_nxlogDebugLevelGeneration);
+   int level = nxlog_get_debug_level_tag(tag);
+   cache->store((static_cast<uint64_t>(generation) << 32) | static_cast<uint32_t>(level), std::memory_order_relaxed);
+   return level;
+}
+
 /**
  * Get current debug level for tag/object combination
  */
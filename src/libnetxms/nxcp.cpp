@@ -506,7 +506,11 @@ TCHAR LIBNETXMS_EXPORTABLE *NXCPMessageCodeName(uint16_t code, TCHAR *buffer)
       _T("CMD_ENABLE_ANONYMOUS_ACCESS"),
       _T("CMD_ADD_WIRELESS_DOMAIN_CNTRL"),
       _T("CMD_PROGRESS_REPORT"),
-      _T("CMD_COMPILE_MIB_FILES")
+      _T("CMD_COMPILE_MIB_FILES"),
+      _T("CMD_EXECUTE_DASBOARD_SCRIPT"),
+      _T("CMD_UPDATE_PEER_INTERFACE"),
+      _T("CMD_CLEAR_PEER_INTERFACE"),
+      _T("CMD_GET_MULTIPLE_PARAMETERS")
    };
    static const TCHAR *reportingMessageNames[] =
    {
@@ -519,7 +523,7 @@ TCHAR LIBNETXMS_EXPORTABLE *NXCPMessageCodeName(uint16_t code, TCHAR *buffer)
       _T("CMD_RS_NOTIFY")
    };
 
-   if ((code >= CMD_LOGIN) && (code <= CMD_COMPILE_MIB_FILES))
+   if ((code >= CMD_LOGIN) && (code <= CMD_GET_MULTIPLE_PARAMETERS))
    {
       _tcscpy(buffer, messageNames[code - CMD_LOGIN]);
    }
@@ -25,6 +25,7 @@
 #include <nxqueue.h>
 #include <welford.h>
 #include <queue>
+#include <deque>
 
 #define DEBUG_TAG _T("threads.pool")
 
@@ -39,19 +40,20 @@ static uint32_t s_waitTimeLowWatermark = 50;
  */
 static int s_maintThreadResponsiveness = 12;
 
+/**
+ * Work stealing mode for new pools
+ */
+static bool s_workStealingMode = false;
+
 /**
  * Indicator for stop with deregistration
  */
 static char s_stopAndUnregister[] = "UNREGISTER";
 
 /**
- * Worker thread data
+ * Indicator for idle worker wakeup (new request placed into local queue of busy worker)
  */
-struct WorkerThreadInfo
-{
-   ThreadPool *pool;
-   THREAD handle;
-};
+static char s_stealHint[] = "STEAL";
 
 /**
  * Thread work request
@@ -64,6 +66,70 @@ struct WorkRequest
    int64_t runTime;
 };
 
+/**
+ * Local request queue of worker thread (used in work stealing mode). Queue objects are bound to pool slots
+ * and are not destroyed until pool is destroyed, so other workers can safely access them for stealing.
+ * Wait time statistics are cumulative and updated only by owning worker; maintenance thread merges them
+ * into pool statistics.
+ */
+struct WorkerQueue
+{
+   Mutex lock;
+   std::deque<WorkRequest*> requests;
+   VolatileCounter size;
+   bool active;
+   VolatileCounter64 waitTimeSum;
+   VolatileCounter64 waitTimeSquareSum;
+   VolatileCounter64 samples;
+   int64_t mergedWaitTimeSum;
+   int64_t mergedWaitTimeSquareSum;
+   int64_t mergedSamples;
+
+   WorkerQueue() : lock(MutexType::FAST)
+   {
+      size = 0;
+      active = false;
+      waitTimeSum = 0;
+      waitTimeSquareSum = 0;
+      samples = 0;
+      mergedWaitTimeSum = 0;
+      mergedWaitTimeSquareSum = 0;
+      mergedSamples = 0;
+   }
+};
+
+/**
+ * Worker thread data
+ */
+struct WorkerThreadInfo
+{
+   ThreadPool *pool;
+   THREAD handle;
+   WorkerQueue *localQueue;
+   int slot;
+};
+
+#if HAVE_THREAD_LOCAL_STORAGE
+
+/**
+ * Current worker thread (used to keep requests queued from worker on same worker)
+ */
+static thread_local WorkerThreadInfo *s_currentWorker = nullptr;
+
+#endif
+
+/**
+ * Number of shards for integer-keyed serialization queues
+ */
+#define SERIALIZATION_SHARDS  32
+
+/**
+ * Max number of idle serialization queues kept for reuse (per shard or string-keyed map)
+ */
+#define MAX_IDLE_SERIALIZATION_QUEUES  64
+
+struct SerializationShard;
+
 /**
  * Request queue for serialized execution
  */
@@ -73,11 +139,34 @@ class SerializationQueue: public Queue
    uint32_t m_maxWaitTime;
 
 public:
-   SerializationQueue() : Queue() { m_maxWaitTime = 0; }
-   SerializationQueue(size_t blockSize) : Queue(blockSize, Ownership::False) { m_maxWaitTime = 0; }
+   ThreadPool *pool;
+   SerializationShard *shard;
+   uint64_t key;
+
+   SerializationQueue() : Queue() { m_maxWaitTime = 0; pool = nullptr; shard = nullptr; key = 0; }
+   SerializationQueue(size_t blockSize) : Queue(blockSize, Ownership::False) { m_maxWaitTime = 0; pool = nullptr; shard = nullptr; key = 0; }
 
    uint32_t getMaxWaitTime() { return m_maxWaitTime; }
    void updateMaxWaitTime(uint32_t waitTime) { m_maxWaitTime = std::max(waitTime, m_maxWaitTime); }
+   void resetMaxWaitTime() { m_maxWaitTime = 0; }
+};
+
+/**
+ * Shard of integer-keyed serialization queues
+ */
+struct SerializationShard
+{
+   Mutex lock;
+   HashMap<uint64_t, SerializationQueue> queues;
+   std::vector<SerializationQueue*> idleQueues;
+
+   SerializationShard() : lock(MutexType::FAST), queues(Ownership::False) { }
+   ~SerializationShard()
+   {
+      queues.setOwner(Ownership::True);
+      for(SerializationQueue *q : idleQueues)
+         delete q;
+   }
 };
 
 /**
@@ -111,6 +200,8 @@ struct ThreadPool
    ObjectQueue<WorkRequest> queue;
    StringObjectMap<SerializationQueue> serializationQueues;
    Mutex serializationLock;
+   std::vector<SerializationQueue*> idleSerializationQueues;
+   SerializationShard serializationShards[SERIALIZATION_SHARDS];
    std::priority_queue<WorkRequest*, std::vector<WorkRequest*>, ScheduledRequestsComparator> schedulerQueue;
    Mutex schedulerLock;
    TCHAR *name;
@@ -124,6 +215,10 @@ struct ThreadPool
    uint64_t threadStopCount;
    VolatileCounter64 taskExecutionCount;
    SynchronizedObjectMemoryPool<WorkRequest> workRequestMemoryPool;
+   bool workStealing;
+   WorkerQueue **workerQueues;
+   VolatileCounter workerQueueCount;
+   VolatileCounter idleWorkers;
 
    ThreadPool(const TCHAR *name, int minThreads, int maxThreads, int stackSize) :
          mutex(MutexType::FAST), maintThreadWakeup(false), queue(64, Ownership::False), serializationQueues(Ownership::True),
@@ -143,11 +238,20 @@ struct ThreadPool
       threadStartCount = 0;
       threadStopCount = 0;
       taskExecutionCount = 0;
+      workStealing = s_workStealingMode;
+      workerQueues = workStealing ? MemAllocArray<WorkerQueue*>(this->maxThreads) : nullptr;
+      workerQueueCount = 0;
+      idleWorkers = 0;
    }
 
    ~ThreadPool()
    {
       threads.setOwner(Ownership::True);
+      for(SerializationQueue *q : idleSerializationQueues)
+         delete q;
+      for(int i = 0; i < workerQueueCount; i++)
+         delete workerQueues[i];
+      MemFree(workerQueues);
       MemFree(name);
    }
 };
@@ -158,6 +262,198 @@ struct ThreadPool
 static StringObjectMap<ThreadPool> s_registry(Ownership::False);
 static Mutex s_registryLock;
 
+/**
+ * Assign local queue to new worker thread. Pool mutex must be held by caller.
+ */
+static void AssignWorkerQueue(ThreadPool *p, WorkerThreadInfo *wt)
+{
+   wt->localQueue = nullptr;
+   wt->slot = -1;
+   if (!p->workStealing)
+      return;
+
+   for(int i = 0; i < p->workerQueueCount; i++)
+   {
+      if (!p->workerQueues[i]->active)
+      {
+         wt->slot = i;
+         break;
+      }
+   }
+   if (wt->slot == -1)
+   {
+      // Number of live threads never exceeds maxThreads, so free slot always exists
+      wt->slot = p->workerQueueCount;
+      p->workerQueues[wt->slot] = new WorkerQueue();
+      InterlockedIncrement(&p->workerQueueCount);
+   }
+   wt->localQueue = p->workerQueues[wt->slot];
+   wt->localQueue->active = true;
+}
+
+/**
+ * Release local queue of stopped or failed worker thread. Pool mutex must be held by caller.
+ */
+static inline void ReleaseWorkerQueue(WorkerThreadInfo *wt)
+{
+   if (wt->localQueue != nullptr)
+      wt->localQueue->active = false;
+}
+
+/**
+ * Create new worker thread. Pool mutex must be held by caller.
+ */
+static void WorkerThread(WorkerThreadInfo *threadInfo);
+static bool CreateWorkerThread(ThreadPool *p)
+{
+   WorkerThreadInfo *wt = new WorkerThreadInfo;
+   wt->pool = p;
+   AssignWorkerQueue(p, wt);
+   wt->handle = ThreadCreateEx(WorkerThread, wt, p->stackSize);
+   if (wt->handle == INVALID_THREAD_HANDLE)
+   {
+      ReleaseWorkerQueue(wt);
+      delete wt;
+      return false;
+   }
+   p->threads.set(CAST_FROM_POINTER(wt, uint64_t), wt);
+   return true;
+}
+
+/**
+ * Put request into queue. In work stealing mode requests queued from pool's own worker thread
+ * are placed into that worker's local queue.
+ */
+static void EnqueueRequest(ThreadPool *p, WorkRequest *rq)
+{
+#if HAVE_THREAD_LOCAL_STORAGE
+   WorkerThreadInfo *worker = s_currentWorker;
+   if ((worker != nullptr) && (worker->pool == p) && (worker->localQueue != nullptr))
+   {
+      WorkerQueue *q = worker->localQueue;
+      q->lock.lock();
+      q->requests.push_back(rq);
+      q->lock.unlock();
+      InterlockedIncrement(&q->size);
+
+      // Owner is busy executing current request, so wake up idle worker to pick up new one
+      if (p->idleWorkers > 0)
+      {
+         WorkRequest *hint = p->workRequestMemoryPool.create();
+         hint->func = nullptr;
+         hint->arg = s_stealHint;
+         p->queue.put(hint);
+      }
+      return;
+   }
+#endif
+   p->queue.put(rq);
+}
+
+/**
+ * Take request from worker's local queue
+ */
+static WorkRequest *PopLocalRequest(WorkerQueue *q)
+{
+   if (q->size == 0)
+      return nullptr;
+
+   WorkRequest *rq = nullptr;
+   q->lock.lock();
+   if (!q->requests.empty())
+   {
+      rq = q->requests.front();
+      q->requests.pop_front();
+      InterlockedDecrement(&q->size);
+   }
+   q->lock.unlock();
+   return rq;
+}
+
+/**
+ * Steal request from local queue of another worker
+ */
+static WorkRequest *StealRequest(ThreadPool *p, WorkerThreadInfo *self)
+{
+   int count = p->workerQueueCount;
+   for(int i = 1; i < count; i++)
+   {
+      WorkRequest *rq = PopLocalRequest(p->workerQueues[(self->slot + i) % count]);
+      if (rq != nullptr)
+         return rq;
+   }
+   return nullptr;
+}
+
+/**
+ * Get next request for worker in work stealing mode: own local queue first, then global queue,
+ * then local queues of other workers. Blocks if there are no requests anywhere.
+ */
+static WorkRequest *GetNextRequest(ThreadPool *p, WorkerThreadInfo *self)
+{
+   WorkRequest *rq = PopLocalRequest(self->localQueue);
+   if (rq != nullptr)
+      return rq;
+
+   rq = p->queue.get();
+   if (rq != nullptr)
+      return rq;
+
+   // Register as idle before last check so that request placed into
+   // local queue of another worker after that check will cause wakeup
+   InterlockedIncrement(&p->idleWorkers);
+   rq = StealRequest(p, self);
+   if (rq == nullptr)
+      rq = p->queue.getOrBlock(INFINITE);
+   InterlockedDecrement(&p->idleWorkers);
+   return rq;
+}
+
+/**
+ * Merge per-worker wait time statistics into pool statistics. Pool mutex must be held by caller.
+ */
+static void MergeWorkerStatistics(ThreadPool *p)
+{
+   int count = p->workerQueueCount;
+   for(int i = 0; i < count; i++)
+   {
+      WorkerQueue *q = p->workerQueues[i];
+      int64_t samples = q->samples;
+      int64_t n = samples - q->mergedSamples;
+      if (n <= 0)
+         continue;
+
+      int64_t sum = q->waitTimeSum;
+      int64_t squareSum = q->waitTimeSquareSum;
+      double s1 = static_cast<double>(sum - q->mergedWaitTimeSum);
+      double s2 = static_cast<double>(squareSum - q->mergedWaitTimeSquareSum);
+      q->mergedSamples = samples;
+      q->mergedWaitTimeSum = sum;
+      q->mergedWaitTimeSquareSum = squareSum;
+
+      double mean = s1 / n;
+      p->waitTimeVariance.merge(n, mean, std::max(s2 - s1 * mean, 0.0));
+
+      // Individual wait times are not available here, so moving average (over last 1000 executions, as in
+      // non-stealing mode) is updated as if each of n requests waited for interval mean time. Applying n
+      // updates with same value v gives ema * d^n + v * (1 - d^n), where d is per-request decay factor.
+      double decay = pow(static_cast<double>(EMA_EXP(1, 1000)) / EMA_FP_1, static_cast<double>(n));
+      p->waitTimeEMA = static_cast<int64_t>(static_cast<double>(p->waitTimeEMA) * decay + mean * EMA_FP_1 * (1.0 - decay));
+   }
+}
+
+/**
+ * Get total number of queued requests
+ */
+static int64_t GetQueueSize(ThreadPool *p)
+{
+   int64_t size = static_cast<int64_t>(p->queue.size());
+   int count = p->workerQueueCount;
+   for(int i = 0; i < count; i++)
+      size += p->workerQueues[i]->size;
+   return size;
+}
+
 /**
  * Worker function to join stopped thread
  */
@@ -185,16 +481,27 @@ static void WorkerThread(WorkerThreadInfo *threadInfo)
    strlcat(threadName, "/WRK", 16);
    ThreadSetName(threadName);
 
+#if HAVE_THREAD_LOCAL_STORAGE
+   s_currentWorker = threadInfo;
+#endif
+
    while(true)
    {
-      WorkRequest *rq = p->queue.getOrBlock(INFINITE);
+      WorkRequest *rq = (threadInfo->localQueue != nullptr) ? GetNextRequest(p, threadInfo) : p->queue.getOrBlock(INFINITE);
       if (rq->func == nullptr) // stop indicator
       {
+         if (rq->arg == s_stealHint)
+         {
+            p->workRequestMemoryPool.destroy(rq);
+            continue;
+         }
+
          if (rq->arg == s_stopAndUnregister)
          {
             p->mutex.lock();
             p->threads.remove(CAST_FROM_POINTER(threadInfo, uint64_t));
             p->threadStopCount++;
+            ReleaseWorkerQueue(threadInfo);
             p->mutex.unlock();
 
             rq->func = JoinWorkerThread;
@@ -207,10 +514,20 @@ static void WorkerThread(WorkerThreadInfo *threadInfo)
       }
 
       int64_t waitTime = GetCurrentTimeMs() - rq->queueTime;
-      p->mutex.lock();
-      UpdateExpMovingAverage(p->waitTimeEMA, EMA_EXP(1, 1000), waitTime); // Use last 1000 executions
-      p->waitTimeVariance.update(waitTime);
-      p->mutex.unlock();
+      if (threadInfo->localQueue != nullptr)
+      {
+         WorkerQueue *q = threadInfo->localQueue;
+         InterlockedAdd64(&q->waitTimeSum, waitTime);
+         InterlockedAdd64(&q->waitTimeSquareSum, waitTime * waitTime);
+         InterlockedIncrement64(&q->samples);
+      }
+      else
+      {
+         p->mutex.lock();
+         UpdateExpMovingAverage(p->waitTimeEMA, EMA_EXP(1, 1000), waitTime); // Use last 1000 executions
+         p->waitTimeVariance.update(waitTime);
+         p->mutex.unlock();
+      }
 
       rq->func(rq->arg);
       p->workRequestMemoryPool.destroy(rq);
@@ -245,6 +562,13 @@ static void MaintenanceThread(ThreadPool *p)
       p->maintThreadWakeup.wait(sleepTime);
       cycleTime += static_cast<uint32_t>(GetCurrentTimeMs() - startTime);
 
+      if (p->workStealing)
+      {
+         p->mutex.lock();
+         MergeWorkerStatistics(p);
+         p->mutex.unlock();
+      }
+
       // Update load data every 5 seconds
       if (cycleTime >= 5000)
       {
@@ -255,7 +579,7 @@ static void MaintenanceThread(ThreadPool *p)
          UpdateExpMovingAverage(p->loadAverage[1], EMA_EXP_60, requestCount);
          UpdateExpMovingAverage(p->loadAverage[2], EMA_EXP_180, requestCount);
 
-         int64_t queueSize = static_cast<int64_t>(p->queue.size());
+         int64_t queueSize = GetQueueSize(p);
          UpdateExpMovingAverage(p->queueSizeEMA, EMA_EXP_180, queueSize);
          p->queueSizeVariance.update(queueSize);
 
@@ -278,18 +602,13 @@ static void MaintenanceThread(ThreadPool *p)
                int delta = std::min(p->maxThreads - threadCount, std::max(std::min(queueSizeSMA, queueSizeEMA) / 2, 1));
                for(int i = 0; i < delta; i++)
                {
-                  WorkerThreadInfo *wt = new WorkerThreadInfo;
-                  wt->pool = p;
-                  wt->handle = ThreadCreateEx(WorkerThread, wt, p->stackSize);
-                  if (wt->handle != INVALID_THREAD_HANDLE)
+                  if (CreateWorkerThread(p))
                   {
-                     p->threads.set(CAST_FROM_POINTER(wt, uint64_t), wt);
                      p->threadStartCount++;
                      started++;
                   }
                   else
                   {
-                     delete wt;
                      failure = true;
                      break;
                   }
@@ -357,7 +676,7 @@ static void MaintenanceThread(ThreadPool *p)
             InterlockedIncrement(&p->activeRequests);
             InterlockedIncrement64(&p->taskExecutionCount);
             rq->queueTime = now;
-            p->queue.put(rq);
+            EnqueueRequest(p, rq);
             p->schedulerQueue.pop();
          }
       }
@@ -377,18 +696,8 @@ ThreadPool LIBNETXMS_EXPORTABLE *ThreadPoolCreate(const TCHAR *name, int minThre
    p->mutex.lock();
    for(int i = 0; i < p->minThreads; i++)
    {
-      WorkerThreadInfo *wt = new WorkerThreadInfo;
-      wt->pool = p;
-      wt->handle = ThreadCreateEx(WorkerThread, wt, stackSize);
-      if (wt->handle != INVALID_THREAD_HANDLE)
-      {
-         p->threads.set(CAST_FROM_POINTER(wt, uint64_t), wt);
-      }
-      else
-      {
+      if (!CreateWorkerThread(p))
          nxlog_debug_tag(DEBUG_TAG, 1, _T("Cannot create worker thread in pool %s"), p->name);
-         delete wt;
-      }
    }
    p->mutex.unlock();
 
@@ -396,7 +705,7 @@ ThreadPool LIBNETXMS_EXPORTABLE *ThreadPoolCreate(const TCHAR *name, int minThre
    s_registry.set(p->name, p);
    s_registryLock.unlock();
 
-   nxlog_debug_tag(DEBUG_TAG, 1, _T("Thread pool %s initialized (min=%d, max=%d)"), p->name, p->minThreads, p->maxThreads);
+   nxlog_debug_tag(DEBUG_TAG, 1, _T("Thread pool %s initialized (min=%d, max=%d%s)"), p->name, p->minThreads, p->maxThreads, p->workStealing ? _T(", work stealing") : _T(""));
    return p;
 }
 
@@ -457,7 +766,7 @@ void LIBNETXMS_EXPORTABLE ThreadPoolExecute(ThreadPool *p, ThreadPoolWorkerFunct
    rq->func = f;
    rq->arg = arg;
    rq->queueTime = GetCurrentTimeMs();
-   p->queue.put(rq);
+   EnqueueRequest(p, rq);
 }
 
 /**
@@ -488,7 +797,16 @@ static void ProcessSerializedRequests(RequestSerializationData *data)
          rq = static_cast<WorkRequest*>(data->queue->get());
          if (rq == nullptr)
          {
-            data->pool->serializationQueues.remove(data->key);
+            data->pool->serializationQueues.unlink(data->key);
+            if (data->pool->idleSerializationQueues.size() < MAX_IDLE_SERIALIZATION_QUEUES)
+            {
+               data->queue->resetMaxWaitTime();
+               data->pool->idleSerializationQueues.push_back(data->queue);
+            }
+            else
+            {
+               delete data->queue;
+            }
             data->pool->serializationLock.unlock();
             break;
          }
@@ -519,7 +837,15 @@ void LIBNETXMS_EXPORTABLE ThreadPoolExecuteSerialized(ThreadPool *p, const TCHAR
    SerializationQueue *q = p->serializationQueues.get(key);
    if (q == nullptr)
    {
-      q = new SerializationQueue(64);
+      if (!p->idleSerializationQueues.empty())
+      {
+         q = p->idleSerializationQueues.back();
+         p->idleSerializationQueues.pop_back();
+      }
+      else
+      {
+         q = new SerializationQueue(64);
+      }
       p->serializationQueues.set(key, q);
       q->put(rq);
 
@@ -538,6 +864,97 @@ void LIBNETXMS_EXPORTABLE ThreadPoolExecuteSerialized(ThreadPool *p, const TCHAR
    p->serializationLock.unlock();
 }
 
+/**
+ * Get shard for given integer serialization key
+ */
+static inline SerializationShard *GetSerializationShard(ThreadPool *p, uint64_t key)
+{
+   return &p->serializationShards[(key * _ULL(0x9E3779B97F4A7C15)) >> 59];
+}
+
+/**
+ * Worker function to process serialized requests with integer key
+ */
+static void ProcessIntegerKeySerializedRequests(SerializationQueue *queue)
+{
+   ThreadPool *p = queue->pool;
+   SerializationShard *shard = queue->shard;
+   while(true)
+   {
+      WorkRequest *rq = static_cast<WorkRequest*>(queue->get());
+      if (rq == nullptr)
+      {
+         // Re-check with shard lock being held (see comment in ProcessSerializedRequests)
+         shard->lock.lock();
+         rq = static_cast<WorkRequest*>(queue->get());
+         if (rq == nullptr)
+         {
+            shard->queues.remove(queue->key);
+            if (shard->idleQueues.size() < MAX_IDLE_SERIALIZATION_QUEUES)
+            {
+               queue->resetMaxWaitTime();
+               shard->idleQueues.push_back(queue);
+            }
+            else
+            {
+               delete queue;
+            }
+            shard->lock.unlock();
+            break;
+         }
+         shard->lock.unlock();
+      }
+      queue->updateMaxWaitTime(static_cast<uint32_t>(GetCurrentTimeMs() - rq->queueTime));
+
+      rq->func(rq->arg);
+      p->workRequestMemoryPool.destroy(rq);
+   }
+}
+
+/**
+ * Execute task serialized (not before previous task with same key ends). This variant uses integer
+ * key (usually object ID) and sharded queue map, so it is cheaper than string-keyed one for frequent calls.
+ * Integer and string keys are independent (tasks with string key "1" and integer key 1 are not serialized).
+ */
+void LIBNETXMS_EXPORTABLE ThreadPoolExecuteSerialized(ThreadPool *p, uint64_t key, ThreadPoolWorkerFunction f, void *arg)
+{
+   if (p->shutdownMode)
+      return;
+
+   WorkRequest *rq = p->workRequestMemoryPool.create();
+   rq->func = f;
+   rq->arg = arg;
+   rq->queueTime = GetCurrentTimeMs();
+
+   SerializationShard *shard = GetSerializationShard(p, key);
+   shard->lock.lock();
+   SerializationQueue *q = shard->queues.get(key);
+   if (q == nullptr)
+   {
+      if (!shard->idleQueues.empty())
+      {
+         q = shard->idleQueues.back();
+         shard->idleQueues.pop_back();
+      }
+      else
+      {
+         q = new SerializationQueue(64);
+         q->pool = p;
+         q->shard = shard;
+      }
+      q->key = key;
+      shard->queues.set(key, q);
+      q->put(rq);
+      ThreadPoolExecute(p, ProcessIntegerKeySerializedRequests, q);
+   }
+   else
+   {
+      q->put(rq);
+      InterlockedIncrement64(&p->taskExecutionCount);
+   }
+   shard->lock.unlock();
+}
+
 /**
  * Schedule task for execution using absolute time (in milliseconds)
  */
@@ -614,6 +1031,19 @@ void LIBNETXMS_EXPORTABLE ThreadPoolGetInfo(ThreadPool *p, ThreadPoolInfo *info)
    while(it.hasNext())
       info->serializedRequests += static_cast<int>(it.next()->value->size());
    p->serializationLock.unlock();
+
+   for(int i = 0; i < SERIALIZATION_SHARDS; i++)
+   {
+      SerializationShard *shard = &p->serializationShards[i];
+      shard->lock.lock();
+      shard->queues.forEach(
+         [info] (const uint64_t& key, SerializationQueue *queue) -> EnumerationCallbackResult
+         {
+            info->serializedRequests += static_cast<int>(queue->size());
+            return _CONTINUE;
+         });
+      shard->lock.unlock();
+   }
 }
 
 /**
@@ -675,6 +1105,32 @@ uint32_t LIBNETXMS_EXPORTABLE ThreadPoolGetSerializedRequestMaxWaitTime(ThreadPo
    return waitTime;
 }
 
+/**
+ * Get number of queued jobs on the pool by integer key
+ */
+int LIBNETXMS_EXPORTABLE ThreadPoolGetSerializedRequestCount(ThreadPool *p, uint64_t key)
+{
+   SerializationShard *shard = GetSerializationShard(p, key);
+   shard->lock.lock();
+   SerializationQueue *q = shard->queues.get(key);
+   int count = (q != nullptr) ? static_cast<int>(q->size()) : 0;
+   shard->lock.unlock();
+   return count;
+}
+
+/**
+ * Get max wait time for jobs on the pool by integer key
+ */
+uint32_t LIBNETXMS_EXPORTABLE ThreadPoolGetSerializedRequestMaxWaitTime(ThreadPool *p, uint64_t key)
+{
+   SerializationShard *shard = GetSerializationShard(p, key);
+   shard->lock.lock();
+   SerializationQueue *q = shard->queues.get(key);
+   uint32_t waitTime = (q != nullptr) ? q->getMaxWaitTime() : 0;
+   shard->lock.unlock();
+   return waitTime;
+}
+
 /**
  * Set thread pool resize parameters - responsiveness and wait time high/low watermarks
  */
@@ -687,3 +1143,13 @@ void LIBNETXMS_EXPORTABLE ThreadPoolSetResizeParameters(int responsiveness, uint
    if (waitTimeLWM > 0)
       s_waitTimeLowWatermark = waitTimeLWM;
 }
+
+/**
+ * Enable or disable work stealing mode for thread pools created after this call. In work stealing mode
+ * each worker thread has own local queue, requests submitted from pool's worker thread are placed into
+ * that worker's local queue, and idle workers take requests from global queue or steal them from other workers.
+ */
+void LIBNETXMS_EXPORTABLE ThreadPoolSetWorkStealingMode(bool enable)
+{
+   s_workStealingMode = enable;
+}
@@ -29,6 +29,7 @@
 #include <nxcpapi.h>
 #include <nxsl.h>
 #include <nxqueue.h>
+#include <netxms-regex.h>
 
 union YYSTYPE;
 typedef void *yyscan_t;
@@ -433,6 +434,36 @@ enum ConverterTokens
    T_V4_ASSIGN_CONCAT = 30004
 };
 
+/**
+ * Compiled regular expression shared via regular expression cache
+ */
+class NXSL_CompiledRegex
+{
+private:
+   PCRE *m_preg;
+   PCRE_STUDY_DATA *m_extra;
+
+public:
+   NXSL_CompiledRegex(PCRE *preg, PCRE_STUDY_DATA *extra)
+   {
+      m_preg = preg;
+      m_extra = extra;
+   }
+   ~NXSL_CompiledRegex();
+
+   int exec(const TCHAR *subject, size_t length, int *pmatch, int size) const
+   {
+      return _pcre_exec_t(m_preg, m_extra, reinterpret_cast<const PCRE_TCHAR*>(subject), static_cast<int>(length), 0, 0, pmatch, size);
+   }
+};
+
+/**
+ * Regular expression cache functions
+ */
+shared_ptr<NXSL_CompiledRegex> GetCompiledRegex(const TCHAR *pattern, bool ignoreCase);
+void PinCompiledRegex(const TCHAR *pattern, bool ignoreCase);
+void UnpinCompiledRegex(const TCHAR *pattern, bool ignoreCase);
+
 //
 // Global variables
 //
@@ -711,6 +711,7 @@ uint64_t NXSL_ProgramBuilder::getMemoryUsage() const
 NXSL_Program::NXSL_Program(size_t valueRegionSize, size_t identifierRegionSize) : NXSL_ValueManager(valueRegionSize, identifierRegionSize),
          m_instructionSet(0, 256), m_requiredModules(0, 16), m_constants(this, Ownership::True), m_functions(0, 64)
 {
+   m_regexLiteralsPinned = false;
 }
 
 /**
@@ -738,6 +739,8 @@ NXSL_Program::NXSL_Program(NXSL_ProgramBuilder *builder) :
    for(int i = 0; i < builder->m_instructionSet.size(); i++)
       m_instructionSet.addPlaceholder()->copyFrom(builder->m_instructionSet.get(i), this);
    builder->m_constants.forEach(CopyConstantsCallback, &m_constants);
+   m_regexLiteralsPinned = false;
+   pinRegexLiterals(true);
 }
 
 /**
@@ -745,10 +748,38 @@ NXSL_Program::NXSL_Program(NXSL_ProgramBuilder *builder) :
  */
 NXSL_Program::~NXSL_Program()
 {
+   pinRegexLiterals(false);
    for(int i = 0; i < m_instructionSet.size(); i++)
       m_instructionSet.get(i)->dispose(this);
 }
 
+/**
+ * Pin (or unpin) compiled regular expressions for string literals used as right operand of match operators,
+ * so they are compiled once on program load and never evicted from regular expression cache while program exists
+ */
+void NXSL_Program::pinRegexLiterals(bool pin)
+{
+   if (m_regexLiteralsPinned == pin)
+      return;
+
+   for(int i = 0; i < m_instructionSet.size() - 1; i++)
+   {
+      NXSL_Instruction *instr = m_instructionSet.get(i);
+      if ((instr->m_opCode != OPCODE_PUSH_CONSTANT) || !instr->m_operand.m_constant->isString())
+         continue;
+
+      int16_t opcode = m_instructionSet.get(i + 1)->m_opCode;
+      if ((opcode == OPCODE_MATCH) || (opcode == OPCODE_IMATCH))
+      {
+         if (pin)
+            PinCompiledRegex(instr->m_operand.m_constant->getValueAsCString(), opcode == OPCODE_IMATCH);
+         else
+            UnpinCompiledRegex(instr->m_operand.m_constant->getValueAsCString(), opcode == OPCODE_IMATCH);
+      }
+   }
+   m_regexLiteralsPinned = pin;
+}
+
 /**
  * Check if this program is empty
  */
@@ -1059,6 +1090,7 @@ NXSL_Program *NXSL_Program::load(ByteStream& s, TCHAR *errMsg, size_t errMsgSize
    for(int i = 0; i < constants.size(); i++)
       p->destroyValue(constants.get(i));
 
+   p->pinRegexLiterals(true);
    return p;
 
 failure:
@@ -0,0 +1,262 @@
+/*
+** NetXMS - Network Management System
+** NetXMS Scripting Language Interpreter
+** Copyright (C) 2003-2024 Victor Kirhenshtein
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as published by
+** the Free Software Foundation; either version 3 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** File: regex.cpp
+**/
+
+#include "libnxsl.h"
+
+/**
+ * Maximum number of compiled regular expressions kept in cache (pinned entries are not counted)
+ */
+#define REGEX_CACHE_CAPACITY  1024
+
+/**
+ * Regular expression cache entry
+ */
+struct RegexCacheEntry
+{
+   RegexCacheEntry *prev;
+   RegexCacheEntry *next;
+   TCHAR *pattern;
+   shared_ptr<NXSL_CompiledRegex> regex;
+   int pinCount;
+   bool ignoreCase;
+
+   RegexCacheEntry(const TCHAR *_pattern, bool _ignoreCase, const shared_ptr<NXSL_CompiledRegex>& _regex) : regex(_regex)
+   {
+      prev = nullptr;
+      next = nullptr;
+      pattern = MemCopyString(_pattern);
+      pinCount = 0;
+      ignoreCase = _ignoreCase;
+   }
+
+   ~RegexCacheEntry()
+   {
+      MemFree(pattern);
+   }
+};
+
+/**
+ * Cache data. Separate maps are used for case sensitive and case insensitive patterns.
+ * Entries are also linked into LRU list (most recently used entry at the head).
+ */
+static StringObjectMap<RegexCacheEntry> s_cache[2] = { StringObjectMap<RegexCacheEntry>(Ownership::True), StringObjectMap<RegexCacheEntry>(Ownership::True) };
+static RegexCacheEntry *s_lruHead = nullptr;
+static RegexCacheEntry *s_lruTail = nullptr;
+static Mutex s_cacheLock(MutexType::FAST);
+static int s_pinnedEntries = 0;
+static uint64_t s_hits = 0;
+static uint64_t s_misses = 0;
+static uint64_t s_evictions = 0;
+static uint64_t s_compilationErrors = 0;
+
+/**
+ * Compiled regular expression destructor
+ */
+NXSL_CompiledRegex::~NXSL_CompiledRegex()
+{
+   if (m_extra != nullptr)
+   {
+#ifdef PCRE_STUDY_JIT_COMPILE
+      _pcre_free_study_t(m_extra);
+#else
+      _pcre_free_t(m_extra);
+#endif
+   }
+   _pcre_free_t(m_preg);
+}
+
+/**
+ * Compile regular expression. Pattern is studied (and JIT compiled if supported by PCRE library).
+ */
+static shared_ptr<NXSL_CompiledRegex> CompileRegex(const TCHAR *pattern, bool ignoreCase)
+{
+   const char *eptr;
+   int eoffset;
+   PCRE *preg = _pcre_compile_t(reinterpret_cast<const PCRE_TCHAR*>(pattern), ignoreCase ? PCRE_COMMON_FLAGS | PCRE_CASELESS : PCRE_COMMON_FLAGS, &eptr, &eoffset, nullptr);
+   if (preg == nullptr)
+      return shared_ptr<NXSL_CompiledRegex>();
+
+#ifdef PCRE_STUDY_JIT_COMPILE
+   PCRE_STUDY_DATA *extra = _pcre_study_t(preg, PCRE_STUDY_JIT_COMPILE, &eptr);
+#else
+   PCRE_STUDY_DATA *extra = _pcre_study_t(preg, 0, &eptr);
+#endif
+   return make_shared<NXSL_CompiledRegex>(preg, extra);
+}
+
+/**
+ * Unlink entry from LRU list
+ */
+static inline void UnlinkEntry(RegexCacheEntry *e)
+{
+   if (e->prev != nullptr)
+      e->prev->next = e->next;
+   else
+      s_lruHead = e->next;
+   if (e->next != nullptr)
+      e->next->prev = e->prev;
+   else
+      s_lruTail = e->prev;
+   e->prev = nullptr;
+   e->next = nullptr;
+}
+
+/**
+ * Link entry at the head of LRU list
+ */
+static inline void LinkEntry(RegexCacheEntry *e)
+{
+   e->prev = nullptr;
+   e->next = s_lruHead;
+   if (s_lruHead != nullptr)
+      s_lruHead->prev = e;
+   else
+      s_lruTail = e;
+   s_lruHead = e;
+}
+
+/**
+ * Evict least recently used unpinned entries while cache is above capacity. Cache lock must be held by caller.
+ * Regular expressions still referenced by running VMs will be destroyed when last reference is released.
+ */
+static void EvictEntries()
+{
+   RegexCacheEntry *e = s_lruTail;
+   while((e != nullptr) && (s_cache[0].size() + s_cache[1].size() - s_pinnedEntries > REGEX_CACHE_CAPACITY))
+   {
+      RegexCacheEntry *prev = e->prev;
+      if (e->pinCount == 0)
+      {
+         UnlinkEntry(e);
+         s_cache[e->ignoreCase ? 1 : 0].remove(e->pattern);
+         s_evictions++;
+      }
+      e = prev;
+   }
+}
+
+/**
+ * Find or compile regular expression and optionally pin it in cache
+ */
+static shared_ptr<NXSL_CompiledRegex> AcquireRegex(const TCHAR *pattern, bool ignoreCase, bool pin)
+{
+   StringObjectMap<RegexCacheEntry> *cache = &s_cache[ignoreCase ? 1 : 0];
+
+   s_cacheLock.lock();
+   RegexCacheEntry *e = cache->get(pattern);
+   if (e != nullptr)
+   {
+      UnlinkEntry(e);
+      LinkEntry(e);
+      if (pin && (e->pinCount++ == 0))
+         s_pinnedEntries++;
+      if (!pin)
+         s_hits++;
+      shared_ptr<NXSL_CompiledRegex> regex = e->regex;
+      s_cacheLock.unlock();
+      return regex;
+   }
+   s_misses++;
+   s_cacheLock.unlock();
+
+   // Compile outside the lock - other threads may use cache meanwhile
+   shared_ptr<NXSL_CompiledRegex> regex = CompileRegex(pattern, ignoreCase);
+
+   s_cacheLock.lock();
+   if (regex != nullptr)
+   {
+      e = cache->get(pattern);
+      if (e != nullptr)
+      {
+         // Same pattern was compiled concurrently by another thread
+         UnlinkEntry(e);
+         regex = e->regex;
+      }
+      else
+      {
+         e = new RegexCacheEntry(pattern, ignoreCase, regex);
+         cache->set(e->pattern, e);
+      }
+      LinkEntry(e);
+      if (pin && (e->pinCount++ == 0))
+         s_pinnedEntries++;
+      EvictEntries();
+   }
+   else
+   {
+      s_compilationErrors++;
+   }
+   s_cacheLock.unlock();
+   return regex;
+}
+
+/**
+ * Get compiled regular expression from cache (will compile it and add to cache if needed).
+ * Returns null pointer if pattern cannot be compiled.
+ */
+shared_ptr<NXSL_CompiledRegex> GetCompiledRegex(const TCHAR *pattern, bool ignoreCase)
+{
+   return AcquireRegex(pattern, ignoreCase, false);
+}
+
+/**
+ * Compile regular expression and pin it in cache so it will not be evicted until unpinned.
+ * Used for regular expression literals when program is loaded.
+ */
+void PinCompiledRegex(const TCHAR *pattern, bool ignoreCase)
+{
+   AcquireRegex(pattern, ignoreCase, true);
+}
+
+/**
+ * Unpin regular expression previously pinned by PinCompiledRegex
+ */
+void UnpinCompiledRegex(const TCHAR *pattern, bool ignoreCase)
+{
+   s_cacheLock.lock();
+   RegexCacheEntry *e = s_cache[ignoreCase ? 1 : 0].get(pattern);
+   if ((e != nullptr) && (e->pinCount > 0))
+   {
+      if (--e->pinCount == 0)
+      {
+         s_pinnedEntries--;
+         EvictEntries();
+      }
+   }
+   s_cacheLock.unlock();
+}
+
+/**
+ * Get regular expression cache statistics
+ */
+void LIBNXSL_EXPORTABLE NXSLGetRegexCacheStats(NXSL_RegexCacheStats *stats)
+{
+   s_cacheLock.lock();
+   stats->hits = s_hits;
+   stats->misses = s_misses;
+   stats->evictions = s_evictions;
+   stats->compilationErrors = s_compilationErrors;
+   stats->size = static_cast<uint32_t>(s_cache[0].size() + s_cache[1].size());
+   stats->pinned = static_cast<uint32_t>(s_pinnedEntries);
+   stats->capacity = REGEX_CACHE_CAPACITY;
+   s_cacheLock.unlock();
+}
@@ -3155,16 +3155,13 @@ NXSL_Value *NXSL_VM::matchRegexp(NXSL_Value *value, NXSL_Value *regexp, bool ign
 {
    NXSL_Value *result;
 
-   const TCHAR *re = regexp->getValueAsCString();
-   const char *eptr;
-   int eoffset;
-	PCRE *preg = _pcre_compile_t(reinterpret_cast<const PCRE_TCHAR*>(re), ignoreCase ? PCRE_COMMON_FLAGS | PCRE_CASELESS : PCRE_COMMON_FLAGS, &eptr, &eoffset, nullptr);
+   shared_ptr<NXSL_CompiledRegex> preg = GetCompiledRegex(regexp->getValueAsCString(), ignoreCase);
    if (preg != nullptr)
    {
       int pmatch[MAX_REGEXP_CGROUPS * 3];
       uint32_t valueLen;
 		const TCHAR *v = value->getValueAsString(&valueLen);
-		int cgcount = _pcre_exec_t(preg, nullptr, reinterpret_cast<const PCRE_TCHAR*>(v), valueLen, 0, 0, pmatch, MAX_REGEXP_CGROUPS * 3);
+		int cgcount = preg->exec(v, valueLen, pmatch, MAX_REGEXP_CGROUPS * 3);
       if (cgcount >= 0)
       {
          if (cgcount == 0)
@@ -3202,7 +3199,6 @@ NXSL_Value *NXSL_VM::matchRegexp(NXSL_Value *value, NXSL_Value *regexp, bool ign
       {
          result = createValue(false);  // No match
       }
-      _pcre_free_t(preg);
    }
    else
    {
@@ -28,7 +28,7 @@
 #define DEBUG_TAG _T("ad")
 
 /**
- * Helper function to read last N values of given DCI
+ * Helper function to read values of given DCI within given time ranges. Returns nullptr on database failure.
  */
 static unique_ptr<StructArray<ScoredDciValue>> LoadDciValues(uint32_t nodeId, uint32_t dciId, DCObjectStorageClass storageClass, const std::pair<time_t, time_t> *timeRanges, int numTimeRanges)
 {
@@ -55,13 +55,15 @@ static unique_ptr<StructArray<ScoredDciValue>> LoadDciValues(uint32_t nodeId, ui
    query.append(_T(" ORDER BY idata_timestamp DESC"));
 
    StructArray<ScoredDciValue> *values = new StructArray<ScoredDciValue>(0, 1024);
+   bool success = false;
 
    DB_HANDLE hdb = DBConnectionPoolAcquireConnection();
    DB_STATEMENT hStmt = DBPrepare(hdb, query, numTimeRanges > 1);
    if (hStmt != nullptr)
    {
+      success = true;
       DBBind(hStmt, 1, DB_SQLTYPE_INTEGER, dciId);
-      for(int n = 0; n < numTimeRanges; n++)
+      for(int n = 0; (n < numTimeRanges) && success; n++)
       {
          DBBind(hStmt, 2, DB_SQLTYPE_INTEGER, static_cast<int32_t>(timeRanges[n].first));
          DBBind(hStmt, 3, DB_SQLTYPE_INTEGER, static_cast<int32_t>(timeRanges[n].second));
@@ -78,11 +80,21 @@ static unique_ptr<StructArray<ScoredDciValue>> LoadDciValues(uint32_t nodeId, ui
             }
             DBFreeResult(hResult);
          }
+         else
+         {
+            success = false;
+         }
       }
       DBFreeStatement(hStmt);
    }
 
    DBConnectionPoolReleaseConnection(hdb);
+
+   if (!success)
+   {
+      delete values;
+      return unique_ptr<StructArray<ScoredDciValue>>();
+   }
    return unique_ptr<StructArray<ScoredDciValue>>(values);
 }
 
@@ -140,70 +152,244 @@ unique_ptr<StructArray<ScoredDciValue>> DetectAnomalies(const DataCollectionTarg
 }
 
 /**
- * Check if given value is an anomaly
- * Period is number of days, depth is number of periods to look into, width is time interval around current time in minutes
+ * Cached anomaly detection model for single DCI and period
  */
-bool IsAnomalousValue(const DataCollectionTarget& dcTarget, const DCObject& dci, double value, double threshold, int period, int depth, int width)
+struct AnomalyModel
 {
-   if (depth > 90)
-      depth = 90;
+   Mutex mutex;
+   shared_ptr<isotree::IsolationForest> model;
+   StructArray<ScoredDciValue> history;   // Training data (accessed only by training task)
+   std::pair<time_t, time_t> timeRanges[90];  // Time ranges covered by training data
+   uint32_t nodeId;
+   uint32_t dciId;
+   DCObjectStorageClass storageClass;
+   int period;
+   int depth;
+   int width;
+   time_t trainingTime;
+   time_t lastAccessTime;
+   bool trainingPending;
 
-   // Construct time ranges for daily periods
-   time_t now = time(nullptr);
+   AnomalyModel(uint32_t _nodeId, uint32_t _dciId, DCObjectStorageClass _storageClass, int _period, int _depth, int _width) : mutex(MutexType::FAST), history(0, 1024)
+   {
+      nodeId = _nodeId;
+      dciId = _dciId;
+      storageClass = _storageClass;
+      period = _period;
+      depth = _depth;
+      width = _width;
+      memset(timeRanges, 0, sizeof(timeRanges));
+      trainingTime = 0;
+      lastAccessTime = 0;
+      trainingPending = false;
+   }
+};
+
+/**
+ * Model cache key
+ */
+struct ModelKey
+{
+   uint32_t dciId;
+   int32_t period;
+   int32_t depth;
+   int32_t width;
+
+   ModelKey(uint32_t _dciId, int _period, int _depth, int _width)
+   {
+      dciId = _dciId;
+      period = _period;
+      depth = _depth;
+      width = _width;
+   }
+};
+
+/**
+ * Model cache
+ */
+static SharedHashMap<ModelKey, AnomalyModel> s_models;
+static Mutex s_modelsLock(MutexType::FAST);
+static time_t s_lastModelCleanup = 0;
+
+/**
+ * Models not used for this time (in seconds) are removed from cache
+ */
+#define MODEL_EXPIRATION_TIME    86400
+
+/**
+ * Calculate time ranges for given period, depth, and width (in minutes) relative to given time
+ */
+static void CalculateTimeRanges(time_t now, int period, int depth, int width, std::pair<time_t, time_t> *timeRanges)
+{
    time_t t = now - width * 30;  // Half-interval in minutes to seconds
-   std::pair<time_t, time_t> timeRanges[90]; // up to 90 days back
    for(int i = 0; i < depth; i++)
    {
       t -= 86400 * period;
       timeRanges[i].first = t;
       timeRanges[i].second = t + width * 60;
    }
+}
 
-   auto series = LoadDciValues(dcTarget.getId(), dci.getId(), dci.getStorageClass(), timeRanges, depth);
-   if (series == nullptr)
+/**
+ * Handle failed attempt to load training data. Covered time ranges and existing model are kept, so missing data
+ * will be loaded on next attempt (after refresh interval).
+ */
+static void FailModelTraining(const shared_ptr<AnomalyModel>& model, time_t now)
+{
+   nxlog_debug_tag(DEBUG_TAG, 5, _T("TrainModel(%u [p=%d d=%d w=%d]): cannot load training data from database"), model->dciId, model->period, model->depth, model->width);
+   model->mutex.lock();
+   model->trainingTime = now;
+   model->trainingPending = false;
+   model->mutex.unlock();
+}
+
+/**
+ * Train anomaly detection model. Only data outside time ranges covered by previous training is read from database.
+ */
+static void TrainModel(const shared_ptr<AnomalyModel>& model)
+{
+   time_t now = time(nullptr);
+   std::pair<time_t, time_t> timeRanges[90];
+   CalculateTimeRanges(now, model->period, model->depth, model->width, timeRanges);
+
+   time_t shift = timeRanges[0].first - model->timeRanges[0].first;
+   if ((model->trainingTime != 0) && (shift >= 0) && (shift < model->width * 60))
    {
-      nxlog_debug_tag(DEBUG_TAG, 5, _T("IsAnomalousValue(%s [%u], \"%s\"): cannot load DCI data"), dcTarget.getName(), dcTarget.getId(), dci.getName().cstr());
-      return false;
+      // Drop values that are outside new time ranges and load only new values
+      int count = 0;
+      for(int i = 0; i < model->history.size(); i++)
+      {
+         ScoredDciValue *v = model->history.get(i);
+         for(int j = 0; j < model->depth; j++)
+         {
+            if ((v->timestamp >= timeRanges[j].first) && (v->timestamp <= timeRanges[j].second))
+            {
+               if (count != i)
+                  model->history.set(count, v);
+               count++;
+               break;
+            }
+         }
+      }
+      model->history.shrinkTo(count);
+
+      if (shift > 0)
+      {
+         std::pair<time_t, time_t> deltaRanges[90];
+         for(int i = 0; i < model->depth; i++)
+         {
+            deltaRanges[i].first = model->timeRanges[i].second + 1;
+            deltaRanges[i].second = timeRanges[i].second;
+         }
+         auto series = LoadDciValues(model->nodeId, model->dciId, model->storageClass, deltaRanges, model->depth);
+         if (series == nullptr)
+         {
+            FailModelTraining(model, now);
+            return;
+         }
+         model->history.addAll(*series);
+         nxlog_debug_tag(DEBUG_TAG, 7, _T("TrainModel(%u [p=%d d=%d w=%d]): %d new data points loaded"), model->dciId, model->period, model->depth, model->width, series->size());
+      }
    }
+   else
+   {
+      auto series = LoadDciValues(model->nodeId, model->dciId, model->storageClass, timeRanges, model->depth);
+      if (series == nullptr)
+      {
+         FailModelTraining(model, now);
+         return;
+      }
+      model->history.clear();
+      model->history.addAll(*series);
+      nxlog_debug_tag(DEBUG_TAG, 7, _T("TrainModel(%u [p=%d d=%d w=%d]): %d data points loaded"), model->dciId, model->period, model->depth, model->width, series->size());
+   }
+   memcpy(model->timeRanges, timeRanges, sizeof(timeRanges));
 
-   if (series->isEmpty())
+   shared_ptr<isotree::IsolationForest> forest;
+   int count = model->history.size();
+   if (count > 0)
    {
-      nxlog_debug_tag(DEBUG_TAG, 5, _T("IsAnomalousValue(%s [%u], \"%s\"): no data points for period [p=%d d=%d w=%d]"),
-            dcTarget.getName(), dcTarget.getId(), dci.getName().cstr(), period, depth, width);
-      return false;
+      double *points = MemAllocArrayNoInit<double>(count);
+      for(int i = 0; i < count; i++)
+         points[i] = model->history.get(i)->value;
+      forest = make_shared<isotree::IsolationForest>();
+      forest->fit(points, count, 1);
+      MemFree(points);
    }
 
-   ScoredDciValue *v = series->addPlaceholder();
-   v->timestamp = now;
-   v->value = value;
+   nxlog_debug_tag(DEBUG_TAG, 6, _T("TrainModel(%u [p=%d d=%d w=%d]): model %s (%d data points)"),
+         model->dciId, model->period, model->depth, model->width, (forest != nullptr) ? _T("trained") : _T("not trained"), count);
 
-   int count = series->size();
-   nxlog_debug_tag(DEBUG_TAG, 6, _T("IsAnomalousValue(%s [%u], \"%s\"): %d data points loaded for period [p=%d d=%d w=%d]"),
-         dcTarget.getName(), dcTarget.getId(), dci.getName().cstr(), count - 1, period, depth, width);
+   model->mutex.lock();
+   model->model = forest;
+   model->trainingTime = now;
+   model->trainingPending = false;
+   model->mutex.unlock();
+}
 
-   isotree::IsolationForest model;
-   double *points = MemAllocArrayNoInit<double>(count);
-   for(int i = 0; i < count; i++)
-      points[i] = series->get(i)->value;
+/**
+ * Check if given value is an anomaly
+ * Period is number of days, depth is number of periods to look into, width is time interval around current time in minutes.
+ * Value is scored against cached model, which is retrained in background when older than configured refresh interval.
+ */
+bool IsAnomalousValue(const DataCollectionTarget& dcTarget, const DCObject& dci, double value, double threshold, int period, int depth, int width)
+{
+   if (depth > 90)
+      depth = 90;
+
+   time_t now = time(nullptr);
+   ModelKey key(dci.getId(), period, depth, width);
 
-   if (nxlog_get_debug_level_tag(DEBUG_TAG) >= 7)
+   s_modelsLock.lock();
+   if (now - s_lastModelCleanup > 3600)
    {
-      StringBuffer sb;
-      for(int i = 0; i < count; i++)
-      {
-         sb.append(points[i]);
-         sb.append(_T("  "));
-      }
-      nxlog_debug_tag(DEBUG_TAG, 7, _T("IsAnomalousValue(%s [%u], \"%s\"): %s"), dcTarget.getName(), dcTarget.getId(), dci.getName().cstr(), sb.cstr());
+      StructArray<ModelKey> expiredModels(0, 64);
+      s_models.forEach(
+         [now, &expiredModels] (const ModelKey& key, const shared_ptr<AnomalyModel>& model) -> EnumerationCallbackResult
+         {
+            if (now - model->lastAccessTime > MODEL_EXPIRATION_TIME)
+               expiredModels.add(key);
+            return _CONTINUE;
+         });
+      for(int i = 0; i < expiredModels.size(); i++)
+         s_models.remove(*expiredModels.get(i));
+      if (!expiredModels.isEmpty())
+         nxlog_debug_tag(DEBUG_TAG, 5, _T("IsAnomalousValue: %d expired models removed from cache"), expiredModels.size());
+      s_lastModelCleanup = now;
+   }
+   shared_ptr<AnomalyModel> model = s_models.getShared(key);
+   if (model == nullptr)
+   {
+      model = make_shared<AnomalyModel>(dcTarget.getId(), dci.getId(), dci.getStorageClass(), period, depth, width);
+      s_models.set(key, model);
    }
+   s_modelsLock.unlock();
 
-   model.fit(points, count, 1);
-   std::vector<double> scores = model.predict(points, count, true);
-   MemFree(points);
+   model->mutex.lock();
+   model->lastAccessTime = now;
+   if (!model->trainingPending && (now - model->trainingTime >= static_cast<time_t>(g_anomalyModelRefreshInterval)))
+   {
+      model->trainingPending = true;
+      nxlog_debug_tag(DEBUG_TAG, 6, _T("IsAnomalousValue(%s [%u], \"%s\"): scheduling model training for period [p=%d d=%d w=%d]"),
+            dcTarget.getName(), dcTarget.getId(), dci.getName().cstr(), period, depth, width);
+      ThreadPoolExecute(g_mainThreadPool, TrainModel, model);
+   }
+
+   if (model->model == nullptr)
+   {
+      model->mutex.unlock();
+      nxlog_debug_tag(DEBUG_TAG, 6, _T("IsAnomalousValue(%s [%u], \"%s\"): model for period [p=%d d=%d w=%d] is not available"),
+            dcTarget.getName(), dcTarget.getId(), dci.getName().cstr(), period, depth, width);
+      return false;
+   }
+
+   double point = value;
+   std::vector<double> scores = model->model->predict(&point, 1, true);
+   model->mutex.unlock();
 
    nxlog_debug_tag(DEBUG_TAG, 6, _T("IsAnomalousValue(%s [%u], \"%s\"): score for value %f and period [p=%d d=%d w=%d] is %f"),
-         dcTarget.getName(), dcTarget.getId(), dci.getName().cstr(), value, period, depth, width, scores[count - 1]);
-   return scores[count - 1] >= threshold;
+         dcTarget.getName(), dcTarget.getId(), dci.getName().cstr(), value, period, depth, width, scores[0]);
+   return scores[0] >= threshold;
 }
 
 #else /* WITH_LIBISOTREE */
@@ -46,21 +46,69 @@ AlarmComment::AlarmComment(uint32_t id, time_t changeTime, uint32_t userId, TCHA
    m_text = text;
 }
 
+/**
+ * Alarm index record
+ */
+struct AlarmIndexRecord
+{
+   Alarm *alarm;
+   uint32_t sourceObject;  // Source object ID alarm is indexed under
+   uint32_t dciId;         // DCI ID alarm is indexed under
+   int severity;           // Severity alarm is counted under
+   bool active;            // True if alarm is counted in object's active alarm counters
+};
+
+/**
+ * Alarms of single object with active alarm counters by severity
+ */
+struct AlarmObjectIndexEntry
+{
+   ObjectArray<Alarm> alarms;
+   uint32_t activeAlarms[5];
+
+   AlarmObjectIndexEntry() : alarms(16, 16, Ownership::False)
+   {
+      memset(activeAlarms, 0, sizeof(activeAlarms));
+   }
+
+   int getMostCriticalStatus() const
+   {
+      for(int i = STATUS_CRITICAL; i >= STATUS_NORMAL; i--)
+         if (activeAlarms[i] > 0)
+            return i;
+      return STATUS_UNKNOWN;
+   }
+};
+
 /**
  * Alarm list
  */
 class AlarmList
 {
 private:
-   Mutex m_lock;
+   RWLock m_lock;
    ObjectArray<Alarm> m_list;
    StringObjectMap<Alarm> m_keyIndex;
+   HashMap<uint32_t, AlarmIndexRecord> m_idIndex;
+   HashMap<uint32_t, AlarmObjectIndexEntry> m_objectIndex;
+   HashMap<uint32_t, ObjectArray<Alarm>> m_dciIndex;
+   uint32_t m_severityCount[5];
+
+   static bool isActive(Alarm *alarm) { return (alarm->getState() & ALARM_STATE_MASK) < ALARM_STATE_RESOLVED; }
+
+   void index(AlarmIndexRecord *r);
+   void unindex(AlarmIndexRecord *r);
 
 public:
-   AlarmList() : m_list(256, 256, Ownership::True), m_keyIndex(Ownership::False) { }
+   AlarmList() : m_list(256, 256, Ownership::True), m_keyIndex(Ownership::False), m_idIndex(Ownership::True),
+            m_objectIndex(Ownership::True), m_dciIndex(Ownership::True)
+   {
+      memset(m_severityCount, 0, sizeof(m_severityCount));
+   }
    ~AlarmList() { }
 
-   void lock() { m_lock.lock(); }
+   void lock() { m_lock.writeLock(); }
+   void readLock() { m_lock.readLock(); }
    void unlock() { m_lock.unlock(); }
 
    int size() { return m_list.size(); }
@@ -68,7 +116,7 @@ class AlarmList
    uint64_t memoryUsage()
    {
       uint64_t memUsage = sizeof(AlarmList);
-      lock();
+      readLock();
       for(int i = 0; i < m_list.size(); i++)
          memUsage += m_list.get(i)->getMemoryUsage();
       unlock();
@@ -80,19 +128,46 @@ class AlarmList
    Alarm *find(const TCHAR *key) { return m_keyIndex.get(key); }
    Alarm *find(uint32_t id)
    {
-      for(int i = 0; i < m_list.size(); i++)
-         if (m_list.get(i)->getAlarmId() == id)
-            return m_list.get(i);
-      return nullptr;
+      AlarmIndexRecord *r = m_idIndex.get(id);
+      return (r != nullptr) ? r->alarm : nullptr;
+   }
+
+   /**
+    * Get alarms for given source object (nullptr if object has no alarms)
+    */
+   const ObjectArray<Alarm> *getObjectAlarms(uint32_t objectId)
+   {
+      AlarmObjectIndexEntry *e = m_objectIndex.get(objectId);
+      return (e != nullptr) ? &e->alarms : nullptr;
+   }
+
+   /**
+    * Get alarms for given DCI (nullptr if DCI has no alarms)
+    */
+   const ObjectArray<Alarm> *getDciAlarms(uint32_t dciId) { return m_dciIndex.get(dciId); }
+
+   int getMostCriticalStatus(uint32_t objectId)
+   {
+      AlarmObjectIndexEntry *e = m_objectIndex.get(objectId);
+      return (e != nullptr) ? e->getMostCriticalStatus() : STATUS_UNKNOWN;
    }
 
+   void getSeverityCounts(uint32_t *counts) { memcpy(counts, m_severityCount, sizeof(m_severityCount)); }
+
    void add(Alarm *alarm)
    {
       m_list.add(alarm);
       if (*alarm->getKey() != 0)
          m_keyIndex.set(alarm->getKey(), alarm);
+
+      auto r = new AlarmIndexRecord;
+      r->alarm = alarm;
+      m_idIndex.set(alarm->getAlarmId(), r);
+      index(r);
    }
 
+   void update(Alarm *alarm);
+
    void remove(int index)
    {
       Alarm *alarm = m_list.get(index);
@@ -104,22 +179,119 @@ class AlarmList
       }
       if (*alarm->getKey() != 0)
          m_keyIndex.remove(alarm->getKey());
+      AlarmIndexRecord *r = m_idIndex.get(alarm->getAlarmId());
+      if (r != nullptr)
+      {
+         unindex(r);
+         m_idIndex.remove(alarm->getAlarmId());
+      }
       m_list.remove(index);
    }
 
    void remove(Alarm *alarm)
    {
-      if (alarm->getParentAlarmId() != 0)
+      int index = m_list.indexOf(alarm);
+      if (index != -1)
+         remove(index);
+   }
+};
+
+/**
+ * Add alarm to object and DCI indexes using alarm's current attributes
+ */
+void AlarmList::index(AlarmIndexRecord *r)
+{
+   Alarm *alarm = r->alarm;
+   r->sourceObject = alarm->getSourceObject();
+   r->dciId = alarm->getDciId();
+   r->severity = alarm->getCurrentSeverity();
+   r->active = isActive(alarm);
+
+   AlarmObjectIndexEntry *e = m_objectIndex.get(r->sourceObject);
+   if (e == nullptr)
+   {
+      e = new AlarmObjectIndexEntry();
+      m_objectIndex.set(r->sourceObject, e);
+   }
+   e->alarms.add(alarm);
+   if (r->active)
+      e->activeAlarms[r->severity]++;
+
+   if (r->dciId != 0)
+   {
+      ObjectArray<Alarm> *dciAlarms = m_dciIndex.get(r->dciId);
+      if (dciAlarms == nullptr)
       {
-         Alarm *parent = find(alarm->getParentAlarmId());
-         if (parent != nullptr)
-            parent->removeSubordinateAlarm(alarm->getAlarmId());
+         dciAlarms = new ObjectArray<Alarm>(4, 16, Ownership::False);
+         m_dciIndex.set(r->dciId, dciAlarms);
       }
-      if (*alarm->getKey() != 0)
-         m_keyIndex.remove(alarm->getKey());
-      m_list.remove(alarm);
+      dciAlarms->add(alarm);
    }
-};
+
+   m_severityCount[r->severity]++;
+}
+
+/**
+ * Remove alarm from object and DCI indexes using attributes it was indexed with
+ */
+void AlarmList::unindex(AlarmIndexRecord *r)
+{
+   AlarmObjectIndexEntry *e = m_objectIndex.get(r->sourceObject);
+   if (e != nullptr)
+   {
+      e->alarms.remove(r->alarm);
+      if (r->active)
+         e->activeAlarms[r->severity]--;
+      if (e->alarms.isEmpty())
+         m_objectIndex.remove(r->sourceObject);
+   }
+
+   if (r->dciId != 0)
+   {
+      ObjectArray<Alarm> *dciAlarms = m_dciIndex.get(r->dciId);
+      if (dciAlarms != nullptr)
+      {
+         dciAlarms->remove(r->alarm);
+         if (dciAlarms->isEmpty())
+            m_dciIndex.remove(r->dciId);
+      }
+   }
+
+   m_severityCount[r->severity]--;
+}
+
+/**
+ * Update indexes and counters after change of alarm's source, DCI, severity, or state.
+ * Does nothing if given alarm object is not in the list.
+ */
+void AlarmList::update(Alarm *alarm)
+{
+   AlarmIndexRecord *r = m_idIndex.get(alarm->getAlarmId());
+   if ((r == nullptr) || (r->alarm != alarm))
+      return;
+
+   if ((r->sourceObject != alarm->getSourceObject()) || (r->dciId != alarm->getDciId()))
+   {
+      unindex(r);
+      index(r);
+      return;
+   }
+
+   bool active = isActive(alarm);
+   int severity = alarm->getCurrentSeverity();
+   if ((active == r->active) && (severity == r->severity))
+      return;
+
+   AlarmObjectIndexEntry *e = m_objectIndex.get(r->sourceObject);
+   if (r->active)
+      e->activeAlarms[r->severity]--;
+   if (active)
+      e->activeAlarms[severity]++;
+   m_severityCount[r->severity]--;
+   m_severityCount[severity]++;
+   r->active = active;
+   r->severity = severity;
+}
 
 /**
  * Global instance of alarm manager
@@ -979,6 +1151,7 @@ uint32_t NXCORE_EXPORTABLE CreateNewAlarm(const uuid& ruleGuid, const TCHAR *rul
                parent->addSubordinateAlarm(alarm->getAlarmId());
          }
          alarm->updateFromEvent(event, parentAlarmId, rcaScriptName, ruleGuid, ruleDescription, ALARM_STATE_OUTSTANDING, severity, timeout, timeoutEvent, ackTimeout, message, impact, alarmCategoryList);
+         s_alarmList.update(alarm);
          if (!alarm->isEventRelated(event->getId()))
          {
             alarmId = alarm->getAlarmId();      // needed for correct update of related events
@@ -1126,15 +1299,12 @@ uint32_t NXCORE_EXPORTABLE AckAlarmById(uint32_t alarmId, GenericClientSession *
    uint32_t objectId, rcc = RCC_INVALID_ALARM_ID;
 
    s_alarmList.lock();
-   for(int i = 0; i < s_alarmList.size(); i++)
+   Alarm *alarm = s_alarmList.find(alarmId);
+   if (alarm != nullptr)
    {
-      Alarm *alarm = s_alarmList.get(i);
-      if (alarm->getAlarmId() == alarmId)
-      {
-         rcc = alarm->acknowledge(session, sticky, acknowledgmentActionTime, includeSubordinates);
-         objectId = alarm->getSourceObject();
-         break;
-      }
+      rcc = alarm->acknowledge(session, sticky, acknowledgmentActionTime, includeSubordinates);
+      objectId = alarm->getSourceObject();
+      s_alarmList.update(alarm);
    }
    s_alarmList.unlock();
 
@@ -1158,6 +1328,7 @@ uint32_t NXCORE_EXPORTABLE AckAlarmByHDRef(const TCHAR *hdref, GenericClientSess
       {
          rcc = alarm->acknowledge(session, sticky, acknowledgmentActionTime, false);
          objectId = alarm->getSourceObject();
+         s_alarmList.update(alarm);
          break;
       }
    }
@@ -1240,74 +1411,67 @@ void NXCORE_EXPORTABLE ResolveAlarmsById(const IntegerArray<uint32_t>& alarmIds,
    {
       uint32_t currentId = alarmIds.get(i);
 
-      int n;
-      for(n = 0; n < s_alarmList.size(); n++)
+      Alarm *alarm = s_alarmList.find(currentId);
+      if (alarm == nullptr)
+      {
+         failIds->add(currentId);
+         failCodes->add(RCC_INVALID_ALARM_ID);
+         continue;
+      }
+
+      // If alarm is open in helpdesk, it cannot be terminated. Check with helpdesk system if it is closed now.
+      if (alarm->getHelpDeskState() == ALARM_HELPDESK_OPEN)
+      {
+         bool isOpen;
+         if (GetHelpdeskIssueState(alarm->getHelpDeskRef(), &isOpen) == RCC_SUCCESS)
+         {
+            if (!isOpen)
+               alarm->onHelpdeskIssueClose();
+         }
+      }
+      if ((alarm->getHelpDeskState() != ALARM_HELPDESK_OPEN) || ConfigReadBoolean(_T("Alarms.IgnoreHelpdeskState"), false))
       {
-         Alarm *alarm = s_alarmList.get(n);
-         if (alarm->getAlarmId() == currentId)
+         if (terminate || (alarm->getState() != ALARM_STATE_RESOLVED))
          {
-            // If alarm is open in helpdesk, it cannot be terminated. Check with helpdesk system if it is closed now.
-            if (alarm->getHelpDeskState() == ALARM_HELPDESK_OPEN)
+            // Allow to resolve/terminate alarms for objects that are already deleted
+            shared_ptr<NetObj> object = FindObjectById(alarm->getSourceObject());
+            if ((session != nullptr) && (object != nullptr))
             {
-               bool isOpen;
-               if (GetHelpdeskIssueState(alarm->getHelpDeskRef(), &isOpen) == RCC_SUCCESS)
+               // If user does not have the required object access rights, the alarm cannot be terminated
+               if (!object->checkAccessRights(session->getUserId(), terminate ? OBJECT_ACCESS_TERM_ALARMS : OBJECT_ACCESS_UPDATE_ALARMS))
                {
-                  if (!isOpen)
-                     alarm->onHelpdeskIssueClose();
+                  failIds->add(currentId);
+                  failCodes->add(RCC_ACCESS_DENIED);
+                  continue;
                }
-            }
-            if ((alarm->getHelpDeskState() != ALARM_HELPDESK_OPEN) || ConfigReadBoolean(_T("Alarms.IgnoreHelpdeskState"), false))
-            {
-               if (terminate || (alarm->getState() != ALARM_STATE_RESOLVED))
-               {
-                  // Allow to resolve/terminate alarms for objects that are already deleted
-                  shared_ptr<NetObj> object = FindObjectById(alarm->getSourceObject());
-                  if ((session != nullptr) && (object != nullptr))
-                  {
-                     // If user does not have the required object access rights, the alarm cannot be terminated
-                     if (!object->checkAccessRights(session->getUserId(), terminate ? OBJECT_ACCESS_TERM_ALARMS : OBJECT_ACCESS_UPDATE_ALARMS))
-                     {
-                        failIds->add(currentId);
-                        failCodes->add(RCC_ACCESS_DENIED);
-                        break;
-                     }
-
-                     session->writeAuditLog(AUDIT_OBJECTS, true, object->getId(),
-                        _T("%s alarm %d (%s) on object %s"), terminate ? _T("Terminated") : _T("Resolved"),
-                        alarm->getAlarmId(), alarm->getMessage(), object->getName());
-                  }
 
-                  alarm->resolve((session != nullptr) ? session->getUserId() : 0, nullptr, terminate, false, includeSubordinates);
-                  processedAlarms.add(alarm->getAlarmId());
-                  if (object != nullptr)
-                  {
-                     if (!updatedObjects.contains(object->getId()))
-                        updatedObjects.add(object->getId());
-                  }
-                  if (terminate)
-                  {
-                     s_alarmList.remove(n);
-                     n--;
-                  }
-               }
-               else
-               {
-                  // Alarm is already resolved, just mark it as processed
-                  processedAlarms.add(alarm->getAlarmId());
-               }
+               session->writeAuditLog(AUDIT_OBJECTS, true, object->getId(),
+                  _T("%s alarm %d (%s) on object %s"), terminate ? _T("Terminated") : _T("Resolved"),
+                  alarm->getAlarmId(), alarm->getMessage(), object->getName());
             }
-            else
+
+            alarm->resolve((session != nullptr) ? session->getUserId() : 0, nullptr, terminate, false, includeSubordinates);
+            processedAlarms.add(alarm->getAlarmId());
+            if (object != nullptr)
             {
-               failIds->add(currentId);
-               failCodes->add(RCC_ALARM_OPEN_IN_HELPDESK);
+               if (!updatedObjects.contains(object->getId()))
+                  updatedObjects.add(object->getId());
             }
-            break;
+            if (terminate)
+               s_alarmList.remove(alarm);
+            else
+               s_alarmList.update(alarm);
+         }
+         else
+         {
+            // Alarm is already resolved, just mark it as processed
+            processedAlarms.add(alarm->getAlarmId());
          }
       }
-      if (n == s_alarmList.size())
+      else
       {
          failIds->add(currentId);
-         failCodes->add(RCC_INVALID_ALARM_ID);
+         failCodes->add(RCC_ALARM_OPEN_IN_HELPDESK);
       }
    }
    s_alarmList.unlock();
@@ -1356,6 +1520,10 @@ static void ResolveAlarmByKeyRegexp(const TCHAR *keyPattern, bool terminate, Eve
                s_alarmList.remove(i);
                i--;
             }
+            else
+            {
+               s_alarmList.update(alarm);
+            }
          }
       }
       s_alarmList.unlock();
@@ -1393,6 +1561,10 @@ static void ResolveAlarmByKeyExact(const TCHAR *key, bool terminate, Event *even
       {
          s_alarmList.remove(alarm);
       }
+      else
+      {
+         s_alarmList.update(alarm);
+      }
    }
    s_alarmList.unlock();
 
@@ -1419,23 +1591,30 @@ void NXCORE_EXPORTABLE ResolveAlarmByDCObjectId(uint32_t dciId, bool terminate)
    IntegerArray<uint32_t> objectList;
 
    s_alarmList.lock();
-   for(int i = 0; i < s_alarmList.size(); i++)
+   const ObjectArray<Alarm> *dciAlarms = s_alarmList.getDciAlarms(dciId);
+   if (dciAlarms != nullptr)
    {
-      Alarm *alarm = s_alarmList.get(i);
-      if ((alarm->getDciId() == dciId) &&
-          ((alarm->getHelpDeskState() != ALARM_HELPDESK_OPEN) || ConfigReadBoolean(_T("Alarms.IgnoreHelpdeskState"), false)) &&
-          (terminate || (alarm->getState() != ALARM_STATE_RESOLVED)))
-      {
-         // Add alarm's source object to update list
-         if (!objectList.contains(alarm->getSourceObject()))
-            objectList.add(alarm->getSourceObject());
+      // Take a copy because list in index will change when alarms are terminated
+      ObjectArray<Alarm> alarms(dciAlarms->size(), 16, Ownership::False);
+      for(int i = 0; i < dciAlarms->size(); i++)
+         alarms.add(dciAlarms->get(i));
 
-         // Resolve or terminate alarm
-         alarm->resolve(0, nullptr, terminate, true, false);
-         if (terminate)
+      for(int i = 0; i < alarms.size(); i++)
+      {
+         Alarm *alarm = alarms.get(i);
+         if (((alarm->getHelpDeskState() != ALARM_HELPDESK_OPEN) || ConfigReadBoolean(_T("Alarms.IgnoreHelpdeskState"), false)) &&
+             (terminate || (alarm->getState() != ALARM_STATE_RESOLVED)))
          {
-            s_alarmList.remove(i);
-            i--;
+            // Add alarm's source object to update list
+            if (!objectList.contains(alarm->getSourceObject()))
+               objectList.add(alarm->getSourceObject());
+
+            // Resolve or terminate alarm
+            alarm->resolve(0, nullptr, terminate, true, false);
+            if (terminate)
+               s_alarmList.remove(alarm);
+            else
+               s_alarmList.update(alarm);
          }
       }
    }
@@ -1475,6 +1654,10 @@ uint32_t NXCORE_EXPORTABLE ResolveAlarmByHDRef(const TCHAR *hdref, GenericClient
             {
                s_alarmList.remove(i);
             }
+            else
+            {
+               s_alarmList.update(alarm);
+            }
             nxlog_debug_tag(DEBUG_TAG, 5, _T("Alarm with helpdesk reference \"%s\" %s"), hdref, terminate ? _T("terminated") : _T("resolved"));
          }
          else
@@ -1549,17 +1732,13 @@ uint32_t OpenHelpdeskIssue(uint32_t alarmId, GenericClientSession *session, TCHA
    *hdref = 0;
 
    s_alarmList.lock();
-   for(int i = 0; i < s_alarmList.size(); i++)
+   Alarm *alarm = s_alarmList.find(alarmId);
+   if (alarm != nullptr)
    {
-      Alarm *alarm = s_alarmList.get(i);
-      if (alarm->getAlarmId() == alarmId)
-      {
-         if (alarm->checkCategoryAccess(session))
-            rcc = alarm->openHelpdeskIssue(hdref);
-         else
-            rcc = RCC_ACCESS_DENIED;
-         break;
-      }
+      if (alarm->checkCategoryAccess(session))
+         rcc = alarm->openHelpdeskIssue(hdref);
+      else
+         rcc = RCC_ACCESS_DENIED;
    }
    s_alarmList.unlock();
    return rcc;
@@ -1572,27 +1751,24 @@ uint32_t GetHelpdeskIssueUrlFromAlarm(uint32_t alarmId, uint32_t userId, TCHAR *
 {
    uint32_t rcc = RCC_INVALID_ALARM_ID;
 
-   s_alarmList.lock();
-   for(int i = 0; i < s_alarmList.size(); i++)
+   s_alarmList.readLock();
+   Alarm *alarm = s_alarmList.find(alarmId);
+   if (alarm != nullptr)
    {
-      if (s_alarmList.get(i)->getAlarmId() == alarmId)
+      if (alarm->checkCategoryAccess(session))
       {
-         if (s_alarmList.get(i)->checkCategoryAccess(session))
+         if ((alarm->getHelpDeskState() != ALARM_HELPDESK_IGNORED) && (alarm->getHelpDeskRef()[0] != 0))
          {
-            if ((s_alarmList.get(i)->getHelpDeskState() != ALARM_HELPDESK_IGNORED) && (s_alarmList.get(i)->getHelpDeskRef()[0] != 0))
-            {
-               rcc = GetHelpdeskIssueUrl(s_alarmList.get(i)->getHelpDeskRef(), url, size);
-            }
-            else
-            {
-               rcc = RCC_OUT_OF_STATE_REQUEST;
-            }
+            rcc = GetHelpdeskIssueUrl(alarm->getHelpDeskRef(), url, size);
          }
          else
          {
-            rcc = RCC_ACCESS_DENIED;
+            rcc = RCC_OUT_OF_STATE_REQUEST;
          }
-         break;
+      }
+      else
+      {
+         rcc = RCC_ACCESS_DENIED;
       }
    }
    s_alarmList.unlock();
@@ -1607,24 +1783,20 @@ uint32_t UnlinkHelpdeskIssueById(uint32_t alarmId, GenericClientSession *session
    uint32_t rcc = RCC_INVALID_ALARM_ID;
 
    s_alarmList.lock();
-   for(int i = 0; i < s_alarmList.size(); i++)
+   Alarm *alarm = s_alarmList.find(alarmId);
+   if (alarm != nullptr)
    {
-      Alarm *alarm = s_alarmList.get(i);
-      if (alarm->getAlarmId() == alarmId)
+      if (session != nullptr)
       {
-         if (session != nullptr)
-         {
-            session->writeAuditLog(AUDIT_OBJECTS, true,
-               alarm->getSourceObject(), _T("Helpdesk issue %s unlinked from alarm %d (%s) on object %s"),
-               alarm->getHelpDeskRef(), alarm->getAlarmId(), alarm->getMessage(),
-               GetObjectName(alarm->getSourceObject(), _T("")));
-         }
-         alarm->unlinkFromHelpdesk();
-			NotifyClients(NX_NOTIFY_ALARM_CHANGED, alarm);
-			alarm->updateInDatabase();
-         rcc = RCC_SUCCESS;
-         break;
+         session->writeAuditLog(AUDIT_OBJECTS, true,
+            alarm->getSourceObject(), _T("Helpdesk issue %s unlinked from alarm %d (%s) on object %s"),
+            alarm->getHelpDeskRef(), alarm->getAlarmId(), alarm->getMessage(),
+            GetObjectName(alarm->getSourceObject(), _T("")));
       }
+      alarm->unlinkFromHelpdesk();
+      NotifyClients(NX_NOTIFY_ALARM_CHANGED, alarm);
+      alarm->updateInDatabase();
+      rcc = RCC_SUCCESS;
    }
    s_alarmList.unlock();
 
@@ -1674,17 +1846,13 @@ void NXCORE_EXPORTABLE DeleteAlarm(uint32_t alarmId, bool objectCleanup)
    // Delete alarm from in-memory list
    if (!objectCleanup)  // otherwise already locked
       s_alarmList.lock();
-   for(int i = 0; i < s_alarmList.size(); i++)
+   Alarm *alarm = s_alarmList.find(alarmId);
+   if (alarm != nullptr)
    {
-      Alarm *alarm = s_alarmList.get(i);
-      if (alarm->getAlarmId() == alarmId)
-      {
-         objectId = alarm->getSourceObject();
-         NotifyClients(NX_NOTIFY_ALARM_DELETED, alarm);
-         s_alarmList.remove(i);
-         found = true;
-         break;
-      }
+      objectId = alarm->getSourceObject();
+      NotifyClients(NX_NOTIFY_ALARM_DELETED, alarm);
+      s_alarmList.remove(alarm);
+      found = true;
    }
    if (!objectCleanup)
       s_alarmList.unlock();
@@ -1713,15 +1881,16 @@ bool DeleteObjectAlarms(uint32_t objectId, DB_HANDLE hdb)
 {
 	s_alarmList.lock();
 
-	// go through from end because s_alarmList.size() is decremented by DeleteAlarm()
-	for(int i = s_alarmList.size() - 1; i >= 0; i--)
-   {
-      Alarm *alarm = s_alarmList.get(i);
-		if (alarm->getSourceObject() == objectId)
-      {
-			DeleteAlarm(alarm->getAlarmId(), true);
-      }
+	// Collect alarm IDs first because object's alarm index is updated by DeleteAlarm()
+	IntegerArray<uint32_t> alarmIds;
+	const ObjectArray<Alarm> *objectAlarms = s_alarmList.getObjectAlarms(objectId);
+	if (objectAlarms != nullptr)
+	{
+	   for(int i = 0; i < objectAlarms->size(); i++)
+	      alarmIds.add(objectAlarms->get(i)->getAlarmId());
 	}
+	for(int i = 0; i < alarmIds.size(); i++)
+	   DeleteAlarm(alarmIds.get(i), true);
 
 	s_alarmList.unlock();
 
@@ -1800,29 +1969,25 @@ uint32_t NXCORE_EXPORTABLE GetAlarm(uint32_t alarmId, NXCPMessage *msg, GenericC
 {
    uint32_t rcc = RCC_INVALID_ALARM_ID;
 
-   s_alarmList.lock();
-   for(int i = 0; i < s_alarmList.size(); i++)
+   s_alarmList.readLock();
+   Alarm *alarm = s_alarmList.find(alarmId);
+   if (alarm != nullptr)
    {
-      Alarm *alarm = s_alarmList.get(i);
-      if (alarm->getAlarmId() == alarmId)
+      if (alarm->checkCategoryAccess(session))
       {
-         if (alarm->checkCategoryAccess(session))
-         {
-            alarm->fillMessage(msg);
-            rcc = RCC_SUCCESS;
-         }
-         else
-         {
-            rcc = RCC_ACCESS_DENIED;
-         }
-         break;
+         alarm->fillMessage(msg);
+         rcc = RCC_SUCCESS;
+      }
+      else
+      {
+         rcc = RCC_ACCESS_DENIED;
       }
    }
    s_alarmList.unlock();
 
    if (rcc == RCC_INVALID_ALARM_ID)
    {
-      Alarm *alarm = LoadAlarmFromDatabase(alarmId);
+      alarm = LoadAlarmFromDatabase(alarmId);
       if (alarm != nullptr)
       {
          if (alarm->checkCategoryAccess(session))
@@ -1849,28 +2014,24 @@ uint32_t NXCORE_EXPORTABLE GetAlarmEvents(uint32_t alarmId, NXCPMessage *msg, Ge
 {
    uint32_t rcc = RCC_INVALID_ALARM_ID;
 
-   s_alarmList.lock();
-   for(int i = 0; i < s_alarmList.size(); i++)
+   s_alarmList.readLock();
+   Alarm *alarm = s_alarmList.find(alarmId);
+   if (alarm != nullptr)
    {
-      if (s_alarmList.get(i)->getAlarmId() == alarmId)
+      if (alarm->checkCategoryAccess(session))
       {
-         if (s_alarmList.get(i)->checkCategoryAccess(session))
-         {
-            rcc = RCC_SUCCESS;
-         }
-         else
-         {
-            rcc = RCC_ACCESS_DENIED;
-         }
-         break;
+         rcc = RCC_SUCCESS;
+      }
+      else
+      {
+         rcc = RCC_ACCESS_DENIED;
       }
    }
-
    s_alarmList.unlock();
 
    if (rcc == RCC_INVALID_ALARM_ID)
    {
-      Alarm *alarm = LoadAlarmFromDatabase(alarmId);
+      alarm = LoadAlarmFromDatabase(alarmId);
       if (alarm != nullptr)
       {
          if (alarm->checkCategoryAccess(session))
@@ -1903,15 +2064,11 @@ shared_ptr<NetObj> NXCORE_EXPORTABLE GetAlarmSourceObject(uint32_t alarmId, bool
    uint32_t objectId = 0;
 
    if (!alreadyLocked)
-      s_alarmList.lock();
-   for(int i = 0; i < s_alarmList.size(); i++)
+      s_alarmList.readLock();
+   Alarm *alarm = s_alarmList.find(alarmId);
+   if (alarm != nullptr)
    {
-      Alarm *alarm = s_alarmList.get(i);
-      if (alarm->getAlarmId() == alarmId)
-      {
-         objectId = alarm->getSourceObject();
-         break;
-      }
+      objectId = alarm->getSourceObject();
    }
 
    if (!alreadyLocked)
@@ -1945,7 +2102,7 @@ shared_ptr<NetObj> NXCORE_EXPORTABLE GetAlarmSourceObject(const TCHAR *hdref)
 {
    UINT32 objectId = 0;
 
-   s_alarmList.lock();
+   s_alarmList.readLock();
    for(int i = 0; i < s_alarmList.size(); i++)
    {
       Alarm *alarm = s_alarmList.get(i);
@@ -1965,19 +2122,8 @@ shared_ptr<NetObj> NXCORE_EXPORTABLE GetAlarmSourceObject(const TCHAR *hdref)
  */
 int GetMostCriticalStatusForObject(uint32_t objectId)
 {
-   int status = STATUS_UNKNOWN;
-
-   s_alarmList.lock();
-   for(int i = 0; (i < s_alarmList.size()) && (status != STATUS_CRITICAL); i++)
-   {
-      Alarm *alarm = s_alarmList.get(i);
-      if ((alarm->getSourceObject() == objectId) &&
-			 ((alarm->getState() & ALARM_STATE_MASK) < ALARM_STATE_RESOLVED) &&
-          ((alarm->getCurrentSeverity() > status) || (status == STATUS_UNKNOWN)))
-      {
-         status = (int)alarm->getCurrentSeverity();
-      }
-   }
+   s_alarmList.readLock();
+   int status = s_alarmList.getMostCriticalStatus(objectId);
    s_alarmList.unlock();
    return status;
 }
@@ -1989,11 +2135,9 @@ void GetAlarmStats(NXCPMessage *pMsg)
 {
    UINT32 dwCount[5];
 
-   s_alarmList.lock();
+   s_alarmList.readLock();
    pMsg->setField(VID_NUM_ALARMS, s_alarmList.size());
-   memset(dwCount, 0, sizeof(UINT32) * 5);
-   for(int i = 0; i < s_alarmList.size(); i++)
-      dwCount[s_alarmList.get(i)->getCurrentSeverity()]++;
+   s_alarmList.getSeverityCounts(dwCount);
    s_alarmList.unlock();
    pMsg->setFieldFromInt32Array(VID_ALARMS_BY_SEVERITY, 5, dwCount);
 }
@@ -2003,7 +2147,7 @@ void GetAlarmStats(NXCPMessage *pMsg)
  */
 int GetAlarmCount()
 {
-   s_alarmList.lock();
+   s_alarmList.readLock();
    int count = s_alarmList.size();
    s_alarmList.unlock();
    return count;
@@ -2072,6 +2216,7 @@ static void WatchdogThread()
                .post();
 
 				alarm->onAckTimeoutExpiration();
+				s_alarmList.update(alarm);
 				alarm->updateInDatabase();
 				NotifyClients(NX_NOTIFY_ALARM_CHANGED, alarm);
 			}
@@ -2227,14 +2372,10 @@ uint32_t UpdateAlarmComment(uint32_t alarmId, uint32_t *noteId, const TCHAR *tex
    uint32_t rcc = RCC_INVALID_ALARM_ID;
 
    s_alarmList.lock();
-   for(int i = 0; i < s_alarmList.size(); i++)
+   Alarm *alarm = s_alarmList.find(alarmId);
+   if (alarm != nullptr)
    {
-      Alarm *alarm = s_alarmList.get(i);
-      if (alarm->getAlarmId() == alarmId)
-      {
-         rcc = alarm->updateAlarmComment(noteId, text, userId, syncWithHelpdesk);
-         break;
-      }
+      rcc = alarm->updateAlarmComment(noteId, text, userId, syncWithHelpdesk);
    }
    s_alarmList.unlock();
 
@@ -2283,14 +2424,10 @@ uint32_t DeleteAlarmCommentByID(uint32_t alarmId, uint32_t noteId)
    uint32_t rcc = RCC_INVALID_ALARM_ID;
 
    s_alarmList.lock();
-   for(int i = 0; i < s_alarmList.size(); i++)
+   Alarm *alarm = s_alarmList.find(alarmId);
+   if (alarm != nullptr)
    {
-      Alarm *alarm = s_alarmList.get(i);
-      if (alarm->getAlarmId() == alarmId)
-      {
-         rcc = alarm->deleteComment(noteId);
-         break;
-      }
+      rcc = alarm->deleteComment(noteId);
    }
    s_alarmList.unlock();
 
@@ -2393,15 +2530,29 @@ uint32_t GetAlarmComments(uint32_t alarmId, NXCPMessage *msg)
  */
 ObjectArray<Alarm> NXCORE_EXPORTABLE *GetAlarms(uint32_t objectId, bool recursive)
 {
-   s_alarmList.lock();
-   ObjectArray<Alarm> *result = new ObjectArray<Alarm>(s_alarmList.size(), 16, Ownership::True);
-   for(int i = 0; i < s_alarmList.size(); i++)
+   ObjectArray<Alarm> *result;
+   s_alarmList.readLock();
+   if ((objectId != 0) && !recursive)
    {
-      Alarm *alarm = s_alarmList.get(i);
-      if ((objectId == 0) || (alarm->getSourceObject() == objectId) ||
-          (recursive && IsParentObject(objectId, alarm->getSourceObject())))
+      const ObjectArray<Alarm> *objectAlarms = s_alarmList.getObjectAlarms(objectId);
+      result = new ObjectArray<Alarm>((objectAlarms != nullptr) ? objectAlarms->size() : 0, 16, Ownership::True);
+      if (objectAlarms != nullptr)
       {
-         result->add(new Alarm(alarm, true));
+         for(int i = 0; i < objectAlarms->size(); i++)
+            result->add(new Alarm(objectAlarms->get(i), true));
+      }
+   }
+   else
+   {
+      result = new ObjectArray<Alarm>(s_alarmList.size(), 16, Ownership::True);
+      for(int i = 0; i < s_alarmList.size(); i++)
+      {
+         Alarm *alarm = s_alarmList.get(i);
+         if ((objectId == 0) || (alarm->getSourceObject() == objectId) ||
+             (recursive && IsParentObject(objectId, alarm->getSourceObject())))
+         {
+            result->add(new Alarm(alarm, true));
+         }
       }
    }
    s_alarmList.unlock();
@@ -2432,7 +2583,7 @@ int F_FindAlarmByKey(int argc, NXSL_Value **argv, NXSL_Value **result, NXSL_VM *
 
    const TCHAR *key = argv[0]->getValueAsCString();
 
-   s_alarmList.lock();
+   s_alarmList.readLock();
    Alarm *alarm = s_alarmList.find(key);
    if (alarm != nullptr)
       alarm = new Alarm(alarm, false);
@@ -2453,7 +2604,7 @@ int F_FindAlarmByKeyRegex(int argc, NXSL_Value **argv, NXSL_Value **result, NXSL
    const TCHAR *key = argv[0]->getValueAsCString();
    Alarm *alarm = nullptr;
 
-   s_alarmList.lock();
+   s_alarmList.readLock();
    for(int i = 0; i < s_alarmList.size(); i++)
    {
       Alarm *a = s_alarmList.get(i);
@@ -2477,7 +2628,7 @@ Alarm NXCORE_EXPORTABLE *FindAlarmById(UINT32 alarmId)
    if (alarmId == 0)
       return nullptr;
 
-   s_alarmList.lock();
+   s_alarmList.readLock();
    Alarm *alarm = s_alarmList.find(alarmId);
    if (alarm != nullptr)
       alarm = new Alarm(alarm, false);
@@ -2541,7 +2692,7 @@ static void RootCauseUpdateThread()
       s_rootCauseUpdateNeeded = false;
 
       ObjectArray<Alarm> updateList(0, 32, Ownership::True);
-      s_alarmList.lock();
+      s_alarmList.readLock();
       for(int i = 0; i < s_alarmList.size(); i++)
       {
          Alarm *a = s_alarmList.get(i);
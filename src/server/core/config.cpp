@@ -589,6 +589,10 @@ static void OnConfigVariableChange(bool isCLOB, const TCHAR *name, const TCHAR *
          g_clientFirstPacketTimeout = 100;
       nxlog_debug_tag(_T("client.session"), 2, _T("Client first packet timeout set to %u milliseconds"), g_clientFirstPacketTimeout);
    }
+   else if (!_tcscmp(name, _T("DataCollection.AnomalyDetection.ModelRefreshInterval")))
+   {
+      g_anomalyModelRefreshInterval = ConvertToUint32(value, 900);
+   }
    else if (!_tcscmp(name, _T("DataCollection.InstanceRetentionTime")))
    {
       g_instanceRetentionTime = _tcstol(value, nullptr, 0);
@@ -774,6 +778,14 @@ static void OnConfigVariableChange(bool isCLOB, const TCHAR *name, const TCHAR *
    {
       UpdateServerFlag(AF_TRAPS_FROM_UNMANAGED_NODES, value);
    }
+   else if (!_tcscmp(name, _T("SNMP.Collection.MaxVarbinds")))
+   {
+      g_snmpMaxVarbinds = ConvertToUint32(value, 32);
+   }
+   else if (!_tcscmp(name, _T("SNMP.Walk.BulkMaxRepetitions")))
+   {
+      g_snmpBulkMaxRepetitions = ConvertToUint32(value, SNMP_DEFAULT_BULK_MAX_REPETITIONS);
+   }
    else if (!_tcscmp(name, _T("SNMP.Traps.RateLimit.Threshold")))
    {
       g_snmpTrapStormCountThreshold = ConvertToUint32(value, 0);
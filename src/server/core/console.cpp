@@ -34,7 +34,6 @@ struct SnmpTrap;
  */
 extern ObjectQueue<SnmpTrap> g_snmpTrapProcessorQueue;
 extern ObjectQueue<SnmpTrap> g_snmpTrapWriterQueue;
-extern ObjectQueue<SyslogMessage> g_syslogProcessingQueue;
 extern ObjectQueue<SyslogMessage> g_syslogWriteQueue;
 extern ObjectQueue<WindowsEvent> g_windowsEventProcessingQueue;
 extern ObjectQueue<WindowsEvent> g_windowsEventWriterQueue;
@@ -48,6 +47,7 @@ uint32_t BindAgentTunnel(uint32_t tunnelId, uint32_t nodeId, uint32_t userId);
 uint32_t UnbindAgentTunnel(uint32_t nodeId, uint32_t userId);
 int64_t GetEventLogWriterQueueSize();
 int64_t GetEventProcessorQueueSize();
+int64_t GetSyslogProcessingQueueSize();
 void RangeScanCallback(const InetAddress& addr, int32_t zoneUIN, const Node *proxy, uint32_t rtt, const TCHAR *proto, ServerConsole *console, void *context);
 void CheckRange(const InetAddressListElement& range, void(*callback)(const InetAddress&, int32_t, const Node*, uint32_t, const TCHAR*, ServerConsole*, void*), ServerConsole *console, void *context);
 void ShowSyncerStats(ServerConsole *console);
@@ -952,6 +952,10 @@ int ProcessConsoleCommand(const TCHAR *command, ServerConsole *console)
             ConsoleWrite(console, _T("Invalid subcommand\n"));
          }
       }
+      else if (IsCommand(_T("EPP"), szBuffer, 3))
+      {
+         g_pEventPolicy->showStatistics(console);
+      }
       else if (IsCommand(_T("EP"), szBuffer, 2))
       {
          StructArray<EventProcessingThreadStats> *stats = GetEventProcessingThreadStats();
@@ -972,6 +976,13 @@ int ProcessConsoleCommand(const TCHAR *command, ServerConsole *console)
             ConsoleWrite(console, _T("Parallel event processing is disabled\n"));
          }
          delete stats;
+
+         EventLogWriterStats logWriterStats;
+         GetEventLogWriterStatistics(&logWriterStats);
+         ConsolePrintf(console, _T("\nEvent log writer: %d threads, queue %u, average wait time %u ms, max wait time %u ms, ")
+                  UINT64_FMT _T(" events in ") UINT64_FMT _T(" transactions, ") UINT64_FMT _T(" failed events\n"),
+                  logWriterStats.writers, logWriterStats.queueSize, logWriterStats.averageWaitTime, logWriterStats.maxWaitTime,
+                  logWriterStats.loggedEvents, logWriterStats.transactions, logWriterStats.failedEvents);
       }
       else if (IsCommand(_T("FDB"), szBuffer, 3))
       {
@@ -1280,6 +1291,19 @@ int ProcessConsoleCommand(const TCHAR *command, ServerConsole *console)
       {
          PrintNetworkDeviceDriverList(console);
       }
+      else if (IsCommand(_T("NXSL"), szBuffer, 2))
+      {
+         NXSL_RegexCacheStats stats;
+         NXSLGetRegexCacheStats(&stats);
+         ConsolePrintf(console, _T("Regular expression cache:\n"));
+         ConsolePrintf(console, _T("   Hits ..............: ") UINT64_FMT _T("\n"), stats.hits);
+         ConsolePrintf(console, _T("   Misses ............: ") UINT64_FMT _T("\n"), stats.misses);
+         ConsolePrintf(console, _T("   Hit ratio .........: %d%%\n"), (stats.hits + stats.misses > 0) ? static_cast<int>(stats.hits * 100 / (stats.hits + stats.misses)) : 0);
+         ConsolePrintf(console, _T("   Evictions .........: ") UINT64_FMT _T("\n"), stats.evictions);
+         ConsolePrintf(console, _T("   Compilation errors : ") UINT64_FMT _T("\n"), stats.compilationErrors);
+         ConsolePrintf(console, _T("   Entries ...........: %u (%u pinned by loaded scripts)\n"), stats.size, stats.pinned);
+         ConsolePrintf(console, _T("   Capacity ..........: %u\n"), stats.capacity);
+      }
       else if (IsCommand(_T("OBJECTS"), szBuffer, 1))
       {
          // Get filter
@@ -1338,7 +1362,7 @@ int ProcessConsoleCommand(const TCHAR *command, ServerConsole *console)
          ShowQueueStats(console, GetDiscoveryPollerQueueSize(), _T("Node discovery poller"));
          ShowQueueStats(console, &g_snmpTrapProcessorQueue, _T("SNMP trap processor"));
          ShowQueueStats(console, &g_snmpTrapWriterQueue, _T("SNMP trap writer"));
-         ShowQueueStats(console, &g_syslogProcessingQueue, _T("Syslog processor"));
+         ShowQueueStats(console, GetSyslogProcessingQueueSize(), _T("Syslog processor"));
          ShowQueueStats(console, &g_syslogWriteQueue, _T("Syslog writer"));
          ShowThreadPoolPendingQueue(console, g_schedulerThreadPool, _T("Scheduler"));
          ShowQueueStats(console, &g_windowsEventProcessingQueue, _T("Windows event processor"));
@@ -1858,7 +1882,8 @@ int ProcessConsoleCommand(const TCHAR *command, ServerConsole *console)
             _T("   show dbcp                         - Show active sessions in database connection pool\n")
             _T("   show dbstats                      - Show DB library statistics\n")
             _T("   show discovery ranges             - Show state of active network discovery by address range\n")
-            _T("   show ep                           - Show event processing threads statistics\n")
+            _T("   show ep                           - Show event processing threads and event log writer statistics\n")
+            _T("   show epp                          - Show event processing policy rule statistics\n")
             _T("   show fdb <node>                   - Show forwarding database for node\n")
             _T("   show flags                        - Show internal server flags\n")
             _T("   show heap details                 - Show detailed heap information\n")
@@ -1866,6 +1891,7 @@ int ProcessConsoleCommand(const TCHAR *command, ServerConsole *console)
             _T("   show index <index>                - Show internal index\n")
             _T("   show modules                      - Show loaded server modules\n")
             _T("   show ndd                          - Show loaded network device drivers\n")
+            _T("   show nxsl                         - Show NXSL regular expression cache statistics\n")
             _T("   show objects [<filter>]           - Dump network objects to screen\n")
             _T("   show pe                           - Show registered prediction engines\n")
             _T("   show pollers                      - Show poller threads state information\n")
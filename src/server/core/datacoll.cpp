@@ -29,6 +29,17 @@
  */
 #define ITEM_POLLING_INTERVAL             1
 
+/**
+ * Number of slots in scheduler's timing wheel (must be power of 2). Each slot covers one second,
+ * objects scheduled further in the future than one wheel turn stay in their slot until due.
+ */
+#define SCHEDULER_WHEEL_SIZE              4096
+
+/**
+ * Interval (in seconds) for re-synchronization of scheduler with data collection objects
+ */
+#define SCHEDULER_RESYNC_INTERVAL         300
+
 /**
  * Thread pool for data collectors
  */
@@ -44,6 +55,32 @@ SharedObjectQueue<DCObjectInfo> g_dciCacheLoaderQueue;
  */
 uint32_t g_averageDCIQueuingTime = 0;
 
+/**
+ * Data collection scheduler statistics
+ */
+uint32_t g_averageDCISchedulerLag = 0;
+uint32_t g_dciSchedulerQueueSize = 0;
+uint32_t g_dciSchedulerMaxBucketSize = 0;
+
+/**
+ * Data collection object scheduled for check
+ */
+struct ScheduledDCObject
+{
+   weak_ptr<DCObject> object;
+   time_t checkTime;
+
+   ScheduledDCObject(const shared_ptr<DCObject>& _object, time_t _checkTime) : object(_object), checkTime(_checkTime) {}
+};
+
+/**
+ * Data collection scheduler's timing wheel
+ */
+static std::vector<ScheduledDCObject> s_schedulerWheel[SCHEDULER_WHEEL_SIZE];
+static Mutex s_schedulerLock(MutexType::FAST);
+static time_t s_schedulerLastTick = 0;
+static VolatileCounter s_schedulerQueueSize = 0;   // Number of scheduled objects (cancelled and stale entries are not counted)
+
 /**
  * GUIDs for NXSL script exit codes
  */
@@ -250,22 +287,24 @@ static shared_ptr<Table> GetTableData(DataCollectionTarget *dcTarget, const DCTa
 }
 
 /**
- * Data collector
+ * Resolve actual data collection target for given DC object (taking source node into account). Returns false
+ * if object should not be processed any further (in that case object is already finalized). On return with true
+ * target can be null if source node is not existing or inaccessible.
  */
-void DataCollector(const shared_ptr<DCObject>& dcObject)
+static bool ResolveDataCollectionTarget(const shared_ptr<DCObject>& dcObject, shared_ptr<DataCollectionTarget> *target)
 {
-   shared_ptr<DataCollectionTarget> target = static_pointer_cast<DataCollectionTarget>(dcObject->getOwner());
+   *target = static_pointer_cast<DataCollectionTarget>(dcObject->getOwner());
 
    SharedString dcObjectName = dcObject->getName();
    if (dcObject->isScheduledForDeletion())
    {
-      nxlog_debug_tag(DEBUG_TAG_DC_COLLECTOR, 7, _T("DataCollector(): about to destroy DC object [%u] \"%s\" owner=[%u]"),
-            dcObject->getId(), dcObjectName.cstr(), (target != nullptr) ? target->getId() : 0);
+      nxlog_debug_tag_cached(DEBUG_TAG_DC_COLLECTOR, 7, _T("DataCollector(): about to destroy DC object [%u] \"%s\" owner=[%u]"),
+            dcObject->getId(), dcObjectName.cstr(), (*target != nullptr) ? (*target)->getId() : 0);
       dcObject->deleteFromDatabase();
-      return;
+      return false;
    }
 
-   if (target == nullptr)
+   if (*target == nullptr)
    {
       nxlog_debug_tag(DEBUG_TAG_DC_COLLECTOR, 3, _T("DataCollector: attempt to collect data for non-existing node (DCI=[%u] \"%s\")"),
             dcObject->getId(), dcObjectName.cstr());
@@ -273,128 +312,390 @@ void DataCollector(const shared_ptr<DCObject>& dcObject)
       // Update item's last poll time and clear busy flag so item can be polled again
       dcObject->setLastPollTime(time(nullptr));
       dcObject->clearBusyFlag();
-      return;
+      return false;
    }
 
    if (IsShutdownInProgress())
    {
       dcObject->clearBusyFlag();
-      return;
+      return false;
    }
 
-   nxlog_debug_tag(DEBUG_TAG_DC_COLLECTOR, 8, _T("DataCollector(): processing DC object %u \"%s\" owner=%u sourceNode=%u"),
-         dcObject->getId(), dcObjectName.cstr(), target->getId(), dcObject->getSourceNode());
-   uint32_t sourceNodeId = target->getEffectiveSourceNode(dcObject.get());
+   nxlog_debug_tag_cached(DEBUG_TAG_DC_COLLECTOR, 8, _T("DataCollector(): processing DC object %u \"%s\" owner=%u sourceNode=%u"),
+         dcObject->getId(), dcObjectName.cstr(), (*target)->getId(), dcObject->getSourceNode());
+   uint32_t sourceNodeId = (*target)->getEffectiveSourceNode(dcObject.get());
    if (sourceNodeId != 0)
    {
       shared_ptr<Node> sourceNode = static_pointer_cast<Node>(FindObjectById(sourceNodeId, OBJECT_NODE));
       if (sourceNode != nullptr)
       {
-         if (((target->getObjectClass() == OBJECT_CHASSIS) && (static_cast<Chassis*>(target.get())->getControllerId() == sourceNodeId)) || sourceNode->isTrustedObject(target->getId()))
+         if ((((*target)->getObjectClass() == OBJECT_CHASSIS) && (static_cast<Chassis*>(target->get())->getControllerId() == sourceNodeId)) || sourceNode->isTrustedObject((*target)->getId()))
          {
-            target = sourceNode;
+            *target = sourceNode;
          }
          else
          {
             // Change item's status to "not supported"
             dcObject->setStatus(ITEM_STATUS_NOT_SUPPORTED, true);
-            target.reset();
+            target->reset();
          }
       }
       else
       {
-         target.reset();
+         target->reset();
+      }
+   }
+
+   if (*target == nullptr)
+   {
+      shared_ptr<DataCollectionOwner> n = dcObject->getOwner();
+      nxlog_debug_tag(DEBUG_TAG_DC_COLLECTOR, 5, _T("Attempt to collect data from non-existing or inaccessible node (DCI=[%u] \"%s\" target=[%u] sourceNode=[%u])"),
+                  dcObject->getId(), dcObjectName.cstr(), (n != nullptr) ? n->getId() : 0, sourceNodeId);
+   }
+   return true;
+}
+
+/**
+ * Transform and store received value into database or handle collection error
+ */
+static void ProcessDataCollectionResult(const shared_ptr<DCObject>& dcObject, time_t currTime, uint32_t error, const TCHAR *value, const shared_ptr<Table>& table)
+{
+   switch(error)
+   {
+      case DCE_SUCCESS:
+         if (dcObject->getStatus() == ITEM_STATUS_NOT_SUPPORTED)
+            dcObject->setStatus(ITEM_STATUS_ACTIVE, true);
+         static_cast<DataCollectionTarget*>(dcObject->getOwner().get())->processNewDCValue(dcObject, currTime, value, table);
+         break;
+      case DCE_COLLECTION_ERROR:
+         if (dcObject->getStatus() == ITEM_STATUS_NOT_SUPPORTED)
+            dcObject->setStatus(ITEM_STATUS_ACTIVE, true);
+         dcObject->processNewError(false);
+         break;
+      case DCE_NO_SUCH_INSTANCE:
+         if (dcObject->getStatus() == ITEM_STATUS_NOT_SUPPORTED)
+            dcObject->setStatus(ITEM_STATUS_ACTIVE, true);
+         dcObject->processNewError(true);
+         break;
+      case DCE_COMM_ERROR:
+         dcObject->processNewError(false);
+         break;
+      case DCE_NOT_SUPPORTED:
+         // Change item's status
+         dcObject->setStatus(ITEM_STATUS_NOT_SUPPORTED, true);
+         break;
+   }
+
+   // Send session notification when force poll is performed
+   if (dcObject->isForcePollRequested())
+   {
+      ClientSession *session = dcObject->processForcePoll();
+      if (session != nullptr)
+      {
+         session->notify(NX_NOTIFY_FORCE_DCI_POLL, dcObject->getOwnerId());
+         session->decRefCount();
       }
    }
+}
+
+/**
+ * Complete data collection cycle for given object
+ */
+static inline void CompleteDataCollection(const shared_ptr<DCObject>& dcObject, time_t currTime)
+{
+   // Update item's last poll time and clear busy flag so item can be polled again
+   dcObject->setLastPollTime(currTime);
+   dcObject->clearBusyFlag();
+
+   ScheduleDataCollection(dcObject, dcObject->getNextPollCheckTime(time(nullptr)));
+}
+
+/**
+ * Collect data for single object from already resolved target
+ */
+static void CollectData(const shared_ptr<DCObject>& dcObject, DataCollectionTarget *target, time_t currTime)
+{
+   TCHAR value[MAX_RESULT_LENGTH];
+   shared_ptr<Table> table;
+   uint32_t error;
+   switch(dcObject->getType())
+   {
+      case DCO_TYPE_ITEM:
+         GetItemData(target, static_cast<DCItem&>(*dcObject), value, &error);
+         break;
+      case DCO_TYPE_TABLE:
+         table = GetTableData(target, static_cast<DCTable&>(*dcObject), &error);
+         break;
+      default:
+         error = DCE_NOT_SUPPORTED;
+         break;
+   }
+   ProcessDataCollectionResult(dcObject, currTime, error, value, table);
+}
+
+/**
+ * Data collector
+ */
+void DataCollector(const shared_ptr<DCObject>& dcObject)
+{
+   shared_ptr<DataCollectionTarget> target;
+   if (!ResolveDataCollectionTarget(dcObject, &target))
+      return;
 
    time_t currTime = time(nullptr);
-   if (target != nullptr)
+   if ((target != nullptr) && !IsShutdownInProgress())
+      CollectData(dcObject, target.get(), currTime);
+
+   CompleteDataCollection(dcObject, currTime);
+}
+
+/**
+ * Collect batch of native agent metrics from given node with single request
+ */
+static void CollectAgentBatch(Node *node, const SharedObjectArray<DCObject>& items, time_t currTime)
+{
+   StringList names;
+   for(int i = 0; i < items.size(); i++)
+      names.add(items.get(i)->getName());
+
+   nxlog_debug_tag_cached(DEBUG_TAG_DC_COLLECTOR, 7, _T("BatchDataCollector(): requesting %d metrics from agent on node %s [%u]"), items.size(), node->getName(), node->getId());
+   StringList values;
+   DataCollectionError *errors = MemAllocArrayNoInit<DataCollectionError>(items.size());
+   node->getMetricsFromAgent(names, &values, errors);
+   for(int i = 0; i < items.size(); i++)
+      ProcessDataCollectionResult(items.getShared(i), currTime, errors[i], values.get(i), shared_ptr<Table>());
+   MemFree(errors);
+}
+
+/**
+ * Number of SNMP metric groups with outstanding requests
+ */
+static VolatileCounter s_pendingSNMPGroups = 0;
+
+/**
+ * Results of SNMP metric group collection
+ */
+struct SNMPGroupResult
+{
+   SharedObjectArray<DCObject> *items;
+   StringList *values;
+   DataCollectionError *errors;
+   time_t currTime;
+
+   SNMPGroupResult(SharedObjectArray<DCObject> *_items, StringList *_values, DataCollectionError *_errors, time_t _currTime)
+   {
+      items = _items;
+      values = _values;
+      errors = _errors;
+      currTime = _currTime;
+   }
+
+   ~SNMPGroupResult()
    {
-      if (!IsShutdownInProgress())
+      delete items;
+      delete values;
+      MemFree(errors);
+   }
+};
+
+/**
+ * Process results of SNMP metric group collection and complete data collection cycle for all items in group
+ */
+static void ProcessSNMPGroupResult(SNMPGroupResult *result)
+{
+   for(int i = 0; i < result->items->size(); i++)
+   {
+      shared_ptr<DCObject> dcObject = result->items->getShared(i);
+      ProcessDataCollectionResult(dcObject, result->currTime, result->errors[i], result->values->get(i), shared_ptr<Table>());
+      CompleteDataCollection(dcObject, result->currTime);
+   }
+   delete result;
+   InterlockedDecrement(&s_pendingSNMPGroups);
+}
+
+/**
+ * Collect batch of SNMP metrics from given node. Items using same SNMP port and version
+ * are requested together (as many variables per request as allowed for the node). Requests
+ * are executed asynchronously; results are processed and data collection cycle is completed
+ * for each item on data collector thread pool when all values for the group are received.
+ */
+static void CollectSNMPBatch(Node *node, const SharedObjectArray<DCObject>& items, time_t currTime)
+{
+   int count = items.size();
+   bool *processed = MemAllocArray<bool>(count);
+   int *rawTypes = MemAllocArrayNoInit<int>(count);
+   for(int i = 0; i < count; i++)
+   {
+      if (processed[i])
+         continue;
+
+      const DCItem *first = static_cast<DCItem*>(items.get(i));
+      uint16_t port = first->getSnmpPort();
+      SNMP_Version version = first->getSnmpVersion();
+
+      StringList names;
+      auto group = new SharedObjectArray<DCObject>(count - i, 16);
+      for(int j = i; j < count; j++)
       {
-         TCHAR value[MAX_RESULT_LENGTH];
-         shared_ptr<Table> table;
-         uint32_t error;
-         switch(dcObject->getType())
-         {
-            case DCO_TYPE_ITEM:
-               GetItemData(target.get(), static_cast<DCItem&>(*dcObject), value, &error);
-               break;
-            case DCO_TYPE_TABLE:
-               table = GetTableData(target.get(), static_cast<DCTable&>(*dcObject), &error);
-               break;
-            default:
-               error = DCE_NOT_SUPPORTED;
-               break;
-         }
+         const DCItem *dci = static_cast<DCItem*>(items.get(j));
+         if (processed[j] || (dci->getSnmpPort() != port) || (dci->getSnmpVersion() != version))
+            continue;
+         processed[j] = true;
+         names.add(dci->getName());
+         rawTypes[group->size()] = dci->isInterpretSnmpRawValue() ? static_cast<int>(dci->getSnmpRawValueType()) : SNMP_RAWTYPE_NONE;
+         group->add(items.getShared(j));
+      }
 
-         // Transform and store received value into database or handle error
-         switch(error)
+      nxlog_debug_tag_cached(DEBUG_TAG_DC_COLLECTOR, 7, _T("BatchDataCollector(): requesting %d SNMP metrics from node %s [%u]"), group->size(), node->getName(), node->getId());
+      InterlockedIncrement(&s_pendingSNMPGroups);
+      node->getMetricsFromSNMP(port, version, names, rawTypes,
+         [group, currTime] (StringList *values, DataCollectionError *errors) -> void
          {
-            case DCE_SUCCESS:
-               if (dcObject->getStatus() == ITEM_STATUS_NOT_SUPPORTED)
-                  dcObject->setStatus(ITEM_STATUS_ACTIVE, true);
-               static_cast<DataCollectionTarget*>(dcObject->getOwner().get())->processNewDCValue(dcObject, currTime, value, table);
-               break;
-            case DCE_COLLECTION_ERROR:
-               if (dcObject->getStatus() == ITEM_STATUS_NOT_SUPPORTED)
-                  dcObject->setStatus(ITEM_STATUS_ACTIVE, true);
-               dcObject->processNewError(false);
-               break;
-            case DCE_NO_SUCH_INSTANCE:
-               if (dcObject->getStatus() == ITEM_STATUS_NOT_SUPPORTED)
-                  dcObject->setStatus(ITEM_STATUS_ACTIVE, true);
-               dcObject->processNewError(true);
-               break;
-            case DCE_COMM_ERROR:
-               dcObject->processNewError(false);
-               break;
-            case DCE_NOT_SUPPORTED:
-               // Change item's status
-               dcObject->setStatus(ITEM_STATUS_NOT_SUPPORTED, true);
-               break;
-         }
+            // Callback can be called from SNMP engine thread, so results are processed on collector thread pool
+            ThreadPoolExecute(g_dataCollectorThreadPool, ProcessSNMPGroupResult, new SNMPGroupResult(group, values, errors, currTime));
+         });
+   }
+   MemFree(rawTypes);
+   MemFree(processed);
+}
 
-         // Send session notification when force poll is performed
-         if (dcObject->isForcePollRequested())
-         {
-            ClientSession *session = dcObject->processForcePoll();
-            if (session != nullptr)
-            {
-               session->notify(NX_NOTIFY_FORCE_DCI_POLL, dcObject->getOwnerId());
-               session->decRefCount();
-            }
-         }
+/**
+ * Batch data collector for native agent and SNMP metrics. All items in batch are expected to share same
+ * serialization key (and so same source node and data source). Metrics resolved to same node are requested
+ * with as few requests as possible, other items are processed individually.
+ */
+static void BatchDataCollector(SharedObjectArray<DCObject> *batch)
+{
+   shared_ptr<Node> node;
+   SharedObjectArray<DCObject> items(batch->size(), 16);
+   for(int i = 0; i < batch->size(); i++)
+   {
+      shared_ptr<DCObject> dcObject = batch->getShared(i);
+      shared_ptr<DataCollectionTarget> target;
+      if (!ResolveDataCollectionTarget(dcObject, &target))
+         continue;
+
+      if ((target != nullptr) && (target->getObjectClass() == OBJECT_NODE) && ((node == nullptr) || (node.get() == target.get())))
+      {
+         node = static_pointer_cast<Node>(target);
+         items.add(dcObject);
+      }
+      else
+      {
+         time_t currTime = time(nullptr);
+         if ((target != nullptr) && !IsShutdownInProgress())
+            CollectData(dcObject, target.get(), currTime);
+         CompleteDataCollection(dcObject, currTime);
       }
    }
-   else     /* target == nullptr */
+   delete batch;
+
+   if (items.isEmpty())
+      return;
+
+   time_t currTime = time(nullptr);
+   if (!IsShutdownInProgress())
    {
-      shared_ptr<DataCollectionOwner> n = dcObject->getOwner();
-      nxlog_debug_tag(DEBUG_TAG_DC_COLLECTOR, 5, _T("Attempt to collect data from non-existing or inaccessible node (DCI=[%u] \"%s\" target=[%u] sourceNode=[%u])"),
-                  dcObject->getId(), dcObjectName.cstr(), (n != nullptr) ? n->getId() : 0, sourceNodeId);
+      if (items.get(0)->getDataSource() == DS_SNMP_AGENT)
+      {
+         // Data collection cycle for SNMP items will be completed when responses are received
+         CollectSNMPBatch(node.get(), items, currTime);
+         return;
+      }
+      CollectAgentBatch(node.get(), items, currTime);
    }
 
-   // Update item's last poll time and clear busy flag so item can be polled again
-   dcObject->setLastPollTime(currTime);
-   dcObject->clearBusyFlag();
+   for(int i = 0; i < items.size(); i++)
+      CompleteDataCollection(items.getShared(i), currTime);
 }
 
 /**
- * Callback for queueing DCIs
+ * Schedule check of data collection object at given time. Previously scheduled check for same object is cancelled.
  */
-static void QueueItems(NetObj *object, uint32_t *watchdogId)
+void ScheduleDataCollection(const shared_ptr<DCObject>& dcObject, time_t checkTime)
+{
+   s_schedulerLock.lock();
+   // Checks scheduled in the past are placed into next slot to be processed
+   time_t slotTime = std::max(checkTime, s_schedulerLastTick + 1);
+   s_schedulerWheel[slotTime & (SCHEDULER_WHEEL_SIZE - 1)].emplace_back(dcObject, checkTime);
+   if (dcObject->getScheduledCheckTime() == 0)
+      InterlockedIncrement(&s_schedulerQueueSize);  // Otherwise previous entry for this object becomes stale
+   dcObject->setScheduledCheckTime(checkTime);
+   s_schedulerLock.unlock();
+}
+
+/**
+ * Schedule check of data collection object if it is not scheduled already
+ */
+static void ScheduleDataCollectionIfIdle(const shared_ptr<DCObject>& dcObject, time_t checkTime)
+{
+   s_schedulerLock.lock();
+   bool scheduled = (dcObject->getScheduledCheckTime() != 0);
+   s_schedulerLock.unlock();
+   if (!scheduled)
+      ScheduleDataCollection(dcObject, checkTime);
+}
+
+/**
+ * Cancel scheduled check for data collection object being destroyed. Scheduler entry itself
+ * is dropped when its slot is processed. Caller must ensure that object is not used by other threads.
+ */
+void CancelScheduledDataCollection(DCObject *dcObject)
+{
+   if (dcObject->getScheduledCheckTime() != 0)
+   {
+      dcObject->setScheduledCheckTime(0);
+      InterlockedDecrement(&s_schedulerQueueSize);
+   }
+}
+
+/**
+ * Move due objects from scheduler slot to given list and drop stale entries (must be called with scheduler lock held)
+ */
+static void CollectDueObjects(std::vector<ScheduledDCObject> *slot, time_t now, int64_t nowMs, SharedObjectArray<DCObject> *dueObjects, int64_t *lagSum)
+{
+   size_t count = 0;
+   for(size_t i = 0; i < slot->size(); i++)
+   {
+      ScheduledDCObject& e = (*slot)[i];
+      shared_ptr<DCObject> object = e.object.lock();
+      if ((object == nullptr) || (object->getScheduledCheckTime() != e.checkTime))
+         continue;   // Object was destroyed or re-scheduled
+
+      if (e.checkTime <= now)
+      {
+         object->setScheduledCheckTime(0);
+         InterlockedDecrement(&s_schedulerQueueSize);
+         dueObjects->add(object);
+         *lagSum += nowMs - static_cast<int64_t>(e.checkTime) * 1000;
+         continue;
+      }
+
+      if (count != i)
+         (*slot)[count] = std::move(e);
+      count++;
+   }
+   slot->erase(slot->begin() + count, slot->end());
+}
+
+/**
+ * Callback for scheduler re-synchronization
+ */
+static void ResyncSchedule(NetObj *object, uint32_t *watchdogId)
 {
    if (IsShutdownInProgress())
       return;
 
    WatchdogNotify(*watchdogId);
-	nxlog_debug_tag(DEBUG_TAG_DC_POLLER, 8, _T("ItemPoller: calling DataCollectionTarget::queueItemsForPolling for object %s [%u]"), object->getName(), object->getId());
-	static_cast<DataCollectionTarget*>(object)->queueItemsForPolling();
+   unique_ptr<SharedObjectArray<DCObject>> dcObjects = static_cast<DataCollectionTarget*>(object)->getAllDCObjects();
+   time_t now = time(nullptr);
+   for(int i = 0; i < dcObjects->size(); i++)
+      ScheduleDataCollectionIfIdle(dcObjects->getShared(i), now);
 }
 
 /**
- * Item poller thread: check nodes' items and put into the
- * data collector queue when data polling required
+ * Item poller thread: check data collection objects which are due according to
+ * scheduler's timing wheel and put into the data collector queue when data polling required
  */
 static void ItemPoller()
 {
@@ -404,23 +705,94 @@ static void ItemPoller()
 
    uint32_t watchdogId = WatchdogAddThread(_T("Item Poller"), 10);
    GaugeData<uint32_t> queuingTime(ITEM_POLLING_INTERVAL, 300);
+   GaugeData<uint32_t> schedulerLag(ITEM_POLLING_INTERVAL, 300);
+   time_t lastResync = 0;
 
    while(!IsShutdownInProgress())
    {
+      // Full walk over all data collection objects is only needed on startup; later it only
+      // catches objects that were added to targets without going through the scheduler
+      time_t now = time(nullptr);
+      if (now - lastResync >= SCHEDULER_RESYNC_INTERVAL)
+      {
+         nxlog_debug_tag(DEBUG_TAG_DC_POLLER, 6, _T("ItemPoller: re-synchronizing scheduler"));
+         g_idxAccessPointById.forEach(ResyncSchedule, &watchdogId);
+         g_idxChassisById.forEach(ResyncSchedule, &watchdogId);
+         g_idxClusterById.forEach(ResyncSchedule, &watchdogId);
+         g_idxCollectorById.forEach(ResyncSchedule, &watchdogId);
+         g_idxMobileDeviceById.forEach(ResyncSchedule, &watchdogId);
+         g_idxNodeById.forEach(ResyncSchedule, &watchdogId);
+         g_idxSensorById.forEach(ResyncSchedule, &watchdogId);
+         lastResync = now;
+      }
+
       if (SleepAndCheckForShutdown(ITEM_POLLING_INTERVAL))
          break;      // Shutdown has arrived
       WatchdogNotify(watchdogId);
-      nxlog_debug_tag(DEBUG_TAG_DC_POLLER, 8, _T("ItemPoller: wakeup"));
+      nxlog_debug_tag_cached(DEBUG_TAG_DC_POLLER, 8, _T("ItemPoller: wakeup"));
 
       int64_t startTime = GetCurrentTimeMs();
-      g_idxAccessPointById.forEach(QueueItems, &watchdogId);
-      g_idxChassisById.forEach(QueueItems, &watchdogId);
-      g_idxClusterById.forEach(QueueItems, &watchdogId);
-      g_idxCollectorById.forEach(QueueItems, &watchdogId);
-		g_idxMobileDeviceById.forEach(QueueItems, &watchdogId);
-      g_idxNodeById.forEach(QueueItems, &watchdogId);
-		g_idxSensorById.forEach(QueueItems, &watchdogId);
+      now = time(nullptr);
+
+      SharedObjectArray<DCObject> dueObjects(1024, 1024);
+      int64_t lagSum = 0;
+      s_schedulerLock.lock();
+      if ((s_schedulerLastTick == 0) || (now < s_schedulerLastTick) || (now - s_schedulerLastTick >= SCHEDULER_WHEEL_SIZE))
+      {
+         // First run or system time change - check all slots
+         for(int i = 0; i < SCHEDULER_WHEEL_SIZE; i++)
+            CollectDueObjects(&s_schedulerWheel[i], now, startTime, &dueObjects, &lagSum);
+      }
+      else
+      {
+         for(time_t t = s_schedulerLastTick + 1; t <= now; t++)
+            CollectDueObjects(&s_schedulerWheel[t & (SCHEDULER_WHEEL_SIZE - 1)], now, startTime, &dueObjects, &lagSum);
+      }
+      s_schedulerLastTick = now;
+
+      size_t maxBucketSize = 0;
+      for(int i = 0; i < SCHEDULER_WHEEL_SIZE; i++)
+         maxBucketSize = std::max(maxBucketSize, s_schedulerWheel[i].size());
+      g_dciSchedulerMaxBucketSize = static_cast<uint32_t>(maxBucketSize);
+      g_dciSchedulerQueueSize = static_cast<uint32_t>(std::max(static_cast<int32_t>(s_schedulerQueueSize), 0));
+      s_schedulerLock.unlock();
+
+      nxlog_debug_tag_cached(DEBUG_TAG_DC_POLLER, 8, _T("ItemPoller: %d data collection objects due for check"), dueObjects.size());
+      HashMap<uint64_t, SharedObjectArray<DCObject>> batches(Ownership::False);
+      for(int i = 0; i < dueObjects.size(); i++)
+      {
+         shared_ptr<DCObject> dcObject = dueObjects.getShared(i);
+         shared_ptr<DataCollectionOwner> owner = dcObject->getOwner();
+         if ((owner == nullptr) || !owner->isDataCollectionTarget() || dcObject->isScheduledForDeletion())
+            continue;
 
+         // Objects queued for polling will be re-scheduled by data collector
+         DataCollectionTarget *target = static_cast<DataCollectionTarget*>(owner.get());
+         if (!target->queueItemForPolling(dcObject, now, &batches))
+            ScheduleDataCollection(dcObject, target->isDataCollectionActive() ? dcObject->getNextPollCheckTime(now) : now + DC_SCHEDULER_RECHECK_INTERVAL);
+      }
+
+      // Agent and SNMP metrics due at same time on same node are collected with as few requests as possible
+      batches.forEach(
+         [] (const uint64_t& key, SharedObjectArray<DCObject> *batch) -> EnumerationCallbackResult
+         {
+            if (batch->size() == 1)
+            {
+               ThreadPoolExecuteSerialized(g_dataCollectorThreadPool, key, DataCollector, batch->getShared(0));
+               delete batch;
+            }
+            else
+            {
+               ThreadPoolExecuteSerialized(g_dataCollectorThreadPool, key, BatchDataCollector, batch);
+            }
+            return _CONTINUE;
+         });
+
+      if (!dueObjects.isEmpty())
+      {
+         schedulerLag.update(static_cast<uint32_t>(lagSum / dueObjects.size()));
+         g_averageDCISchedulerLag = static_cast<uint32_t>(schedulerLag.getAverage());
+      }
 		queuingTime.update(static_cast<uint32_t>(GetCurrentTimeMs() - startTime));
 		g_averageDCIQueuingTime = static_cast<uint32_t>(queuingTime.getAverage());
    }
@@ -449,6 +821,7 @@ static void CacheLoader()
             nxlog_debug_tag(DEBUG_TAG_DC_CACHE, 6, _T("Loading cache for DCI %s [%d] on %s [%d]"),
                      ref->getName(), ref->getId(), object->getName(), object->getId());
             static_cast<DCItem*>(dci.get())->reloadCache(false);
+            ScheduleDataCollection(dci, time(nullptr));
          }
       }
    }
@@ -482,6 +855,10 @@ void StopDataCollection()
 {
    ThreadJoin(s_itemPollerThread);
    ThreadJoin(s_cacheLoaderThread);
+
+   // Wait for outstanding asynchronous SNMP requests (they will complete or time out while SNMP engine is still running)
+   while(s_pendingSNMPGroups > 0)
+      ThreadSleepMs(100);
    ThreadPoolDestroy(g_dataCollectorThreadPool);
 }
 
@@ -527,25 +527,54 @@ struct PreparedStatement_PostgreSQL
 };
 
 /**
- * Worker thread that prepares INSERT statements for PostgreSQL database
+ * Build base of INSERT statement for PostgreSQL idata table. Returns true if timestamps should be converted.
  */
-static void QueryPrepareThread_PostgreSQL(IDataWriter *writer, ObjectQueue<PreparedStatement_PostgreSQL> *statementQueue,
-      SynchronizedObjectMemoryPool<PreparedStatement_PostgreSQL> *memoryPool)
+static bool BuildInsertQueryBase_PostgreSQL(IDataWriter *writer, TCHAR *queryBase)
 {
-   ThreadSetName("DBWriter/QPrep");
-
-   bool convertTimestamps;
-   TCHAR queryBase[256];
    if (writer->storageClass != nullptr)   // TimescaleDB
    {
       _sntprintf(queryBase, 256, _T("INSERT INTO idata_sc_%s (item_id,idata_timestamp,idata_value,raw_value) VALUES"), writer->storageClass);
-      convertTimestamps = true;
+      return true;
+   }
+   _tcscpy(queryBase, _T("INSERT INTO idata (item_id,idata_timestamp,idata_value,raw_value) VALUES"));
+   return false;
+}
+
+/**
+ * Append single record to PostgreSQL INSERT statement
+ */
+static void AppendInsertRecord_PostgreSQL(StringBuffer& query, const DELAYED_IDATA_INSERT *rq, bool first, bool convertTimestamps)
+{
+   query.append(first ? _T(" (") : _T(",("), 2);
+   query.append(rq->dciId);
+   if (convertTimestamps)
+   {
+      query.append(_T(",to_timestamp("), 14);
+      query.append(static_cast<int64_t>(rq->timestamp));
+      query.append(_T("),"), 2);
    }
    else
    {
-      _tcscpy(queryBase, _T("INSERT INTO idata (item_id,idata_timestamp,idata_value,raw_value) VALUES"));
-      convertTimestamps = false;
+      query.append(_T(','));
+      query.append(static_cast<int64_t>(rq->timestamp));
+      query.append(_T(','));
    }
+   query.append(DBPrepareString(g_dbDriver, rq->transformedValue));
+   query.append(_T(','));
+   query.append(DBPrepareString(g_dbDriver, rq->rawValue));
+   query.append(_T(')'));
+}
+
+/**
+ * Worker thread that prepares INSERT statements for PostgreSQL database
+ */
+static void QueryPrepareThread_PostgreSQL(IDataWriter *writer, ObjectQueue<PreparedStatement_PostgreSQL> *statementQueue,
+      SynchronizedObjectMemoryPool<PreparedStatement_PostgreSQL> *memoryPool)
+{
+   ThreadSetName("DBWriter/QPrep");
+
+   TCHAR queryBase[256];
+   bool convertTimestamps = BuildInsertQueryBase_PostgreSQL(writer, queryBase);
 
    int maxRecordsPerStmt = ConfigReadInt(_T("DBWriter.MaxRecordsPerStatement"), 100);
 
@@ -562,24 +591,7 @@ static void QueryPrepareThread_PostgreSQL(IDataWriter *writer, ObjectQueue<Prepa
       int count = 0;
       while(true)
       {
-         query.append((count > 0) ? _T(",(") : _T(" ("), 2);
-         query.append(rq->dciId);
-         if (convertTimestamps)
-         {
-            query.append(_T(",to_timestamp("), 14);
-            query.append(static_cast<int64_t>(rq->timestamp));
-            query.append(_T("),"), 2);
-         }
-         else
-         {
-            query.append(_T(','));
-            query.append(static_cast<int64_t>(rq->timestamp));
-            query.append(_T(','));
-         }
-         query.append(DBPrepareString(g_dbDriver, rq->transformedValue));
-         query.append(_T(','));
-         query.append(DBPrepareString(g_dbDriver, rq->rawValue));
-         query.append(_T(')'));
+         AppendInsertRecord_PostgreSQL(query, rq, count == 0, convertTimestamps);
          MemFree(rq);
 
          count++;
@@ -731,6 +743,284 @@ static void IDataWriteThreadSingleTable_PostgreSQL(IDataWriter *writer)
       ThreadPoolDestroy(writerPool);
 }
 
+/**
+ * Number of columns in bulk load staging table
+ */
+#define BULK_LOAD_COLUMNS  4
+
+/**
+ * Batch of idata records prepared for bulk load
+ */
+struct BulkLoadBatch_PostgreSQL
+{
+   DELAYED_IDATA_INSERT **records;
+   const TCHAR **values;
+   TCHAR *numbers;
+   int count;
+
+   BulkLoadBatch_PostgreSQL(int maxRecords)
+   {
+      records = MemAllocArrayNoInit<DELAYED_IDATA_INSERT*>(maxRecords);
+      values = MemAllocArrayNoInit<const TCHAR*>(maxRecords * BULK_LOAD_COLUMNS);
+      numbers = MemAllocArrayNoInit<TCHAR>(maxRecords * 64);
+      count = 0;
+   }
+
+   ~BulkLoadBatch_PostgreSQL()
+   {
+      for(int i = 0; i < count; i++)
+         MemFree(records[i]);
+      MemFree(records);
+      MemFree(values);
+      MemFree(numbers);
+   }
+};
+
+/**
+ * Database connections with already created bulk load staging table
+ */
+static HashSet<DB_HANDLE> s_bulkLoadConnections;
+static Mutex s_bulkLoadConnectionsLock(MutexType::FAST);
+
+/**
+ * Create session-local bulk load staging table if it was not created yet for given connection
+ */
+static bool PrepareBulkLoadStagingTable(DB_HANDLE hdb)
+{
+   s_bulkLoadConnectionsLock.lock();
+   bool exists = s_bulkLoadConnections.contains(hdb);
+   s_bulkLoadConnectionsLock.unlock();
+   if (exists)
+      return true;
+
+   if (!DBQuery(hdb, _T("CREATE TEMPORARY TABLE IF NOT EXISTS idata_bulk_load (item_id integer,idata_timestamp bigint,idata_value varchar(255),raw_value varchar(255)) ON COMMIT DELETE ROWS")))
+      return false;
+
+   s_bulkLoadConnectionsLock.lock();
+   s_bulkLoadConnections.put(hdb);
+   s_bulkLoadConnectionsLock.unlock();
+   return true;
+}
+
+/**
+ * Load batch into staging table and move it to target table in single transaction
+ */
+static bool BulkLoadBatch(DB_HANDLE hdb, const TCHAR *transferQuery, BulkLoadBatch_PostgreSQL *batch)
+{
+   if (!DBBegin(hdb))
+      return false;
+
+   bool success =
+            DBBulkLoad(hdb, _T("idata_bulk_load"), _T("item_id,idata_timestamp,idata_value,raw_value"), BULK_LOAD_COLUMNS, batch->count, batch->values) &&
+            DBQuery(hdb, transferQuery);
+   if (success)
+      success = DBCommit(hdb);
+   else
+      DBRollback(hdb);
+   return success;
+}
+
+/**
+ * Write batch prepared for bulk load using regular INSERT statements (used as fallback if bulk load fails)
+ */
+static bool InsertBatch(DB_HANDLE hdb, IDataWriter *writer, BulkLoadBatch_PostgreSQL *batch)
+{
+   TCHAR queryBase[256];
+   bool convertTimestamps = BuildInsertQueryBase_PostgreSQL(writer, queryBase);
+
+   int maxRecordsPerStmt = ConfigReadInt(_T("DBWriter.MaxRecordsPerStatement"), 100);
+   if (maxRecordsPerStmt < 1)
+      maxRecordsPerStmt = 1;
+
+   if (!DBBegin(hdb))
+      return false;
+
+   bool success = true;
+   StringBuffer query;
+   for(int i = 0; success && (i < batch->count); i += maxRecordsPerStmt)
+   {
+      query.clear(false);
+      query.append(queryBase);
+      int end = std::min(i + maxRecordsPerStmt, batch->count);
+      for(int j = i; j < end; j++)
+         AppendInsertRecord_PostgreSQL(query, batch->records[j], j == i, convertTimestamps);
+      query.append(_T(" ON CONFLICT DO NOTHING"));
+      success = DBQuery(hdb, query);
+   }
+
+   if (success)
+      success = DBCommit(hdb);
+   else
+      DBRollback(hdb);
+   return success;
+}
+
+/**
+ * Write prepared batch using bulk load interface
+ */
+static void WriteBulkLoadBatch(IDataWriter *writer, const TCHAR *transferQuery, BulkLoadBatch_PostgreSQL *batch)
+{
+   DB_HANDLE hdb = DBConnectionPoolAcquireConnection();
+   if (!PrepareBulkLoadStagingTable(hdb) || !BulkLoadBatch(hdb, transferQuery, batch))
+   {
+      // Staging table is lost if connection was re-established, so re-create it and retry once
+      s_bulkLoadConnectionsLock.lock();
+      s_bulkLoadConnections.remove(hdb);
+      s_bulkLoadConnectionsLock.unlock();
+      if (!PrepareBulkLoadStagingTable(hdb) || !BulkLoadBatch(hdb, transferQuery, batch))
+      {
+         nxlog_write_tag(NXLOG_ERROR, DEBUG_TAG, _T("Bulk load of %d idata records failed, falling back to INSERT statements"), batch->count);
+         if (!InsertBatch(hdb, writer, batch))
+            nxlog_write_tag(NXLOG_ERROR, DEBUG_TAG, _T("Cannot write %d idata records to database"), batch->count);
+      }
+   }
+   DBConnectionPoolReleaseConnection(hdb);
+
+   InterlockedAdd(&writer->pendingRequests, -batch->count);
+   delete batch;
+}
+
+/**
+ * Worker thread that prepares batches for bulk load into PostgreSQL database
+ */
+static void BulkLoadPrepareThread_PostgreSQL(IDataWriter *writer, ObjectQueue<BulkLoadBatch_PostgreSQL> *batchQueue, int maxRecords)
+{
+   ThreadSetName("DBWriter/BPrep");
+
+   while(true)
+   {
+      DELAYED_IDATA_INSERT *rq = writer->queue->getOrBlock();
+      if (rq == INVALID_POINTER_VALUE)   // End-of-job indicator
+         break;
+
+      auto batch = new BulkLoadBatch_PostgreSQL(maxRecords);
+      while(true)
+      {
+         batch->records[batch->count] = rq;
+         TCHAR *itemId = &batch->numbers[batch->count * 64];
+         TCHAR *timestamp = itemId + 32;
+         IntegerToString(rq->dciId, itemId);
+         IntegerToString(static_cast<int64_t>(rq->timestamp), timestamp);
+         const TCHAR **row = &batch->values[batch->count * BULK_LOAD_COLUMNS];
+         row[0] = itemId;
+         row[1] = timestamp;
+         row[2] = rq->transformedValue;
+         row[3] = rq->rawValue;
+         batch->count++;
+         if (batch->count >= maxRecords)
+            break;
+
+         rq = writer->queue->getOrBlock(500);
+         if ((rq == nullptr) || (rq == INVALID_POINTER_VALUE))
+            break;
+      }
+      InterlockedAdd(&writer->pendingRequests, batch->count);
+      batchQueue->put(batch);
+
+      if (rq == INVALID_POINTER_VALUE)   // End-of-job indicator
+         break;
+   }
+
+   batchQueue->put(INVALID_POINTER_VALUE);
+}
+
+/**
+ * Database "lazy" write thread for idata INSERTs - PostgreSQL version using bulk load (COPY) interface.
+ * Data is loaded into session-local staging table and then moved to target table with single INSERT ... SELECT
+ * (COPY cannot skip duplicate records and cannot convert UNIX timestamps for TimescaleDB tables).
+ * Batches are prepared by background workers and written in parallel if configured, same as for INSERT based writer.
+ */
+static void IDataWriteThreadSingleTable_PostgreSQLBulkLoad(IDataWriter *writer)
+{
+   ThreadSetName("DBWriter/IData");
+
+   bool idataLock;
+   if (writer->storageClass == nullptr)   // Lock is not needed for TimescaleDB
+      idataLock = ((g_flags & AF_DBWRITER_HK_INTERLOCK) != 0);
+   else
+      idataLock = false;
+
+   TCHAR transferQuery[512];
+   if (writer->storageClass != nullptr)   // TimescaleDB
+   {
+      _sntprintf(transferQuery, 512, _T("INSERT INTO idata_sc_%s (item_id,idata_timestamp,idata_value,raw_value) SELECT item_id,to_timestamp(idata_timestamp),idata_value,raw_value FROM idata_bulk_load ON CONFLICT DO NOTHING"), writer->storageClass);
+   }
+   else
+   {
+      _tcscpy(transferQuery, _T("INSERT INTO idata (item_id,idata_timestamp,idata_value,raw_value) SELECT item_id,idata_timestamp,idata_value,raw_value FROM idata_bulk_load ON CONFLICT DO NOTHING"));
+   }
+
+   int maxRecords = ConfigReadInt(_T("DBWriter.MaxRecordsPerTransaction"), 1000);
+   if (maxRecords < 1)
+      maxRecords = 1;
+
+   ObjectQueue<BulkLoadBatch_PostgreSQL> batchQueue(1024, Ownership::False);
+
+   int activeWorkers = std::max(writer->workerCount, 1);
+   THREAD *workerThreads = static_cast<THREAD*>(MemAllocLocal(activeWorkers * sizeof(THREAD)));
+   for(int i = 0; i < activeWorkers; i++)
+      workerThreads[i] = ThreadCreateEx(BulkLoadPrepareThread_PostgreSQL, writer, &batchQueue, maxRecords);
+   int workerCount = activeWorkers;
+
+   ThreadPool *writerPool = nullptr;
+   int numWriters = ConfigReadInt(_T("DBWriter.InsertParallelismDegree"), 1);
+   if (numWriters > 1)
+   {
+      if (!idataLock)
+      {
+         TCHAR poolName[64] = _T("DBWRITE");
+         if (writer->storageClass != nullptr)
+         {
+            _tcscat(poolName, _T("/"));
+            _tcscat(poolName, writer->storageClass);
+            _tcsupr(poolName);
+         }
+         writerPool = ThreadPoolCreate(poolName, numWriters, numWriters);
+         nxlog_write_tag(NXLOG_INFO, DEBUG_TAG, _T("Using parallel bulk load mode for idata (%d writers)"), numWriters);
+      }
+      else
+      {
+         nxlog_write_tag(NXLOG_WARNING, DEBUG_TAG, _T("Parallel write disabled because DBWriter/Housekeeper interlock is ON"));
+      }
+   }
+
+   while(true)
+   {
+      BulkLoadBatch_PostgreSQL *batch = batchQueue.getOrBlock();
+      if (batch == INVALID_POINTER_VALUE)   // End-of-job indicator
+      {
+         activeWorkers--;
+         if (activeWorkers == 0) // We should get end-of-job indicator from each worker
+            break;
+         continue;
+      }
+
+      if (writerPool != nullptr)
+      {
+         ThreadPoolExecute(writerPool,
+            [writer, &transferQuery, batch] ()
+            {
+               WriteBulkLoadBatch(writer, transferQuery, batch);
+            });
+      }
+      else
+      {
+         if (idataLock)
+            s_idataWriteLock.readLock();
+         WriteBulkLoadBatch(writer, transferQuery, batch);
+         if (idataLock)
+            s_idataWriteLock.unlock();
+      }
+   }
+
+   for(int i = 0; i < workerCount; i++)
+      ThreadJoin(workerThreads[i]);
+   MemFreeLocal(workerThreads);
+
+   if (writerPool != nullptr)
+      ThreadPoolDestroy(writerPool);
+}
+
 /**
  * Database "lazy" write thread for idata INSERTs - Oracle version
  */
@@ -987,6 +1277,11 @@ void StartDBWriter()
 
 	if (g_flags & AF_SINGLE_TABLE_PERF_DATA)
 	{
+	   // Use bulk load interface (COPY) for PostgreSQL if driver supports it
+	   bool useBulkLoad = DBIsBulkLoadSupported(g_dbDriver) && ConfigReadBoolean(_T("DBWriter.UseBulkLoad"), true);
+	   if (useBulkLoad && ((g_dbSyntax == DB_SYNTAX_PGSQL) || (g_dbSyntax == DB_SYNTAX_TSDB)))
+	      nxlog_debug_tag(DEBUG_TAG, 1, _T("Using bulk load interface for DCI data writer"));
+
 	   // Always use single writer if performance data stored in single table
       switch(g_dbSyntax)
       {
@@ -1000,7 +1295,7 @@ void StartDBWriter()
          case DB_SYNTAX_PGSQL:
             s_idataWriters[0].storageClass = nullptr;
             s_idataWriters[0].queue = new ObjectQueue<DELAYED_IDATA_INSERT>(4096, Ownership::True, QueuedRequestDestructor);
-            s_idataWriters[0].thread = ThreadCreateEx(IDataWriteThreadSingleTable_PostgreSQL, &s_idataWriters[0]);
+            s_idataWriters[0].thread = ThreadCreateEx(useBulkLoad ? IDataWriteThreadSingleTable_PostgreSQLBulkLoad : IDataWriteThreadSingleTable_PostgreSQL, &s_idataWriters[0]);
             s_idataWriters[0].workerCount = ConfigReadInt(_T("DBWriter.BackgroundWorkers"), 1);
             s_idataWriters[0].pendingRequests = 0;
             break;
@@ -1010,7 +1305,7 @@ void StartDBWriter()
             {
                s_idataWriters[i].storageClass = DCObject::getStorageClassName(static_cast<DCObjectStorageClass>(i));
                s_idataWriters[i].queue = new ObjectQueue<DELAYED_IDATA_INSERT>(4096, Ownership::True, QueuedRequestDestructor);
-               s_idataWriters[i].thread = ThreadCreateEx(IDataWriteThreadSingleTable_PostgreSQL, &s_idataWriters[i]);
+               s_idataWriters[i].thread = ThreadCreateEx(useBulkLoad ? IDataWriteThreadSingleTable_PostgreSQLBulkLoad : IDataWriteThreadSingleTable_PostgreSQL, &s_idataWriters[i]);
                s_idataWriters[i].workerCount = ConfigReadInt(_T("DBWriter.BackgroundWorkers"), 1);
                s_idataWriters[i].pendingRequests = 0;
             }
@@ -26,24 +26,13 @@
 /**
  * Create DCItem from another DCItem
  */
-DCItem::DCItem(const DCItem *src, bool shadowCopy) : DCObject(src, shadowCopy)
+DCItem::DCItem(const DCItem *src, bool shadowCopy) : DCObject(src, shadowCopy), m_valueCache(shadowCopy ? src->m_valueCache : DCItemValueCache(src->getTransformedDataType()))
 {
    m_dataType = src->m_dataType;
    m_transformedDataType = src->m_transformedDataType;
    m_deltaCalculation = src->m_deltaCalculation;
 	m_sampleCount = src->m_sampleCount;
-   m_cacheSize = shadowCopy ? src->m_cacheSize : 0;
    m_requiredCacheSize = shadowCopy ? src->m_requiredCacheSize : 0;
-   if (m_cacheSize > 0)
-   {
-      m_ppValueCache = MemAllocArray<ItemValue*>(m_cacheSize);
-      for(uint32_t i = 0; i < m_cacheSize; i++)
-         m_ppValueCache[i] = new ItemValue(*src->m_ppValueCache[i]);
-   }
-   else
-   {
-      m_ppValueCache = nullptr;
-   }
    m_prevValueTimeStamp = shadowCopy ? src->m_prevValueTimeStamp : 0;
    m_prevDeltaValue = shadowCopy ? src->m_prevDeltaValue : 0;
    m_cacheLoaded = shadowCopy ? src->m_cacheLoaded : false;
@@ -98,9 +87,7 @@ DCItem::DCItem(DB_HANDLE hdb, DB_RESULT hResult, int row, const shared_ptr<DataC
    m_instanceName = DBGetFieldAsSharedString(hResult, row, 11);
    m_templateItemId = DBGetFieldULong(hResult, row, 12);
    m_thresholds = nullptr;
-   m_cacheSize = 0;
    m_requiredCacheSize = 0;
-   m_ppValueCache = nullptr;
    m_prevValueTimeStamp = 0;
    m_prevDeltaValue = 0;
    m_cacheLoaded = false;
@@ -136,6 +123,7 @@ DCItem::DCItem(DB_HANDLE hdb, DB_RESULT hResult, int row, const shared_ptr<DataC
    m_stateFlags = DBGetFieldLong(hResult, row, 37);
    m_allThresholdsRearmEvent = DBGetFieldULong(hResult, row, 38);
    m_transformedDataType = (BYTE)DBGetFieldLong(hResult, row, 39);
+   m_valueCache.setDataType(getTransformedDataType());
 
    int effectivePollingInterval = getEffectivePollingInterval();
    m_startTime = (useStartupDelay && (effectivePollingInterval >= 10)) ? time(nullptr) + rand() % (effectivePollingInterval / 2) : 0;
@@ -172,12 +160,11 @@ DCItem::DCItem(uint32_t id, const TCHAR *name, int source, int dataType, BYTE sc
 {
    m_dataType = dataType;
    m_transformedDataType = DCI_DT_NULL;
+   m_valueCache.setDataType(dataType);
    m_deltaCalculation = DCM_ORIGINAL_VALUE;
 	m_sampleCount = 0;
    m_thresholds = nullptr;
-   m_cacheSize = 0;
    m_requiredCacheSize = 0;
-   m_ppValueCache = nullptr;
    m_prevValueTimeStamp = 0;
    m_prevDeltaValue = 0;
    m_cacheLoaded = false;
@@ -197,11 +184,10 @@ DCItem::DCItem(ConfigEntry *config, const shared_ptr<DataCollectionOwner>& owner
 {
    m_dataType = (BYTE)config->getSubEntryValueAsInt(_T("dataType"));
    m_transformedDataType = (BYTE)config->getSubEntryValueAsInt(_T("transformedDataType"));
+   m_valueCache.setDataType(getTransformedDataType());
    m_deltaCalculation = (BYTE)config->getSubEntryValueAsInt(_T("delta"));
    m_sampleCount = (BYTE)config->getSubEntryValueAsInt(_T("samples"));
-   m_cacheSize = 0;
    m_requiredCacheSize = 0;
-   m_ppValueCache = nullptr;
    m_prevValueTimeStamp = 0;
    m_prevDeltaValue = 0;
    m_cacheLoaded = false;
@@ -259,11 +245,7 @@ void DCItem::deleteAllThresholds()
  */
 void DCItem::clearCache()
 {
-   for(uint32_t i = 0; i < m_cacheSize; i++)
-      delete m_ppValueCache[i];
-   MemFree(m_ppValueCache);
-   m_ppValueCache = nullptr;
-   m_cacheSize = 0;
+   m_valueCache.clear();
 }
 
 /**
@@ -412,7 +394,7 @@ bool DCItem::saveToDatabase(DB_HANDLE hdb)
          DBBind(hStmt, 1, DB_SQLTYPE_INTEGER, m_id);
          DBBind(hStmt, 2, DB_SQLTYPE_VARCHAR, m_prevRawValue.getString(), DB_BIND_STATIC, 255);
          DBBind(hStmt, 3, DB_SQLTYPE_INTEGER, static_cast<int64_t>(m_prevValueTimeStamp));
-         DBBind(hStmt, 4, DB_SQLTYPE_INTEGER, static_cast<int64_t>((m_cacheLoaded  && (m_cacheSize > 0)) ? m_ppValueCache[m_cacheSize - 1]->getTimeStamp() : 0));
+         DBBind(hStmt, 4, DB_SQLTYPE_INTEGER, static_cast<int64_t>((m_cacheLoaded && !m_valueCache.isEmpty()) ? m_valueCache.getTimeStamp(m_valueCache.size() - 1) : 0));
          DBBind(hStmt, 5, DB_SQLTYPE_VARCHAR, m_anomalyDetected ? _T("1") : _T("0"), DB_BIND_STATIC);
          success = DBExecute(hStmt);
          DBFreeStatement(hStmt);
@@ -445,7 +427,7 @@ void DCItem::checkThresholds(ItemValue &value)
 		Threshold *t = m_thresholds->get(i);
 		uint32_t thresholdId = t->getId();
       ItemValue checkValue, thresholdValue;
-      ThresholdCheckResult result = t->check(value, m_ppValueCache, checkValue, thresholdValue, owner, this);
+      ThresholdCheckResult result = t->check(value, m_valueCache, checkValue, thresholdValue, owner, this);
       t->setLastCheckedValue(checkValue);
       switch(result)
       {
@@ -610,6 +592,7 @@ void DCItem::updateFromMessage(const NXCPMessage& msg, uint32_t *numMaps, uint32
 
    m_dataType = (BYTE)msg.getFieldAsUInt16(VID_DCI_DATA_TYPE);
    m_transformedDataType = (BYTE)msg.getFieldAsUInt16(VID_TRANSFORMED_DATA_TYPE);
+   m_valueCache.setDataType(getTransformedDataType());
    m_deltaCalculation = (BYTE)msg.getFieldAsUInt16(VID_DCI_DELTA_CALCULATION);
 	m_sampleCount = msg.getFieldAsInt16(VID_SAMPLE_COUNT);
 	m_multiplier = msg.getFieldAsInt32(VID_MULTIPLIER);
@@ -743,7 +726,7 @@ bool DCItem::processNewValue(time_t tmTimeStamp, const TCHAR *originalValue, boo
 
    m_errorCount = 0;
 
-   if (isStatusDCO() && (tmTimeStamp > m_prevValueTimeStamp) && ((m_cacheSize == 0) || !m_cacheLoaded || (pValue->getUInt32() != m_ppValueCache[0]->getUInt32())))
+   if (isStatusDCO() && (tmTimeStamp > m_prevValueTimeStamp) && (m_valueCache.isEmpty() || !m_cacheLoaded || (pValue->getUInt32() != m_valueCache.getUInt32(0))))
    {
       *updateStatus = true;
    }
@@ -762,11 +745,11 @@ bool DCItem::processNewValue(time_t tmTimeStamp, const TCHAR *originalValue, boo
       m_prevValueTimeStamp = tmTimeStamp;
 
       // Save raw value into database
-      QueueRawDciDataUpdate(tmTimeStamp, m_id, originalValue, pValue->getString(), (m_cacheLoaded && (m_cacheSize > 0)) ? m_ppValueCache[m_cacheSize - 1]->getTimeStamp() : 0, m_anomalyDetected);
+      QueueRawDciDataUpdate(tmTimeStamp, m_id, originalValue, pValue->getString(), (m_cacheLoaded && !m_valueCache.isEmpty()) ? m_valueCache.getTimeStamp(m_valueCache.size() - 1) : 0, m_anomalyDetected);
    }
 
 	// Check if user wants to collect all values or only changed values.
-   if (!isStoreChangesOnly() || (m_cacheLoaded && (m_cacheSize > 0) && _tcscmp(pValue->getString(), m_ppValueCache[0]->getString())))
+   if (!isStoreChangesOnly() || (m_cacheLoaded && !m_valueCache.isEmpty() && _tcscmp(pValue->getString(), m_valueCache.getLastString())))
    {
       //Save transformed value to database
       if (m_retentionType != DC_RETENTION_NONE)
@@ -857,34 +840,22 @@ bool DCItem::processNewValue(time_t tmTimeStamp, const TCHAR *originalValue, boo
       }
    }
 
-   if ((m_cacheSize > 0) && (tmTimeStamp >= m_prevValueTimeStamp))
+   if (!m_valueCache.isEmpty() && (tmTimeStamp >= m_prevValueTimeStamp))
    {
-      delete m_ppValueCache[m_cacheSize - 1];
-      memmove(&m_ppValueCache[1], m_ppValueCache, sizeof(ItemValue *) * (m_cacheSize - 1));
-      m_ppValueCache[0] = pValue;
+      m_valueCache.push(*pValue);
       m_lastValueTimestamp = tmTimeStamp;
    }
    else if (!m_cacheLoaded && (m_requiredCacheSize == 1))
    {
       // If required cache size is 1 and we got value before cache loader
       // loads DCI cache then update it directly
-      for(uint32_t i = 0; i < m_cacheSize; i++)
-         delete m_ppValueCache[i];
-
-      if (m_cacheSize != m_requiredCacheSize)
-      {
-         m_ppValueCache = MemReallocArray(m_ppValueCache, m_requiredCacheSize);
-         m_cacheSize = m_requiredCacheSize;
-      }
-
-      m_ppValueCache[0] = pValue;
+      m_valueCache.clear();
+      m_valueCache.resize(m_requiredCacheSize);
+      m_valueCache.push(*pValue);
       m_cacheLoaded = true;
       m_lastValueTimestamp = tmTimeStamp;
    }
-   else
-   {
-      delete pValue;
-   }
+   delete pValue;
 
    unlock();
 
@@ -1045,7 +1016,7 @@ void DCItem::generateEventsAfterMaintenance()
                .param(_T("dciId"), m_id, EventBuilder::OBJECT_ID_FORMAT)
                .param(_T("instance"), m_instanceName)
                .param(_T("isRepeatedEvent"), _T("0"))
-               .param(_T("dciValue"), (m_cacheLoaded && (m_cacheSize > 0)) ? m_ppValueCache[0]->getString() : _T(""))
+               .param(_T("dciValue"), (m_cacheLoaded && !m_valueCache.isEmpty()) ? m_valueCache.getLastString() : _T(""))
                .param(_T("operation"), t->getOperation())
                .param(_T("function"), t->getFunction())
                .param(_T("pollCount"), t->getSampleCount())
@@ -1062,7 +1033,7 @@ void DCItem::generateEventsAfterMaintenance()
                .param(_T("instance"), m_instanceName)
                .param(_T("thresholdValue"), t->getStringValue())
                .param(_T("currentValue"), t->getLastCheckValue().getString())
-               .param(_T("dciValue"), (m_cacheLoaded && (m_cacheSize > 0)) ? m_ppValueCache[0]->getString() : _T(""))
+               .param(_T("dciValue"), (m_cacheLoaded && !m_valueCache.isEmpty()) ? m_valueCache.getLastString() : _T(""))
                .param(_T("operation"), t->getOperation())
                .param(_T("function"), t->getFunction())
                .param(_T("pollCount"), t->getSampleCount())
@@ -1282,7 +1253,8 @@ bool DCItem::transform(ItemValue &value, time_t elapsedTime)
 
    if (m_transformationScript != nullptr)
    {
-      ScriptVMHandle vm = CreateServerScriptVM(m_transformationScript, m_owner.lock(), createDescriptorInternal());
+      uint64_t vmVersion;
+      ScriptVMHandle vm = acquireTransformationVM(&vmVersion);
       if (vm.isValid())
       {
          NXSL_Value *nxslValue = vm->createValue(value.getString());
@@ -1347,7 +1319,7 @@ bool DCItem::transform(ItemValue &value, time_t elapsedTime)
                m_lastScriptErrorReport = now;
             }
          }
-         vm.destroy();
+         releaseTransformationVM(vm, vmVersion);
       }
       else if (vm.failureReason() == ScriptVMFailureReason::SCRIPT_IS_EMPTY)
       {
@@ -1439,44 +1411,43 @@ void DCItem::updateCacheSizeInternal(bool allowLoad)
       }
 
 		m_requiredCacheSize = requiredSize;
+
+      // Maintain rolling aggregates for windows used by thresholds (thresholds with same window share one)
+      IntegerArray<uint32_t> windows;
+      for(int i = 0; i < getThresholdCount(); i++)
+      {
+         uint32_t window = m_thresholds->get(i)->getAggregateWindow();
+         if ((window > 0) && (windows.indexOf(window) == -1))
+            windows.add(window);
+      }
+      m_valueCache.setAggregateWindows(windows);
    }
    else
    {
       m_requiredCacheSize = 0;
+      m_valueCache.setAggregateWindows(IntegerArray<uint32_t>());
    }
 
    nxlog_debug_tag(DEBUG_TAG_DC_CACHE, 8, _T("DCItem::updateCacheSizeInternal(dci=\"%s\", node=%s [%d]): requiredSize=%d cacheSize=%d"),
-            m_name.cstr(), owner->getName(), owner->getId(), m_requiredCacheSize, m_cacheSize);
+            m_name.cstr(), owner->getName(), owner->getId(), m_requiredCacheSize, m_valueCache.size());
 
    // Update cache if needed
-   if (m_requiredCacheSize < m_cacheSize)
+   if (m_requiredCacheSize < m_valueCache.size())
    {
       // Destroy unneeded values
-      if (m_cacheSize > 0)
-		{
-         for(uint32_t i = m_requiredCacheSize; i < m_cacheSize; i++)
-            delete m_ppValueCache[i];
-		}
-
-      m_cacheSize = m_requiredCacheSize;
-      if (m_cacheSize > 0)
-      {
-         m_ppValueCache = MemReallocArray(m_ppValueCache, m_cacheSize);
-      }
+      if (m_requiredCacheSize > 0)
+         m_valueCache.resize(m_requiredCacheSize);
       else
-      {
-         MemFree(m_ppValueCache);
-         m_ppValueCache = nullptr;
-      }
+         m_valueCache.clear();
    }
-   else if (m_requiredCacheSize > m_cacheSize)
+   else if (m_requiredCacheSize > m_valueCache.size())
    {
       // Load missing values from database
       // Skip caching for DCIs where estimated time to fill the cache is less then 5 minutes
       // to reduce load on database at server startup
       if (allowLoad &&
           (m_ownerId != 0) &&
-          (((m_requiredCacheSize - m_cacheSize) * getEffectivePollingInterval() > 300) ||
+          (((m_requiredCacheSize - m_valueCache.size()) * getEffectivePollingInterval() > 300) ||
            (m_source == DS_PUSH_AGENT) ||
            (m_pollingScheduleType == DC_POLLING_SCHEDULE_ADVANCED)))
       {
@@ -1486,11 +1457,9 @@ void DCItem::updateCacheSizeInternal(bool allowLoad)
       else
       {
          // will not read data from database, fill cache with empty values
-         m_ppValueCache = MemReallocArray(m_ppValueCache, m_requiredCacheSize);
-         for(uint32_t i = m_cacheSize; i < m_requiredCacheSize; i++)
-            m_ppValueCache[i] = new ItemValue(_T(""), 1);
+         m_valueCache.resize(m_requiredCacheSize);
+         m_valueCache.appendPlaceholders(m_requiredCacheSize - m_valueCache.size());
          nxlog_debug_tag(DEBUG_TAG_DC_CACHE, 7, _T("Cache load skipped for parameter %s [%u]"), m_name.cstr(), m_id);
-         m_cacheSize = m_requiredCacheSize;
          m_cacheLoaded = true;
       }
    }
@@ -1510,7 +1479,7 @@ void DCItem::loadCache()
 void DCItem::reloadCache(bool forceReload)
 {
    lock();
-   if (!forceReload && m_cacheLoaded && (m_cacheSize == m_requiredCacheSize))
+   if (!forceReload && m_cacheLoaded && (m_valueCache.size() == m_requiredCacheSize))
    {
       unlock();
       return;  // Cache already fully populated
@@ -1611,55 +1580,37 @@ void DCItem::reloadCache(bool forceReload)
 
    // While reload request was in queue DCI cache may have been already filled
    lock();
-   if (forceReload || !m_cacheLoaded || (m_cacheSize != m_requiredCacheSize))
+   if (forceReload || !m_cacheLoaded || (m_valueCache.size() != m_requiredCacheSize))
    {
-      for(uint32_t i = 0; i < m_cacheSize; i++)
-         delete m_ppValueCache[i];
-
-      if (m_cacheSize != m_requiredCacheSize)
-      {
-         m_ppValueCache = MemReallocArray(m_ppValueCache, m_requiredCacheSize);
-      }
-
       nxlog_debug_tag(DEBUG_TAG_DC_CACHE, 8, _T("DCItem::reloadCache(dci=\"%s\", node=%s [%d]): requiredSize=%d cacheSize=%d"),
-               m_name.cstr(), getOwnerName(), m_ownerId, m_requiredCacheSize, m_cacheSize);
+               m_name.cstr(), getOwnerName(), m_ownerId, m_requiredCacheSize, m_valueCache.size());
+
+      m_valueCache.clear();
+      m_valueCache.resize(m_requiredCacheSize);
       if (hResult != nullptr)
       {
          // Create cache entries
-         bool moreData = true;
-         uint32_t i;
-         for(i = 0; (i < m_requiredCacheSize) && moreData; i++)
+         while((m_valueCache.size() < m_requiredCacheSize) && DBFetch(hResult))
          {
-            moreData = DBFetch(hResult);
-            if (moreData)
-            {
-               DBGetField(hResult, 0, szBuffer, MAX_DB_STRING);
-               m_ppValueCache[i] = new ItemValue(szBuffer, DBGetFieldULong(hResult, 1));
-            }
-            else
-            {
-               m_ppValueCache[i] = new ItemValue(_T(""), 1);   // Empty value
-            }
+            DBGetField(hResult, 0, szBuffer, MAX_DB_STRING);
+            m_valueCache.append(szBuffer, DBGetFieldULong(hResult, 1));
          }
 
          // Fill up cache with empty values if we don't have enough values in database
-         if (i < m_requiredCacheSize)
+         if (m_valueCache.size() < m_requiredCacheSize)
          {
             nxlog_debug_tag(DEBUG_TAG_DC_CACHE, 8, _T("DCItem::reloadCache(dci=\"%s\", node=%s [%d]): %d values missing in DB"),
-                     m_name.cstr(), getOwnerName(), m_ownerId, m_requiredCacheSize - i);
-            for(; i < m_requiredCacheSize; i++)
-               m_ppValueCache[i] = new ItemValue(_T(""), 1);
+                     m_name.cstr(), getOwnerName(), m_ownerId, m_requiredCacheSize - m_valueCache.size());
+            m_valueCache.appendPlaceholders(m_requiredCacheSize - m_valueCache.size());
          }
          DBFreeResult(hResult);
       }
       else
       {
          // Error reading data from database, fill cache with empty values
-         for(uint32_t i = 0; i < m_requiredCacheSize; i++)
-            m_ppValueCache[i] = new ItemValue(_T(""), 1);
+         m_valueCache.appendPlaceholders(m_requiredCacheSize);
       }
 
-      m_cacheSize = m_requiredCacheSize;
       m_cacheLoaded = true;
    }
    else if (hResult != nullptr)
@@ -1677,7 +1628,7 @@ void DCItem::reloadCache(bool forceReload)
 uint64_t DCItem::getCacheMemoryUsage() const
 {
    lock();
-   uint64_t size = m_cacheSize * (sizeof(ItemValue) + sizeof(ItemValue*));
+   uint64_t size = m_valueCache.getMemoryUsage();
    unlock();
    return size;
 }
@@ -1689,12 +1640,12 @@ void DCItem::fillLastValueMessage(NXCPMessage *msg)
 {
    lock();
    msg->setField(VID_DCI_SOURCE_TYPE, m_source);
-   if (m_cacheSize > 0)
+   if (!m_valueCache.isEmpty())
    {
       msg->setField(VID_DCI_DATA_TYPE, static_cast<uint16_t>(getTransformedDataType()));
-      msg->setField(VID_VALUE, m_ppValueCache[0]->getString());
+      msg->setField(VID_VALUE, m_valueCache.getLastString());
       msg->setField(VID_RAW_VALUE, m_prevRawValue.getString());
-      msg->setFieldFromTime(VID_TIMESTAMP, m_ppValueCache[0]->getTimeStamp());
+      msg->setFieldFromTime(VID_TIMESTAMP, m_valueCache.getTimeStamp(0));
    }
    else
    {
@@ -1718,11 +1669,11 @@ void DCItem::fillLastValueSummaryMessage(NXCPMessage *msg, uint32_t baseId, cons
    msg->setField(baseId++, m_flags);
    msg->setField(baseId++, m_description);
    msg->setField(baseId++, static_cast<uint16_t>(m_source));
-   if (m_cacheSize > 0)
+   if (!m_valueCache.isEmpty())
    {
       msg->setField(baseId++, static_cast<uint16_t>(getTransformedDataType()));
-      msg->setField(baseId++, m_ppValueCache[0]->getString());
-      msg->setFieldFromTime(baseId++, m_ppValueCache[0]->getTimeStamp());
+      msg->setField(baseId++, m_valueCache.getLastString());
+      msg->setFieldFromTime(baseId++, m_valueCache.getTimeStamp(0));
    }
    else
    {
@@ -1836,14 +1787,14 @@ NXSL_Value *DCItem::getValueForNXSL(NXSL_VM *vm, int function, int sampleCount)
    {
       case F_LAST:
          // cache placeholders will have timestamp 1
-         value = (m_cacheLoaded && (m_cacheSize > 0) && (m_ppValueCache[0]->getTimeStamp() != 1)) ? vm->createValue(m_ppValueCache[0]->getString()) : vm->createValue();
+         value = (m_cacheLoaded && !m_valueCache.isEmpty() && !m_valueCache.isPlaceholder(0)) ? vm->createValue(m_valueCache.getLastString()) : vm->createValue();
          CastNXSLValue(value, getTransformedDataType());
          break;
       case F_DIFF:
-         if (m_cacheLoaded && (m_cacheSize >= 2))
+         if (m_cacheLoaded && (m_valueCache.size() >= 2))
          {
             ItemValue result;
-            CalculateItemValueDiff(&result, getTransformedDataType(), *m_ppValueCache[0], *m_ppValueCache[1]);
+            CalculateItemValueDiff(&result, getTransformedDataType(), m_valueCache.get(0), m_valueCache.get(1));
             value = vm->createValue(result.getString());
          }
          else
@@ -1852,10 +1803,10 @@ NXSL_Value *DCItem::getValueForNXSL(NXSL_VM *vm, int function, int sampleCount)
          }
          break;
       case F_AVERAGE:
-         if (m_cacheLoaded && (m_cacheSize > 0))
+         if (m_cacheLoaded && !m_valueCache.isEmpty() && (sampleCount > 0))
          {
             ItemValue result;
-            CalculateItemValueAverage(&result, getTransformedDataType(), m_ppValueCache, std::min(m_cacheSize, static_cast<uint32_t>(sampleCount)));
+            CalculateItemValueAverage(&result, getTransformedDataType(), m_valueCache, static_cast<uint32_t>(sampleCount));
             value = vm->createValue(result.getString());
             CastNXSLValue(value, getTransformedDataType());
          }
@@ -1865,10 +1816,12 @@ NXSL_Value *DCItem::getValueForNXSL(NXSL_VM *vm, int function, int sampleCount)
          }
          break;
       case F_MEAN_DEVIATION:
-         if (m_cacheLoaded && (m_cacheSize > 0))
+         if (m_cacheLoaded && !m_valueCache.isEmpty() && (sampleCount > 0))
          {
+            ObjectArray<ItemValue> values(sampleCount, 16, Ownership::True);
+            getCachedValues(&values, sampleCount);
             ItemValue result;
-            CalculateItemValueMeanDeviation(&result, getTransformedDataType(), m_ppValueCache, std::min(m_cacheSize, static_cast<uint32_t>(sampleCount)));
+            CalculateItemValueMeanDeviation(&result, getTransformedDataType(), values.getBuffer(), values.size());
             value = vm->createValue(result.getString());
          }
          else
@@ -1887,13 +1840,23 @@ NXSL_Value *DCItem::getValueForNXSL(NXSL_VM *vm, int function, int sampleCount)
    return value;
 }
 
+/**
+ * Get up to given number of most recent cached values (must be called with DCI locked)
+ */
+void DCItem::getCachedValues(ObjectArray<ItemValue> *values, int count) const
+{
+   uint32_t size = std::min(m_valueCache.size(), static_cast<uint32_t>(count));
+   for(uint32_t i = 0; i < size; i++)
+      values->add(new ItemValue(m_valueCache.get(i)));
+}
+
 /**
  * Get last value
  */
 const TCHAR *DCItem::getLastValue()
 {
    lock();
-   const TCHAR *v = (m_cacheSize > 0) ? (const TCHAR *)m_ppValueCache[0]->getString() : nullptr;
+   const TCHAR *v = !m_valueCache.isEmpty() ? m_valueCache.getLastString() : nullptr;
    unlock();
    return v;
 }
@@ -1904,7 +1867,7 @@ const TCHAR *DCItem::getLastValue()
 ItemValue *DCItem::getInternalLastValue()
 {
    lock();
-   ItemValue *v = (m_cacheSize > 0) ? new ItemValue(*m_ppValueCache[0]) : nullptr;
+   ItemValue *v = !m_valueCache.isEmpty() ? new ItemValue(m_valueCache.get(0)) : nullptr;
    unlock();
    return v;
 }
@@ -2086,17 +2049,8 @@ bool DCItem::deleteEntry(time_t timestamp)
       return false;
 
    lock();
-   for(uint32_t i = 0; i < m_cacheSize; i++)
-   {
-      if (m_ppValueCache[i]->getTimeStamp() == timestamp)
-      {
-         delete m_ppValueCache[i];
-         memmove(&m_ppValueCache[i], &m_ppValueCache[i + 1], sizeof(ItemValue *) * (m_cacheSize - (i + 1)));
-         m_cacheSize--;
-         updateCacheSizeInternal(true);
-         break;
-      }
-   }
+   if (m_valueCache.remove(timestamp))
+      updateCacheSizeInternal(true);
    unlock();
 
    return success;
@@ -2120,6 +2074,7 @@ void DCItem::updateFromTemplate(DCObject *src)
 
    m_dataType = item->m_dataType;
    m_transformedDataType = item->m_transformedDataType;
+   m_valueCache.setDataType(getTransformedDataType());
    m_deltaCalculation = item->m_deltaCalculation;
    m_sampleCount = item->m_sampleCount;
    m_snmpRawValueType = item->m_snmpRawValueType;
@@ -2457,6 +2412,7 @@ void DCItem::updateFromImport(ConfigEntry *config, bool nxslV5)
    lock();
    m_dataType = (BYTE)config->getSubEntryValueAsInt(_T("dataType"));
    m_transformedDataType = (BYTE)config->getSubEntryValueAsInt(_T("transformedDataType"));
+   m_valueCache.setDataType(getTransformedDataType());
    m_deltaCalculation = (BYTE)config->getSubEntryValueAsInt(_T("delta"));
    m_sampleCount = (BYTE)config->getSubEntryValueAsInt(_T("samples"));
    m_snmpRawValueType = static_cast<uint16_t>(config->getSubEntryValueAsInt(_T("snmpRawValueType")));
@@ -2553,12 +2509,8 @@ void DCItem::recalculateValue(ItemValue &value)
       m_prevValueTimeStamp = value.getTimeStamp();
    }
 
-   if ((m_cacheSize > 0) && (value.getTimeStamp() >= m_prevValueTimeStamp))
-   {
-      delete m_ppValueCache[m_cacheSize - 1];
-      memmove(&m_ppValueCache[1], m_ppValueCache, sizeof(ItemValue *) * (m_cacheSize - 1));
-      m_ppValueCache[0] = new ItemValue(value);
-   }
+   if (!m_valueCache.isEmpty() && (value.getTimeStamp() >= m_prevValueTimeStamp))
+      m_valueCache.push(value);
 
    m_lastPoll = value.getTimeStamp();
 }
@@ -20,6 +20,7 @@
 **/
 
 #include "nxcore.h"
+#include <uthash.h>
 
 /**
  * Default constructor
@@ -284,6 +285,47 @@ void CalculateItemValueAverage(ItemValue *result, int dataType, const ItemValue
    }
 }
 
+/**
+ * Calculate average value for given number of most recent cached values of given type
+ */
+template<typename T> static T CalculateAverage(const DCItemValueCache& cache, uint32_t sampleCount)
+{
+   uint32_t count = std::min(cache.size(), sampleCount) - cache.getPlaceholderCount(sampleCount);
+   return (count > 0) ? cache.getSum<T>(sampleCount) / static_cast<T>(count) : 0;
+}
+
+/**
+ * Calculate average value for given number of most recent cached values
+ */
+void CalculateItemValueAverage(ItemValue *result, int dataType, const DCItemValueCache& cache, uint32_t sampleCount)
+{
+   switch(dataType)
+   {
+      case DCI_DT_INT:
+         *result = CalculateAverage<int32_t>(cache, sampleCount);
+         break;
+      case DCI_DT_UINT:
+      case DCI_DT_COUNTER32:
+         *result = CalculateAverage<uint32_t>(cache, sampleCount);
+         break;
+      case DCI_DT_INT64:
+         *result = CalculateAverage<int64_t>(cache, sampleCount);
+         break;
+      case DCI_DT_UINT64:
+      case DCI_DT_COUNTER64:
+         *result = CalculateAverage<uint64_t>(cache, sampleCount);
+         break;
+      case DCI_DT_FLOAT:
+         *result = CalculateAverage<double>(cache, sampleCount);
+         break;
+      case DCI_DT_STRING:
+         *result = _T("");   // Average value for string is meaningless
+         break;
+      default:
+         break;
+   }
+}
+
 /**
  * Calculate total value for values of given type
  */
@@ -526,3 +568,766 @@ void CalculateItemValueMax(ItemValue *result, int nDataType, const ItemValue * c
          break;
    }
 }
+
+/**
+ * Number of shards in DCI string store
+ */
+#define STRING_STORE_SHARDS   32
+
+/**
+ * String in DCI string store
+ */
+struct StoredString
+{
+   UT_hash_handle hh;
+   uint32_t refCount;
+   uint32_t shard;
+   size_t length;
+   TCHAR value[1];   // Actual size determined by string length
+};
+
+/**
+ * DCI string store
+ */
+static StoredString *s_stringStore[STRING_STORE_SHARDS];
+static Mutex s_stringStoreLock[STRING_STORE_SHARDS];
+static VolatileCounter64 s_stringStoreMemoryUsage = 0;
+
+/**
+ * Acquire string from string store. Will add new string to the store if needed.
+ */
+static const TCHAR *AcquireStoredString(const TCHAR *value)
+{
+   size_t length = _tcslen(value);
+   uint32_t hash = 0;
+   for(const TCHAR *p = value; *p != 0; p++)
+      hash = hash * 31 + static_cast<uint32_t>(*p);
+   uint32_t shard = hash % STRING_STORE_SHARDS;
+
+   s_stringStoreLock[shard].lock();
+   StoredString *s;
+   HASH_FIND(hh, s_stringStore[shard], value, length * sizeof(TCHAR), s);
+   if (s == nullptr)
+   {
+      size_t size = sizeof(StoredString) + length * sizeof(TCHAR);
+      s = static_cast<StoredString*>(MemAlloc(size));
+      s->refCount = 1;
+      s->shard = shard;
+      s->length = length;
+      memcpy(s->value, value, (length + 1) * sizeof(TCHAR));
+      HASH_ADD_KEYPTR(hh, s_stringStore[shard], s->value, length * sizeof(TCHAR), s);
+      InterlockedAdd64(&s_stringStoreMemoryUsage, size);
+   }
+   else
+   {
+      s->refCount++;
+   }
+   s_stringStoreLock[shard].unlock();
+   return s->value;
+}
+
+/**
+ * Release string previously acquired from string store
+ */
+static void ReleaseStoredString(const TCHAR *value)
+{
+   StoredString *s = reinterpret_cast<StoredString*>(const_cast<char*>(reinterpret_cast<const char*>(value)) - offsetof(StoredString, value));
+   uint32_t shard = s->shard;
+   s_stringStoreLock[shard].lock();
+   if (--s->refCount == 0)
+   {
+      HASH_DEL(s_stringStore[shard], s);
+      InterlockedAdd64(&s_stringStoreMemoryUsage, -static_cast<int64_t>(sizeof(StoredString) + s->length * sizeof(TCHAR)));
+      MemFree(s);
+   }
+   s_stringStoreLock[shard].unlock();
+}
+
+/**
+ * Get memory used by DCI string store
+ */
+uint64_t GetDCIStringStoreMemoryUsage()
+{
+   return static_cast<uint64_t>(s_stringStoreMemoryUsage);
+}
+
+/**
+ * Create empty value cache
+ */
+DCItemValueCache::DCItemValueCache(int dataType)
+{
+   m_samples = nullptr;
+   m_capacity = 0;
+   m_size = 0;
+   m_head = 0;
+   m_dataType = dataType;
+   m_lastString = nullptr;
+   m_lastStringCapacity = 0;
+   m_sequence = 0;
+   m_windows = nullptr;
+}
+
+/**
+ * Copy constructor
+ */
+DCItemValueCache::DCItemValueCache(const DCItemValueCache& src)
+{
+   m_capacity = src.m_capacity;
+   m_size = src.m_size;
+   m_head = 0;
+   m_dataType = src.m_dataType;
+   m_samples = (m_capacity > 0) ? MemAllocArrayNoInit<Sample>(m_capacity) : nullptr;
+   for(uint32_t i = 0; i < m_size; i++)
+   {
+      m_samples[i] = src.sample(i);
+      if (isStringType())
+         m_samples[i].value.s = AcquireStoredString(m_samples[i].value.s);
+   }
+   m_lastStringCapacity = src.m_lastStringCapacity;
+   m_lastString = (src.m_lastString != nullptr) ? MemCopyBlock(src.m_lastString, m_lastStringCapacity * sizeof(TCHAR)) : nullptr;
+   m_sequence = src.m_sequence;
+   if (src.m_windows != nullptr)
+   {
+      m_windows = new ObjectArray<AggregateWindow>(src.m_windows->size(), 4, Ownership::True);
+      for(int i = 0; i < src.m_windows->size(); i++)
+         m_windows->add(new AggregateWindow(*src.m_windows->get(i)));
+   }
+   else
+   {
+      m_windows = nullptr;
+   }
+}
+
+/**
+ * Destructor
+ */
+DCItemValueCache::~DCItemValueCache()
+{
+   clear();
+   delete m_windows;
+}
+
+/**
+ * Store value in given sample
+ */
+void DCItemValueCache::setSample(Sample *s, const ItemValue& value)
+{
+   s->timestamp = value.getTimeStamp();
+   if (isStringType())
+      s->value.s = AcquireStoredString(value.getString());
+   else if (m_dataType == DCI_DT_FLOAT)
+      s->value.d = value.getDouble();
+   else if (isUnsignedType())
+      s->value.i = static_cast<int64_t>(value.getUInt64());
+   else
+      s->value.i = value.getInt64();
+}
+
+/**
+ * Store value in given sample
+ */
+void DCItemValueCache::setSample(Sample *s, const TCHAR *value, time_t timestamp)
+{
+   s->timestamp = (timestamp == 0) ? time(nullptr) : timestamp;
+   if (isStringType())
+      s->value.s = AcquireStoredString(value);
+   else if (m_dataType == DCI_DT_FLOAT)
+      s->value.d = _tcstod(value, nullptr);
+   else if (isUnsignedType())
+      s->value.i = static_cast<int64_t>(_tcstoull(value, nullptr, 0));
+   else
+      s->value.i = _tcstoll(value, nullptr, 0);
+}
+
+/**
+ * Release resources held by sample
+ */
+void DCItemValueCache::releaseSample(Sample *s)
+{
+   if (isStringType())
+      ReleaseStoredString(s->value.s);
+}
+
+/**
+ * Convert cached floating point value to string without loss of precision (shortest representation that converts back to same value)
+ */
+static void FloatSampleToString(double value, TCHAR *buffer)
+{
+   _sntprintf(buffer, 64, _T("%.15g"), value);
+   if (_tcstod(buffer, nullptr) != value)
+      _sntprintf(buffer, 64, _T("%.17g"), value);
+}
+
+/**
+ * Set string representation of most recent value
+ */
+void DCItemValueCache::setLastString(const TCHAR *value)
+{
+   size_t len = _tcslen(value) + 1;
+   if (len > m_lastStringCapacity)
+   {
+      m_lastStringCapacity = (len + 15) & ~static_cast<size_t>(15);
+      m_lastString = MemRealloc(m_lastString, m_lastStringCapacity * sizeof(TCHAR));
+   }
+   memcpy(m_lastString, value, len * sizeof(TCHAR));
+}
+
+/**
+ * Update string representation of most recent value from stored sample
+ */
+void DCItemValueCache::updateLastString()
+{
+   if (m_size == 0)
+   {
+      MemFreeAndNull(m_lastString);
+      m_lastStringCapacity = 0;
+      return;
+   }
+
+   const Sample& s = sample(0);
+   if (s.timestamp == 1)
+   {
+      setLastString(_T(""));
+   }
+   else if (isStringType())
+   {
+      setLastString(s.value.s);
+   }
+   else
+   {
+      TCHAR buffer[64];
+      if (m_dataType == DCI_DT_FLOAT)
+         FloatSampleToString(s.value.d, buffer);
+      else if (isUnsignedType())
+         IntegerToString(static_cast<uint64_t>(s.value.i), buffer);
+      else
+         IntegerToString(s.value.i, buffer);
+      setLastString(buffer);
+   }
+}
+
+/**
+ * Move samples into new buffer of given capacity (most recent sample will be at position 0).
+ * Oldest samples that do not fit into new buffer are released.
+ */
+void DCItemValueCache::linearize(uint32_t capacity)
+{
+   Sample *samples = (capacity > 0) ? MemAllocArrayNoInit<Sample>(capacity) : nullptr;
+   uint32_t count = std::min(m_size, capacity);
+   for(uint32_t i = 0; i < count; i++)
+      samples[i] = sample(i);
+   for(uint32_t i = count; i < m_size; i++)
+      releaseSample(&sample(i));
+   MemFree(m_samples);
+   m_samples = samples;
+   m_capacity = capacity;
+   m_size = count;
+   m_head = 0;
+   if (m_size == 0)
+      updateLastString();
+   invalidateAggregateWindows();
+}
+
+/**
+ * Change data type of cached values. Existing samples are converted to new type.
+ */
+void DCItemValueCache::setDataType(int dataType)
+{
+   if (dataType == m_dataType)
+      return;
+
+   bool wasString = isStringType();
+   bool wasFloat = (m_dataType == DCI_DT_FLOAT);
+   bool wasUnsigned = isUnsignedType();
+   m_dataType = dataType;
+   invalidateAggregateWindows();
+   if ((wasString == isStringType()) && (wasFloat == (m_dataType == DCI_DT_FLOAT)))
+      return;  // Same storage format (signed and unsigned integers share representation)
+
+   for(uint32_t i = 0; i < m_size; i++)
+   {
+      Sample& s = sample(i);
+      if (wasString)
+      {
+         const TCHAR *value = s.value.s;
+         setSample(&s, value, s.timestamp);
+         ReleaseStoredString(value);
+      }
+      else if (isStringType())
+      {
+         TCHAR buffer[64];
+         if (s.timestamp == 1)
+            buffer[0] = 0;
+         else if (wasFloat)
+            FloatSampleToString(s.value.d, buffer);
+         else if (wasUnsigned)
+            IntegerToString(static_cast<uint64_t>(s.value.i), buffer);
+         else
+            IntegerToString(s.value.i, buffer);
+         s.value.s = AcquireStoredString(buffer);
+      }
+      else if (wasFloat)
+      {
+         s.value.i = isUnsignedType() ? static_cast<int64_t>(static_cast<uint64_t>(s.value.d)) : static_cast<int64_t>(s.value.d);
+      }
+      else
+      {
+         s.value.d = wasUnsigned ? static_cast<double>(static_cast<uint64_t>(s.value.i)) : static_cast<double>(s.value.i);
+      }
+   }
+}
+
+/**
+ * Change cache capacity. Oldest values are dropped if new capacity is less than current number of values.
+ */
+void DCItemValueCache::resize(uint32_t capacity)
+{
+   if (capacity != m_capacity)
+      linearize(capacity);
+}
+
+/**
+ * Remove all values from cache and release memory
+ */
+void DCItemValueCache::clear()
+{
+   for(uint32_t i = 0; i < m_size; i++)
+      releaseSample(&sample(i));
+   MemFreeAndNull(m_samples);
+   m_capacity = 0;
+   m_size = 0;
+   m_head = 0;
+   MemFreeAndNull(m_lastString);
+   m_lastStringCapacity = 0;
+   invalidateAggregateWindows();
+}
+
+/**
+ * Add new value as most recent one. Oldest value will be dropped if cache is full.
+ */
+void DCItemValueCache::push(const ItemValue& value)
+{
+   if (m_capacity == 0)
+      return;
+
+   // Remove values leaving covered range from aggregate windows
+   if (m_windows != nullptr)
+   {
+      for(int i = 0; i < m_windows->size(); i++)
+      {
+         AggregateWindow *w = m_windows->get(i);
+         if (!w->valid)
+            continue;
+         uint32_t index = std::min(w->count, m_capacity) - 1;
+         if (index >= m_size)
+            continue;
+         const Sample& s = sample(index);
+         if (s.timestamp == 1)
+            w->placeholders--;
+         if (m_dataType == DCI_DT_FLOAT)
+         {
+            if (std::isfinite(s.value.d))
+            {
+               w->dsum -= s.value.d;
+               w->sumOfSquares -= s.value.d * s.value.d;
+            }
+            else
+            {
+               w->valid = false;
+            }
+         }
+         else
+         {
+            w->isum -= static_cast<uint64_t>(s.value.i);
+            double d = sampleAsDouble(s);
+            w->sumOfSquares -= d * d;
+         }
+      }
+   }
+
+   m_head = (m_head + m_capacity - 1) % m_capacity;
+   if (m_size == m_capacity)
+      releaseSample(&m_samples[m_head]);  // Slot was occupied by oldest value
+   else
+      m_size++;
+   setSample(&m_samples[m_head], value);
+   setLastString(value.getString());
+   m_sequence++;
+
+   if (m_windows != nullptr)
+   {
+      const Sample& s = m_samples[m_head];
+      for(int i = 0; i < m_windows->size(); i++)
+      {
+         AggregateWindow *w = m_windows->get(i);
+         if (!w->valid)
+            continue;
+
+         // Drop min/max candidates that left the window
+         uint32_t size = std::min(w->count, m_capacity);
+         while(!w->minQueue.isEmpty() && (w->minQueue.front() + size <= m_sequence))
+            w->minQueue.popFront();
+         while(!w->maxQueue.isEmpty() && (w->maxQueue.front() + size <= m_sequence))
+            w->maxQueue.popFront();
+
+         addToAggregateWindow(w, s, m_sequence);
+
+         // Recalculate periodically to avoid accumulation of floating point rounding errors
+         if (((m_dataType == DCI_DT_FLOAT) && !std::isfinite(s.value.d)) || (++w->updates >= w->count))
+            w->valid = false;
+      }
+   }
+}
+
+/**
+ * Add value as oldest one (used by cache loader). Value is ignored if cache is full.
+ */
+void DCItemValueCache::append(const TCHAR *value, time_t timestamp)
+{
+   if (m_size == m_capacity)
+      return;
+
+   setSample(&m_samples[(m_head + m_size) % m_capacity], value, timestamp);
+   if (m_size == 0)
+      setLastString(value);
+   m_size++;
+   invalidateAggregateWindows();
+}
+
+/**
+ * Fill cache with given number of placeholder values (empty values with timestamp 1)
+ */
+void DCItemValueCache::appendPlaceholders(uint32_t count)
+{
+   for(uint32_t i = 0; (i < count) && (m_size < m_capacity); i++)
+      append(_T(""), 1);
+}
+
+/**
+ * Remove value with given timestamp. Returns true if value was found.
+ */
+bool DCItemValueCache::remove(time_t timestamp)
+{
+   for(uint32_t i = 0; i < m_size; i++)
+   {
+      if (sample(i).timestamp == timestamp)
+      {
+         releaseSample(&sample(i));
+         for(uint32_t j = i + 1; j < m_size; j++)
+            sample(j - 1) = sample(j);
+         m_size--;
+         if (i == 0)
+            updateLastString();
+         invalidateAggregateWindows();
+         return true;
+      }
+   }
+   return false;
+}
+
+/**
+ * Get value at given position as signed 64 bit integer
+ */
+int64_t DCItemValueCache::getInt64(uint32_t index) const
+{
+   const Sample& s = sample(index);
+   if (isStringType())
+      return _tcstoll(s.value.s, nullptr, 0);
+   if (m_dataType == DCI_DT_FLOAT)
+      return static_cast<int64_t>(s.value.d);
+   return s.value.i;
+}
+
+/**
+ * Get value at given position as unsigned 64 bit integer
+ */
+uint64_t DCItemValueCache::getUInt64(uint32_t index) const
+{
+   const Sample& s = sample(index);
+   if (isStringType())
+      return _tcstoull(s.value.s, nullptr, 0);
+   if (m_dataType == DCI_DT_FLOAT)
+      return static_cast<uint64_t>(s.value.d);
+   return static_cast<uint64_t>(s.value.i);
+}
+
+/**
+ * Get value at given position as floating point number
+ */
+double DCItemValueCache::getDouble(uint32_t index) const
+{
+   const Sample& s = sample(index);
+   if (isStringType())
+      return _tcstod(s.value.s, nullptr);
+   if (m_dataType == DCI_DT_FLOAT)
+      return s.value.d;
+   return isUnsignedType() ? static_cast<double>(static_cast<uint64_t>(s.value.i)) : static_cast<double>(s.value.i);
+}
+
+/**
+ * Get sample value as floating point number (for non-string types only)
+ */
+double DCItemValueCache::sampleAsDouble(const Sample& s) const
+{
+   if (m_dataType == DCI_DT_FLOAT)
+      return s.value.d;
+   return isUnsignedType() ? static_cast<double>(static_cast<uint64_t>(s.value.i)) : static_cast<double>(s.value.i);
+}
+
+/**
+ * Compare sample values (for non-string types only)
+ */
+bool DCItemValueCache::isLess(const Sample& a, const Sample& b) const
+{
+   if (m_dataType == DCI_DT_FLOAT)
+      return a.value.d < b.value.d;
+   if (isUnsignedType())
+      return static_cast<uint64_t>(a.value.i) < static_cast<uint64_t>(b.value.i);
+   return a.value.i < b.value.i;
+}
+
+/**
+ * Set numbers of most recent values for which aggregates should be maintained. Existing windows not
+ * present in new list are removed. Aggregates for other numbers of values are calculated by scanning cache.
+ */
+void DCItemValueCache::setAggregateWindows(const IntegerArray<uint32_t>& counts)
+{
+   if (counts.isEmpty())
+   {
+      delete_and_null(m_windows);
+      return;
+   }
+
+   auto windows = new ObjectArray<AggregateWindow>(counts.size(), 4, Ownership::True);
+   for(int i = 0; i < counts.size(); i++)
+   {
+      uint32_t count = counts.get(i);
+      if (count == 0)
+         continue;
+
+      AggregateWindow *w = nullptr;
+      for(int j = 0; j < windows->size(); j++)
+      {
+         if (windows->get(j)->count == count)
+         {
+            w = windows->get(j);
+            break;
+         }
+      }
+      if (w != nullptr)
+         continue;   // Duplicate
+
+      if (m_windows != nullptr)
+      {
+         for(int j = 0; j < m_windows->size(); j++)
+         {
+            if (m_windows->get(j)->count == count)
+            {
+               w = m_windows->get(j);
+               m_windows->unlink(j);
+               break;
+            }
+         }
+      }
+      windows->add((w != nullptr) ? w : new AggregateWindow(count));
+   }
+
+   delete m_windows;
+   m_windows = windows;
+}
+
+/**
+ * Get up to date aggregate window for given number of most recent values.
+ * Returns null if no window is registered for given number of values.
+ */
+const DCItemValueCache::AggregateWindow *DCItemValueCache::getAggregateWindow(uint32_t count) const
+{
+   if ((m_windows == nullptr) || isStringType() || (m_capacity == 0))
+      return nullptr;
+
+   for(int i = 0; i < m_windows->size(); i++)
+   {
+      AggregateWindow *w = m_windows->get(i);
+      if (w->count == count)
+      {
+         if (!w->valid)
+            recalculateAggregateWindow(w);
+         return w;
+      }
+   }
+   return nullptr;
+}
+
+/**
+ * Add sample as most recent value of aggregate window
+ */
+void DCItemValueCache::addToAggregateWindow(AggregateWindow *w, const Sample& s, uint64_t seq) const
+{
+   if (s.timestamp == 1)
+      w->placeholders++;
+
+   double d = sampleAsDouble(s);
+   if (m_dataType == DCI_DT_FLOAT)
+      w->dsum += d;
+   else
+      w->isum += static_cast<uint64_t>(s.value.i);
+   w->sumOfSquares += d * d;
+
+   while(!w->minQueue.isEmpty() && !isLess(sampleBySequence(w->minQueue.back()), s))
+      w->minQueue.popBack();
+   w->minQueue.pushBack(seq);
+
+   while(!w->maxQueue.isEmpty() && !isLess(s, sampleBySequence(w->maxQueue.back())))
+      w->maxQueue.popBack();
+   w->maxQueue.pushBack(seq);
+}
+
+/**
+ * Recalculate aggregate window from cached values
+ */
+void DCItemValueCache::recalculateAggregateWindow(AggregateWindow *w) const
+{
+   w->placeholders = 0;
+   w->updates = 0;
+   w->isum = 0;
+   w->dsum = 0;
+   w->sumOfSquares = 0;
+   w->minQueue.clear();
+   w->maxQueue.clear();
+   for(uint32_t i = std::min(w->count, m_size); i > 0; i--)
+      addToAggregateWindow(w, sample(i - 1), m_sequence - (i - 1));
+   w->valid = true;
+}
+
+/**
+ * Invalidate all aggregate windows (they will be recalculated on next request)
+ */
+void DCItemValueCache::invalidateAggregateWindows()
+{
+   if (m_windows == nullptr)
+      return;
+   for(int i = 0; i < m_windows->size(); i++)
+      m_windows->get(i)->valid = false;
+}
+
+/**
+ * Find position of minimal or maximal value within given number of most recent values (for non-empty cache only)
+ */
+uint32_t DCItemValueCache::findExtremum(uint32_t count, bool maximum) const
+{
+   const AggregateWindow *w = getAggregateWindow(count);
+   if ((w != nullptr) && (m_size > 0))
+      return static_cast<uint32_t>(m_sequence - (maximum ? w->maxQueue.front() : w->minQueue.front()));
+
+   uint32_t n = std::min(std::max(count, 1u), m_size);
+   uint32_t index = 0;
+   for(uint32_t i = 1; i < n; i++)
+   {
+      if (isStringType())
+      {
+         double curr = getDouble(i), best = getDouble(index);
+         if (maximum ? (curr > best) : (curr < best))
+            index = i;
+      }
+      else if (maximum ? isLess(sample(index), sample(i)) : isLess(sample(i), sample(index)))
+      {
+         index = i;
+      }
+   }
+   return index;
+}
+
+/**
+ * Get population standard deviation of given number of most recent values
+ */
+double DCItemValueCache::getStandardDeviation(uint32_t count) const
+{
+   uint32_t n = std::min(count, m_size);
+   if (n == 0)
+      return 0;
+
+   double sum = 0, sumOfSquares = 0;
+   const AggregateWindow *w = getAggregateWindow(count);
+   if (w != nullptr)
+   {
+      if (m_dataType == DCI_DT_FLOAT)
+         sum = w->dsum;
+      else
+         sum = isUnsignedType() ? static_cast<double>(w->isum) : static_cast<double>(static_cast<int64_t>(w->isum));
+      sumOfSquares = w->sumOfSquares;
+   }
+   else
+   {
+      for(uint32_t i = 0; i < n; i++)
+      {
+         double d = getDouble(i);
+         sum += d;
+         sumOfSquares += d * d;
+      }
+   }
+
+   double mean = sum / n;
+   double variance = sumOfSquares / n - mean * mean;
+   return (variance > 0) ? sqrt(variance) : 0;
+}
+
+/**
+ * Get number of placeholders within given number of most recent values
+ */
+uint32_t DCItemValueCache::getPlaceholderCount(uint32_t count) const
+{
+   if (count == 0)
+      return 0;
+
+   const AggregateWindow *w = getAggregateWindow(count);
+   if (w != nullptr)
+      return w->placeholders;
+
+   uint32_t placeholders = 0;
+   uint32_t n = std::min(count, m_size);
+   for(uint32_t i = 0; i < n; i++)
+      if (isPlaceholder(i))
+         placeholders++;
+   return placeholders;
+}
+
+/**
+ * Get approximate memory usage by cache
+ */
+uint64_t DCItemValueCache::getMemoryUsage() const
+{
+   uint64_t usage = static_cast<uint64_t>(m_capacity) * sizeof(Sample) + m_lastStringCapacity * sizeof(TCHAR);
+   if (m_windows != nullptr)
+   {
+      for(int i = 0; i < m_windows->size(); i++)
+      {
+         const AggregateWindow *w = m_windows->get(i);
+         usage += sizeof(AggregateWindow) + static_cast<uint64_t>(w->minQueue.capacity() + w->maxQueue.capacity()) * sizeof(uint64_t);
+      }
+   }
+   return usage;
+}
+
+/**
+ * Get value at given position as full value object
+ */
+ItemValue DCItemValueCache::get(uint32_t index) const
+{
+   const Sample& s = sample(index);
+   if ((index == 0) || (s.timestamp == 1) || isStringType())
+      return ItemValue((index == 0) ? m_lastString : ((s.timestamp == 1) ? _T("") : s.value.s), s.timestamp);
+
+   ItemValue value;
+   if (m_dataType == DCI_DT_FLOAT)
+   {
+      TCHAR buffer[64];
+      FloatSampleToString(s.value.d, buffer);
+      value.set(s.value.d, buffer);
+   }
+   else if (isUnsignedType())
+      value.set(static_cast<uint64_t>(s.value.i));
+   else
+      value.set(s.value.i);
+   value.setTimeStamp(s.timestamp);
+   return value;
+}
@@ -85,6 +85,7 @@ DCObject::DCObject(const shared_ptr<DataCollectionOwner>& owner) : m_owner(owner
    m_status = ITEM_STATUS_NOT_SUPPORTED;
    m_lastPoll = 0;
    m_lastValueTimestamp = 0;
+   m_scheduledCheckTime = 0;
    m_schedules = nullptr;
    m_tLastCheck = 0;
 	m_flags = 0;
@@ -97,6 +98,9 @@ DCObject::DCObject(const shared_ptr<DataCollectionOwner>& owner) : m_owner(owner
 	m_snmpVersion = SNMP_VERSION_DEFAULT;
    m_transformationScriptSource = nullptr;
    m_transformationScript = nullptr;
+   m_transformationScriptVersion = 0;
+   m_transformationVM = nullptr;
+   m_transformationVMVersion = 0;
    m_lastScriptErrorReport = 0;
    m_doForcePoll = false;
    m_pollingSession = nullptr;
@@ -133,6 +137,7 @@ DCObject::DCObject(const DCObject *src, bool shadowCopy) :
    m_source = src->m_source;
    m_status = src->m_status;
    m_lastPoll = shadowCopy ? src->m_lastPoll : 0;
+   m_scheduledCheckTime = 0;
    m_lastValueTimestamp = shadowCopy ? src->m_lastValueTimestamp : 0;
    m_tLastCheck = shadowCopy ? src->m_tLastCheck : 0;
    m_errorCount = shadowCopy ? src->m_errorCount : 0;
@@ -148,6 +153,9 @@ DCObject::DCObject(const DCObject *src, bool shadowCopy) :
 
    m_transformationScriptSource = nullptr;
    m_transformationScript = nullptr;
+   m_transformationScriptVersion = 0;
+   m_transformationVM = nullptr;
+   m_transformationVMVersion = 0;
    m_lastScriptErrorReport = 0;
    setTransformationScript(MemCopyString(src->m_transformationScriptSource));
 
@@ -188,6 +196,7 @@ DCObject::DCObject(uint32_t id, const TCHAR *name, int source, BYTE scheduleType
    m_scheduledForDeletion = 0;
    m_lastPoll = 0;
    m_lastValueTimestamp = 0;
+   m_scheduledCheckTime = 0;
    m_flags = 0;
    m_stateFlags = 0;
    m_schedules = nullptr;
@@ -200,6 +209,9 @@ DCObject::DCObject(uint32_t id, const TCHAR *name, int source, BYTE scheduleType
    m_snmpVersion = SNMP_VERSION_DEFAULT;
    m_transformationScriptSource = nullptr;
    m_transformationScript = nullptr;
+   m_transformationScriptVersion = 0;
+   m_transformationVM = nullptr;
+   m_transformationVMVersion = 0;
    m_lastScriptErrorReport = 0;
    m_doForcePoll = false;
    m_pollingSession = nullptr;
@@ -258,6 +270,7 @@ DCObject::DCObject(ConfigEntry *config, const shared_ptr<DataCollectionOwner>& o
    m_scheduledForDeletion = 0;
    m_lastPoll = 0;
    m_lastValueTimestamp = 0;
+   m_scheduledCheckTime = 0;
    m_tLastCheck = 0;
    m_errorCount = 0;
    m_resourceId = 0;
@@ -270,6 +283,9 @@ DCObject::DCObject(ConfigEntry *config, const shared_ptr<DataCollectionOwner>& o
 
    m_transformationScriptSource = nullptr;
    m_transformationScript = nullptr;
+   m_transformationScriptVersion = 0;
+   m_transformationVM = nullptr;
+   m_transformationVMVersion = 0;
    m_lastScriptErrorReport = 0;
    m_comments = config->getSubEntryValue(_T("comments"));
    m_doForcePoll = false;
@@ -328,10 +344,12 @@ DCObject::DCObject(ConfigEntry *config, const shared_ptr<DataCollectionOwner>& o
  */
 DCObject::~DCObject()
 {
+   CancelScheduledDataCollection(this);
    MemFree(m_retentionTimeSrc);
    MemFree(m_pollingIntervalSrc);
    MemFree(m_transformationScriptSource);
    delete m_transformationScript;
+   delete m_transformationVM;
    delete m_schedules;
    MemFree(m_pszPerfTabSettings);
    MemFree(m_instanceFilterSource);
@@ -788,6 +806,41 @@ bool DCObject::isReadyForPolling(time_t currTime)
    return result;
 }
 
+/**
+ * Get time when data collection object should be checked again by scheduler. Objects that
+ * cannot be polled because of their state are re-checked with DC_SCHEDULER_RECHECK_INTERVAL
+ * (or earlier if they are re-scheduled on configuration change or poll completion).
+ */
+time_t DCObject::getNextPollCheckTime(time_t currTime)
+{
+   if (!tryLock())
+      return currTime + 1;
+
+   time_t nextCheckTime;
+   if (m_doForcePoll && !m_busy)
+   {
+      nextCheckTime = currTime + 1;
+   }
+   else if ((m_status == ITEM_STATUS_DISABLED) || m_busy || (m_source == DS_PUSH_AGENT) ||
+            !isCacheLoaded() || !matchClusterResource() || !hasValue() || (getAgentCacheMode() != AGENT_CACHE_OFF))
+   {
+      nextCheckTime = currTime + DC_SCHEDULER_RECHECK_INTERVAL;
+   }
+   else if (m_pollingScheduleType == DC_POLLING_SCHEDULE_ADVANCED)
+   {
+      nextCheckTime = currTime + 1;  // Schedules can contain seconds
+   }
+   else
+   {
+      int interval = getEffectivePollingInterval();
+      if (m_status == ITEM_STATUS_NOT_SUPPORTED)
+         interval *= 10;
+      nextCheckTime = std::max(std::max(m_lastPoll + interval, m_startTime), currTime + 1);
+   }
+   unlock();
+   return nextCheckTime;
+}
+
 /**
  * Returns true if internal cache is loaded. If data collection object
  * does not have cache should return true
@@ -1149,6 +1202,8 @@ void DCObject::setTransformationScript(TCHAR *source)
 {
    MemFree(m_transformationScriptSource);
    delete m_transformationScript;
+   delete_and_null(m_transformationVM);
+   m_transformationScriptVersion++;
    if (source != nullptr)
    {
       m_transformationScriptSource = Trim(source);
@@ -1170,6 +1225,48 @@ void DCObject::setTransformationScript(TCHAR *source)
    m_lastScriptErrorReport = 0;  // allow immediate error report after script change
 }
 
+/**
+ * Get VM for running transformation script - either cached from previous run or new one.
+ * Expected to be called while object is locked. VM should be returned by call to releaseTransformationVM.
+ */
+ScriptVMHandle DCObject::acquireTransformationVM(uint64_t *version)
+{
+   *version = (static_cast<uint64_t>(m_transformationScriptVersion) << 32) | GetServerScriptLibrary()->getChangeCounter();
+   if (m_transformationVM != nullptr)
+   {
+      NXSL_VM *vm = m_transformationVM;
+      m_transformationVM = nullptr;
+      if (m_transformationVMVersion == *version)
+         return ScriptVMHandle(SetupServerScriptVM(vm, m_owner.lock(), createDescriptorInternal()));
+      delete vm;  // Transformation script or script library was changed
+   }
+   return CreateServerScriptVM(m_transformationScript, m_owner.lock(), createDescriptorInternal());
+}
+
+/**
+ * Return transformation script VM after use. VM will be kept for next run if it completed successfully and
+ * neither transformation script nor script library was changed since VM creation. Expected to be called while object is locked.
+ */
+void DCObject::releaseTransformationVM(NXSL_VM *vm, uint64_t version)
+{
+   if ((m_transformationVM == nullptr) && (vm->getErrorCode() == 0) &&
+       (version == ((static_cast<uint64_t>(m_transformationScriptVersion) << 32) | GetServerScriptLibrary()->getChangeCounter())))
+   {
+      // Drop result and references to owning object and DCI descriptor, they will be set again on next run
+      vm->clearResult();
+      vm->removeGlobalVariable("$object");
+      vm->removeGlobalVariable("$node");
+      vm->removeGlobalVariable("$isCluster");
+      vm->removeGlobalVariable("$dci");
+      m_transformationVM = vm;
+      m_transformationVMVersion = version;
+   }
+   else
+   {
+      delete vm;
+   }
+}
+
 /**
  * Get actual agent cache mode
  */
@@ -26,7 +26,8 @@
 /**
  * Data collection owner object constructor
  */
-DataCollectionOwner::DataCollectionOwner() : super(), m_dcObjects(0, 128)
+DataCollectionOwner::DataCollectionOwner() : super(), m_dcObjectIdIndex(Ownership::False), m_dcObjectTemplateItemIndex(Ownership::True),
+         m_dcObjectNameIndex(Ownership::True), m_dcObjects(0, 128)
 {
    m_status = STATUS_NORMAL;
    m_dciListModified = false;
@@ -36,7 +37,8 @@ DataCollectionOwner::DataCollectionOwner() : super(), m_dcObjects(0, 128)
 /**
  * Constructor for new data collection owner object
  */
-DataCollectionOwner::DataCollectionOwner(const TCHAR *name, const uuid& guid) : super(), m_dcObjects(0, 128)
+DataCollectionOwner::DataCollectionOwner(const TCHAR *name, const uuid& guid) : super(), m_dcObjectIdIndex(Ownership::False),
+         m_dcObjectTemplateItemIndex(Ownership::True), m_dcObjectNameIndex(Ownership::True), m_dcObjects(0, 128)
 {
    _tcslcpy(m_name, name, MAX_OBJECT_NAME);
    m_status = STATUS_NORMAL;
@@ -61,9 +63,177 @@ DataCollectionOwner::~DataCollectionOwner()
  */
 void DataCollectionOwner::destroyItems()
 {
+   m_dcObjectIdIndex.clear();
+   m_dcObjectTemplateItemIndex.clear();
+   m_dcObjectNameIndex.clear();
 	m_dcObjects.clear();
 }
 
+/**
+ * Find first DC object with given name (case-insensitive), ignoring given object. DCI access must be locked by caller.
+ */
+DCObject *DataCollectionOwner::findFirstDCObjectByName(const TCHAR *name, const DCObject *exclude) const
+{
+   for(int i = 0; i < m_dcObjects.size(); i++)
+   {
+      DCObject *object = m_dcObjects.get(i);
+      if ((object != exclude) && !_tcsicmp(object->getName(), name))
+         return object;
+   }
+   return nullptr;
+}
+
+/**
+ * Find first DC object with given template item ID, ignoring given object. DCI access must be locked by caller.
+ */
+DCObject *DataCollectionOwner::findFirstDCObjectByTemplateItemId(uint32_t templateItemId, const DCObject *exclude) const
+{
+   for(int i = 0; i < m_dcObjects.size(); i++)
+   {
+      DCObject *object = m_dcObjects.get(i);
+      if ((object != exclude) && (object->getTemplateItemId() == templateItemId))
+         return object;
+   }
+   return nullptr;
+}
+
+/**
+ * Add DC object to name index. Object should be already in DC object list.
+ * If object was appended to the end of the list, first object with same name will not change.
+ */
+void DataCollectionOwner::addToNameIndex(DCObject *object, bool appended)
+{
+   DCObjectIndexEntry *entry = m_dcObjectNameIndex.get(object->getName());
+   if (entry == nullptr)
+   {
+      m_dcObjectNameIndex.set(object->getName(), new DCObjectIndexEntry(object));
+   }
+   else
+   {
+      entry->count++;
+      if (!appended)
+         entry->object = findFirstDCObjectByName(object->getName(), nullptr);
+   }
+}
+
+/**
+ * Remove DC object from name index
+ */
+void DataCollectionOwner::removeFromNameIndex(const TCHAR *name, const DCObject *object)
+{
+   DCObjectIndexEntry *entry = m_dcObjectNameIndex.get(name);
+   if (entry == nullptr)
+      return;
+
+   if (--entry->count == 0)
+      m_dcObjectNameIndex.remove(name);
+   else if (entry->object == object)
+      entry->object = findFirstDCObjectByName(name, object);
+}
+
+/**
+ * Add DC object to template item ID index. Object should be already in DC object list.
+ * If object was appended to the end of the list, first object with same template item ID will not change.
+ */
+void DataCollectionOwner::addToTemplateItemIndex(DCObject *object, bool appended)
+{
+   uint32_t templateItemId = object->getTemplateItemId();
+   if (templateItemId == 0)
+      return;
+
+   DCObjectIndexEntry *entry = m_dcObjectTemplateItemIndex.get(templateItemId);
+   if (entry == nullptr)
+   {
+      m_dcObjectTemplateItemIndex.set(templateItemId, new DCObjectIndexEntry(object));
+   }
+   else
+   {
+      entry->count++;
+      if (!appended)
+         entry->object = findFirstDCObjectByTemplateItemId(templateItemId, nullptr);
+   }
+}
+
+/**
+ * Remove DC object from template item ID index
+ */
+void DataCollectionOwner::removeFromTemplateItemIndex(uint32_t templateItemId, const DCObject *object)
+{
+   if (templateItemId == 0)
+      return;
+
+   DCObjectIndexEntry *entry = m_dcObjectTemplateItemIndex.get(templateItemId);
+   if (entry == nullptr)
+      return;
+
+   if (--entry->count == 0)
+      m_dcObjectTemplateItemIndex.remove(templateItemId);
+   else if (entry->object == object)
+      entry->object = findFirstDCObjectByTemplateItemId(templateItemId, object);
+}
+
+/**
+ * Add DC object to the end of DC object list and update indexes. DCI access must be write locked by caller.
+ */
+void DataCollectionOwner::addDCObjectToList(const shared_ptr<DCObject>& object)
+{
+   m_dcObjects.add(object);
+   m_dcObjectIdIndex.set(object->getId(), object.get());
+   addToNameIndex(object.get(), true);
+   addToTemplateItemIndex(object.get(), true);
+}
+
+/**
+ * Remove DC object at given position from DC object list and update indexes. DCI access must be write locked by caller.
+ */
+void DataCollectionOwner::removeDCObjectFromList(int index)
+{
+   DCObject *object = m_dcObjects.get(index);
+   m_dcObjectIdIndex.remove(object->getId());
+   removeFromNameIndex(object->getName(), object);
+   removeFromTemplateItemIndex(object->getTemplateItemId(), object);
+   m_dcObjects.remove(index);
+}
+
+/**
+ * Update indexes after change of DC object's name or template item ID. DCI access must be write locked by caller.
+ */
+void DataCollectionOwner::updateDCObjectIndex(DCObject *object, const TCHAR *oldName, uint32_t oldTemplateItemId)
+{
+   if (_tcsicmp(oldName, object->getName()))
+   {
+      removeFromNameIndex(oldName, object);
+      addToNameIndex(object, false);
+   }
+   if (oldTemplateItemId != object->getTemplateItemId())
+   {
+      removeFromTemplateItemIndex(oldTemplateItemId, object);
+      addToTemplateItemIndex(object, false);
+   }
+}
+
+/**
+ * Find DC object by template ID and template item ID. DCI access must be locked by caller.
+ */
+DCObject *DataCollectionOwner::findDCObjectByTemplateItem(uint32_t templateId, uint32_t templateItemId) const
+{
+   DCObjectIndexEntry *entry = m_dcObjectTemplateItemIndex.get(templateItemId);
+   if (entry == nullptr)
+      return nullptr;
+   if (entry->object->getTemplateId() == templateId)
+      return entry->object;
+   if (entry->count == 1)
+      return nullptr;
+
+   for(int i = 0; i < m_dcObjects.size(); i++)
+   {
+      DCObject *object = m_dcObjects.get(i);
+      if ((object->getTemplateId() == templateId) && (object->getTemplateItemId() == templateItemId))
+         return object;
+   }
+   return nullptr;
+}
+
 /**
  * Create data collection owner object from database data
  *
@@ -298,7 +468,7 @@ void DataCollectionOwner::loadItemsFromDB(DB_HANDLE hdb)
 		{
 			int count = DBGetNumRows(hResult);
 			for(int i = 0; i < count; i++)
-				m_dcObjects.add(make_shared<DCItem>(hdb, hResult, i, self(), useStartupDelay));
+				addDCObjectToList(make_shared<DCItem>(hdb, hResult, i, self(), useStartupDelay));
 			DBFreeResult(hResult);
 		}
 		DBFreeStatement(hStmt);
@@ -320,7 +490,7 @@ void DataCollectionOwner::loadItemsFromDB(DB_HANDLE hdb)
 		{
 			int count = DBGetNumRows(hResult);
 			for(int i = 0; i < count; i++)
-				m_dcObjects.add(make_shared<DCTable>(hdb, hResult, i, self(), useStartupDelay));
+				addDCObjectToList(make_shared<DCTable>(hdb, hResult, i, self(), useStartupDelay));
 			DBFreeResult(hResult);
 		}
 		DBFreeStatement(hStmt);
@@ -340,20 +510,17 @@ bool DataCollectionOwner::addDCObject(DCObject *object, bool alreadyLocked, bool
       writeLockDciAccess();
 
    // Check if that object exists
-   int i;
-   for(i = 0; i < m_dcObjects.size(); i++)
-      if (m_dcObjects.get(i)->getId() == object->getId())
-         break;   // Object with specified id already exist
-
-   if (i == m_dcObjects.size())     // Add new item
+   if (findDCObjectById(object->getId()) == nullptr)     // Add new item
    {
-		m_dcObjects.add(object);
+      addDCObjectToList(shared_ptr<DCObject>(object));
       object->setLastPollTime(0);    // Cause item to be polled immediately
       if (object->getStatus() != ITEM_STATUS_DISABLED)
          object->setStatus(ITEM_STATUS_ACTIVE, false);
       object->clearBusyFlag();
       if (object->getInstanceDiscoveryMethod() != IDM_NONE)
          m_instanceDiscoveryChanges = true;
+      if (isDataCollectionTarget())
+         ScheduleDataCollection(m_dcObjects.getShared(m_dcObjects.size() - 1), time(nullptr));
       success = true;
    }
 
@@ -383,41 +550,40 @@ bool DataCollectionOwner::deleteDCObject(uint32_t dcObjectId, bool needLock, uin
 		writeLockDciAccess();  // write lock
 
    // Check if that item exists
-   for(int i = 0; i < m_dcObjects.size(); i++)
-	{
-		DCObject *object = m_dcObjects.get(i);
-      if (object->getId() == dcObjectId)
+   DCObject *object = findDCObjectById(dcObjectId);
+   if (object != nullptr)
+   {
+      if (object->hasAccess(userId))
       {
-         if (object->hasAccess(userId))
+         int i = 0;
+         while(m_dcObjects.get(i) != object)
+            i++;
+         shared_ptr<DCObject> ref = m_dcObjects.getShared(i);  // Prevent destruction by call to remove
+         removeDCObjectFromList(i);
+
+         // Check if it is instance DCI
+         if (object->getInstanceDiscoveryMethod() != IDM_NONE)
          {
-            shared_ptr<DCObject> ref = m_dcObjects.getShared(i);  // Prevent destruction by call to remove
-            m_dcObjects.remove(i);
-
-            // Check if it is instance DCI
-            if (object->getInstanceDiscoveryMethod() != IDM_NONE)
-            {
-               deleteChildDCIs(dcObjectId);
-            }
+            deleteChildDCIs(dcObjectId);
+         }
 
-            if (json != nullptr)
-               *json = object->toJson();
+         if (json != nullptr)
+            *json = object->toJson();
 
-            // Destroy item
-            nxlog_debug_tag(_T("obj.dc"), 7, _T("DataCollectionOwner::DeleteDCObject: deleting DCObject [%u] from object %s [%u]"), dcObjectId, m_name, m_id);
-            deleteDCObject(object);
-            success = true;
-            NotifyClientsOnDCIDelete(*this, dcObjectId);
-            nxlog_debug_tag(_T("obj.dc"), 7, _T("DataCollectionOwner::DeleteDCObject: DCObject deleted from object %s [%u]"), m_name, m_id);
-         }
-         else
-         {
-            nxlog_debug_tag(_T("obj.dc"), 6, _T("DataCollectionOwner::DeleteDCObject: denied access to DCObject %u for user %u"), dcObjectId, userId);
-            if (rcc != nullptr)
-               *rcc = RCC_ACCESS_DENIED;
-         }
-         break;
+         // Destroy item
+         nxlog_debug_tag(_T("obj.dc"), 7, _T("DataCollectionOwner::DeleteDCObject: deleting DCObject [%u] from object %s [%u]"), dcObjectId, m_name, m_id);
+         deleteDCObject(object);
+         success = true;
+         NotifyClientsOnDCIDelete(*this, dcObjectId);
+         nxlog_debug_tag(_T("obj.dc"), 7, _T("DataCollectionOwner::DeleteDCObject: DCObject deleted from object %s [%u]"), m_name, m_id);
       }
-	}
+      else
+      {
+         nxlog_debug_tag(_T("obj.dc"), 6, _T("DataCollectionOwner::DeleteDCObject: denied access to DCObject %u for user %u"), dcObjectId, userId);
+         if (rcc != nullptr)
+            *rcc = RCC_ACCESS_DENIED;
+      }
+   }
 
 	if (needLock)
 	   unlockDciAccess();
@@ -439,6 +605,9 @@ bool DataCollectionOwner::deleteDCObject(uint32_t dcObjectId, bool needLock, uin
  */
 void DataCollectionOwner::deleteChildDCIs(uint32_t dcObjectId)
 {
+   // All objects with this template item ID will be removed
+   m_dcObjectTemplateItemIndex.remove(dcObjectId);
+
    for(int i = 0; i < m_dcObjects.size(); i++)
    {
       DCObject *subObject = m_dcObjects.get(i);
@@ -447,7 +616,7 @@ void DataCollectionOwner::deleteChildDCIs(uint32_t dcObjectId)
          nxlog_debug_tag(_T("obj.dc"), 7, _T("DataCollectionOwner::DeleteDCObject: deleting DCObject %d created by DCObject %d instance discovery from object %d"), (int)subObject->getId(), (int)dcObjectId, (int)m_id);
          deleteDCObject(subObject);
          NotifyClientsOnDCIDelete(*this, subObject->getId());
-         m_dcObjects.remove(i);
+         removeDCObjectFromList(i);
          i--;
       }
    }
@@ -479,37 +648,35 @@ uint32_t DataCollectionOwner::updateDCObject(uint32_t dcObjectId, const NXCPMess
 {
    uint32_t result = RCC_INVALID_DCI_ID;
 
-   readLockDciAccess();
+   writeLockDciAccess();   // write lock because object name may change
 
    // Check if that item exists
-   for(int i = 0; i < m_dcObjects.size(); i++)
-	{
-		DCObject *object = m_dcObjects.get(i);
-      if (object->getId() == dcObjectId)
+   DCObject *object = findDCObjectById(dcObjectId);
+   if (object != nullptr)
+   {
+      if (object->hasAccess(userId))
       {
-         if (object->hasAccess(userId))
-         {
-            if (object->getType() == DCO_TYPE_ITEM)
-               static_cast<DCItem*>(object)->updateFromMessage(msg, numMaps, mapIndex, mapId);
-            else
-               object->updateFromMessage(msg);
-
-            if (object->getInstanceDiscoveryMethod() != IDM_NONE)
-            {
-               updateInstanceDiscoveryItems(object);
-               m_instanceDiscoveryChanges = true;
-            }
-
-            result = RCC_SUCCESS;
-         }
+         SharedString oldName = object->getName();
+         if (object->getType() == DCO_TYPE_ITEM)
+            static_cast<DCItem*>(object)->updateFromMessage(msg, numMaps, mapIndex, mapId);
          else
+            object->updateFromMessage(msg);
+         updateDCObjectIndex(object, oldName, object->getTemplateItemId());
+
+         if (object->getInstanceDiscoveryMethod() != IDM_NONE)
          {
-            result = RCC_ACCESS_DENIED;
-            nxlog_debug_tag(_T("obj.dc"), 6, _T("DataCollectionOwner::updateDCObject: denied access to DCObject %u for user %u"), dcObjectId, userId);
+            updateInstanceDiscoveryItems(object);
+            m_instanceDiscoveryChanges = true;
          }
-         break;
+
+         result = RCC_SUCCESS;
       }
-	}
+      else
+      {
+         result = RCC_ACCESS_DENIED;
+         nxlog_debug_tag(_T("obj.dc"), 6, _T("DataCollectionOwner::updateDCObject: denied access to DCObject %u for user %u"), dcObjectId, userId);
+      }
+   }
 
    unlockDciAccess();
 
@@ -536,7 +703,9 @@ void DataCollectionOwner::updateInstanceDiscoveryItems(DCObject *dci)
 		DCObject *object = m_dcObjects.get(i);
       if ((object->getTemplateId() == m_id) && (object->getTemplateItemId() == dci->getId()))
       {
+         SharedString oldName = object->getName();
          object->updateFromTemplate(dci);
+         updateDCObjectIndex(object, oldName, object->getTemplateItemId());
          NotifyClientsOnDCIUpdate(*this, object);
       }
 	}
@@ -551,25 +720,20 @@ unique_ptr<IntegerArray<uint32_t>> DataCollectionOwner::setItemStatus(const Inte
    readLockDciAccess();
    for(int i = 0; i < dciList.size(); i++)
    {
-		int j;
-      for(j = 0; j < m_dcObjects.size(); j++)
+      DCObject *object = findDCObjectById(dciList.get(i));
+      if (object == nullptr)
       {
-         if (m_dcObjects.get(j)->getId() == dciList.get(i))
-         {
-            if (m_dcObjects.get(j)->hasAccess(userId))
-            {
-               m_dcObjects.get(j)->setStatus(status, true, userChange);
-               result->set(j, RCC_SUCCESS);
-               break;
-            }
-            else
-            {
-               result->set(j, RCC_ACCESS_DENIED);
-            }
-         }
+         result->add(RCC_INVALID_DCI_ID);
+      }
+      else if (object->hasAccess(userId))
+      {
+         object->setStatus(status, true, userChange);
+         result->add(RCC_SUCCESS);
+      }
+      else
+      {
+         result->add(RCC_ACCESS_DENIED);
       }
-      if (j == m_dcObjects.size())
-         result->set(j, RCC_INVALID_DCI_ID);
    }
    unlockDciAccess();
    return result;
@@ -601,29 +765,21 @@ int DataCollectionOwner::updateMultipleDCObjects(const NXCPMessage& request, uin
    readLockDciAccess();
    for(int i = 0; i < idList.size(); i++)
    {
-      int j;
-      for(j = 0; j < m_dcObjects.size(); j++)
+      DCObject *dci = findDCObjectById(idList.get(i));
+      if ((dci != nullptr) && dci->hasAccess(userId))
       {
-         DCObject *dci = m_dcObjects.get(j);
-         if (dci->getId() == idList.get(i))
-         {
-            if (dci->hasAccess(userId))
-            {
-               if (!pollingIntervalSrc.isNull())
-                  dci->setPollingInterval(pollingIntervalSrc);
-               if (!retentionTimeSrc.isNull())
-                  dci->setRetention(retentionTimeSrc);
-               if (pollingScheduleType != -1)
-                  dci->setPollingIntervalType(static_cast<BYTE>(pollingScheduleType));
-               if (retentionType != -1)
-                  dci->setRetentionType(static_cast<BYTE>(retentionType));
-               if (!unitName.isNull() && (dci->getType() == DCO_TYPE_ITEM))
-                  static_cast<DCItem*>(dci)->setUnitName(unitName);
-               NotifyClientsOnDCIUpdate(*this, dci);
-               count++;
-            }
-            break;
-         }
+         if (!pollingIntervalSrc.isNull())
+            dci->setPollingInterval(pollingIntervalSrc);
+         if (!retentionTimeSrc.isNull())
+            dci->setRetention(retentionTimeSrc);
+         if (pollingScheduleType != -1)
+            dci->setPollingIntervalType(static_cast<BYTE>(pollingScheduleType));
+         if (retentionType != -1)
+            dci->setRetentionType(static_cast<BYTE>(retentionType));
+         if (!unitName.isNull() && (dci->getType() == DCO_TYPE_ITEM))
+            static_cast<DCItem*>(dci)->setUnitName(unitName);
+         NotifyClientsOnDCIUpdate(*this, dci);
+         count++;
       }
    }
    unlockDciAccess();
@@ -702,18 +858,14 @@ shared_ptr<DCObject> DataCollectionOwner::getDCObjectById(uint32_t itemId, uint3
    if (lock)
       readLockDciAccess();
 
-   for(int i = 0; i < m_dcObjects.size(); i++)
-	{
-      DCObject *curr = m_dcObjects.get(i);
-      if (curr->getId() == itemId)
-		{
-         if (curr->hasAccess(userId))
-            object = m_dcObjects.getShared(i);
-         else
-            nxlog_debug_tag(_T("obj.dc"), 6, _T("DataCollectionOwner::getDCObjectById: denied access to DCObject %u for user %u"), itemId, userId);
-         break;
-		}
-	}
+   DCObject *curr = findDCObjectById(itemId);
+   if (curr != nullptr)
+   {
+      if (curr->hasAccess(userId))
+         object = curr->shared_from_this();
+      else
+         nxlog_debug_tag(_T("obj.dc"), 6, _T("DataCollectionOwner::getDCObjectById: denied access to DCObject %u for user %u"), itemId, userId);
+   }
 
    if (lock)
       unlockDciAccess();
@@ -728,20 +880,14 @@ shared_ptr<DCObject> DataCollectionOwner::getDCObjectByTemplateId(uint32_t tmplI
    shared_ptr<DCObject> object;
 
    readLockDciAccess();
-   // Check if that item exists
-   for(int i = 0; i < m_dcObjects.size(); i++)
-	{
-      DCObject *curr = m_dcObjects.get(i);
-      if (curr->getTemplateItemId() == tmplItemId)
-		{
-         if (curr->hasAccess(userId))
-            object = m_dcObjects.getShared(i);
-         else
-            nxlog_debug_tag(_T("obj.dc"), 6, _T("DataCollectionOwner::getDCObjectByTemplateId: denied access to DCObject %u for user %u"), curr->getId(), userId);
-         break;
-		}
-	}
-
+   DCObjectIndexEntry *entry = m_dcObjectTemplateItemIndex.get(tmplItemId);
+   if (entry != nullptr)
+   {
+      if (entry->object->hasAccess(userId))
+         object = entry->object->shared_from_this();
+      else
+         nxlog_debug_tag(_T("obj.dc"), 6, _T("DataCollectionOwner::getDCObjectByTemplateId: denied access to DCObject %u for user %u"), entry->object->getId(), userId);
+   }
    unlockDciAccess();
    return object;
 }
@@ -754,19 +900,14 @@ shared_ptr<DCObject> DataCollectionOwner::getDCObjectByName(const TCHAR *name, u
    shared_ptr<DCObject> object;
 
    readLockDciAccess();
-   // Check if that item exists
-   for(int i = 0; i < m_dcObjects.size(); i++)
-	{
-      DCObject *curr = m_dcObjects.get(i);
-      if (!_tcsicmp(curr->getName(), name))
-		{
-         if (curr->hasAccess(userId))
-            object = m_dcObjects.getShared(i);
-         else
-            nxlog_debug_tag(_T("obj.dc"), 6, _T("DataCollectionOwner::getDCObjectByName: denied access to DCObject %u for user %u"), curr->getId(), userId);
-         break;
-		}
-	}
+   DCObjectIndexEntry *entry = m_dcObjectNameIndex.get(name);
+   if (entry != nullptr)
+   {
+      if (entry->object->hasAccess(userId))
+         object = entry->object->shared_from_this();
+      else
+         nxlog_debug_tag(_T("obj.dc"), 6, _T("DataCollectionOwner::getDCObjectByName: denied access to DCObject %u for user %u"), entry->object->getId(), userId);
+   }
    unlockDciAccess();
    return object;
 }
@@ -1026,12 +1167,14 @@ void DataCollectionOwner::updateFromImport(ConfigEntry *config, ImportContext *c
          shared_ptr<DCObject> curr = !guid.isNull() ? getDCObjectByGUID(guid, 0, false) : shared_ptr<DCObject>();
          if ((curr != nullptr) && (curr->getType() == DCO_TYPE_ITEM))
          {
+            SharedString oldName = curr->getName();
             curr->updateFromImport(e, nxslV5);
+            updateDCObjectIndex(curr.get(), oldName, curr->getTemplateItemId());
          }
          else
          {
             auto dci = make_shared<DCItem>(e, self(), nxslV5);
-            m_dcObjects.add(dci);
+            addDCObjectToList(dci);
             guid = dci->getGuid();  // For case when export file does not contain valid GUID
          }
          guidList.add(new uuid(guid));
@@ -1045,12 +1188,14 @@ void DataCollectionOwner::updateFromImport(ConfigEntry *config, ImportContext *c
          shared_ptr<DCObject> curr = !guid.isNull() ? getDCObjectByGUID(guid, 0, false) : shared_ptr<DCObject>();
          if ((curr != NULL) && (curr->getType() == DCO_TYPE_TABLE))
          {
+            SharedString oldName = curr->getName();
             curr->updateFromImport(e, nxslV5);
+            updateDCObjectIndex(curr.get(), oldName, curr->getTemplateItemId());
          }
          else
          {
             auto dci = make_shared<DCTable>(e, self(), nxslV5);
-            m_dcObjects.add(dci);
+            addDCObjectToList(dci);
             guid = dci->getGuid();  // For case when export file does not contain valid GUID
          }
          guidList.add(new uuid(guid));
@@ -346,7 +346,8 @@ bool DCTable::transform(const shared_ptr<Table>& value)
       return true;
 
    bool success = false;
-   ScriptVMHandle vm = CreateServerScriptVM(m_transformationScript, m_owner.lock(), createDescriptorInternal());
+   uint64_t vmVersion;
+   ScriptVMHandle vm = acquireTransformationVM(&vmVersion);
    if (vm.isValid())
    {
       NXSL_Value *nxslValue = vm->createValue(vm->createObject(&g_nxslTableClass, new shared_ptr<Table>(value)));
@@ -379,7 +380,7 @@ bool DCTable::transform(const shared_ptr<Table>& value)
             }
          }
       }
-      vm.destroy();
+      releaseTransformationVM(vm, vmVersion);
    }
    else if (vm.failureReason() != ScriptVMFailureReason::SCRIPT_IS_EMPTY)
    {
@@ -690,16 +690,12 @@ uint32_t DataCollectionTarget::getDciLastValue(uint32_t dciId, NXCPMessage *msg)
 
    readLockDciAccess();
 
-   for(int i = 0; i < m_dcObjects.size(); i++)
+   DCObject *object = findDCObjectById(dciId);
+   if (object != nullptr)
    {
-      DCObject *object = m_dcObjects.get(i);
-      if (object->getId() == dciId)
-      {
-         msg->setField(VID_DCOBJECT_TYPE, static_cast<int16_t>(object->getType()));
-         object->fillLastValueMessage(msg);
-         rcc = RCC_SUCCESS;
-         break;
-      }
+      msg->setField(VID_DCOBJECT_TYPE, static_cast<int16_t>(object->getType()));
+      object->fillLastValueMessage(msg);
+      rcc = RCC_SUCCESS;
    }
 
    unlockDciAccess();
@@ -715,20 +711,16 @@ int DataCollectionTarget::getDciThreshold(uint32_t dciId)
 
    readLockDciAccess();
 
-   for(int i = 0; i < m_dcObjects.size(); i++)
+   DCObject *object = findDCObjectById(dciId);
+   if (object != nullptr)
    {
-      DCObject *object = m_dcObjects.get(i);
-      if (object->getId() == dciId)
+      if (object->getType() == DCO_TYPE_TABLE)
       {
-         if (object->getType() == DCO_TYPE_TABLE)
-         {
-            //TODO: add DCTable support
-         }
-         else
-         {
-            threshold = static_cast<DCItem*>(object)->getThresholdSeverity();
-         }
-         break;
+         //TODO: add DCTable support
+      }
+      else
+      {
+         threshold = static_cast<DCItem*>(object)->getThresholdSeverity();
       }
    }
 
@@ -745,23 +737,19 @@ uint32_t DataCollectionTarget::getTableLastValue(uint32_t dciId, NXCPMessage *ms
 
    readLockDciAccess();
 
-   for(int i = 0; i < m_dcObjects.size(); i++)
-	{
-		DCObject *object = m_dcObjects.get(i);
-		if (object->getId() == dciId)
-		{
-		   if (object->getType() == DCO_TYPE_TABLE)
-		   {
-		      static_cast<DCTable*>(object)->fillLastValueMessage(msg);
-		      rcc = RCC_SUCCESS;
-		   }
-		   else
-		   {
-		      rcc = RCC_INCOMPATIBLE_OPERATION;
-		   }
-			break;
-		}
-	}
+   DCObject *object = findDCObjectById(dciId);
+   if (object != nullptr)
+   {
+      if (object->getType() == DCO_TYPE_TABLE)
+      {
+         static_cast<DCTable*>(object)->fillLastValueMessage(msg);
+         rcc = RCC_SUCCESS;
+      }
+      else
+      {
+         rcc = RCC_INCOMPATIBLE_OPERATION;
+      }
+   }
 
    unlockDciAccess();
    return rcc;
@@ -780,13 +768,8 @@ bool DataCollectionTarget::applyTemplateItem(uint32_t templateId, DCObject *dcOb
    nxlog_debug_tag(_T("obj.dc"), 5, _T("Applying data collection object \"%s\" to target \"%s\""), dcObject->getName().cstr(), m_name);
 
    // Check if that template item exists
-	int i;
-   for(i = 0; i < m_dcObjects.size(); i++)
-      if ((m_dcObjects.get(i)->getTemplateId() == templateId) &&
-          (m_dcObjects.get(i)->getTemplateItemId() == dcObject->getId()))
-         break;   // Item with specified id already exist
-
-   if (i == m_dcObjects.size())
+   DCObject *curr = findDCObjectByTemplateItem(templateId, dcObject->getId());
+   if (curr == nullptr)
    {
       // New item from template, just add it
 		DCObject *newObject = dcObject->clone();
@@ -797,8 +780,9 @@ bool DataCollectionTarget::applyTemplateItem(uint32_t templateId, DCObject *dcOb
    else
    {
       // Update existing item unless it is disabled
-      DCObject *curr = m_dcObjects.get(i);
+      SharedString oldName = curr->getName();
       curr->updateFromTemplate(dcObject);
+      updateDCObjectIndex(curr, oldName, curr->getTemplateItemId());
       NotifyClientsOnDCIUpdate(*this, curr);
       if (curr->getInstanceDiscoveryMethod() != IDM_NONE)
       {
@@ -876,13 +860,18 @@ void DataCollectionTarget::onTemplateRemove(const shared_ptr<DataCollectionOwner
    }
    else
    {
-      readLockDciAccess();
+      writeLockDciAccess();  // write lock because template item index will change
 
       for(int i = 0; i < m_dcObjects.size(); i++)
-         if (m_dcObjects.get(i)->getTemplateId() == templateId)
+      {
+         DCObject *object = m_dcObjects.get(i);
+         if (object->getTemplateId() == templateId)
          {
-            m_dcObjects.get(i)->setTemplateId(0, 0);
+            uint32_t templateItemId = object->getTemplateItemId();
+            object->setTemplateId(0, 0);
+            updateDCObjectIndex(object, object->getName(), templateItemId);
          }
+      }
 
       unlockDciAccess();
    }
@@ -997,46 +986,79 @@ bool DataCollectionTarget::isDataCollectionDisabled()
 }
 
 /**
- * Put items which requires polling into the queue
+ * Put data collection object into the queue if it requires polling. Returns true if object was queued.
+ * If batches is not null, native agent and SNMP metrics are added to batch with same serialization key
+ * instead of being queued immediately (caller is responsible for queuing collected batches).
  */
-void DataCollectionTarget::queueItemsForPolling()
+bool DataCollectionTarget::queueItemForPolling(const shared_ptr<DCObject>& object, time_t currTime, HashMap<uint64_t, SharedObjectArray<DCObject>> *batches)
 {
-   if ((m_status == STATUS_UNMANAGED) || isDataCollectionDisabled() || m_isDeleted)
-      return;  // Do not collect data for unmanaged objects or if data collection is disabled
+   if (!isDataCollectionActive())
+      return false;  // Do not collect data for unmanaged objects or if data collection is disabled
 
-   time_t currTime = time(nullptr);
+   if (!object->isReadyForPolling(currTime))
+      return false;
 
-   readLockDciAccess();
-   for(int i = 0; i < m_dcObjects.size(); i++)
+   object->setBusyFlag();
+
+   if ((object->getDataSource() == DS_NATIVE_AGENT) ||
+       (object->getDataSource() == DS_WINPERF) ||
+       (object->getDataSource() == DS_SNMP_AGENT) ||
+       (object->getDataSource() == DS_SSH) ||
+       (object->getDataSource() == DS_MODBUS) ||
+       (object->getDataSource() == DS_SMCLP))
    {
-		DCObject *object = m_dcObjects.get(i);
-      if (m_dcObjects.get(i)->isReadyForPolling(currTime))
+      // Serialize collection by source node and data provider
+      uint32_t sourceNodeId = getEffectiveSourceNode(object.get());
+      uint64_t key = (static_cast<uint64_t>((sourceNodeId != 0) ? sourceNodeId : m_id) << 32) | static_cast<uint64_t>(object->getDataSource());
+      if ((batches != nullptr) && ((object->getDataSource() == DS_NATIVE_AGENT) || (object->getDataSource() == DS_SNMP_AGENT)) &&
+          (object->getType() == DCO_TYPE_ITEM) && (getObjectClass() != OBJECT_CLUSTER))
       {
-         object->setBusyFlag();
-
-         if ((object->getDataSource() == DS_NATIVE_AGENT) ||
-             (object->getDataSource() == DS_WINPERF) ||
-             (object->getDataSource() == DS_SNMP_AGENT) ||
-             (object->getDataSource() == DS_SSH) ||
-             (object->getDataSource() == DS_MODBUS) ||
-             (object->getDataSource() == DS_SMCLP))
+         SharedObjectArray<DCObject> *batch = batches->get(key);
+         if (batch == nullptr)
          {
-            uint32_t sourceNodeId = getEffectiveSourceNode(object);
-            TCHAR key[32];
-            _sntprintf(key, 32, _T("%08X/%s"), (sourceNodeId != 0) ? sourceNodeId : m_id, object->getDataProviderName());
-            ThreadPoolExecuteSerialized(g_dataCollectorThreadPool, key, DataCollector, m_dcObjects.getShared(i));
+            batch = new SharedObjectArray<DCObject>(16, 16);
+            batches->set(key, batch);
          }
-         else
-         {
-            ThreadPoolExecute(g_dataCollectorThreadPool, DataCollector, m_dcObjects.getShared(i));
-         }
-			nxlog_debug_tag(_T("obj.dc.queue"), 8, _T("DataCollectionTarget(%s)->QueueItemsForPolling(): item %d \"%s\" added to queue"),
-			         m_name, object->getId(), object->getName().cstr());
+         batch->add(object);
+      }
+      else
+      {
+         ThreadPoolExecuteSerialized(g_dataCollectorThreadPool, key, DataCollector, object);
       }
    }
+   else
+   {
+      ThreadPoolExecute(g_dataCollectorThreadPool, DataCollector, object);
+   }
+   nxlog_debug_tag(_T("obj.dc.queue"), 8, _T("DataCollectionTarget(%s)->queueItemForPolling(): item %d \"%s\" added to queue"),
+            m_name, object->getId(), object->getName().cstr());
+   return true;
+}
+
+/**
+ * Schedule check of all data collection objects by data collection scheduler
+ */
+void DataCollectionTarget::scheduleItemsForPolling(time_t checkTime)
+{
+   readLockDciAccess();
+   for(int i = 0; i < m_dcObjects.size(); i++)
+      ScheduleDataCollection(m_dcObjects.getShared(i), checkTime);
    unlockDciAccess();
 }
 
+/**
+ * Set management status. Data collection objects are re-scheduled when object becomes managed.
+ */
+bool DataCollectionTarget::setMgmtStatus(bool isManaged)
+{
+   if (!super::setMgmtStatus(isManaged))
+      return false;
+
+   if (isManaged)
+      scheduleItemsForPolling(time(nullptr));
+   return true;
+}
+
 /**
  * Update time intervals in data collection objects
  */
@@ -1990,9 +2012,7 @@ void DataCollectionTarget::leaveMaintenanceMode(uint32_t userId)
 
    if (forcePoll)
    {
-      TCHAR threadKey[32];
-      _sntprintf(threadKey, 32, _T("POLL_%u"), getId());
-      ThreadPoolExecuteSerialized(g_pollerThreadPool, threadKey, static_cast<Pollable*>(this), &Pollable::doForcedStatusPoll, RegisterPoller(PollerType::STATUS, self()));
+      ThreadPoolExecuteSerialized(g_pollerThreadPool, static_cast<uint64_t>(m_id), static_cast<Pollable*>(this), &Pollable::doForcedStatusPoll, RegisterPoller(PollerType::STATUS, self()));
    }
 }
 
@@ -2629,8 +2649,10 @@ bool DataCollectionTarget::updateInstances(DCObject *root, StringObjectMap<Insta
          bool notify = false;
          if (_tcscmp(name, object->getInstanceName()))
          {
+            SharedString oldName = object->getName();
             object->setInstanceName(name);
             object->updateFromTemplate(root);
+            updateDCObjectIndex(object, oldName, object->getTemplateItemId());
             changed = true;
             notify = true;
          }
@@ -2756,6 +2778,7 @@ void DataCollectionTarget::onDataCollectionChange()
 {
    super::onDataCollectionChange();
    calculateProxyLoad();
+   scheduleItemsForPolling(time(nullptr));
 }
 
 /**
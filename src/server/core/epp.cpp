@@ -28,6 +28,56 @@
 void StartDowntime(uint32_t objectId, String tag);
 void EndDowntime(uint32_t objectId, String tag);
 
+/**
+ * Event matching context shared by all rules checked for single event
+ */
+struct EPRuleMatchContext
+{
+   Event *event;
+   shared_ptr<NetObj> object;
+   bool objectResolved;
+   HashSet<uint32_t> ancestors;
+   bool ancestorsCollected;
+
+   EPRuleMatchContext(Event *e)
+   {
+      event = e;
+      objectResolved = false;
+      ancestorsCollected = false;
+   }
+
+   /**
+    * Get event source object (resolved on first call)
+    */
+   const shared_ptr<NetObj>& getObject()
+   {
+      if (!objectResolved)
+      {
+         object = FindObjectById(event->getSourceId());
+         objectResolved = true;
+      }
+      return object;
+   }
+
+   /**
+    * Check if given object is event source or one of it's parents (direct or indirect)
+    */
+   bool isSourceOrAncestor(uint32_t id)
+   {
+      const shared_ptr<NetObj>& o = getObject();
+      if (o == nullptr)
+         return false;
+      if (o->getId() == id)
+         return true;
+      if (!ancestorsCollected)
+      {
+         o->collectAncestors(&ancestors);
+         ancestorsCollected = true;
+      }
+      return ancestors.contains(id);
+   }
+};
+
 /**
  * Default event policy rule constructor
  */
@@ -36,6 +86,8 @@ EPRule::EPRule(uint32_t id) : m_timeFrames(0, 16, Ownership::True), m_actions(0,
    m_id = id;
    m_guid = uuid::generate();
    m_flags = 0;
+   m_matchCount = 0;
+   m_skipCount = 0;
    m_comments = nullptr;
    m_alarmSeverity = 0;
    m_alarmKey = nullptr;
@@ -61,6 +113,8 @@ EPRule::EPRule(const ConfigEntry& config, bool nxslV5) : m_timeFrames(0, 16, Own
    if (m_guid.isNull())
       m_guid = uuid::generate(); // generate random GUID if rule was imported without GUID
    m_flags = config.getSubEntryValueAsUInt(_T("flags"));
+   m_matchCount = 0;
+   m_skipCount = 0;
 
 	ConfigEntry *eventsRoot = config.findEntry(_T("events"));
    if (eventsRoot != nullptr)
@@ -252,6 +306,8 @@ EPRule::EPRule(DB_RESULT hResult, int row) : m_timeFrames(0, 16, Ownership::True
    m_id = DBGetFieldULong(hResult, row, 0);
    m_guid = DBGetFieldGUID(hResult, row, 1);
    m_flags = DBGetFieldULong(hResult, row, 2);
+   m_matchCount = 0;
+   m_skipCount = 0;
    m_comments = DBGetField(hResult, row, 3, nullptr, 0);
    m_alarmMessage = DBGetField(hResult, row, 4, nullptr, 0);
    m_alarmSeverity = DBGetFieldLong(hResult, row, 5);
@@ -296,6 +352,8 @@ EPRule::EPRule(const NXCPMessage& msg) : m_timeFrames(0, 16, Ownership::True), m
 {
    m_flags = msg.getFieldAsUInt32(VID_FLAGS);
    m_id = msg.getFieldAsUInt32(VID_RULE_ID);
+   m_matchCount = 0;
+   m_skipCount = 0;
    m_guid = msg.getFieldAsGUID(VID_GUID);
    m_comments = msg.getFieldAsString(VID_COMMENTS);
 
@@ -600,26 +658,18 @@ void EPRule::validateConfig() const
 /**
  * Check if source object's id match to the rule
  */
-bool EPRule::matchSource(const shared_ptr<NetObj>& object) const
+bool EPRule::matchSource(EPRuleMatchContext *context) const
 {
    if (m_sources.isEmpty() && m_sourceExclusions.isEmpty())
       return (m_flags & RF_NEGATED_SOURCE) ? false : true;
 
-   if (object == nullptr)
+   if (context->getObject() == nullptr)
       return (m_flags & RF_NEGATED_SOURCE) ? true : false;
 
-   uint32_t objectId = object->getId();
    bool exception = false;
    for(int i = 0; i < m_sourceExclusions.size(); i++)
    {
-      uint32_t id = m_sourceExclusions.get(i);
-      if (id == objectId)
-      {
-         exception = true;
-         break;
-      }
-
-      if (object->isParent(id))
+      if (context->isSourceOrAncestor(m_sourceExclusions.get(i)))
       {
          exception = true;
          break;
@@ -633,14 +683,7 @@ bool EPRule::matchSource(const shared_ptr<NetObj>& object) const
    bool match = m_sources.isEmpty();
    for(int i = 0; i < m_sources.size(); i++)
    {
-      uint32_t id = m_sources.get(i);
-      if (id == objectId)
-      {
-         match = true;
-         break;
-      }
-
-      if (object->isParent(id))
+      if (context->isSourceOrAncestor(m_sources.get(i)))
       {
          match = true;
          break;
@@ -835,20 +878,17 @@ static EnumerationCallbackResult ExecutePstorageSetAction(const TCHAR *key, cons
  * Check if event match to rule and perform required actions if yes
  * Method will return TRUE if event matched and RF_STOP_PROCESSING flag is set
  */
-bool EPRule::processEvent(Event *event) const
+bool EPRule::processEvent(Event *event, EPRuleMatchContext *context) const
 {
    if (m_flags & RF_DISABLED)
       return false;
 
-   if ((event->getRootId() != 0) && !(m_flags & RF_ACCEPT_CORRELATED))
-      return false;
-
-   if (!matchSeverity(event->getSeverity()) || !matchEvent(event->getCode()))
-      return false;
-
-   shared_ptr<NetObj> object = FindObjectById(event->getSourceId());
-   if (!matchSource(object))
+   if (((event->getRootId() != 0) && !(m_flags & RF_ACCEPT_CORRELATED)) ||
+       !matchSeverity(event->getSeverity()) || !matchEvent(event->getCode()) || !matchSource(context))
+   {
+      InterlockedIncrement64(&m_skipCount);
       return false;
+   }
 
    time_t now = time(nullptr);
    struct tm currLocal;
@@ -858,8 +898,12 @@ bool EPRule::processEvent(Event *event) const
    memcpy(&currLocal, localtime(&now), sizeof(struct tm));
 #endif
    if (!matchTime(&currLocal) || !matchScript(event))
+   {
+      InterlockedIncrement64(&m_skipCount);
       return false;
+   }
 
+   InterlockedIncrement64(&m_matchCount);
    nxlog_debug_tag(DEBUG_TAG, 6, _T("Event ") UINT64_FMT _T(" match EPP rule %d"), event->getId(), (int)m_id + 1);
 
    // Generate alarm if requested
@@ -953,6 +997,7 @@ bool EPRule::processEvent(Event *event) const
          DeletePersistentStorageValue(key);
    }
 
+   const shared_ptr<NetObj>& object = context->getObject();
    if (object != nullptr)
    {
       for(KeyValuePair<const TCHAR> *attribute : m_customAttributeSetActions)
@@ -1600,6 +1645,11 @@ bool EventPolicy::loadFromDB()
    }
 
    DBConnectionPoolReleaseConnection(hdb);
+
+   writeLock();
+   buildIndex();
+   unlock();
+
    return success;
 }
 
@@ -1640,18 +1690,77 @@ bool EventPolicy::saveToDB() const
 }
 
 /**
- * Pass event through policy
+ * Rebuild rule index by event code. Must be called with write lock held.
+ * Disabled rules are not indexed. Rules with empty or negated event list are
+ * placed into wildcard list because they can match events not mentioned in rule.
+ */
+void EventPolicy::buildIndex()
+{
+   m_eventIndex.clear();
+   m_wildcardRules.clear();
+   for(int i = 0; i < m_rules.size(); i++)
+   {
+      EPRule *rule = m_rules.get(i);
+      uint32_t flags = rule->getFlags();
+      if (flags & RF_DISABLED)
+         continue;
+
+      const IntegerArray<uint32_t>& events = rule->getEvents();
+      if (flags & RF_NEGATED_EVENTS)
+      {
+         if (!events.isEmpty())   // negated empty list never match
+            m_wildcardRules.add(i);
+      }
+      else if (events.isEmpty())
+      {
+         m_wildcardRules.add(i);
+      }
+      else
+      {
+         for(int j = 0; j < events.size(); j++)
+         {
+            uint32_t code = events.get(j);
+            IntegerArray<int32_t> *list = m_eventIndex.get(code);
+            if (list == nullptr)
+            {
+               list = new IntegerArray<int32_t>(0, 16);
+               m_eventIndex.set(code, list);
+            }
+            if (list->isEmpty() || (list->get(list->size() - 1) != i))  // event code can be listed in rule more than once
+               list->add(i);
+         }
+      }
+   }
+   nxlog_debug_tag(DEBUG_TAG, 4, _T("Event processing policy index rebuilt (%d rules, %d indexed event codes, %d wildcard rules)"),
+            m_rules.size(), m_eventIndex.size(), m_wildcardRules.size());
+}
+
+/**
+ * Pass event through policy. Only rules from index for event's code and wildcard rules
+ * are checked, in the same order as they appear in policy.
  */
 void EventPolicy::processEvent(Event *pEvent)
 {
 	nxlog_debug_tag(DEBUG_TAG, 7, _T("EPP: processing event ") UINT64_FMT, pEvent->getId());
+   EPRuleMatchContext context(pEvent);
    readLock();
-   for(int i = 0; i < m_rules.size(); i++)
-      if (m_rules.get(i)->processEvent(pEvent))
+   IntegerArray<int32_t> *indexed = m_eventIndex.get(pEvent->getCode());
+   int indexedCount = (indexed != nullptr) ? indexed->size() : 0;
+   int i = 0, j = 0;
+   while((i < indexedCount) || (j < m_wildcardRules.size()))
+   {
+      int ruleIndex;
+      if ((j >= m_wildcardRules.size()) || ((i < indexedCount) && (indexed->get(i) < m_wildcardRules.get(j))))
+         ruleIndex = indexed->get(i++);
+      else
+         ruleIndex = m_wildcardRules.get(j++);
+
+      if (m_rules.get(ruleIndex)->processEvent(pEvent, &context))
 		{
-			nxlog_debug_tag(DEBUG_TAG, 7, _T("EPP: got \"stop processing\" flag for event ") UINT64_FMT _T(" at rule %d"), pEvent->getId(), i + 1);
+			nxlog_debug_tag(DEBUG_TAG, 7, _T("EPP: got \"stop processing\" flag for event ") UINT64_FMT _T(" at rule %d"), pEvent->getId(), ruleIndex + 1);
          break;   // EPRule::ProcessEvent() return TRUE if we should stop processing this event
 		}
+   }
    unlock();
 }
 
@@ -1688,6 +1797,7 @@ void EventPolicy::replacePolicy(uint32_t numRules, EPRule **ruleList)
          m_rules.add(r);
       }
    }
+   buildIndex();
    unlock();
 }
 
@@ -1860,6 +1970,7 @@ void EventPolicy::importRule(EPRule *rule, bool overwrite, ObjectArray<uuid> *ru
       }
    }
 
+   buildIndex();
    unlock();
 }
 
@@ -1896,3 +2007,21 @@ void EventPolicy::getEventReferences(uint32_t eventCode, ObjectArray<EventRefere
    }
    unlock();
 }
+
+/**
+ * Show rule match statistics on server console
+ */
+void EventPolicy::showStatistics(ServerConsole *console) const
+{
+   readLock();
+   console->printf(_T("Rules: %d, indexed event codes: %d, wildcard rules: %d\n\n"), m_rules.size(), m_eventIndex.size(), m_wildcardRules.size());
+   console->print(_T("Rule Matched     Skipped      Comments\n"));
+   console->print(_T("----------------------------------------------------------------\n"));
+   for(int i = 0; i < m_rules.size(); i++)
+   {
+      EPRule *rule = m_rules.get(i);
+      console->printf(_T("%-4d ") UINT64_FMT_ARGS(_T("-12")) _T(" ") UINT64_FMT_ARGS(_T("-12")) _T(" %s%s\n"), i + 1, rule->getMatchCount(), rule->getSkipCount(),
+               (rule->getFlags() & RF_DISABLED) ? _T("[disabled] ") : _T(""), CHECK_NULL_EX(rule->getComments()));
+   }
+   unlock();
+}
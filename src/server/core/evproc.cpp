@@ -41,7 +41,6 @@ VolatileCounter64 g_totalEventsProcessed = 0;
  * Static data
  */
 static THREAD s_threadStormDetector = INVALID_THREAD_HANDLE;
-static THREAD s_threadLogger = INVALID_THREAD_HANDLE;
 static ObjectQueue<Event> s_loggerQueue(4096, Ownership::True);
 
 /**
@@ -102,6 +101,7 @@ static void EventStormDetector()
  */
 static time_t s_dbQueryFailedTimestamps[MAX_DB_QUERY_FAILED_EVENTS];
 static int s_dbQueryFailedTimestampPos = 0;
+static Mutex s_dbQueryFailedTimestampsLock(MutexType::FAST);
 
 /**
  * Check that event can be written to database
@@ -114,6 +114,7 @@ static bool IsEventWriteAllowed(Event *event)
    {
       time_t now = time(nullptr);
       bool allow = false;
+      s_dbQueryFailedTimestampsLock.lock();
       for(int i = 0; i < MAX_DB_QUERY_FAILED_EVENTS; i++)
       {
          if (s_dbQueryFailedTimestamps[i] < now - 60)
@@ -125,6 +126,7 @@ static bool IsEventWriteAllowed(Event *event)
       s_dbQueryFailedTimestamps[s_dbQueryFailedTimestampPos++] = event->getTimestamp();
       if (s_dbQueryFailedTimestampPos == MAX_DB_QUERY_FAILED_EVENTS)
          s_dbQueryFailedTimestampPos = 0;
+      s_dbQueryFailedTimestampsLock.unlock();
       if (!allow)
          nxlog_debug_tag(DEBUG_TAG, 5, _T("EventLogger: event %s with ID ") UINT64_FMT _T(" dropped by rate limiter"), event->getName(), event->getId());
       return allow;
@@ -133,123 +135,400 @@ static bool IsEventWriteAllowed(Event *event)
 }
 
 /**
- * Write event
+ * Event log writer
  */
-static inline void WriteEvent(DB_STATEMENT hStmt, Event *event)
+struct EventLogWriter
 {
-   DBBind(hStmt, 1, DB_SQLTYPE_BIGINT, event->getId());
-   DBBind(hStmt, 2, DB_SQLTYPE_INTEGER, event->getCode());
-   DBBind(hStmt, 3, DB_SQLTYPE_INTEGER, static_cast<UINT32>(event->getTimestamp()));
-   DBBind(hStmt, 4, DB_SQLTYPE_INTEGER, static_cast<INT32>(event->getOrigin()));
-   DBBind(hStmt, 5, DB_SQLTYPE_INTEGER, static_cast<UINT32>(event->getOriginTimestamp()));
-   DBBind(hStmt, 6, DB_SQLTYPE_INTEGER, event->getSourceId());
-   DBBind(hStmt, 7, DB_SQLTYPE_INTEGER, event->getZoneUIN());
-   DBBind(hStmt, 8, DB_SQLTYPE_INTEGER, event->getDciId());
-   DBBind(hStmt, 9, DB_SQLTYPE_INTEGER, event->getSeverity());
-   DBBind(hStmt, 10, DB_SQLTYPE_VARCHAR, event->getMessage(), DB_BIND_STATIC, MAX_EVENT_MSG_LENGTH);
-   DBBind(hStmt, 11, DB_SQLTYPE_BIGINT, event->getRootId());
-   DBBind(hStmt, 12, DB_SQLTYPE_VARCHAR, event->getTagsAsList(), DB_BIND_TRANSIENT, 2000);
-   DBBind(hStmt, 13, DB_SQLTYPE_TEXT, event->toJson(), DB_BIND_DYNAMIC);
-   DBExecute(hStmt);
-   nxlog_debug_tag(DEBUG_TAG, 8, _T("EventLogger: DBExecute: id=%d,code=%d"), (int)event->getId(), (int)event->getCode());
+   THREAD thread;
+   ObjectArray<Event> batch;  // Events taken from queue but not yet written
+   Mutex lock;
+
+   EventLogWriter() : batch(0, 256, Ownership::True), lock(MutexType::FAST)
+   {
+      thread = INVALID_THREAD_HANDLE;
+   }
+
+   void run(int id);
+   void writeBatch(ByteStream *jsonBuffer, StringBuffer *query);
+   bool writeBatchMultiRow(DB_HANDLE hdb, int syntax, ByteStream *jsonBuffer, StringBuffer *query);
+   bool writeBatchPrepared(DB_HANDLE hdb, ByteStream *jsonBuffer);
+   int writeBatchRowByRow(DB_HANDLE hdb, ByteStream *jsonBuffer);
+};
+
+/**
+ * Event log writers
+ */
+static EventLogWriter *s_logWriters = nullptr;
+static int s_logWriterCount = 0;
+static int s_logWriterMaxRecordsPerTxn = 500;
+static int s_logWriterMaxRecordsPerStmt = 100;
+static uint32_t s_logWriterMaxBatchAge = 500;
+
+/**
+ * Event log writer statistics
+ */
+static VolatileCounter64 s_loggedEvents = 0;
+static VolatileCounter64 s_logWriterTransactions = 0;
+static VolatileCounter64 s_logWriterFailedEvents = 0;
+static int64_t s_logWriterAverageWaitTime = 0;
+static uint32_t s_logWriterMaxWaitTime = 0;
+static Mutex s_logWriterStatsLock(MutexType::FAST);
+
+/**
+ * Callback for serializing JSON document into byte stream
+ */
+static int JsonDumpCallback(const char *buffer, size_t size, void *data)
+{
+   static_cast<ByteStream*>(data)->write(buffer, size);
+   return 0;
 }
 
 /**
- * Event logger
+ * Serialize event's raw data into provided buffer. Returned pointer is valid until next call.
  */
-static void EventLogger()
+static const char *SerializeEventData(Event *event, ByteStream *buffer)
 {
-   ThreadSetName("EventLogger");
+   buffer->clear();
+   json_t *json = event->toJson();
+   json_dump_callback(json, JsonDumpCallback, buffer, JSON_COMPACT);
+   json_decref(json);
+   buffer->write('\0');
+   return reinterpret_cast<const char*>(buffer->buffer());
+}
 
-   while(true)
+/**
+ * Write batch using multi-row INSERT statements (MySQL, PostgreSQL, SQLite, MS SQL).
+ * Returns false if any statement failed.
+ */
+bool EventLogWriter::writeBatchMultiRow(DB_HANDLE hdb, int syntax, ByteStream *jsonBuffer, StringBuffer *query)
+{
+   int count = 0;
+   for(int i = 0; i < batch.size(); i++)
+   {
+      Event *event = batch.get(i);
+      if (count == 0)
+      {
+         query->clear();
+         query->append(_T("INSERT INTO event_log (event_id,event_code,event_timestamp,origin,origin_timestamp,event_source,")
+                       _T("zone_uin,dci_id,event_severity,event_message,root_event_id,event_tags,raw_data) VALUES "));
+      }
+      else
+      {
+         query->append(_T(','));
+      }
+
+      query->append(_T('('));
+      query->append(event->getId());
+      query->append(_T(','));
+      query->append(event->getCode());
+      if (syntax == DB_SYNTAX_TSDB)
+      {
+         query->append(_T(",to_timestamp("));
+         query->append(static_cast<uint32_t>(event->getTimestamp()));
+         query->append(_T("),"));
+      }
+      else
+      {
+         query->append(_T(','));
+         query->append(static_cast<uint32_t>(event->getTimestamp()));
+         query->append(_T(','));
+      }
+      query->append(static_cast<int32_t>(event->getOrigin()));
+      query->append(_T(','));
+      query->append(static_cast<uint32_t>(event->getOriginTimestamp()));
+      query->append(_T(','));
+      query->append(event->getSourceId());
+      query->append(_T(','));
+      query->append(event->getZoneUIN());
+      query->append(_T(','));
+      query->append(event->getDciId());
+      query->append(_T(','));
+      query->append(event->getSeverity());
+      query->append(_T(','));
+      query->append(DBPrepareString(hdb, event->getMessage(), MAX_EVENT_MSG_LENGTH));
+      query->append(_T(','));
+      query->append(event->getRootId());
+      query->append(_T(','));
+      query->append(DBPrepareString(hdb, event->getTagsAsList(), 2000));
+      query->append(_T(','));
+      query->append(DBPrepareStringUTF8(hdb, SerializeEventData(event, jsonBuffer)));
+      query->append(_T(')'));
+
+      count++;
+      if ((count == s_logWriterMaxRecordsPerStmt) || (i == batch.size() - 1))
+      {
+         if (!DBQuery(hdb, *query))
+            return false;
+         nxlog_debug_tag(DEBUG_TAG, 8, _T("EventLogger: DBQuery: %d records"), count);
+         count = 0;
+      }
+   }
+   return true;
+}
+
+/**
+ * Write batch using prepared statement (array bind if supported by driver).
+ * Returns false if any statement failed.
+ */
+bool EventLogWriter::writeBatchPrepared(DB_HANDLE hdb, ByteStream *jsonBuffer)
+{
+   DB_STATEMENT hStmt = DBPrepare(hdb,
+            _T("INSERT INTO event_log (event_id,event_code,event_timestamp,origin,origin_timestamp,event_source,")
+            _T("zone_uin,dci_id,event_severity,event_message,root_event_id,event_tags,raw_data) ")
+            _T("VALUES (?,?,?,?,?,?,?,?,?,?,?,?,?)"), batch.size() > 1);
+   if (hStmt == nullptr)
+      return false;
+
+   bool success = true;
+   bool batchMode = DBOpenBatch(hStmt);
+   int count = 0;
+   for(int i = 0; i < batch.size(); i++)
+   {
+      Event *event = batch.get(i);
+      if (batchMode)
+         DBNextBatchRow(hStmt);
+      DBBind(hStmt, 1, DB_SQLTYPE_BIGINT, event->getId());
+      DBBind(hStmt, 2, DB_SQLTYPE_INTEGER, event->getCode());
+      DBBind(hStmt, 3, DB_SQLTYPE_INTEGER, static_cast<uint32_t>(event->getTimestamp()));
+      DBBind(hStmt, 4, DB_SQLTYPE_INTEGER, static_cast<int32_t>(event->getOrigin()));
+      DBBind(hStmt, 5, DB_SQLTYPE_INTEGER, static_cast<uint32_t>(event->getOriginTimestamp()));
+      DBBind(hStmt, 6, DB_SQLTYPE_INTEGER, event->getSourceId());
+      DBBind(hStmt, 7, DB_SQLTYPE_INTEGER, event->getZoneUIN());
+      DBBind(hStmt, 8, DB_SQLTYPE_INTEGER, event->getDciId());
+      DBBind(hStmt, 9, DB_SQLTYPE_INTEGER, event->getSeverity());
+      DBBind(hStmt, 10, DB_SQLTYPE_VARCHAR, event->getMessage(), DB_BIND_STATIC, MAX_EVENT_MSG_LENGTH);
+      DBBind(hStmt, 11, DB_SQLTYPE_BIGINT, event->getRootId());
+      DBBind(hStmt, 12, DB_SQLTYPE_VARCHAR, event->getTagsAsList(), DB_BIND_TRANSIENT, 2000);
+      DBBind(hStmt, 13, DB_SQLTYPE_TEXT, DB_CTYPE_UTF8_STRING, SerializeEventData(event, jsonBuffer), DB_BIND_TRANSIENT);
+
+      count++;
+      if (!batchMode || (count == s_logWriterMaxRecordsPerStmt) || (i == batch.size() - 1))
+      {
+         if (!DBExecute(hStmt))
+         {
+            success = false;
+            break;
+         }
+         nxlog_debug_tag(DEBUG_TAG, 8, _T("EventLogger: DBExecute: %d records"), count);
+         count = 0;
+         if (batchMode && (i < batch.size() - 1))
+            DBOpenBatch(hStmt);
+      }
+   }
+   DBFreeStatement(hStmt);
+   return success;
+}
+
+/**
+ * Write events from batch one by one using single-row INSERT statement, outside of transaction.
+ * Used as fallback when batch write fails, so one bad event does not cause loss of whole batch.
+ * Returns number of events that could not be written.
+ */
+int EventLogWriter::writeBatchRowByRow(DB_HANDLE hdb, ByteStream *jsonBuffer)
+{
+   DB_STATEMENT hStmt = DBPrepare(hdb,
+            (DBGetSyntax(hdb) == DB_SYNTAX_TSDB) ?
+                  _T("INSERT INTO event_log (event_id,event_code,event_timestamp,origin,origin_timestamp,event_source,")
+                  _T("zone_uin,dci_id,event_severity,event_message,root_event_id,event_tags,raw_data) ")
+                  _T("VALUES (?,?,to_timestamp(?),?,?,?,?,?,?,?,?,?,?)") :
+                  _T("INSERT INTO event_log (event_id,event_code,event_timestamp,origin,origin_timestamp,event_source,")
+                  _T("zone_uin,dci_id,event_severity,event_message,root_event_id,event_tags,raw_data) ")
+                  _T("VALUES (?,?,?,?,?,?,?,?,?,?,?,?,?)"));
+   if (hStmt == nullptr)
+   {
+      for(int i = 0; i < batch.size(); i++)
+      {
+         Event *event = batch.get(i);
+         nxlog_write_tag(NXLOG_ERROR, DEBUG_TAG, _T("Event %s [") UINT64_FMT _T("] from object %u dropped (cannot write to event log)"),
+                  event->getName(), event->getId(), event->getSourceId());
+      }
+      return batch.size();
+   }
+
+   int failed = 0;
+   for(int i = 0; i < batch.size(); i++)
+   {
+      Event *event = batch.get(i);
+      DBBind(hStmt, 1, DB_SQLTYPE_BIGINT, event->getId());
+      DBBind(hStmt, 2, DB_SQLTYPE_INTEGER, event->getCode());
+      DBBind(hStmt, 3, DB_SQLTYPE_INTEGER, static_cast<uint32_t>(event->getTimestamp()));
+      DBBind(hStmt, 4, DB_SQLTYPE_INTEGER, static_cast<int32_t>(event->getOrigin()));
+      DBBind(hStmt, 5, DB_SQLTYPE_INTEGER, static_cast<uint32_t>(event->getOriginTimestamp()));
+      DBBind(hStmt, 6, DB_SQLTYPE_INTEGER, event->getSourceId());
+      DBBind(hStmt, 7, DB_SQLTYPE_INTEGER, event->getZoneUIN());
+      DBBind(hStmt, 8, DB_SQLTYPE_INTEGER, event->getDciId());
+      DBBind(hStmt, 9, DB_SQLTYPE_INTEGER, event->getSeverity());
+      DBBind(hStmt, 10, DB_SQLTYPE_VARCHAR, event->getMessage(), DB_BIND_STATIC, MAX_EVENT_MSG_LENGTH);
+      DBBind(hStmt, 11, DB_SQLTYPE_BIGINT, event->getRootId());
+      DBBind(hStmt, 12, DB_SQLTYPE_VARCHAR, event->getTagsAsList(), DB_BIND_TRANSIENT, 2000);
+      DBBind(hStmt, 13, DB_SQLTYPE_TEXT, DB_CTYPE_UTF8_STRING, SerializeEventData(event, jsonBuffer), DB_BIND_TRANSIENT);
+      if (!DBExecute(hStmt))
+      {
+         nxlog_write_tag(NXLOG_ERROR, DEBUG_TAG, _T("Event %s [") UINT64_FMT _T("] from object %u dropped (cannot write to event log)"),
+                  event->getName(), event->getId(), event->getSourceId());
+         failed++;
+      }
+   }
+   DBFreeStatement(hStmt);
+   return failed;
+}
+
+/**
+ * Write collected batch of events to database in single transaction
+ */
+void EventLogWriter::writeBatch(ByteStream *jsonBuffer, StringBuffer *query)
+{
+   DB_HANDLE hdb = DBConnectionPoolAcquireConnection();
+
+   int failed = 0;
+   if (DBBegin(hdb))
+   {
+      int syntax = DBGetSyntax(hdb);
+      bool success;
+      if ((syntax == DB_SYNTAX_MYSQL) || (syntax == DB_SYNTAX_PGSQL) || (syntax == DB_SYNTAX_TSDB) || (syntax == DB_SYNTAX_SQLITE) || (syntax == DB_SYNTAX_MSSQL))
+         success = writeBatchMultiRow(hdb, syntax, jsonBuffer, query);
+      else
+         success = writeBatchPrepared(hdb, jsonBuffer);
+
+      if (success)
+         success = DBCommit(hdb);
+      else
+         DBRollback(hdb);
+      InterlockedIncrement64(&s_logWriterTransactions);
+
+      if (!success)
+      {
+         nxlog_debug_tag(DEBUG_TAG, 4, _T("EventLogger: batch write failed, retrying %d events one by one"), batch.size());
+         failed = writeBatchRowByRow(hdb, jsonBuffer);
+      }
+   }
+   else
+   {
+      // Cannot start transaction, so partial batch write could not be rolled back
+      nxlog_debug_tag(DEBUG_TAG, 4, _T("EventLogger: cannot start transaction, writing %d events one by one"), batch.size());
+      failed = writeBatchRowByRow(hdb, jsonBuffer);
+   }
+   DBConnectionPoolReleaseConnection(hdb);
+
+   InterlockedAdd64(&s_loggedEvents, batch.size() - failed);
+   if (failed > 0)
+      InterlockedAdd64(&s_logWriterFailedEvents, failed);
+   nxlog_debug_tag(DEBUG_TAG, 7, _T("EventLogger: %d events written to database (%d failed)"), batch.size() - failed, failed);
+}
+
+/**
+ * Event log writer main loop. Events are collected into batches limited by
+ * number of records and by age of first event in batch, and each batch is
+ * written in single transaction.
+ */
+void EventLogWriter::run(int id)
+{
+   char tname[32];
+   snprintf(tname, 32, "EventLogger-%d", id);
+   ThreadSetName(tname);
+
+   ByteStream jsonBuffer(8192);
+   jsonBuffer.setAllocationStep(8192);
+   StringBuffer query;
+   query.setAllocationStep(65536);
+
+   bool shutdown = false;
+   while(!shutdown)
    {
       Event *event = s_loggerQueue.getOrBlock();
       if (event == INVALID_POINTER_VALUE)
          break;   // Shutdown indicator
 
-      if (!IsEventWriteAllowed(event))
+      int64_t batchStartTime = GetCurrentTimeMs();
+      while(true)
       {
-         delete event;
-         continue;
+         if (IsEventWriteAllowed(event))
+         {
+            int64_t waitTime = batchStartTime - event->getQueueTime();
+            s_logWriterStatsLock.lock();
+            UpdateExpMovingAverage(s_logWriterAverageWaitTime, EMA_EXP_180, waitTime);
+            if (static_cast<uint32_t>(waitTime) > s_logWriterMaxWaitTime)
+               s_logWriterMaxWaitTime = static_cast<uint32_t>(waitTime);
+            s_logWriterStatsLock.unlock();
+
+            lock.lock();
+            batch.add(event);
+            lock.unlock();
+         }
+         else
+         {
+            delete event;
+         }
+
+         if (batch.size() >= s_logWriterMaxRecordsPerTxn)
+            break;
+
+         int64_t elapsed = GetCurrentTimeMs() - batchStartTime;
+         if (elapsed >= s_logWriterMaxBatchAge)
+            break;
+
+         event = s_loggerQueue.getOrBlock(static_cast<uint32_t>(s_logWriterMaxBatchAge - elapsed));
+         if (event == nullptr)
+            break;
+         if (event == INVALID_POINTER_VALUE)
+         {
+            shutdown = true;
+            break;
+         }
       }
 
-		DB_HANDLE hdb = DBConnectionPoolAcquireConnection();
-		int syntaxId = DBGetSyntax(hdb);
-		if (syntaxId == DB_SYNTAX_SQLITE)
-		{ 
-         StringBuffer query = _T("INSERT INTO event_log (event_id,event_code,event_timestamp,event_source,zone_uin,origin,")
-                        _T("origin_timestamp,dci_id,event_severity,event_message,root_event_id,event_tags,raw_data) VALUES (");
-         query.append(event->getId());
-         query.append(_T(','));
-         query.append(event->getCode());
-         query.append(_T(','));
-         query.append((UINT32)event->getTimestamp());
-         query.append(_T(','));
-         query.append(event->getSourceId());
-         query.append(_T(','));
-         query.append(event->getZoneUIN());
-         query.append(_T(','));
-         query.append(static_cast<int32_t>(event->getOrigin()));
-         query.append(_T(','));
-         query.append(static_cast<uint32_t>(event->getOriginTimestamp()));
-         query.append(_T(','));
-         query.append(event->getDciId());
-         query.append(_T(','));
-         query.append(event->getSeverity());
-         query.append(_T(','));
-         query.append(DBPrepareString(hdb, event->getMessage(), MAX_EVENT_MSG_LENGTH));
-         query.append(_T(','));
-         query.append(event->getRootId());
-         query.append(_T(','));
-         query.append(DBPrepareString(hdb, event->getTagsAsList(), 2000));
-         query.append(_T(','));
-         json_t *json = event->toJson();
-         char *jsonText = json_dumps(json, JSON_COMPACT);
-         query.append(DBPrepareStringUTF8(hdb, jsonText));
-         MemFree(jsonText);
-         json_decref(json);
-         query.append(_T(')'));
-
-         DBQuery(hdb, query);
-         nxlog_debug_tag(DEBUG_TAG, 8, _T("EventLogger: DBQuery: id=%d,code=%d"), (int)event->getId(), (int)event->getCode());
-			delete event;
-		}
-		else
-		{
-			DB_STATEMENT hStmt = DBPrepare(hdb,
-			         (g_dbSyntax == DB_SYNTAX_TSDB) ?
-                        _T("INSERT INTO event_log (event_id,event_code,event_timestamp,origin,")
-                        _T("origin_timestamp,event_source,zone_uin,dci_id,event_severity,event_message,root_event_id,event_tags,raw_data) ")
-                        _T("VALUES (?,?,to_timestamp(?),?,?,?,?,?,?,?,?,?,?)") :
-                        _T("INSERT INTO event_log (event_id,event_code,event_timestamp,origin,")
-                        _T("origin_timestamp,event_source,zone_uin,dci_id,event_severity,event_message,root_event_id,event_tags,raw_data) ")
-                        _T("VALUES (?,?,?,?,?,?,?,?,?,?,?,?,?)"), true);
-			if (hStmt != nullptr)
-			{
-			   WriteEvent(hStmt, event);
-			   delete event;
-            event = s_loggerQueue.getOrBlock(500);
-			   while((event != nullptr) && (event != INVALID_POINTER_VALUE))
-				{
-				   if (IsEventWriteAllowed(event))
-				   {
-		            WriteEvent(hStmt, event);
-				   }
-					delete event;
-					event = s_loggerQueue.getOrBlock(500);
-				}
-				DBFreeStatement(hStmt);
-			}
-			else
-			{
-				delete event;
-			}
-		}
+      if (!batch.isEmpty())
+      {
+         writeBatch(&jsonBuffer, &query);
+         lock.lock();
+         batch.clear();
+         lock.unlock();
+      }
+   }
+   nxlog_debug_tag(DEBUG_TAG, 1, _T("Event log writer thread #%d stopped"), id);
+}
 
-		DBConnectionPoolReleaseConnection(hdb);
-		if (event == INVALID_POINTER_VALUE)
-         break;   // Shutdown indicator (need second check if got it in inner loop)
-	}
+/**
+ * Start event log writers
+ */
+static void StartEventLogWriters()
+{
+   s_logWriterCount = ConfigReadInt(_T("Events.LogWriter.Threads"), 1);
+   if (s_logWriterCount < 1)
+      s_logWriterCount = 1;
+   else if (s_logWriterCount > 32)
+      s_logWriterCount = 32;
+
+   s_logWriterMaxRecordsPerTxn = ConfigReadInt(_T("Events.LogWriter.MaxRecordsPerTransaction"), 500);
+   if (s_logWriterMaxRecordsPerTxn < 1)
+      s_logWriterMaxRecordsPerTxn = 1;
+
+   // MS SQL does not accept more than 1000 rows in single VALUES clause
+   s_logWriterMaxRecordsPerStmt = ConfigReadInt(_T("Events.LogWriter.MaxRecordsPerStatement"), 100);
+   if (s_logWriterMaxRecordsPerStmt < 1)
+      s_logWriterMaxRecordsPerStmt = 1;
+   else if (s_logWriterMaxRecordsPerStmt > 1000)
+      s_logWriterMaxRecordsPerStmt = 1000;
+
+   s_logWriterMaxBatchAge = ConfigReadULong(_T("Events.LogWriter.MaxBatchAge"), 500);
+
+   s_logWriters = new EventLogWriter[s_logWriterCount];
+   for(int i = 0; i < s_logWriterCount; i++)
+      s_logWriters[i].thread = ThreadCreateEx(&s_logWriters[i], &EventLogWriter::run, i + 1);
+
+   nxlog_debug_tag(DEBUG_TAG, 1, _T("%d event log writer threads started (maxRecordsPerTransaction=%d maxRecordsPerStatement=%d maxBatchAge=%u)"),
+            s_logWriterCount, s_logWriterMaxRecordsPerTxn, s_logWriterMaxRecordsPerStmt, s_logWriterMaxBatchAge);
+}
+
+/**
+ * Stop event log writers. All events already in queue will be written before writers stop.
+ */
+static void StopEventLogWriters()
+{
+   for(int i = 0; i < s_logWriterCount; i++)
+      s_loggerQueue.put(INVALID_POINTER_VALUE);
+   for(int i = 0; i < s_logWriterCount; i++)
+      ThreadJoin(s_logWriters[i].thread);
 }
 
 /**
@@ -321,6 +600,7 @@ static void ProcessEvent(Event *event, int processorId)
    // Logger will destroy event object after logging
    if (event->getFlags() & EF_LOG)
    {
+      event->setQueueTime(GetCurrentTimeMs());
       s_loggerQueue.put(event);
    }
    else
@@ -357,9 +637,8 @@ static void SerialEventProcessor()
       ProcessEvent(event, 0);
    }
 
-   s_loggerQueue.put(INVALID_POINTER_VALUE);
+   StopEventLogWriters();
    ThreadJoin(s_threadStormDetector);
-   ThreadJoin(s_threadLogger);
    nxlog_debug_tag(DEBUG_TAG, 1, _T("Event processing thread stopped"));
 }
 
@@ -596,9 +875,8 @@ static void ParallelEventProcessor()
    HASH_CLEAR(hh, queueBindings);
    MemFreeLocal(weights);
 
-	s_loggerQueue.put(INVALID_POINTER_VALUE);
+   StopEventLogWriters();
 	ThreadJoin(s_threadStormDetector);
-	ThreadJoin(s_threadLogger);
    nxlog_debug_tag(DEBUG_TAG, 1, _T("Event processing thread stopped"));
 }
 
@@ -608,7 +886,7 @@ static void ParallelEventProcessor()
 THREAD StartEventProcessor()
 {
    memset(s_dbQueryFailedTimestamps, 0, sizeof(s_dbQueryFailedTimestamps));
-   s_threadLogger = ThreadCreateEx(EventLogger);
+   StartEventLogWriters();
    s_threadStormDetector = ThreadCreateEx(EventStormDetector);
    ThreadPoolScheduleRelative(g_mainThreadPool, 600000, ResetScriptErrorEventCounter);
    return (ConfigReadInt(_T("Events.Processor.PoolSize"), 1) > 1) ? ThreadCreateEx(ParallelEventProcessor) : ThreadCreateEx(SerialEventProcessor);
@@ -666,7 +944,27 @@ static Event *CopyEvent(Event *event)
  */
 Event *FindEventInLoggerQueue(uint64_t eventId)
 {
-   return s_loggerQueue.find(&eventId, CompareEvent, CopyEvent);
+   Event *event = s_loggerQueue.find(&eventId, CompareEvent, CopyEvent);
+   if (event != nullptr)
+      return event;
+
+   // Check events already taken by writers but not yet committed
+   for(int i = 0; (i < s_logWriterCount) && (event == nullptr); i++)
+   {
+      EventLogWriter *writer = &s_logWriters[i];
+      writer->lock.lock();
+      for(int j = 0; j < writer->batch.size(); j++)
+      {
+         Event *e = writer->batch.get(j);
+         if (e->getId() == eventId)
+         {
+            event = new Event(*e);
+            break;
+         }
+      }
+      writer->lock.unlock();
+   }
+   return event;
 }
 
 /**
@@ -676,3 +974,19 @@ int64_t GetEventLogWriterQueueSize()
 {
    return s_loggerQueue.size();
 }
+
+/**
+ * Get event log writer statistics
+ */
+void GetEventLogWriterStatistics(EventLogWriterStats *stats)
+{
+   stats->loggedEvents = s_loggedEvents;
+   stats->transactions = s_logWriterTransactions;
+   stats->failedEvents = s_logWriterFailedEvents;
+   s_logWriterStatsLock.lock();
+   stats->averageWaitTime = static_cast<uint32_t>(s_logWriterAverageWaitTime / EMA_FP_1);
+   stats->maxWaitTime = s_logWriterMaxWaitTime;
+   s_logWriterStatsLock.unlock();
+   stats->queueSize = static_cast<uint32_t>(s_loggerQueue.size());
+   stats->writers = s_logWriterCount;
+}
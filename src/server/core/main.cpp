@@ -183,10 +183,13 @@ time_t g_serverStartTime = 0;
 uint32_t g_agentCommandTimeout = 4000;  // Default timeout for requests to agent
 uint32_t g_agentRestartWaitTime = 0;   // Wait time for agent restart in seconds
 uint32_t g_thresholdRepeatInterval = 0;	// Disabled by default
+uint32_t g_anomalyModelRefreshInterval = 900;
 uint32_t g_requiredPolls = 1;
 int32_t g_instanceRetentionTime = 7; // Default instance retention time (in days)
 uint32_t g_snmpTrapStormCountThreshold = 0;
 uint32_t g_snmpTrapStormDurationThreshold = 15;
+uint32_t g_snmpMaxVarbinds = 32;
+uint32_t g_snmpBulkMaxRepetitions = SNMP_DEFAULT_BULK_MAX_REPETITIONS;
 DB_DRIVER g_dbDriver = nullptr;
 NXCORE_EXPORTABLE_VAR(ThreadPool *g_mainThreadPool) = nullptr;
 int16_t g_defaultAgentCacheMode = AGENT_CACHE_OFF;
@@ -538,11 +541,14 @@ static void LoadGlobalConfig()
    g_agentCommandTimeout = ConfigReadInt(_T("Agent.CommandTimeout"), 4000);
    g_agentRestartWaitTime = ConfigReadInt(_T("Agent.RestartWaitTime"), 0);
    g_thresholdRepeatInterval = ConfigReadInt(_T("DataCollection.ThresholdRepeatInterval"), 0);
+   g_anomalyModelRefreshInterval = ConfigReadULong(_T("DataCollection.AnomalyDetection.ModelRefreshInterval"), 900);
    g_requiredPolls = ConfigReadInt(_T("Objects.PollCountForStatusChange"), 1);
    g_offlineDataRelevanceTime = ConfigReadInt(_T("DataCollection.OfflineDataRelevanceTime"), 86400);
    g_instanceRetentionTime = ConfigReadInt(_T("DataCollection.InstanceRetentionTime"), 7); // Config values are in days
    g_snmpTrapStormCountThreshold = ConfigReadInt(_T("SNMP.Traps.RateLimit.Threshold"), 0);
    g_snmpTrapStormDurationThreshold = ConfigReadInt(_T("SNMP.Traps.RateLimit.Duration"), 15);
+   g_snmpMaxVarbinds = ConfigReadULong(_T("SNMP.Collection.MaxVarbinds"), 32);
+   g_snmpBulkMaxRepetitions = ConfigReadULong(_T("SNMP.Walk.BulkMaxRepetitions"), SNMP_DEFAULT_BULK_MAX_REPETITIONS);
 
    switch(ConfigReadInt(_T("Objects.Nodes.ResolveDNSToIPOnStatusPoll"), static_cast<int>(PrimaryIPUpdateMode::NEVER)))
    {
@@ -1098,11 +1104,20 @@ bool NXCORE_EXPORTABLE Initialize()
    CASReadSettings();
    nxlog_debug_tag(DEBUG_TAG_STARTUP, 1, _T("Global configuration loaded"));
 
-   // Setup thread pool resize parameters
+   // Setup thread pool resize parameters and queueing mode
    ThreadPoolSetResizeParameters(
             ConfigReadInt(_T("ThreadPool.Global.Responsiveness"), 12),
             ConfigReadInt(_T("ThreadPool.Global.WaitTimeHighWatermark"), 100),
             ConfigReadInt(_T("ThreadPool.Global.WaitTimeLowWatermark"), 50));
+   ThreadPoolSetWorkStealingMode(ConfigReadBoolean(_T("ThreadPool.Global.WorkStealing"), true));
+
+   // Start shared SNMP request engine
+   int snmpEngineSockets = ConfigReadInt(_T("SNMP.RequestEngine.Sockets"), 4);
+   if (snmpEngineSockets > 0)
+   {
+      if (!SnmpStartRequestEngine(snmpEngineSockets))
+         nxlog_write_tag(NXLOG_WARNING, DEBUG_TAG_STARTUP, _T("Cannot start shared SNMP request engine, SNMP transports will use individual sockets"));
+   }
 
    // Check data directory
    if (!CheckDataDirectory())
@@ -1458,6 +1473,9 @@ void NXCORE_EXPORTABLE Shutdown()
    ThreadPoolDestroy(g_clientThreadPool);
    ThreadPoolDestroy(g_agentConnectionThreadPool);
    ThreadPoolDestroy(g_mainThreadPool);
+
+   // Stop SNMP request engine only after all thread pools that may still execute SNMP requests are destroyed
+   SnmpStopRequestEngine();
    WatchdogShutdown();
 
    SaveCurrentFreeId();
@@ -33,6 +33,7 @@
 #define DEBUG_TAG_ICMP_POLL         _T("poll.icmp")
 #define DEBUG_TAG_NODE_INTERFACES   _T("node.iface")
 #define DEBUG_TAG_ROUTES_POLL       _T("poll.routes")
+#define DEBUG_TAG_SNMP_CAPS         _T("snmp.caps")
 #define DEBUG_TAG_SNMP_TRAP_FLOOD   _T("snmp.trap.flood")
 
 /**
@@ -42,6 +43,9 @@ extern VolatileCounter64 g_snmpTrapsReceived;
 extern VolatileCounter64 g_syslogMessagesReceived;
 extern VolatileCounter64 g_windowsEventsReceived;
 extern uint32_t g_averageDCIQueuingTime;
+extern uint32_t g_averageDCISchedulerLag;
+extern uint32_t g_dciSchedulerQueueSize;
+extern uint32_t g_dciSchedulerMaxBucketSize;
 
 /**
  * Poller thread pool
@@ -195,6 +199,8 @@ Node::Node() : super(Pollable::STATUS | Pollable::CONFIGURATION | Pollable::DISC
    m_snmpTrapLastTotal = 0;
    m_snmpTrapStormLastCheckTime = 0;
    m_snmpTrapStormActualDuration = 0;
+   m_snmpMaxVarbinds = 0;
+   m_snmpBulkMaxRepetitions = -1;
    m_sshKeyId = 0;
    m_sshPort = SSH_PORT;
    m_sshProxy = 0;
@@ -324,6 +330,8 @@ Node::Node(const NewNodeData *newNodeData, uint32_t flags) : super(Pollable::STA
    m_snmpTrapLastTotal = 0;
    m_snmpTrapStormLastCheckTime = 0;
    m_snmpTrapStormActualDuration = 0;
+   m_snmpMaxVarbinds = 0;
+   m_snmpBulkMaxRepetitions = -1;
    m_sshKeyId = 0;
    m_sshPort = newNodeData->sshPort;
    m_sshProxy = newNodeData->sshProxyId;
@@ -5721,6 +5729,21 @@ bool Node::confPollSnmp()
       return false;
    }
 
+   // Let learned limit for number of variables in SNMP request grow back, as it could be reduced because of temporary condition
+   // (limit can be reduced concurrently by data collection callback, so it is updated with compare-exchange)
+   int learnedMaxVarbinds = m_snmpMaxVarbinds.load();
+   if (learnedMaxVarbinds > 0)
+   {
+      int maxVarbinds = static_cast<int>(getCustomAttributeAsUInt32(_T("SysConfig:SNMP.Collection.MaxVarbinds"), g_snmpMaxVarbinds));
+      int newMaxVarbinds;
+      do
+      {
+         newMaxVarbinds = (learnedMaxVarbinds * 2 < maxVarbinds) ? learnedMaxVarbinds * 2 : 0;
+      } while((learnedMaxVarbinds > 0) && !m_snmpMaxVarbinds.compare_exchange_weak(learnedMaxVarbinds, newMaxVarbinds));
+      if (learnedMaxVarbinds > 0)
+         nxlog_debug_tag(DEBUG_TAG_CONF_POLL, 5, _T("ConfPoll(%s): learned max varbinds per SNMP request increased to %d"), m_name, (newMaxVarbinds > 0) ? newMaxVarbinds : maxVarbinds);
+   }
+
    lockProperties();
    m_snmpPort = pTransport->getPort();
    delete m_snmpSecurity;
@@ -7041,6 +7064,52 @@ inline DataCollectionError DCErrorFromSNMPError(UINT32 snmpError)
    }
 }
 
+/**
+ * Convert raw SNMP value into text according to requested interpretation
+ */
+static void ConvertSNMPRawValue(const BYTE *rawValue, uint32_t length, int interpretRawValue, TCHAR *buffer, size_t size)
+{
+   switch(interpretRawValue)
+   {
+      case SNMP_RAWTYPE_INT32:
+         IntegerToString(static_cast<int32_t>(ntohl(*reinterpret_cast<const uint32_t*>(rawValue))), buffer);
+         break;
+      case SNMP_RAWTYPE_UINT32:
+         IntegerToString(static_cast<uint32_t>(ntohl(*reinterpret_cast<const uint32_t*>(rawValue))), buffer);
+         break;
+      case SNMP_RAWTYPE_INT64:
+         IntegerToString(static_cast<int64_t>(ntohq(*reinterpret_cast<const uint64_t*>(rawValue))), buffer);
+         break;
+      case SNMP_RAWTYPE_UINT64:
+         IntegerToString(ntohq(*reinterpret_cast<const uint64_t*>(rawValue)), buffer);
+         break;
+      case SNMP_RAWTYPE_DOUBLE:
+         _sntprintf(buffer, size, _T("%f"), ntohd(*reinterpret_cast<const double*>(rawValue)));
+         break;
+      case SNMP_RAWTYPE_IP_ADDR:
+         if (length == 4)
+            IpToStr(ntohl(*reinterpret_cast<const uint32_t*>(rawValue)), buffer);
+         else
+            buffer[0] = 0;
+         break;
+      case SNMP_RAWTYPE_IP6_ADDR:
+         if (length == 16)
+            Ip6ToStr(rawValue, buffer);
+         else
+            buffer[0] = 0;
+         break;
+      case SNMP_RAWTYPE_MAC_ADDR:
+         if ((length == 6) || (length == 8))
+            BinToStrEx(rawValue, length, buffer, _T(':'), 0);
+         else
+            buffer[0] = 0;
+         break;
+      default:
+         buffer[0] = 0;
+         break;
+   }
+}
+
 /**
  * Get DCI value via SNMP. Buffer size should be at least 64 characters.
  */
@@ -7075,47 +7144,7 @@ DataCollectionError Node::getMetricFromSNMP(uint16_t port, SNMP_Version version,
          uint32_t length;
          snmpResult = SnmpGetEx(snmp, name, nullptr, 0, rawValue, 1024, SG_RAW_RESULT, &length);
          if (snmpResult == SNMP_ERR_SUCCESS)
-         {
-            switch(interpretRawValue)
-            {
-               case SNMP_RAWTYPE_INT32:
-                  IntegerToString(static_cast<int32_t>(ntohl(*reinterpret_cast<uint32_t*>(rawValue))), buffer);
-                  break;
-               case SNMP_RAWTYPE_UINT32:
-                  IntegerToString(static_cast<uint32_t>(ntohl(*reinterpret_cast<uint32_t*>(rawValue))), buffer);
-                  break;
-               case SNMP_RAWTYPE_INT64:
-                  IntegerToString(static_cast<int64_t>(ntohq(*reinterpret_cast<uint64_t*>(rawValue))), buffer);
-                  break;
-               case SNMP_RAWTYPE_UINT64:
-                  IntegerToString(ntohq(*reinterpret_cast<uint64_t*>(rawValue)), buffer);
-                  break;
-               case SNMP_RAWTYPE_DOUBLE:
-                  _sntprintf(buffer, size, _T("%f"), ntohd(*reinterpret_cast<double*>(rawValue)));
-                  break;
-               case SNMP_RAWTYPE_IP_ADDR:
-                  if (length == 4)
-                     IpToStr(ntohl(*reinterpret_cast<uint32_t*>(rawValue)), buffer);
-                  else
-                     buffer[0] = 0;
-                  break;
-               case SNMP_RAWTYPE_IP6_ADDR:
-                  if (length == 16)
-                     Ip6ToStr(rawValue, buffer);
-                  else
-                     buffer[0] = 0;
-                  break;
-               case SNMP_RAWTYPE_MAC_ADDR:
-                  if ((length == 6) || (length == 8))
-                     BinToStrEx(rawValue, length, buffer, _T(':'), 0);
-                  else
-                     buffer[0] = 0;
-                  break;
-               default:
-                  buffer[0] = 0;
-                  break;
-            }
-         }
+            ConvertSNMPRawValue(rawValue, length, interpretRawValue, buffer, size);
       }
       delete snmp;
    }
@@ -7127,6 +7156,103 @@ DataCollectionError Node::getMetricFromSNMP(uint16_t port, SNMP_Version version,
    return DCErrorFromSNMPError(snmpResult);
 }
 
+/**
+ * Get values of multiple DCIs via SNMP using as few requests as possible. Requests are sent through shared
+ * SNMP request engine when possible, so calling thread is not blocked while waiting for responses. Callback
+ * is called when all values are received (possibly from SNMP engine thread or from calling thread) and takes
+ * ownership of provided string list (contains exactly names.size() elements) and array of collection status
+ * codes for each metric (should be destroyed with MemFree).
+ */
+void Node::getMetricsFromSNMP(uint16_t port, SNMP_Version version, const StringList& names, const int *interpretRawValue,
+         std::function<void (StringList*, DataCollectionError*)> callback)
+{
+   int count = names.size();
+   if ((((m_state & NSF_SNMP_UNREACHABLE) || !(m_capabilities & NC_IS_SNMP)) && (port == 0)) ||
+       (m_state & DCSF_UNREACHABLE) ||
+       (m_flags & NF_DISABLE_SNMP))
+   {
+      nxlog_debug_tag(DEBUG_TAG_DC_SNMP, 7, _T("Node(%s)->getMetricsFromSNMP(%d metrics): snmpResult=%d"), m_name, count, SNMP_ERR_COMM);
+      StringList *values = new StringList();
+      DataCollectionError *errors = MemAllocArrayNoInit<DataCollectionError>(count);
+      for(int i = 0; i < count; i++)
+      {
+         values->add(_T(""));
+         errors[i] = DCErrorFromSNMPError(SNMP_ERR_COMM);
+      }
+      callback(values, errors);
+      return;
+   }
+
+   SNMP_Transport *snmp = createSnmpTransport(port, version);
+   if (snmp == nullptr)
+   {
+      nxlog_debug_tag(DEBUG_TAG_DC_SNMP, 7, _T("Node(%s)->getMetricsFromSNMP(%d metrics): cannot create SNMP transport"), m_name, count);
+      StringList *values = new StringList();
+      DataCollectionError *errors = MemAllocArrayNoInit<DataCollectionError>(count);
+      for(int i = 0; i < count; i++)
+      {
+         values->add(_T(""));
+         errors[i] = DCErrorFromSNMPError(SNMP_ERR_COMM);
+      }
+      callback(values, errors);
+      return;
+   }
+
+   int maxVarbinds = static_cast<int>(getCustomAttributeAsUInt32(_T("SysConfig:SNMP.Collection.MaxVarbinds"), g_snmpMaxVarbinds));
+   int learnedMaxVarbinds = m_snmpMaxVarbinds.load();
+   if ((learnedMaxVarbinds > 0) && (learnedMaxVarbinds < maxVarbinds))
+      maxVarbinds = learnedMaxVarbinds;
+
+   SNMP_ObjectId *oids = new SNMP_ObjectId[count];
+   for(int i = 0; i < count; i++)
+      oids[i] = SNMP_ObjectId::parse(names.get(i));
+   std::vector<int> rawTypes(interpretRawValue, interpretRawValue + count);
+
+   shared_ptr<Node> node = static_pointer_cast<Node>(self());
+   SnmpGetMultipleAsync(snmp, oids, count, maxVarbinds,
+      [node, snmp, count, rawTypes, maxVarbinds, callback] (uint32_t snmpResult, SNMP_Variable **variables, uint32_t *rcc, int finalMaxVarbinds) -> void
+      {
+         if (finalMaxVarbinds < maxVarbinds)
+         {
+            // Only reduce learned limit - other requests may have already reduced it further
+            int current = node->m_snmpMaxVarbinds.load();
+            while(((current == 0) || (current > finalMaxVarbinds)) && !node->m_snmpMaxVarbinds.compare_exchange_weak(current, finalMaxVarbinds));
+            nxlog_debug_tag(DEBUG_TAG_DC_SNMP, 5, _T("Node(%s)->getMetricsFromSNMP(): max varbinds per request reduced to %d"), node->m_name, finalMaxVarbinds);
+         }
+
+         StringList *values = new StringList();
+         DataCollectionError *errors = MemAllocArrayNoInit<DataCollectionError>(count);
+         for(int i = 0; i < count; i++)
+         {
+            TCHAR buffer[MAX_RESULT_LENGTH] = _T("");
+            SNMP_Variable *v = variables[i];
+            if (v != nullptr)
+            {
+               if (rawTypes[i] == SNMP_RAWTYPE_NONE)
+               {
+                  bool convert = true;
+                  v->getValueAsPrintableString(buffer, MAX_RESULT_LENGTH, &convert);
+               }
+               else
+               {
+                  BYTE rawValue[1024];
+                  memset(rawValue, 0, 1024);
+                  uint32_t length = static_cast<uint32_t>(v->getRawValue(rawValue, 1024));
+                  ConvertSNMPRawValue(rawValue, length, rawTypes[i], buffer, MAX_RESULT_LENGTH);
+               }
+               delete v;
+            }
+            values->add(buffer);
+            errors[i] = DCErrorFromSNMPError(rcc[i]);
+         }
+         delete snmp;
+
+         nxlog_debug_tag(DEBUG_TAG_DC_SNMP, 7, _T("Node(%s)->getMetricsFromSNMP(%d metrics): snmpResult=%u"), node->m_name, count, snmpResult);
+         callback(values, errors);
+      });
+   delete[] oids;
+}
+
 /**
  * Read one row for SNMP table
  */
@@ -7369,6 +7495,74 @@ DataCollectionError Node::getMetricFromAgent(const TCHAR *name, TCHAR *buffer, s
    return rc;
 }
 
+/**
+ * Convert agent error code for single metric into data collection error
+ */
+static inline DataCollectionError DCErrorFromAgentError(uint32_t agentError)
+{
+   switch(agentError)
+   {
+      case ERR_SUCCESS:
+         return DCE_SUCCESS;
+      case ERR_UNKNOWN_METRIC:
+      case ERR_UNSUPPORTED_METRIC:
+         return DCE_NOT_SUPPORTED;
+      case ERR_NO_SUCH_INSTANCE:
+         return DCE_NO_SUCH_INSTANCE;
+      case ERR_INTERNAL_ERROR:
+         return DCE_COLLECTION_ERROR;
+      default:
+         return DCE_COMM_ERROR;
+   }
+}
+
+/**
+ * Get values of multiple metrics via native agent with single request. On return "values" will
+ * contain exactly names.size() elements and "errors" (should be at least names.size() elements)
+ * will contain collection status for each metric.
+ */
+void Node::getMetricsFromAgent(const StringList& names, StringList *values, DataCollectionError *errors)
+{
+   for(int i = 0; i < names.size(); i++)
+      errors[i] = DCE_COMM_ERROR;
+
+   if ((m_state & NSF_AGENT_UNREACHABLE) ||
+       (m_state & DCSF_UNREACHABLE) ||
+       (m_flags & NF_DISABLE_NXCP) ||
+       !(m_capabilities & NC_IS_NATIVE_AGENT))
+   {
+      for(int i = 0; i < names.size(); i++)
+         values->add(_T(""));
+      return;
+   }
+
+   uint32_t agentError = ERR_NOT_CONNECTED;
+   uint32_t *rcc = MemAllocArrayNoInit<uint32_t>(names.size());
+   int retry = 3;
+   shared_ptr<AgentConnectionEx> conn = getAgentConnection();
+   while((conn != nullptr) && (retry-- > 0))
+   {
+      values->clear();
+      agentError = conn->getMultipleParameters(names, values, rcc);
+      if (agentError == ERR_SUCCESS)
+      {
+         for(int i = 0; i < names.size(); i++)
+            errors[i] = DCErrorFromAgentError(rcc[i]);
+         setLastAgentCommTime();
+         break;
+      }
+      if ((agentError != ERR_NOT_CONNECTED) && (agentError != ERR_CONNECTION_BROKEN) && (agentError != ERR_REQUEST_TIMEOUT))
+         break;
+      conn = getAgentConnection();
+   }
+   MemFree(rcc);
+
+   while(values->size() < names.size())
+      values->add(_T(""));
+
+   nxlog_debug_tag(DEBUG_TAG_DC_AGENT, 7, _T("Node(%s)->getMetricsFromAgent(%d metrics): agentError=%u"), m_name, names.size(), agentError);
+}
+
 /**
  * Helper function to get metric from agent as double
  */
@@ -8267,6 +8461,18 @@ DataCollectionError Node::getInternalMetric(const TCHAR *name, TCHAR *buffer, si
          });
          ret_int(buffer, dciCount);
       }
+      else if (!_tcsicmp(name, _T("Server.DataCollector.Scheduler.AverageLag")))
+      {
+         ret_uint(buffer, g_averageDCISchedulerLag);
+      }
+      else if (!_tcsicmp(name, _T("Server.DataCollector.Scheduler.MaxBucketSize")))
+      {
+         ret_uint(buffer, g_dciSchedulerMaxBucketSize);
+      }
+      else if (!_tcsicmp(name, _T("Server.DataCollector.Scheduler.QueueSize")))
+      {
+         ret_uint(buffer, g_dciSchedulerQueueSize);
+      }
       else if (!_tcsicmp(name, _T("Server.DB.Queries.Failed")))
       {
          LIBNXDB_PERF_COUNTERS counters;
@@ -8309,6 +8515,36 @@ DataCollectionError Node::getInternalMetric(const TCHAR *name, TCHAR *buffer, si
       {
          IntegerToString(g_rawDataWriteRequests, buffer);
       }
+      else if (!_tcsicmp(name, _T("Server.EventLogWriter.AverageWaitTime")))
+      {
+         EventLogWriterStats stats;
+         GetEventLogWriterStatistics(&stats);
+         IntegerToString(stats.averageWaitTime, buffer);
+      }
+      else if (!_tcsicmp(name, _T("Server.EventLogWriter.FailedEvents")))
+      {
+         EventLogWriterStats stats;
+         GetEventLogWriterStatistics(&stats);
+         IntegerToString(stats.failedEvents, buffer);
+      }
+      else if (!_tcsicmp(name, _T("Server.EventLogWriter.LoggedEvents")))
+      {
+         EventLogWriterStats stats;
+         GetEventLogWriterStatistics(&stats);
+         IntegerToString(stats.loggedEvents, buffer);
+      }
+      else if (!_tcsicmp(name, _T("Server.EventLogWriter.MaxWaitTime")))
+      {
+         EventLogWriterStats stats;
+         GetEventLogWriterStatistics(&stats);
+         IntegerToString(stats.maxWaitTime, buffer);
+      }
+      else if (!_tcsicmp(name, _T("Server.EventLogWriter.Transactions")))
+      {
+         EventLogWriterStats stats;
+         GetEventLogWriterStatistics(&stats);
+         IntegerToString(stats.transactions, buffer);
+      }
       else if (MatchString(_T("Server.EventProcessor.AverageWaitTime(*)"), name, false))
       {
          rc = GetEventProcessorStatistic(name, 'W', buffer);
@@ -8436,6 +8672,36 @@ DataCollectionError Node::getInternalMetric(const TCHAR *name, TCHAR *buffer, si
       {
          ret_uint64(buffer, g_windowsEventsReceived);
       }
+      else if (!_tcsicmp(name, _T("Server.SNMPTrapProcessor.AverageProcessingTime")))
+      {
+         SNMPTrapProcessorStats stats;
+         GetSNMPTrapProcessorStatistics(&stats);
+         ret_double(buffer, stats.averageProcessingTime, 3);
+      }
+      else if (!_tcsicmp(name, _T("Server.SNMPTrapProcessor.AverageWaitTime")))
+      {
+         SNMPTrapProcessorStats stats;
+         GetSNMPTrapProcessorStatistics(&stats);
+         ret_double(buffer, stats.averageWaitTime, 3);
+      }
+      else if (!_tcsicmp(name, _T("Server.SNMPTrapProcessor.MaxProcessingTime")))
+      {
+         SNMPTrapProcessorStats stats;
+         GetSNMPTrapProcessorStatistics(&stats);
+         IntegerToString(stats.maxProcessingTime, buffer);
+      }
+      else if (!_tcsicmp(name, _T("Server.SNMPTrapProcessor.MaxWaitTime")))
+      {
+         SNMPTrapProcessorStats stats;
+         GetSNMPTrapProcessorStatistics(&stats);
+         IntegerToString(stats.maxWaitTime, buffer);
+      }
+      else if (!_tcsicmp(name, _T("Server.SNMPTrapProcessor.ProcessedTraps")))
+      {
+         SNMPTrapProcessorStats stats;
+         GetSNMPTrapProcessorStatistics(&stats);
+         IntegerToString(stats.processedTraps, buffer);
+      }
       else if (!_tcsicmp(_T("Server.SyncerRunTime.Average"), name))
       {
          ret_int64(buffer, GetSyncerRunTime(StatisticType::AVERAGE));
@@ -10379,6 +10645,27 @@ SNMP_Transport *Node::createSnmpTransport(uint16_t port, SNMP_Version version, c
          transport->setCodepage(g_snmpCodepage);
       }
 
+      // GETBULK capabilities learned by walks are only tracked for node's primary SNMP port
+      if ((g_snmpBulkMaxRepetitions > 0) && ((port == 0) || (port == m_snmpPort)))
+      {
+         transport->setBulkMaxRepetitions((m_snmpBulkMaxRepetitions >= 0) ? std::min(m_snmpBulkMaxRepetitions, static_cast<int>(g_snmpBulkMaxRepetitions)) : static_cast<int>(g_snmpBulkMaxRepetitions));
+         weak_ptr<Node> node = self();
+         transport->setBulkCapabilityUpdateHandler(
+            [node] (int maxRepetitions) -> void
+            {
+               shared_ptr<Node> n = node.lock();
+               if (n != nullptr)
+               {
+                  n->m_snmpBulkMaxRepetitions = maxRepetitions;
+                  nxlog_debug_tag(DEBUG_TAG_SNMP_CAPS, 5, _T("GETBULK max repetitions for node %s [%u] set to %d"), n->m_name, n->m_id, maxRepetitions);
+               }
+            });
+      }
+      else
+      {
+         transport->setBulkMaxRepetitions(static_cast<int>(g_snmpBulkMaxRepetitions));
+      }
+
       if (context == nullptr)
       {
          if (community == nullptr)
@@ -702,6 +702,419 @@ NXSL_METHOD_DEFINITION(NetObj, writeMaintenanceJournal)
    return NXSL_ERR_SUCCESS;
 }
 
+/**
+ * Object destruction handler
+ */
+void NXSL_NetObjClass::onObjectDelete(NXSL_Object *object)
+{
+   delete static_cast<shared_ptr<NetObj>*>(object->getData());
+}
+
+/**
+ * NetObj::alarms attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, alarms)
+{
+   NetObj *thisObject = SharedObjectFromData<NetObj>(object);
+   NXSL_Value *value = nullptr;
+   ObjectArray<Alarm> *alarms = GetAlarms(thisObject->getId(), true);
+   alarms->setOwner(Ownership::False);
+   NXSL_Array *array = new NXSL_Array(vm);
+   for(int i = 0; i < alarms->size(); i++)
+      array->append(vm->createValue(vm->createObject(&g_nxslAlarmClass, alarms->get(i))));
+   value = vm->createValue(array);
+   delete alarms;
+   return value;
+}
+
+/**
+ * NetObj::alias attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, alias)
+{
+   NetObj *thisObject = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(thisObject->getAlias());
+}
+
+/**
+ * NetObj::asset attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, asset)
+{
+   NetObj *thisObject = SharedObjectFromData<NetObj>(object);
+   NXSL_Value *value = nullptr;
+   uint32_t assetId = thisObject->getAssetId();
+   if (assetId != 0)
+   {
+      shared_ptr<Asset> asset = static_pointer_cast<Asset>(FindObjectById(assetId, OBJECT_ASSET));
+      value = (asset != nullptr) ? asset->createNXSLObject(vm) : vm->createValue();
+   }
+   else
+   {
+      value = vm->createValue();
+   }
+   return value;
+}
+
+/**
+ * NetObj::assetId attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, assetId)
+{
+   NetObj *thisObject = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(thisObject->getAssetId());
+}
+
+/**
+ * NetObj::assetProperties attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, assetProperties)
+{
+   NetObj *thisObject = SharedObjectFromData<NetObj>(object);
+   NXSL_Value *value = nullptr;
+   uint32_t assetId = thisObject->getAssetId();
+   if (assetId != 0)
+   {
+      shared_ptr<Asset> asset = static_pointer_cast<Asset>(FindObjectById(assetId, OBJECT_ASSET));
+      value = (asset != nullptr) ? vm->createValue(vm->createObject(&g_nxslAssetPropertiesClass, new shared_ptr<Asset>(asset))) : vm->createValue();
+   }
+   else
+   {
+      value = vm->createValue();
+   }
+   return value;
+}
+
+/**
+ * NetObj::backupZoneProxy attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, backupZoneProxy)
+{
+   NetObj *thisObject = SharedObjectFromData<NetObj>(object);
+   NXSL_Value *value = nullptr;
+   uint32_t id = thisObject->getAssignedZoneProxyId(true);
+   if (id != 0)
+   {
+      shared_ptr<NetObj> proxy = FindObjectById(id, OBJECT_NODE);
+      value = (proxy != nullptr) ? proxy->createNXSLObject(vm) : vm->createValue();
+   }
+   else
+   {
+      value = vm->createValue();
+   }
+   return value;
+}
+
+/**
+ * NetObj::backupZoneProxyId attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, backupZoneProxyId)
+{
+   NetObj *thisObject = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(thisObject->getAssignedZoneProxyId(true));
+}
+
+/**
+ * NetObj::category attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, category)
+{
+   NetObj *thisObject = SharedObjectFromData<NetObj>(object);
+   NXSL_Value *value = nullptr;
+   if (thisObject->getCategoryId() != 0)
+   {
+      shared_ptr<ObjectCategory> category = GetObjectCategory(thisObject->getCategoryId());
+      value = (category != nullptr) ? vm->createValue(category->getName()) : vm->createValue();
+   }
+   else
+   {
+      value = vm->createValue();
+   }
+   return value;
+}
+
+/**
+ * NetObj::categoryId attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, categoryId)
+{
+   NetObj *thisObject = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(thisObject->getCategoryId());
+}
+
+/**
+ * NetObj::children attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, children)
+{
+   NetObj *thisObject = SharedObjectFromData<NetObj>(object);
+   return thisObject->getChildrenForNXSL(vm);
+}
+
+/**
+ * NetObj::city attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, city)
+{
+   NetObj *thisObject = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(thisObject->getPostalAddress().getCity());
+}
+
+/**
+ * NetObj::comments attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, comments)
+{
+   NetObj *thisObject = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(thisObject->getComments());
+}
+
+/**
+ * NetObj::country attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, country)
+{
+   NetObj *thisObject = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(thisObject->getPostalAddress().getCountry());
+}
+
+/**
+ * NetObj::creationTime attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, creationTime)
+{
+   NetObj *thisObject = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(static_cast<INT64>(thisObject->getCreationTime()));
+}
+
+/**
+ * NetObj::customAttributes attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, customAttributes)
+{
+   NetObj *thisObject = SharedObjectFromData<NetObj>(object);
+   return thisObject->getCustomAttributesForNXSL(vm);
+}
+
+/**
+ * NetObj::district attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, district)
+{
+   NetObj *thisObject = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(thisObject->getPostalAddress().getDistrict());
+}
+
+/**
+ * NetObj::geolocation attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, geolocation)
+{
+   NetObj *thisObject = SharedObjectFromData<NetObj>(object);
+   return NXSL_GeoLocationClass::createObject(vm, thisObject->getGeoLocation());
+}
+
+/**
+ * NetObj::guid attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, guid)
+{
+   NetObj *thisObject = SharedObjectFromData<NetObj>(object);
+   NXSL_Value *value = nullptr;
+   TCHAR buffer[64];
+   value = vm->createValue(thisObject->getGuid().toString(buffer));
+   return value;
+}
+
+/**
+ * NetObj::id attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, id)
+{
+   NetObj *thisObject = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(thisObject->getId());
+}
+
+/**
+ * NetObj::ipAddr attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, ipAddr)
+{
+   NetObj *thisObject = SharedObjectFromData<NetObj>(object);
+   NXSL_Value *value = nullptr;
+   TCHAR buffer[64];
+   value = vm->createValue(thisObject->getPrimaryIpAddress().toString(buffer));
+   return value;
+}
+
+/**
+ * NetObj::ipAddress attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, ipAddress)
+{
+   NetObj *thisObject = SharedObjectFromData<NetObj>(object);
+   return NXSL_InetAddressClass::createObject(vm, thisObject->getPrimaryIpAddress());
+}
+
+/**
+ * NetObj::isInMaintenanceMode attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, isInMaintenanceMode)
+{
+   NetObj *thisObject = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(thisObject->isInMaintenanceMode());
+}
+
+/**
+ * NetObj::maintenanceInitiator attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, maintenanceInitiator)
+{
+   NetObj *thisObject = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(thisObject->getMaintenanceInitiator());
+}
+
+/**
+ * NetObj::mapImage attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, mapImage)
+{
+   NetObj *thisObject = SharedObjectFromData<NetObj>(object);
+   NXSL_Value *value = nullptr;
+   TCHAR buffer[64];
+   value = vm->createValue(thisObject->getMapImage().toString(buffer));
+   return value;
+}
+
+/**
+ * NetObj::name attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, name)
+{
+   NetObj *thisObject = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(thisObject->getName());
+}
+
+/**
+ * NetObj::nameOnMap attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, nameOnMap)
+{
+   NetObj *thisObject = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(thisObject->getNameOnMap());
+}
+
+/**
+ * NetObj::parents attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, parents)
+{
+   NetObj *thisObject = SharedObjectFromData<NetObj>(object);
+   return thisObject->getParentsForNXSL(vm);
+}
+
+/**
+ * NetObj::postcode attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, postcode)
+{
+   NetObj *thisObject = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(thisObject->getPostalAddress().getPostCode());
+}
+
+/**
+ * NetObj::primaryZoneProxy attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, primaryZoneProxy)
+{
+   NetObj *thisObject = SharedObjectFromData<NetObj>(object);
+   NXSL_Value *value = nullptr;
+   UINT32 id = thisObject->getAssignedZoneProxyId(false);
+   if (id != 0)
+   {
+      shared_ptr<NetObj> proxy = FindObjectById(id, OBJECT_NODE);
+      value = (proxy != nullptr) ? proxy->createNXSLObject(vm) : vm->createValue();
+   }
+   else
+   {
+      value = vm->createValue();
+   }
+   return value;
+}
+
+/**
+ * NetObj::primaryZoneProxyId attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, primaryZoneProxyId)
+{
+   NetObj *thisObject = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(thisObject->getAssignedZoneProxyId(false));
+}
+
+/**
+ * NetObj::region attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, region)
+{
+   NetObj *thisObject = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(thisObject->getPostalAddress().getRegion());
+}
+
+/**
+ * NetObj::responsibleUsers attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, responsibleUsers)
+{
+   NetObj *thisObject = SharedObjectFromData<NetObj>(object);
+   NXSL_Value *value = nullptr;
+   NXSL_Array *array = new NXSL_Array(vm);
+   unique_ptr<StructArray<ResponsibleUser>> responsibleUsers = thisObject->getAllResponsibleUsers();
+   unique_ptr<ObjectArray<UserDatabaseObject>> userDB = FindUserDBObjects(*responsibleUsers);
+   userDB->setOwner(Ownership::False);
+   for(int i = 0; i < userDB->size(); i++)
+   {
+      array->append(userDB->get(i)->createNXSLObject(vm));
+   }
+   value = vm->createValue(array);
+   return value;
+}
+
+/**
+ * NetObj::state attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, state)
+{
+   NetObj *thisObject = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(thisObject->getState());
+}
+
+/**
+ * NetObj::status attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, status)
+{
+   NetObj *thisObject = SharedObjectFromData<NetObj>(object);
+   return vm->createValue((LONG)thisObject->getStatus());
+}
+
+/**
+ * NetObj::streetAddress attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, streetAddress)
+{
+   NetObj *thisObject = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(thisObject->getPostalAddress().getStreetAddress());
+}
+
+/**
+ * NetObj::type attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, type)
+{
+   NetObj *thisObject = SharedObjectFromData<NetObj>(object);
+   return vm->createValue((LONG)thisObject->getObjectClass());
+}
+
 /**
  * NXSL class NetObj: constructor
  */
@@ -741,14 +1154,43 @@ NXSL_NetObjClass::NXSL_NetObjClass() : NXSL_Class()
    NXSL_REGISTER_METHOD(NetObj, unbindFrom, 1);
    NXSL_REGISTER_METHOD(NetObj, unmanage, 0);
    NXSL_REGISTER_METHOD(NetObj, writeMaintenanceJournal, 1);
-}
 
-/**
- * Object destruction handler
- */
-void NXSL_NetObjClass::onObjectDelete(NXSL_Object *object)
-{
-   delete static_cast<shared_ptr<NetObj>*>(object->getData());
+   NXSL_REGISTER_ATTRIBUTE(NetObj, alarms);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, alias);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, asset);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, assetId);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, assetProperties);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, backupZoneProxy);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, backupZoneProxyId);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, category);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, categoryId);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, children);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, city);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, comments);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, country);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, creationTime);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, customAttributes);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, district);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, geolocation);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, guid);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, id);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, ipAddr);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, ipAddress);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, isInMaintenanceMode);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, maintenanceInitiator);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, mapImage);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, name);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, nameOnMap);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, parents);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, postcode);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, primaryZoneProxy);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, primaryZoneProxyId);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, region);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, responsibleUsers);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, state);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, status);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, streetAddress);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, type);
 }
 
 /**
@@ -762,221 +1204,16 @@ NXSL_Value *NXSL_NetObjClass::getAttr(NXSL_Object *_object, const NXSL_Identifie
 
    NXSL_VM *vm = _object->vm();
    auto object = SharedObjectFromData<NetObj>(_object);
-   if (NXSL_COMPARE_ATTRIBUTE_NAME("alarms"))
-   {
-      ObjectArray<Alarm> *alarms = GetAlarms(object->getId(), true);
-      alarms->setOwner(Ownership::False);
-      NXSL_Array *array = new NXSL_Array(vm);
-      for(int i = 0; i < alarms->size(); i++)
-         array->append(vm->createValue(vm->createObject(&g_nxslAlarmClass, alarms->get(i))));
-      value = vm->createValue(array);
-      delete alarms;
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("alias"))
+   if (object != nullptr)   // Object can be null if attribute scan is running
    {
-      value = vm->createValue(object->getAlias());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("asset"))
-   {
-      uint32_t assetId = object->getAssetId();
-      if (assetId != 0)
-      {
-         shared_ptr<Asset> asset = static_pointer_cast<Asset>(FindObjectById(assetId, OBJECT_ASSET));
-         value = (asset != nullptr) ? asset->createNXSLObject(vm) : vm->createValue();
-      }
-      else
-      {
-         value = vm->createValue();
-      }
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("assetId"))
-   {
-      value = vm->createValue(object->getAssetId());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("assetProperties"))
-   {
-      uint32_t assetId = object->getAssetId();
-      if (assetId != 0)
-      {
-         shared_ptr<Asset> asset = static_pointer_cast<Asset>(FindObjectById(assetId, OBJECT_ASSET));
-         value = (asset != nullptr) ? vm->createValue(vm->createObject(&g_nxslAssetPropertiesClass, new shared_ptr<Asset>(asset))) : vm->createValue();
-      }
-      else
-      {
-         value = vm->createValue();
-      }
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("backupZoneProxy"))
-   {
-      uint32_t id = object->getAssignedZoneProxyId(true);
-      if (id != 0)
-      {
-         shared_ptr<NetObj> proxy = FindObjectById(id, OBJECT_NODE);
-         value = (proxy != nullptr) ? proxy->createNXSLObject(vm) : vm->createValue();
-      }
-      else
-      {
-         value = vm->createValue();
-      }
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("backupZoneProxyId"))
-   {
-      value = vm->createValue(object->getAssignedZoneProxyId(true));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("category"))
-   {
-      if (object->getCategoryId() != 0)
-      {
-         shared_ptr<ObjectCategory> category = GetObjectCategory(object->getCategoryId());
-         value = (category != nullptr) ? vm->createValue(category->getName()) : vm->createValue();
-      }
-      else
-      {
-         value = vm->createValue();
-      }
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("categoryId"))
-   {
-      value = vm->createValue(object->getCategoryId());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("children"))
-   {
-      value = object->getChildrenForNXSL(vm);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("city"))
-   {
-      value = vm->createValue(object->getPostalAddress().getCity());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("comments"))
-   {
-      value = vm->createValue(object->getComments());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("country"))
-   {
-      value = vm->createValue(object->getPostalAddress().getCountry());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("creationTime"))
-   {
-      value = vm->createValue(static_cast<INT64>(object->getCreationTime()));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("customAttributes"))
-   {
-      value = object->getCustomAttributesForNXSL(vm);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("district"))
-   {
-      value = vm->createValue(object->getPostalAddress().getDistrict());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("geolocation"))
-   {
-      value = NXSL_GeoLocationClass::createObject(vm, object->getGeoLocation());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("guid"))
-   {
-      TCHAR buffer[64];
-      value = vm->createValue(object->getGuid().toString(buffer));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("id"))
-   {
-      value = vm->createValue(object->getId());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("ipAddr"))
-   {
-      TCHAR buffer[64];
-      value = vm->createValue(object->getPrimaryIpAddress().toString(buffer));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("ipAddress"))
-   {
-      value = NXSL_InetAddressClass::createObject(vm, object->getPrimaryIpAddress());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isInMaintenanceMode"))
-   {
-      value = vm->createValue(object->isInMaintenanceMode());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("maintenanceInitiator"))
-   {
-      value = vm->createValue(object->getMaintenanceInitiator());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("mapImage"))
-   {
-      TCHAR buffer[64];
-      value = vm->createValue(object->getMapImage().toString(buffer));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("name"))
-   {
-      value = vm->createValue(object->getName());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("nameOnMap"))
-   {
-      value = vm->createValue(object->getNameOnMap());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("parents"))
-   {
-      value = object->getParentsForNXSL(vm);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("postcode"))
-   {
-      value = vm->createValue(object->getPostalAddress().getPostCode());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("primaryZoneProxy"))
-   {
-      UINT32 id = object->getAssignedZoneProxyId(false);
-      if (id != 0)
-      {
-         shared_ptr<NetObj> proxy = FindObjectById(id, OBJECT_NODE);
-         value = (proxy != nullptr) ? proxy->createNXSLObject(vm) : vm->createValue();
-      }
-      else
-      {
-         value = vm->createValue();
-      }
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("primaryZoneProxyId"))
-   {
-      value = vm->createValue(object->getAssignedZoneProxyId(false));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("region"))
-   {
-      value = vm->createValue(object->getPostalAddress().getRegion());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("responsibleUsers"))
-   {
-      NXSL_Array *array = new NXSL_Array(vm);
-      unique_ptr<StructArray<ResponsibleUser>> responsibleUsers = object->getAllResponsibleUsers();
-      unique_ptr<ObjectArray<UserDatabaseObject>> userDB = FindUserDBObjects(*responsibleUsers);
-      userDB->setOwner(Ownership::False);
-      for(int i = 0; i < userDB->size(); i++)
-      {
-         array->append(userDB->get(i)->createNXSLObject(vm));
-      }
-      value = vm->createValue(array);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("state"))
-   {
-      value = vm->createValue(object->getState());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("status"))
-   {
-      value = vm->createValue((LONG)object->getStatus());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("streetAddress"))
-   {
-      value = vm->createValue(object->getPostalAddress().getStreetAddress());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("type"))
-   {
-      value = vm->createValue((LONG)object->getObjectClass());
-   }
-   else if (object != nullptr)   // Object can be null if attribute scan is running
-   {
-#ifdef UNICODE
-      WCHAR wattr[MAX_IDENTIFIER_LENGTH];
-      utf8_to_wchar(attr.value, -1, wattr, MAX_IDENTIFIER_LENGTH);
-      wattr[MAX_IDENTIFIER_LENGTH - 1] = 0;
-      value = object->getCustomAttributeForNXSL(vm, wattr);
-#else
-      value = object->getCustomAttributeForNXSL(vm, attr.value);
-#endif
+#ifdef UNICODE
+      WCHAR wattr[MAX_IDENTIFIER_LENGTH];
+      utf8_to_wchar(attr.value, -1, wattr, MAX_IDENTIFIER_LENGTH);
+      wattr[MAX_IDENTIFIER_LENGTH - 1] = 0;
+      value = object->getCustomAttributeForNXSL(vm, wattr);
+#else
+      value = object->getCustomAttributeForNXSL(vm, attr.value);
+#endif
    }
    return value;
 }
@@ -1303,6 +1540,15 @@ NXSL_METHOD_DEFINITION(DataCollectionTarget, removeTemplate)
    return 0;
 }
 
+/**
+ * DataCollectionTarget::templates attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(DataCollectionTarget, templates)
+{
+   auto dcTarget = SharedObjectFromData<DataCollectionTarget>(object);
+   return vm->createValue(dcTarget->getTemplatesForNXSL(vm));
+}
+
 /**
  * NXSL class DataCollectionTarget: constructor
  */
@@ -1316,24 +1562,8 @@ NXSL_DCTargetClass::NXSL_DCTargetClass() : NXSL_NetObjClass()
    NXSL_REGISTER_METHOD(DataCollectionTarget, enableStatusPolling, 1);
    NXSL_REGISTER_METHOD(DataCollectionTarget, readInternalParameter, 1);
    NXSL_REGISTER_METHOD(DataCollectionTarget, removeTemplate, 1);
-}
-
-/**
- * NXSL class Zone: get attribute
- */
-NXSL_Value *NXSL_DCTargetClass::getAttr(NXSL_Object *object, const NXSL_Identifier& attr)
-{
-   NXSL_Value *value = NXSL_NetObjClass::getAttr(object, attr);
-   if (value != nullptr)
-      return value;
 
-   NXSL_VM *vm = object->vm();
-   auto dcTarget = SharedObjectFromData<DataCollectionTarget>(object);
-   if (NXSL_COMPARE_ATTRIBUTE_NAME("templates"))
-   {
-      value = vm->createValue(dcTarget->getTemplatesForNXSL(vm));
-   }
-   return value;
+   NXSL_REGISTER_ATTRIBUTE(DataCollectionTarget, templates);
 }
 
 /**
@@ -2030,47 +2260,6 @@ NXSL_METHOD_DEFINITION(Node, setIfXTableUsageMode)
    return 0;
 }
 
-/**
- * NXSL class Node: constructor
- */
-NXSL_NodeClass::NXSL_NodeClass() : NXSL_DCTargetClass()
-{
-   setName(_T("Node"));
-
-   NXSL_REGISTER_METHOD(Node, callWebService, -1);
-   NXSL_REGISTER_METHOD(Node, createSNMPTransport, -1);
-   NXSL_REGISTER_METHOD(Node, enable8021xStatusPolling, 1);
-   NXSL_REGISTER_METHOD(Node, enableAgent, 1);
-   NXSL_REGISTER_METHOD(Node, enableDiscoveryPolling, 1);
-   NXSL_REGISTER_METHOD(Node, enableEtherNetIP, 1);
-   NXSL_REGISTER_METHOD(Node, enableIcmp, 1);
-   NXSL_REGISTER_METHOD(Node, enableModbusTcp, 1);
-   NXSL_REGISTER_METHOD(Node, enablePrimaryIPPing, 1);
-   NXSL_REGISTER_METHOD(Node, enableRoutingTablePolling, 1);
-   NXSL_REGISTER_METHOD(Node, enableSnmp, 1);
-   NXSL_REGISTER_METHOD(Node, enableSsh, 1);
-   NXSL_REGISTER_METHOD(Node, enableWinPerfCountersCache, 1);
-   NXSL_REGISTER_METHOD(Node, enableTopologyPolling, 1);
-   NXSL_REGISTER_METHOD(Node, executeAgentCommand, -1);
-   NXSL_REGISTER_METHOD(Node, executeAgentCommandWithOutput, -1);
-   NXSL_REGISTER_METHOD(Node, executeSSHCommand, 1);
-   NXSL_REGISTER_METHOD(Node, getInterface, 1);
-   NXSL_REGISTER_METHOD(Node, getInterfaceByIndex, 1);
-   NXSL_REGISTER_METHOD(Node, getInterfaceByMACAddress, 1);
-   NXSL_REGISTER_METHOD(Node, getInterfaceByName, 1);
-   NXSL_REGISTER_METHOD(Node, getInterfaceName, 1);
-   NXSL_REGISTER_METHOD(Node, getWebService, 1);
-   NXSL_REGISTER_METHOD(Node, readAgentList, 1);
-   NXSL_REGISTER_METHOD(Node, readAgentParameter, 1);
-   NXSL_REGISTER_METHOD(Node, readAgentTable, 1);
-   NXSL_REGISTER_METHOD(Node, readDriverParameter, 1);
-   NXSL_REGISTER_METHOD(Node, readInternalParameter, 1);
-   NXSL_REGISTER_METHOD(Node, readInternalTable, 1);
-   NXSL_REGISTER_METHOD(Node, readWebServiceList, 1);
-   NXSL_REGISTER_METHOD(Node, readWebServiceParameter, 1);
-   NXSL_REGISTER_METHOD(Node, setIfXTableUsageMode, 1);
-}
-
 /**
  * Get ICMP statistic for object
  */
@@ -2090,1037 +2279,2049 @@ static NXSL_Value *GetNodeIcmpStatistic(Node *node, IcmpStatFunction function, N
 }
 
 /**
- * NXSL class Node: get attribute
+ * Node::agentCertificateMappingData attribute
  */
-NXSL_Value *NXSL_NodeClass::getAttr(NXSL_Object *object, const NXSL_Identifier& attr)
+NXSL_ATTRIBUTE_DEFINITION(Node, agentCertificateMappingData)
 {
-   NXSL_Value *value = NXSL_DCTargetClass::getAttr(object, attr);
-   if (value != nullptr)
-      return value;
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getAgentCertificateMappingData());
+}
 
-   NXSL_VM *vm = object->vm();
+/**
+ * Node::agentCertificateMappingMethod attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, agentCertificateMappingMethod)
+{
    auto node = SharedObjectFromData<Node>(object);
-   if (NXSL_COMPARE_ATTRIBUTE_NAME("agentCertificateMappingData"))
-   {
-      value = vm->createValue(node->getAgentCertificateMappingData());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("agentCertificateMappingMethod"))
-   {
-      value = vm->createValue(static_cast<int32_t>(node->getAgentCertificateMappingMethod()));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("agentCertificateSubject"))
-   {
-      value = vm->createValue(node->getAgentCertificateSubject());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("agentId"))
-   {
-      TCHAR buffer[64];
-      value = vm->createValue(node->getAgentId().toString(buffer));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("agentProxy"))
-   {
-      shared_ptr<NetObj> object = FindObjectById(node->getAgentProxy());
-      if (object != nullptr)
-      {
-         value = object->createNXSLObject(vm);
-      }
-      else
-      {
-         value = vm->createValue();
-      }
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("agentVersion"))
-   {
-      value = vm->createValue(node->getAgentVersion());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("bootTime"))
-   {
-      value = vm->createValue(static_cast<INT64>(node->getBootTime()));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("bridgeBaseAddress"))
-   {
-      TCHAR buffer[64];
-      value = vm->createValue(BinToStr(node->getBridgeId(), MAC_ADDR_LENGTH, buffer));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("capabilities"))
-   {
-      value = vm->createValue(node->getCapabilities());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("cipDeviceType"))
-   {
-      value = vm->createValue(node->getCipDeviceType());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("cipDeviceTypeAsText"))
-   {
-      value = vm->createValue(CIP_DeviceTypeNameFromCode(node->getCipDeviceType()));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("cipExtendedStatus"))
-   {
-      value = vm->createValue((node->getCipStatus() & CIP_DEVICE_STATUS_EXTENDED_STATUS_MASK) >> 4);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("cipExtendedStatusAsText"))
-   {
-      value = vm->createValue(CIP_DecodeExtendedDeviceStatus(node->getCipStatus()));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("cipStatus"))
-   {
-      value = vm->createValue(node->getCipStatus());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("cipStatusAsText"))
+   return vm->createValue(static_cast<int32_t>(node->getAgentCertificateMappingMethod()));
+}
+
+/**
+ * Node::agentCertificateSubject attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, agentCertificateSubject)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getAgentCertificateSubject());
+}
+
+/**
+ * Node::agentId attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, agentId)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value = nullptr;
+   TCHAR buffer[64];
+   value = vm->createValue(node->getAgentId().toString(buffer));
+   return value;
+}
+
+/**
+ * Node::agentProxy attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, agentProxy)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value = nullptr;
+   shared_ptr<NetObj> proxy = FindObjectById(node->getAgentProxy());
+   if (proxy != nullptr)
    {
-      value = vm->createValue(CIP_DecodeDeviceStatus(node->getCipStatus()));
+      value = proxy->createNXSLObject(vm);
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("cipState"))
+   else
    {
-      value = vm->createValue(node->getCipState());
+      value = vm->createValue();
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("cipStateAsText"))
-   {
-      value = vm->createValue(CIP_DeviceStateTextFromCode(node->getCipState()));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("cipVendorCode"))
-   {
-      value = vm->createValue(node->getCipVendorCode());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("cluster"))
-   {
-      shared_ptr<Cluster> cluster = node->getCluster();
-      value = (cluster != nullptr) ? cluster->createNXSLObject(vm) : vm->createValue();
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("components"))
-   {
-      shared_ptr<ComponentTree> components = node->getComponents();
-      if (components != nullptr)
-      {
-         value = ComponentTree::getRootForNXSL(vm, components);
-      }
-      else
-      {
-         value = vm->createValue();
-      }
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("dependentNodes"))
-   {
-      unique_ptr<StructArray<DependentNode>> dependencies = GetNodeDependencies(node->getId());
-      NXSL_Array *a = new NXSL_Array(vm);
-      for(int i = 0; i < dependencies->size(); i++)
-      {
-         a->append(vm->createValue(vm->createObject(&g_nxslNodeDependencyClass, new DependentNode(*dependencies->get(i)))));
-      }
-      value = vm->createValue(a);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("driver"))
-   {
-      value = vm->createValue(node->getDriverName());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("downSince"))
-   {
-      value = vm->createValue(static_cast<INT64>(node->getDownSince()));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("effectiveAgentProxy"))
-   {
-      shared_ptr<NetObj> object = FindObjectById(node->getEffectiveAgentProxy());
-      if (object != nullptr)
-      {
-         value = object->createNXSLObject(vm);
-      }
-      else
-      {
-         value = vm->createValue();
-      }
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("effectiveIcmpProxy"))
-   {
-      shared_ptr<NetObj> object = FindObjectById(node->getEffectiveIcmpProxy());
-      if (object != nullptr)
-      {
-         value = object->createNXSLObject(vm);
-      }
-      else
-      {
-         value = vm->createValue();
-      }
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("effectiveSnmpProxy"))
-   {
-      shared_ptr<NetObj> object = FindObjectById(node->getEffectiveSnmpProxy());
-      if (object != nullptr)
-      {
-         value = object->createNXSLObject(vm);
-      }
-      else
-      {
-         value = vm->createValue();
-      }
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("flags"))
-   {
-		value = vm->createValue(node->getFlags());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("hasAgentIfXCounters"))
-   {
-      value = vm->createValue(is_bit_set(node->getCapabilities(), NC_HAS_AGENT_IFXCOUNTERS));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("hasEntityMIB"))
-   {
-      value = vm->createValue(is_bit_set(node->getCapabilities(), NC_HAS_ENTITY_MIB));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("hasIfXTable"))
-   {
-      value = vm->createValue(is_bit_set(node->getCapabilities(), NC_HAS_IFXTABLE));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("hasUserAgent"))
-   {
-      value = vm->createValue(is_bit_set(node->getCapabilities(), NC_HAS_USER_AGENT));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("hasVLANs"))
-   {
-      value = vm->createValue(is_bit_set(node->getCapabilities(), NC_HAS_VLANS));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("hardwareId"))
-   {
-      TCHAR buffer[HARDWARE_ID_LENGTH * 2 + 1];
-      value = vm->createValue(BinToStr(node->getHardwareId().value(), HARDWARE_ID_LENGTH, buffer));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("hardwareComponents"))
-   {
-      value = node->getHardwareComponentsForNXSL(vm);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("hasWinPDH"))
-   {
-      value = vm->createValue(is_bit_set(node->getCapabilities(), NC_HAS_WINPDH));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("hypervisorInfo"))
-   {
-      value = vm->createValue(node->getHypervisorInfo());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("hypervisorType"))
-   {
-      value = vm->createValue(node->getHypervisorType());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("icmpAverageRTT"))
-   {
-      value = GetNodeIcmpStatistic(node, IcmpStatFunction::AVERAGE, vm);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("icmpLastRTT"))
-   {
-      value = GetNodeIcmpStatistic(node, IcmpStatFunction::LAST, vm);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("icmpMaxRTT"))
-   {
-      value = GetNodeIcmpStatistic(node, IcmpStatFunction::MAX, vm);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("icmpMinRTT"))
-   {
-      value = GetNodeIcmpStatistic(node, IcmpStatFunction::MIN, vm);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("icmpPacketLoss"))
-   {
-      value = GetNodeIcmpStatistic(node, IcmpStatFunction::LOSS, vm);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("icmpProxy"))
-   {
-      shared_ptr<NetObj> object = FindObjectById(node->getIcmpProxy());
-      if (object != nullptr)
-      {
-         value = object->createNXSLObject(vm);
-      }
-      else
-      {
-         value = vm->createValue();
-      }
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("interfaces"))
-   {
-      value = node->getInterfacesForNXSL(vm);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isAgent"))
-   {
-      value = vm->createValue(node->isNativeAgent());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isBridge"))
-   {
-      value = vm->createValue(node->isBridge());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isCDP"))
-   {
-      value = vm->createValue(is_bit_set(node->getCapabilities(), NC_IS_CDP));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isEtherNetIP"))
-   {
-      value = vm->createValue(node->isEthernetIPSupported());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isInMaintenanceMode"))
-   {
-      value = vm->createValue(node->isInMaintenanceMode());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isLLDP"))
-   {
-      value = vm->createValue(is_bit_set(node->getCapabilities(), NC_IS_LLDP));
-   }
-	else if (NXSL_COMPARE_ATTRIBUTE_NAME("isLocalMgmt") || NXSL_COMPARE_ATTRIBUTE_NAME("isLocalManagement"))
-	{
-		value = vm->createValue(node->isLocalManagement());
-	}
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isModbusTCP"))
-   {
-      value = vm->createValue(node->isModbusTCPSupported());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isOSPF"))
-   {
-      value = vm->createValue(node->isOSPFSupported());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isPAE") || NXSL_COMPARE_ATTRIBUTE_NAME("is802_1x"))
-   {
-      value = vm->createValue(is_bit_set(node->getCapabilities(), NC_IS_8021X));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isPrinter"))
+   return value;
+}
+
+/**
+ * Node::agentVersion attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, agentVersion)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getAgentVersion());
+}
+
+/**
+ * Node::bootTime attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, bootTime)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(static_cast<INT64>(node->getBootTime()));
+}
+
+/**
+ * Node::bridgeBaseAddress attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, bridgeBaseAddress)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value = nullptr;
+   TCHAR buffer[64];
+   value = vm->createValue(BinToStr(node->getBridgeId(), MAC_ADDR_LENGTH, buffer));
+   return value;
+}
+
+/**
+ * Node::capabilities attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, capabilities)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getCapabilities());
+}
+
+/**
+ * Node::cipDeviceType attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, cipDeviceType)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getCipDeviceType());
+}
+
+/**
+ * Node::cipDeviceTypeAsText attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, cipDeviceTypeAsText)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(CIP_DeviceTypeNameFromCode(node->getCipDeviceType()));
+}
+
+/**
+ * Node::cipExtendedStatus attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, cipExtendedStatus)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue((node->getCipStatus() & CIP_DEVICE_STATUS_EXTENDED_STATUS_MASK) >> 4);
+}
+
+/**
+ * Node::cipExtendedStatusAsText attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, cipExtendedStatusAsText)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(CIP_DecodeExtendedDeviceStatus(node->getCipStatus()));
+}
+
+/**
+ * Node::cipStatus attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, cipStatus)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getCipStatus());
+}
+
+/**
+ * Node::cipStatusAsText attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, cipStatusAsText)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(CIP_DecodeDeviceStatus(node->getCipStatus()));
+}
+
+/**
+ * Node::cipState attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, cipState)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getCipState());
+}
+
+/**
+ * Node::cipStateAsText attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, cipStateAsText)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(CIP_DeviceStateTextFromCode(node->getCipState()));
+}
+
+/**
+ * Node::cipVendorCode attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, cipVendorCode)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getCipVendorCode());
+}
+
+/**
+ * Node::cluster attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, cluster)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value = nullptr;
+   shared_ptr<Cluster> cluster = node->getCluster();
+   value = (cluster != nullptr) ? cluster->createNXSLObject(vm) : vm->createValue();
+   return value;
+}
+
+/**
+ * Node::components attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, components)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value = nullptr;
+   shared_ptr<ComponentTree> components = node->getComponents();
+   if (components != nullptr)
    {
-      value = vm->createValue(is_bit_set(node->getCapabilities(), NC_IS_PRINTER));
+      value = ComponentTree::getRootForNXSL(vm, components);
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isProfiNet"))
+   else
    {
-      value = vm->createValue(node->isProfiNetSupported());
+      value = vm->createValue();
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isRemotelyManaged") || NXSL_COMPARE_ATTRIBUTE_NAME("isExternalGateway"))
+   return value;
+}
+
+/**
+ * Node::dependentNodes attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, dependentNodes)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value = nullptr;
+   unique_ptr<StructArray<DependentNode>> dependencies = GetNodeDependencies(node->getId());
+   NXSL_Array *a = new NXSL_Array(vm);
+   for(int i = 0; i < dependencies->size(); i++)
    {
-      value = vm->createValue(is_bit_set(node->getFlags(), NF_EXTERNAL_GATEWAY));
+      a->append(vm->createValue(vm->createObject(&g_nxslNodeDependencyClass, new DependentNode(*dependencies->get(i)))));
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isRouter"))
+   value = vm->createValue(a);
+   return value;
+}
+
+/**
+ * Node::driver attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, driver)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getDriverName());
+}
+
+/**
+ * Node::downSince attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, downSince)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(static_cast<INT64>(node->getDownSince()));
+}
+
+/**
+ * Node::effectiveAgentProxy attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, effectiveAgentProxy)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value = nullptr;
+   shared_ptr<NetObj> proxy = FindObjectById(node->getEffectiveAgentProxy());
+   if (proxy != nullptr)
    {
-      value = vm->createValue(node->isRouter());
+      value = proxy->createNXSLObject(vm);
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isSMCLP"))
+   else
    {
-      value = vm->createValue(is_bit_set(node->getCapabilities(), NC_IS_SMCLP));
+      value = vm->createValue();
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isSNMP"))
+   return value;
+}
+
+/**
+ * Node::effectiveIcmpProxy attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, effectiveIcmpProxy)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value = nullptr;
+   shared_ptr<NetObj> proxy = FindObjectById(node->getEffectiveIcmpProxy());
+   if (proxy != nullptr)
    {
-      value = vm->createValue(node->isSNMPSupported());
+      value = proxy->createNXSLObject(vm);
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isSSH"))
+   else
    {
-      value = vm->createValue(node->isSSHSupported());
+      value = vm->createValue();
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isSONMP") || NXSL_COMPARE_ATTRIBUTE_NAME("isNDP"))
+   return value;
+}
+
+/**
+ * Node::effectiveSnmpProxy attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, effectiveSnmpProxy)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value = nullptr;
+   shared_ptr<NetObj> proxy = FindObjectById(node->getEffectiveSnmpProxy());
+   if (proxy != nullptr)
    {
-      value = vm->createValue(is_bit_set(node->getCapabilities(), NC_IS_NDP));
+      value = proxy->createNXSLObject(vm);
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isSTP"))
+   else
    {
-      value = vm->createValue(is_bit_set(node->getCapabilities(), NC_IS_STP));
+      value = vm->createValue();
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isVirtual"))
-   {
-      value = vm->createValue(node->isVirtual());
+   return value;
+}
+
+/**
+ * Node::flags attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, flags)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getFlags());
+}
+
+/**
+ * Node::hasAgentIfXCounters attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, hasAgentIfXCounters)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(is_bit_set(node->getCapabilities(), NC_HAS_AGENT_IFXCOUNTERS));
+}
+
+/**
+ * Node::hasEntityMIB attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, hasEntityMIB)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(is_bit_set(node->getCapabilities(), NC_HAS_ENTITY_MIB));
+}
+
+/**
+ * Node::hasIfXTable attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, hasIfXTable)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(is_bit_set(node->getCapabilities(), NC_HAS_IFXTABLE));
+}
+
+/**
+ * Node::hasUserAgent attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, hasUserAgent)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(is_bit_set(node->getCapabilities(), NC_HAS_USER_AGENT));
+}
+
+/**
+ * Node::hasVLANs attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, hasVLANs)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(is_bit_set(node->getCapabilities(), NC_HAS_VLANS));
+}
+
+/**
+ * Node::hardwareId attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, hardwareId)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value = nullptr;
+   TCHAR buffer[HARDWARE_ID_LENGTH * 2 + 1];
+   value = vm->createValue(BinToStr(node->getHardwareId().value(), HARDWARE_ID_LENGTH, buffer));
+   return value;
+}
+
+/**
+ * Node::hardwareComponents attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, hardwareComponents)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return node->getHardwareComponentsForNXSL(vm);
+}
+
+/**
+ * Node::hasWinPDH attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, hasWinPDH)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(is_bit_set(node->getCapabilities(), NC_HAS_WINPDH));
+}
+
+/**
+ * Node::hypervisorInfo attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, hypervisorInfo)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getHypervisorInfo());
+}
+
+/**
+ * Node::hypervisorType attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, hypervisorType)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getHypervisorType());
+}
+
+/**
+ * Node::icmpAverageRTT attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, icmpAverageRTT)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return GetNodeIcmpStatistic(node, IcmpStatFunction::AVERAGE, vm);
+}
+
+/**
+ * Node::icmpLastRTT attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, icmpLastRTT)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return GetNodeIcmpStatistic(node, IcmpStatFunction::LAST, vm);
+}
+
+/**
+ * Node::icmpMaxRTT attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, icmpMaxRTT)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return GetNodeIcmpStatistic(node, IcmpStatFunction::MAX, vm);
+}
+
+/**
+ * Node::icmpMinRTT attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, icmpMinRTT)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return GetNodeIcmpStatistic(node, IcmpStatFunction::MIN, vm);
+}
+
+/**
+ * Node::icmpPacketLoss attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, icmpPacketLoss)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return GetNodeIcmpStatistic(node, IcmpStatFunction::LOSS, vm);
+}
+
+/**
+ * Node::icmpProxy attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, icmpProxy)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value = nullptr;
+   shared_ptr<NetObj> proxy = FindObjectById(node->getIcmpProxy());
+   if (proxy != nullptr)
+   {
+      value = proxy->createNXSLObject(vm);
+   }
+   else
+   {
+      value = vm->createValue();
+   }
+   return value;
+}
+
+/**
+ * Node::interfaces attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, interfaces)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return node->getInterfacesForNXSL(vm);
+}
+
+/**
+ * Node::isAgent attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isAgent)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->isNativeAgent());
+}
+
+/**
+ * Node::isBridge attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isBridge)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->isBridge());
+}
+
+/**
+ * Node::isCDP attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isCDP)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(is_bit_set(node->getCapabilities(), NC_IS_CDP));
+}
+
+/**
+ * Node::isEtherNetIP attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isEtherNetIP)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->isEthernetIPSupported());
+}
+
+/**
+ * Node::isLLDP attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isLLDP)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(is_bit_set(node->getCapabilities(), NC_IS_LLDP));
+}
+
+/**
+ * Node::isLocalMgmt attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isLocalMgmt)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->isLocalManagement());
+}
+
+/**
+ * Node::isModbusTCP attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isModbusTCP)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->isModbusTCPSupported());
+}
+
+/**
+ * Node::isOSPF attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isOSPF)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->isOSPFSupported());
+}
+
+/**
+ * Node::isPAE attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isPAE)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(is_bit_set(node->getCapabilities(), NC_IS_8021X));
+}
+
+/**
+ * Node::isPrinter attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isPrinter)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(is_bit_set(node->getCapabilities(), NC_IS_PRINTER));
+}
+
+/**
+ * Node::isProfiNet attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isProfiNet)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->isProfiNetSupported());
+}
+
+/**
+ * Node::isRemotelyManaged attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isRemotelyManaged)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(is_bit_set(node->getFlags(), NF_EXTERNAL_GATEWAY));
+}
+
+/**
+ * Node::isRouter attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isRouter)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->isRouter());
+}
+
+/**
+ * Node::isSMCLP attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isSMCLP)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(is_bit_set(node->getCapabilities(), NC_IS_SMCLP));
+}
+
+/**
+ * Node::isSNMP attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isSNMP)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->isSNMPSupported());
+}
+
+/**
+ * Node::isSSH attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isSSH)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->isSSHSupported());
+}
+
+/**
+ * Node::isSONMP attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isSONMP)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(is_bit_set(node->getCapabilities(), NC_IS_NDP));
+}
+
+/**
+ * Node::isSTP attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isSTP)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(is_bit_set(node->getCapabilities(), NC_IS_STP));
+}
+
+/**
+ * Node::isVirtual attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isVirtual)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->isVirtual());
+}
+
+/**
+ * Node::isVRRP attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isVRRP)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(is_bit_set(node->getCapabilities(), NC_IS_VRRP));
+}
+
+/**
+ * Node::isWirelessAP attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isWirelessAP)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->isWirelessAccessPoint());
+}
+
+/**
+ * Node::isWirelessController attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isWirelessController)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->isWirelessController());
+}
+
+/**
+ * Node::lastAgentCommTime attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, lastAgentCommTime)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(static_cast<int64_t>(node->getLastAgentCommTime()));
+}
+
+/**
+ * Node::modbusProxy attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, modbusProxy)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value = nullptr;
+   shared_ptr<NetObj> proxy = FindObjectById(node->getModbusProxy());
+   if (proxy != nullptr)
+   {
+      value = proxy->createNXSLObject(vm);
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isVRRP"))
+   else
    {
-      value = vm->createValue(is_bit_set(node->getCapabilities(), NC_IS_VRRP));
+      value = vm->createValue();
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isWirelessAP"))
+   return value;
+}
+
+/**
+ * Node::modbusProxyId attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, modbusProxyId)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getModbusProxy());
+}
+
+/**
+ * Node::modbusTCPPort attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, modbusTCPPort)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getModbusTcpPort());
+}
+
+/**
+ * Node::modbusUnitId attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, modbusUnitId)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getModbusUnitId());
+}
+
+/**
+ * Node::networkPathCheckResult attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, networkPathCheckResult)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(vm->createObject(&g_nxslNetworkPathCheckResultClass, new NetworkPathCheckResult(node->getNetworkPathCheckResult())));
+}
+
+/**
+ * Node::nodeSubType attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, nodeSubType)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getSubType());
+}
+
+/**
+ * Node::nodeType attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, nodeType)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(static_cast<int32_t>(node->getType()));
+}
+
+/**
+ * Node::ospfAreas attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, ospfAreas)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return node->isOSPFSupported() ? node->getOSPFAreasForNXSL(vm) : vm->createValue();
+}
+
+/**
+ * Node::ospfNeighbors attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, ospfNeighbors)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return node->isOSPFSupported() ? node->getOSPFNeighborsForNXSL(vm) : vm->createValue();
+}
+
+/**
+ * Node::ospfRouterId attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, ospfRouterId)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value = nullptr;
+   TCHAR buffer[16];
+   value = node->isOSPFSupported() ? vm->createValue(IpToStr(node->getOSPFRouterId(), buffer)) : vm->createValue();
+   return value;
+}
+
+/**
+ * Node::physicalContainer attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, physicalContainer)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value = nullptr;
+   shared_ptr<NetObj> container = FindObjectById(node->getPhysicalContainerId());
+   if (container != nullptr)
    {
-      value = vm->createValue(node->isWirelessAccessPoint());
+      value = container->createNXSLObject(vm);
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isWirelessController"))
+   else
    {
-      value = vm->createValue(node->isWirelessController());
+      value = vm->createValue();
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("lastAgentCommTime"))
+   return value;
+}
+
+/**
+ * Node::physicalContainerId attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, physicalContainerId)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getPhysicalContainerId());
+}
+
+/**
+ * Node::platformName attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, platformName)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getPlatformName());
+}
+
+/**
+ * Node::primaryHostName attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, primaryHostName)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getPrimaryHostName());
+}
+
+/**
+ * Node::productCode attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, productCode)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getProductCode());
+}
+
+/**
+ * Node::productName attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, productName)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getProductName());
+}
+
+/**
+ * Node::productVersion attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, productVersion)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getProductVersion());
+}
+
+/**
+ * Node::rack attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, rack)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value = nullptr;
+   shared_ptr<NetObj> rack = FindObjectById(node->getPhysicalContainerId(), OBJECT_RACK);
+   if (rack != nullptr)
+   {
+      value = rack->createNXSLObject(vm);
+   }
+   else
+   {
+      value = vm->createValue();
+   }
+   return value;
+}
+
+/**
+ * Node::rackId attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, rackId)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value = nullptr;
+   if (FindObjectById(node->getPhysicalContainerId(), OBJECT_RACK) != nullptr)
+   {
+      value = vm->createValue(node->getPhysicalContainerId());
+   }
+   else
+   {
+      value = vm->createValue(0);
+   }
+   return value;
+}
+
+/**
+ * Node::rackHeight attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, rackHeight)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getRackHeight());
+}
+
+/**
+ * Node::rackPosition attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, rackPosition)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getRackPosition());
+}
+
+/**
+ * Node::runtimeFlags attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, runtimeFlags)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getRuntimeFlags());
+}
+
+/**
+ * Node::serialNumber attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, serialNumber)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getSerialNumber());
+}
+
+/**
+ * Node::snmpOID attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, snmpOID)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value = nullptr;
+   value = vm->createValue(node->getSNMPObjectId().toString());   // FIXME: use object representation
+   return value;
+}
+
+/**
+ * Node::snmpProxy attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, snmpProxy)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value = nullptr;
+   shared_ptr<NetObj> proxy = FindObjectById(node->getSNMPProxy());
+   if (proxy != nullptr)
+   {
+      value = proxy->createNXSLObject(vm);
+   }
+   else
    {
-      value = vm->createValue(static_cast<int64_t>(node->getLastAgentCommTime()));
+      value = vm->createValue();
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("modbusProxy"))
+   return value;
+}
+
+/**
+ * Node::snmpProxyId attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, snmpProxyId)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getSNMPProxy());
+}
+
+/**
+ * Node::snmpSysContact attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, snmpSysContact)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getSysContact());
+}
+
+/**
+ * Node::snmpSysLocation attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, snmpSysLocation)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getSysLocation());
+}
+
+/**
+ * Node::snmpSysName attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, snmpSysName)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getSysName());
+}
+
+/**
+ * Node::snmpVersion attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, snmpVersion)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue((LONG)node->getSNMPVersion());
+}
+
+/**
+ * Node::softwarePackages attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, softwarePackages)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return node->getSoftwarePackagesForNXSL(vm);
+}
+
+/**
+ * Node::sysDescription attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, sysDescription)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getSysDescription());
+}
+
+/**
+ * Node::tunnel attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, tunnel)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value = nullptr;
+   shared_ptr<AgentTunnel> tunnel = GetTunnelForNode(node->getId());
+   if (tunnel != nullptr)
+      value = vm->createValue(vm->createObject(&g_nxslTunnelClass, new shared_ptr<AgentTunnel>(tunnel)));
+   else
+      value = vm->createValue();
+   return value;
+}
+
+/**
+ * Node::vendor attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, vendor)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getVendor());
+}
+
+/**
+ * Node::vlans attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, vlans)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value = nullptr;
+   shared_ptr<VlanList> vlans = node->getVlans();
+   if (vlans != nullptr)
    {
-      shared_ptr<NetObj> object = FindObjectById(node->getModbusProxy());
-      if (object != nullptr)
-      {
-         value = object->createNXSLObject(vm);
-      }
-      else
+      NXSL_Array *a = new NXSL_Array(vm);
+      for(int i = 0; i < vlans->size(); i++)
       {
-         value = vm->createValue();
+         a->append(vm->createValue(vm->createObject(&g_nxslVlanClass, new VlanInfo(vlans->get(i), node->getId()))));
       }
+      value = vm->createValue(a);
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("modbusProxyId"))
-   {
-      value = vm->createValue(node->getModbusProxy());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("modbusTCPPort"))
-   {
-      value = vm->createValue(node->getModbusTcpPort());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("modbusUnitId"))
-   {
-      value = vm->createValue(node->getModbusUnitId());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("networkPathCheckResult"))
-   {
-      value = vm->createValue(vm->createObject(&g_nxslNetworkPathCheckResultClass, new NetworkPathCheckResult(node->getNetworkPathCheckResult())));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("nodeSubType"))
-   {
-      value = vm->createValue(node->getSubType());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("nodeType"))
-   {
-      value = vm->createValue(static_cast<int32_t>(node->getType()));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("ospfAreas"))
+   else
    {
-      value = node->isOSPFSupported() ? node->getOSPFAreasForNXSL(vm) : vm->createValue();
+      value = vm->createValue();
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("ospfNeighbors"))
+   return value;
+}
+
+/**
+ * Node::wirelessDomain attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, wirelessDomain)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value = nullptr;
+   shared_ptr<WirelessDomain> wirelessDomain = node->getWirelessDomain();
+   value = (wirelessDomain != nullptr) ? wirelessDomain->createNXSLObject(vm) : vm->createValue();
+   return value;
+}
+
+/**
+ * Node::wirelessDomainId attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, wirelessDomainId)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value = nullptr;
+   shared_ptr<WirelessDomain> wirelessDomain = node->getWirelessDomain();
+   value = (wirelessDomain != nullptr) ? vm->createValue(wirelessDomain->getId()) : vm->createValue(static_cast<uint32_t>(0));
+   return value;
+}
+
+/**
+ * Node::wirelessStations attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, wirelessStations)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value = nullptr;
+   if (node->getCapabilities() & (NC_IS_WIFI_AP | NC_IS_WIFI_CONTROLLER))
    {
-      value = node->isOSPFSupported() ? node->getOSPFNeighborsForNXSL(vm) : vm->createValue();
+      value = node->getWirelessStationsForNXSL(vm);
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("ospfRouterId"))
+   else
    {
-      TCHAR buffer[16];
-      value = node->isOSPFSupported() ? vm->createValue(IpToStr(node->getOSPFRouterId(), buffer)) : vm->createValue();
+      value = vm->createValue();
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("physicalContainer"))
+   return value;
+}
+
+/**
+ * Node::zone attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, zone)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value = nullptr;
+   if (IsZoningEnabled())
    {
-      shared_ptr<NetObj> object = FindObjectById(node->getPhysicalContainerId());
-      if (object != nullptr)
+      shared_ptr<Zone> zone = FindZoneByUIN(node->getZoneUIN());
+      if (zone != nullptr)
       {
-         value = object->createNXSLObject(vm);
+         value = zone->createNXSLObject(vm);
       }
       else
       {
          value = vm->createValue();
       }
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("physicalContainerId"))
-   {
-      value = vm->createValue(node->getPhysicalContainerId());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("platformName"))
-   {
-      value = vm->createValue(node->getPlatformName());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("primaryHostName"))
-   {
-      value = vm->createValue(node->getPrimaryHostName());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("productCode"))
-   {
-      value = vm->createValue(node->getProductCode());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("productName"))
-   {
-      value = vm->createValue(node->getProductName());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("productVersion"))
-   {
-      value = vm->createValue(node->getProductVersion());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("rack"))
+   else
    {
-      shared_ptr<NetObj> rack = FindObjectById(node->getPhysicalContainerId(), OBJECT_RACK);
-      if (rack != nullptr)
-      {
-         value = rack->createNXSLObject(vm);
-      }
-      else
-      {
-         value = vm->createValue();
-      }
+      value = vm->createValue();
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("rackId"))
+   return value;
+}
+
+/**
+ * Node::zoneProxyAssignments attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, zoneProxyAssignments)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value = nullptr;
+   if (IsZoningEnabled())
    {
-      if (FindObjectById(node->getPhysicalContainerId(), OBJECT_RACK) != nullptr)
+      shared_ptr<Zone> zone = FindZoneByProxyId(node->getId());
+      if (zone != nullptr)
       {
-         value = vm->createValue(node->getPhysicalContainerId());
+         value = vm->createValue(zone->getProxyNodeAssignments(node->getId()));
       }
       else
       {
          value = vm->createValue(0);
       }
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("rackHeight"))
-   {
-      value = vm->createValue(node->getRackHeight());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("rackPosition"))
-   {
-      value = vm->createValue(node->getRackPosition());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("runtimeFlags"))
-   {
-      value = vm->createValue(node->getRuntimeFlags());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("serialNumber"))
-   {
-      value = vm->createValue(node->getSerialNumber());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("snmpOID"))
+   else
    {
-      value = vm->createValue(node->getSNMPObjectId().toString());   // FIXME: use object representation
+      value = vm->createValue(0);
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("snmpProxy"))
+   return value;
+}
+
+/**
+ * Node::zoneProxyStatus attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, zoneProxyStatus)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value = nullptr;
+   if (IsZoningEnabled())
    {
-      shared_ptr<NetObj> object = FindObjectById(node->getSNMPProxy());
-      if (object != nullptr)
+      shared_ptr<Zone> zone = FindZoneByProxyId(node->getId());
+      if (zone != nullptr)
       {
-         value = object->createNXSLObject(vm);
+         value = vm->createValue(zone->isProxyNodeAvailable(node->getId()));
       }
       else
       {
-         value = vm->createValue();
+         value = vm->createValue(0);
       }
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("snmpProxyId"))
-   {
-      value = vm->createValue(node->getSNMPProxy());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("snmpSysContact"))
-   {
-      value = vm->createValue(node->getSysContact());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("snmpSysLocation"))
-   {
-      value = vm->createValue(node->getSysLocation());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("snmpSysName"))
-   {
-      value = vm->createValue(node->getSysName());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("snmpVersion"))
-   {
-      value = vm->createValue((LONG)node->getSNMPVersion());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("softwarePackages"))
+   else
    {
-      value = node->getSoftwarePackagesForNXSL(vm);
+      value = vm->createValue(0);
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("sysDescription"))
+   return value;
+}
+
+/**
+ * Node::zoneUIN attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, zoneUIN)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getZoneUIN());
+}
+
+/**
+ * NXSL class Node: constructor
+ */
+NXSL_NodeClass::NXSL_NodeClass() : NXSL_DCTargetClass()
+{
+   setName(_T("Node"));
+
+   NXSL_REGISTER_METHOD(Node, callWebService, -1);
+   NXSL_REGISTER_METHOD(Node, createSNMPTransport, -1);
+   NXSL_REGISTER_METHOD(Node, enable8021xStatusPolling, 1);
+   NXSL_REGISTER_METHOD(Node, enableAgent, 1);
+   NXSL_REGISTER_METHOD(Node, enableDiscoveryPolling, 1);
+   NXSL_REGISTER_METHOD(Node, enableEtherNetIP, 1);
+   NXSL_REGISTER_METHOD(Node, enableIcmp, 1);
+   NXSL_REGISTER_METHOD(Node, enableModbusTcp, 1);
+   NXSL_REGISTER_METHOD(Node, enablePrimaryIPPing, 1);
+   NXSL_REGISTER_METHOD(Node, enableRoutingTablePolling, 1);
+   NXSL_REGISTER_METHOD(Node, enableSnmp, 1);
+   NXSL_REGISTER_METHOD(Node, enableSsh, 1);
+   NXSL_REGISTER_METHOD(Node, enableWinPerfCountersCache, 1);
+   NXSL_REGISTER_METHOD(Node, enableTopologyPolling, 1);
+   NXSL_REGISTER_METHOD(Node, executeAgentCommand, -1);
+   NXSL_REGISTER_METHOD(Node, executeAgentCommandWithOutput, -1);
+   NXSL_REGISTER_METHOD(Node, executeSSHCommand, 1);
+   NXSL_REGISTER_METHOD(Node, getInterface, 1);
+   NXSL_REGISTER_METHOD(Node, getInterfaceByIndex, 1);
+   NXSL_REGISTER_METHOD(Node, getInterfaceByMACAddress, 1);
+   NXSL_REGISTER_METHOD(Node, getInterfaceByName, 1);
+   NXSL_REGISTER_METHOD(Node, getInterfaceName, 1);
+   NXSL_REGISTER_METHOD(Node, getWebService, 1);
+   NXSL_REGISTER_METHOD(Node, readAgentList, 1);
+   NXSL_REGISTER_METHOD(Node, readAgentParameter, 1);
+   NXSL_REGISTER_METHOD(Node, readAgentTable, 1);
+   NXSL_REGISTER_METHOD(Node, readDriverParameter, 1);
+   NXSL_REGISTER_METHOD(Node, readInternalParameter, 1);
+   NXSL_REGISTER_METHOD(Node, readInternalTable, 1);
+   NXSL_REGISTER_METHOD(Node, readWebServiceList, 1);
+   NXSL_REGISTER_METHOD(Node, readWebServiceParameter, 1);
+   NXSL_REGISTER_METHOD(Node, setIfXTableUsageMode, 1);
+
+   NXSL_REGISTER_ATTRIBUTE(Node, agentCertificateMappingData);
+   NXSL_REGISTER_ATTRIBUTE(Node, agentCertificateMappingMethod);
+   NXSL_REGISTER_ATTRIBUTE(Node, agentCertificateSubject);
+   NXSL_REGISTER_ATTRIBUTE(Node, agentId);
+   NXSL_REGISTER_ATTRIBUTE(Node, agentProxy);
+   NXSL_REGISTER_ATTRIBUTE(Node, agentVersion);
+   NXSL_REGISTER_ATTRIBUTE(Node, bootTime);
+   NXSL_REGISTER_ATTRIBUTE(Node, bridgeBaseAddress);
+   NXSL_REGISTER_ATTRIBUTE(Node, capabilities);
+   NXSL_REGISTER_ATTRIBUTE(Node, cipDeviceType);
+   NXSL_REGISTER_ATTRIBUTE(Node, cipDeviceTypeAsText);
+   NXSL_REGISTER_ATTRIBUTE(Node, cipExtendedStatus);
+   NXSL_REGISTER_ATTRIBUTE(Node, cipExtendedStatusAsText);
+   NXSL_REGISTER_ATTRIBUTE(Node, cipStatus);
+   NXSL_REGISTER_ATTRIBUTE(Node, cipStatusAsText);
+   NXSL_REGISTER_ATTRIBUTE(Node, cipState);
+   NXSL_REGISTER_ATTRIBUTE(Node, cipStateAsText);
+   NXSL_REGISTER_ATTRIBUTE(Node, cipVendorCode);
+   NXSL_REGISTER_ATTRIBUTE(Node, cluster);
+   NXSL_REGISTER_ATTRIBUTE(Node, components);
+   NXSL_REGISTER_ATTRIBUTE(Node, dependentNodes);
+   NXSL_REGISTER_ATTRIBUTE(Node, driver);
+   NXSL_REGISTER_ATTRIBUTE(Node, downSince);
+   NXSL_REGISTER_ATTRIBUTE(Node, effectiveAgentProxy);
+   NXSL_REGISTER_ATTRIBUTE(Node, effectiveIcmpProxy);
+   NXSL_REGISTER_ATTRIBUTE(Node, effectiveSnmpProxy);
+   NXSL_REGISTER_ATTRIBUTE(Node, flags);
+   NXSL_REGISTER_ATTRIBUTE(Node, hasAgentIfXCounters);
+   NXSL_REGISTER_ATTRIBUTE(Node, hasEntityMIB);
+   NXSL_REGISTER_ATTRIBUTE(Node, hasIfXTable);
+   NXSL_REGISTER_ATTRIBUTE(Node, hasUserAgent);
+   NXSL_REGISTER_ATTRIBUTE(Node, hasVLANs);
+   NXSL_REGISTER_ATTRIBUTE(Node, hardwareId);
+   NXSL_REGISTER_ATTRIBUTE(Node, hardwareComponents);
+   NXSL_REGISTER_ATTRIBUTE(Node, hasWinPDH);
+   NXSL_REGISTER_ATTRIBUTE(Node, hypervisorInfo);
+   NXSL_REGISTER_ATTRIBUTE(Node, hypervisorType);
+   NXSL_REGISTER_ATTRIBUTE(Node, icmpAverageRTT);
+   NXSL_REGISTER_ATTRIBUTE(Node, icmpLastRTT);
+   NXSL_REGISTER_ATTRIBUTE(Node, icmpMaxRTT);
+   NXSL_REGISTER_ATTRIBUTE(Node, icmpMinRTT);
+   NXSL_REGISTER_ATTRIBUTE(Node, icmpPacketLoss);
+   NXSL_REGISTER_ATTRIBUTE(Node, icmpProxy);
+   NXSL_REGISTER_ATTRIBUTE(Node, interfaces);
+   NXSL_REGISTER_ATTRIBUTE(Node, isAgent);
+   NXSL_REGISTER_ATTRIBUTE(Node, isBridge);
+   NXSL_REGISTER_ATTRIBUTE(Node, isCDP);
+   NXSL_REGISTER_ATTRIBUTE(Node, isEtherNetIP);
+   NXSL_REGISTER_ATTRIBUTE(Node, isLLDP);
+   NXSL_REGISTER_ATTRIBUTE(Node, isLocalMgmt);
+   NXSL_REGISTER_ATTRIBUTE_ALIAS(Node, isLocalManagement, isLocalMgmt);
+   NXSL_REGISTER_ATTRIBUTE(Node, isModbusTCP);
+   NXSL_REGISTER_ATTRIBUTE(Node, isOSPF);
+   NXSL_REGISTER_ATTRIBUTE(Node, isPAE);
+   NXSL_REGISTER_ATTRIBUTE_ALIAS(Node, is802_1x, isPAE);
+   NXSL_REGISTER_ATTRIBUTE(Node, isPrinter);
+   NXSL_REGISTER_ATTRIBUTE(Node, isProfiNet);
+   NXSL_REGISTER_ATTRIBUTE(Node, isRemotelyManaged);
+   NXSL_REGISTER_ATTRIBUTE_ALIAS(Node, isExternalGateway, isRemotelyManaged);
+   NXSL_REGISTER_ATTRIBUTE(Node, isRouter);
+   NXSL_REGISTER_ATTRIBUTE(Node, isSMCLP);
+   NXSL_REGISTER_ATTRIBUTE(Node, isSNMP);
+   NXSL_REGISTER_ATTRIBUTE(Node, isSSH);
+   NXSL_REGISTER_ATTRIBUTE(Node, isSONMP);
+   NXSL_REGISTER_ATTRIBUTE_ALIAS(Node, isNDP, isSONMP);
+   NXSL_REGISTER_ATTRIBUTE(Node, isSTP);
+   NXSL_REGISTER_ATTRIBUTE(Node, isVirtual);
+   NXSL_REGISTER_ATTRIBUTE(Node, isVRRP);
+   NXSL_REGISTER_ATTRIBUTE(Node, isWirelessAP);
+   NXSL_REGISTER_ATTRIBUTE(Node, isWirelessController);
+   NXSL_REGISTER_ATTRIBUTE(Node, lastAgentCommTime);
+   NXSL_REGISTER_ATTRIBUTE(Node, modbusProxy);
+   NXSL_REGISTER_ATTRIBUTE(Node, modbusProxyId);
+   NXSL_REGISTER_ATTRIBUTE(Node, modbusTCPPort);
+   NXSL_REGISTER_ATTRIBUTE(Node, modbusUnitId);
+   NXSL_REGISTER_ATTRIBUTE(Node, networkPathCheckResult);
+   NXSL_REGISTER_ATTRIBUTE(Node, nodeSubType);
+   NXSL_REGISTER_ATTRIBUTE(Node, nodeType);
+   NXSL_REGISTER_ATTRIBUTE(Node, ospfAreas);
+   NXSL_REGISTER_ATTRIBUTE(Node, ospfNeighbors);
+   NXSL_REGISTER_ATTRIBUTE(Node, ospfRouterId);
+   NXSL_REGISTER_ATTRIBUTE(Node, physicalContainer);
+   NXSL_REGISTER_ATTRIBUTE(Node, physicalContainerId);
+   NXSL_REGISTER_ATTRIBUTE(Node, platformName);
+   NXSL_REGISTER_ATTRIBUTE(Node, primaryHostName);
+   NXSL_REGISTER_ATTRIBUTE(Node, productCode);
+   NXSL_REGISTER_ATTRIBUTE(Node, productName);
+   NXSL_REGISTER_ATTRIBUTE(Node, productVersion);
+   NXSL_REGISTER_ATTRIBUTE(Node, rack);
+   NXSL_REGISTER_ATTRIBUTE(Node, rackId);
+   NXSL_REGISTER_ATTRIBUTE(Node, rackHeight);
+   NXSL_REGISTER_ATTRIBUTE(Node, rackPosition);
+   NXSL_REGISTER_ATTRIBUTE(Node, runtimeFlags);
+   NXSL_REGISTER_ATTRIBUTE(Node, serialNumber);
+   NXSL_REGISTER_ATTRIBUTE(Node, snmpOID);
+   NXSL_REGISTER_ATTRIBUTE(Node, snmpProxy);
+   NXSL_REGISTER_ATTRIBUTE(Node, snmpProxyId);
+   NXSL_REGISTER_ATTRIBUTE(Node, snmpSysContact);
+   NXSL_REGISTER_ATTRIBUTE(Node, snmpSysLocation);
+   NXSL_REGISTER_ATTRIBUTE(Node, snmpSysName);
+   NXSL_REGISTER_ATTRIBUTE(Node, snmpVersion);
+   NXSL_REGISTER_ATTRIBUTE(Node, softwarePackages);
+   NXSL_REGISTER_ATTRIBUTE(Node, sysDescription);
+   NXSL_REGISTER_ATTRIBUTE(Node, tunnel);
+   NXSL_REGISTER_ATTRIBUTE(Node, vendor);
+   NXSL_REGISTER_ATTRIBUTE(Node, vlans);
+   NXSL_REGISTER_ATTRIBUTE(Node, wirelessDomain);
+   NXSL_REGISTER_ATTRIBUTE(Node, wirelessDomainId);
+   NXSL_REGISTER_ATTRIBUTE(Node, wirelessStations);
+   NXSL_REGISTER_ATTRIBUTE(Node, zone);
+   NXSL_REGISTER_ATTRIBUTE(Node, zoneProxyAssignments);
+   NXSL_REGISTER_ATTRIBUTE(Node, zoneProxyStatus);
+   NXSL_REGISTER_ATTRIBUTE(Node, zoneUIN);
+}
+
+/**
+ * Interface::enableAgentStatusPolling(enabled) method
+ */
+NXSL_METHOD_DEFINITION(Interface, enableAgentStatusPolling)
+{
+   return ChangeFlagMethod(object, argv[0], result, IF_DISABLE_AGENT_STATUS_POLL, true);
+}
+
+/**
+ * Interface::enableICMPStatusPolling(enabled) method
+ */
+NXSL_METHOD_DEFINITION(Interface, enableICMPStatusPolling)
+{
+   return ChangeFlagMethod(object, argv[0], result, IF_DISABLE_ICMP_STATUS_POLL, true);
+}
+
+/**
+ * Interface::enableSNMPStatusPolling(enabled) method
+ */
+NXSL_METHOD_DEFINITION(Interface, enableSNMPStatusPolling)
+{
+   return ChangeFlagMethod(object, argv[0], result, IF_DISABLE_SNMP_STATUS_POLL, true);
+}
+
+/**
+ * Interface::setExcludeFromTopology(enabled) method
+ */
+NXSL_METHOD_DEFINITION(Interface, setExcludeFromTopology)
+{
+   Interface *iface = static_cast<shared_ptr<Interface>*>(object->getData())->get();
+   iface->setExcludeFromTopology(argv[0]->getValueAsBoolean());
+   *result = vm->createValue();
+   return 0;
+}
+
+/**
+ * Interface::setExpectedState(state) method
+ */
+NXSL_METHOD_DEFINITION(Interface, setExpectedState)
+{
+   int state;
+   if (argv[0]->isInteger())
    {
-      value = vm->createValue(node->getSysDescription());
+      state = argv[0]->getValueAsInt32();
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("tunnel"))
+   else if (argv[0]->isString())
    {
-      shared_ptr<AgentTunnel> tunnel = GetTunnelForNode(node->getId());
-      if (tunnel != nullptr)
-         value = vm->createValue(vm->createObject(&g_nxslTunnelClass, new shared_ptr<AgentTunnel>(tunnel)));
-      else
-         value = vm->createValue();
+      static const TCHAR *stateNames[] = { _T("UP"), _T("DOWN"), _T("IGNORE"), nullptr };
+      const TCHAR *name = argv[0]->getValueAsCString();
+      for(state = 0; stateNames[state] != nullptr; state++)
+         if (!_tcsicmp(stateNames[state], name))
+            break;
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("vendor"))
+   else
    {
-      value = vm->createValue(node->getVendor());
+      return NXSL_ERR_NOT_STRING;
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("vlans"))
+
+   if ((state >= 0) && (state <= 2))
+      static_cast<shared_ptr<Interface>*>(object->getData())->get()->setExpectedState(state);
+
+   *result = vm->createValue();
+   return 0;
+}
+
+/**
+ * Interface::setIncludeInIcmpPoll(enabled) method
+ */
+NXSL_METHOD_DEFINITION(Interface, setIncludeInIcmpPoll)
+{
+   Interface *iface = static_cast<shared_ptr<Interface>*>(object->getData())->get();
+   iface->setIncludeInIcmpPoll(argv[0]->getValueAsBoolean());
+   *result = vm->createValue();
+   return 0;
+}
+
+/**
+ * Get ICMP statistic for interface
+ */
+static NXSL_Value *GetInterfaceIcmpStatistic(const Interface *iface, IcmpStatFunction function, NXSL_VM *vm)
+{
+   NXSL_Value *value;
+   auto parentNode = iface->getParentNode();
+   if (parentNode != nullptr)
    {
-      shared_ptr<VlanList> vlans = node->getVlans();
-      if (vlans != nullptr)
+      TCHAR target[MAX_OBJECT_NAME + 5], buffer[MAX_RESULT_LENGTH];
+      _sntprintf(target, MAX_OBJECT_NAME + 4, _T("X(N:%s)"), iface->getName());
+      if (parentNode->getIcmpStatistic(target, function, buffer) == DCE_SUCCESS)
       {
-         NXSL_Array *a = new NXSL_Array(vm);
-         for(int i = 0; i < vlans->size(); i++)
-         {
-            a->append(vm->createValue(vm->createObject(&g_nxslVlanClass, new VlanInfo(vlans->get(i), node->getId()))));
-         }
-         value = vm->createValue(a);
+         value = vm->createValue(buffer);
       }
       else
       {
          value = vm->createValue();
       }
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("wirelessDomain"))
+   else
    {
-      shared_ptr<WirelessDomain> wirelessDomain = node->getWirelessDomain();
-      value = (wirelessDomain != nullptr) ? wirelessDomain->createNXSLObject(vm) : vm->createValue();
+      value = vm->createValue();
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("wirelessDomainId"))
+   return value;
+}
+
+/**
+ * Interface::adminState attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, adminState)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue((LONG)iface->getAdminState());
+}
+
+/**
+ * Interface::bridgePortNumber attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, bridgePortNumber)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue(iface->getBridgePortNumber());
+}
+
+/**
+ * Interface::chassis attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, chassis)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue(iface->getChassis());
+}
+
+/**
+ * Interface::description attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, description)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue(iface->getDescription());
+}
+
+/**
+ * Interface::dot1xBackendAuthState attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, dot1xBackendAuthState)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue((LONG)iface->getDot1xBackendAuthState());
+}
+
+/**
+ * Interface::dot1xPaeAuthState attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, dot1xPaeAuthState)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue((LONG)iface->getDot1xPaeAuthState());
+}
+
+/**
+ * Interface::expectedState attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, expectedState)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue((iface->getFlags() & IF_EXPECTED_STATE_MASK) >> 28);
+}
+
+/**
+ * Interface::flags attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, flags)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue(iface->getFlags());
+}
+
+/**
+ * Interface::icmpAverageRTT attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, icmpAverageRTT)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return GetInterfaceIcmpStatistic(iface, IcmpStatFunction::AVERAGE, vm);
+}
+
+/**
+ * Interface::icmpLastRTT attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, icmpLastRTT)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return GetInterfaceIcmpStatistic(iface, IcmpStatFunction::LAST, vm);
+}
+
+/**
+ * Interface::icmpMaxRTT attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, icmpMaxRTT)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return GetInterfaceIcmpStatistic(iface, IcmpStatFunction::MAX, vm);
+}
+
+/**
+ * Interface::icmpMinRTT attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, icmpMinRTT)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return GetInterfaceIcmpStatistic(iface, IcmpStatFunction::MIN, vm);
+}
+
+/**
+ * Interface::icmpPacketLoss attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, icmpPacketLoss)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return GetInterfaceIcmpStatistic(iface, IcmpStatFunction::LOSS, vm);
+}
+
+/**
+ * Interface::ifAlias attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, ifAlias)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue(iface->getIfAlias());
+}
+
+/**
+ * Interface::ifIndex attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, ifIndex)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue(iface->getIfIndex());
+}
+
+/**
+ * Interface::ifName attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, ifName)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue(iface->getIfName());
+}
+
+/**
+ * Interface::ifType attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, ifType)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue(iface->getIfType());
+}
+
+/**
+ * Interface::inboundUtilization attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, inboundUtilization)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue(iface->getInboundUtilization());
+}
+
+/**
+ * Interface::ipAddressList attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, ipAddressList)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   NXSL_Value *value = nullptr;
+   const InetAddressList *addrList = iface->getIpAddressList();
+   NXSL_Array *a = new NXSL_Array(vm);
+   for(int i = 0; i < addrList->size(); i++)
    {
-      shared_ptr<WirelessDomain> wirelessDomain = node->getWirelessDomain();
-      value = (wirelessDomain != nullptr) ? vm->createValue(wirelessDomain->getId()) : vm->createValue(static_cast<uint32_t>(0));
+      a->append(NXSL_InetAddressClass::createObject(vm, addrList->get(i)));
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("wirelessStations"))
+   value = vm->createValue(a);
+   return value;
+}
+
+/**
+ * Interface::isExcludedFromTopology attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, isExcludedFromTopology)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue(iface->isExcludedFromTopology());
+}
+
+/**
+ * Interface::isIncludedInIcmpPoll attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, isIncludedInIcmpPoll)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue(iface->isIncludedInIcmpPoll());
+}
+
+/**
+ * Interface::isLoopback attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, isLoopback)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue(iface->isLoopback());
+}
+
+/**
+ * Interface::isManuallyCreated attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, isManuallyCreated)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue(iface->isManuallyCreated());
+}
+
+/**
+ * Interface::isOSPF attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, isOSPF)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue(iface->isOSPF());
+}
+
+/**
+ * Interface::isPhysicalPort attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, isPhysicalPort)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue(iface->isPhysicalPort());
+}
+
+/**
+ * Interface::macAddress attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, macAddress)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   NXSL_Value *value = nullptr;
+   TCHAR buffer[256];
+   value = vm->createValue(iface->getMacAddress().toString(buffer));
+   return value;
+}
+
+/**
+ * Interface::module attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, module)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue(iface->getModule());
+}
+
+/**
+ * Interface::mtu attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, mtu)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue(iface->getMTU());
+}
+
+/**
+ * Interface::node attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, node)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   NXSL_Value *value = nullptr;
+   shared_ptr<Node> parentNode = iface->getParentNode();
+   if (parentNode != nullptr)
    {
-      if (node->getCapabilities() & (NC_IS_WIFI_AP | NC_IS_WIFI_CONTROLLER))
-      {
-         value = node->getWirelessStationsForNXSL(vm);
-      }
-      else
-      {
-         value = vm->createValue();
-      }
+      value = parentNode->createNXSLObject(vm);
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("zone"))
-	{
-      if (IsZoningEnabled())
-      {
-         shared_ptr<Zone> zone = FindZoneByUIN(node->getZoneUIN());
-		   if (zone != nullptr)
-		   {
-			   value = zone->createNXSLObject(vm);
-		   }
-		   else
-		   {
-			   value = vm->createValue();
-		   }
-	   }
-	   else
-	   {
-		   value = vm->createValue();
-	   }
-	}
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("zoneProxyAssignments"))
+   else
+   {
+      value = vm->createValue();
+   }
+   return value;
+}
+
+/**
+ * Interface::operState attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, operState)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue((LONG)iface->getOperState());
+}
+
+/**
+ * Interface::ospfAreaId attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, ospfAreaId)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   NXSL_Value *value = nullptr;
+   TCHAR buffer[16];
+   value = vm->createValue(IpToStr(iface->getOSPFArea(), buffer));
+   return value;
+}
+
+/**
+ * Interface::ospfState attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, ospfState)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue(static_cast<int32_t>(iface->getOSPFState()));
+}
+
+/**
+ * Interface::ospfStateText attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, ospfStateText)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue(OSPFInterfaceStateToText(iface->getOSPFState()));
+}
+
+/**
+ * Interface::ospfType attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, ospfType)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue(static_cast<int32_t>(iface->getOSPFType()));
+}
+
+/**
+ * Interface::ospfTypeText attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, ospfTypeText)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue(OSPFInterfaceTypeToText(iface->getOSPFType()));
+}
+
+/**
+ * Interface::outboundUtilization attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, outboundUtilization)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue(iface->getOutboundUtilization());
+}
+
+/**
+ * Interface::peerInterface attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, peerInterface)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   NXSL_Value *value = nullptr;
+   shared_ptr<NetObj> peerIface = FindObjectById(iface->getPeerInterfaceId(), OBJECT_INTERFACE);
+   if (peerIface != nullptr)
    {
-      if (IsZoningEnabled())
+      if (g_flags & AF_CHECK_TRUSTED_OBJECTS)
       {
-         shared_ptr<Zone> zone = FindZoneByProxyId(node->getId());
-         if (zone != nullptr)
+         shared_ptr<Node> parentNode = iface->getParentNode();
+         shared_ptr<Node> peerNode = static_cast<Interface*>(peerIface.get())->getParentNode();
+         if ((parentNode != nullptr) && (peerNode != nullptr))
          {
-            value = vm->createValue(zone->getProxyNodeAssignments(node->getId()));
+            if (peerNode->isTrustedObject(parentNode->getId()))
+            {
+               value = peerIface->createNXSLObject(vm);
+            }
+            else
+            {
+               // No access, return null
+               value = vm->createValue();
+               nxlog_debug_tag(_T("nxsl.objects"), 4, _T("NXSL::Interface::peerInterface(%s [%u]): access denied for node %s [%u]"),
+                         iface->getName(), iface->getId(), peerNode->getName(), peerNode->getId());
+            }
          }
          else
          {
-            value = vm->createValue(0);
+            value = vm->createValue();
+            nxlog_debug_tag(_T("nxsl.objects"), 4, _T("NXSL::Interface::peerInterface(%s [%u]): parentNode=% [%u] peerNode=%s [%u]"),
+                  iface->getName(), iface->getId(), parentNode->getName(), parentNode->getId(), peerNode->getName(), peerNode->getId());
          }
       }
       else
       {
-         value = vm->createValue(0);
+         value = peerIface->createNXSLObject(vm);
       }
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("zoneProxyStatus"))
+   else
+   {
+      value = vm->createValue();
+   }
+   return value;
+}
+
+/**
+ * Interface::peerNode attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, peerNode)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   NXSL_Value *value = nullptr;
+   shared_ptr<NetObj> peerNode = FindObjectById(iface->getPeerNodeId());
+   if (peerNode != nullptr)
    {
-      if (IsZoningEnabled())
+      if (g_flags & AF_CHECK_TRUSTED_OBJECTS)
       {
-         shared_ptr<Zone> zone = FindZoneByProxyId(node->getId());
-         if (zone != nullptr)
+         shared_ptr<Node> parentNode = iface->getParentNode();
+         if ((parentNode != nullptr) && (peerNode->isTrustedObject(parentNode->getId())))
          {
-            value = vm->createValue(zone->isProxyNodeAvailable(node->getId()));
+            value = peerNode->createNXSLObject(vm);
          }
          else
          {
-            value = vm->createValue(0);
+            // No access, return null
+            value = vm->createValue();
+            nxlog_debug_tag(_T("nxsl.objects"), 4, _T("NXSL::Interface::peerNode(%s [%d]): access denied for node %s [%d]"),
+                      iface->getName(), iface->getId(), peerNode->getName(), peerNode->getId());
          }
       }
       else
       {
-         value = vm->createValue(0);
+         value = peerNode->createNXSLObject(vm);
       }
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("zoneUIN"))
-	{
-      value = vm->createValue(node->getZoneUIN());
+   else
+   {
+      value = vm->createValue();
    }
    return value;
 }
 
 /**
- * Interface::enableAgentStatusPolling(enabled) method
- */
-NXSL_METHOD_DEFINITION(Interface, enableAgentStatusPolling)
-{
-   return ChangeFlagMethod(object, argv[0], result, IF_DISABLE_AGENT_STATUS_POLL, true);
-}
-
-/**
- * Interface::enableICMPStatusPolling(enabled) method
+ * Interface::pic attribute
  */
-NXSL_METHOD_DEFINITION(Interface, enableICMPStatusPolling)
+NXSL_ATTRIBUTE_DEFINITION(Interface, pic)
 {
-   return ChangeFlagMethod(object, argv[0], result, IF_DISABLE_ICMP_STATUS_POLL, true);
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue(iface->getPIC());
 }
 
 /**
- * Interface::enableSNMPStatusPolling(enabled) method
+ * Interface::port attribute
  */
-NXSL_METHOD_DEFINITION(Interface, enableSNMPStatusPolling)
+NXSL_ATTRIBUTE_DEFINITION(Interface, port)
 {
-   return ChangeFlagMethod(object, argv[0], result, IF_DISABLE_SNMP_STATUS_POLL, true);
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue(iface->getPort());
 }
 
 /**
- * Interface::setExcludeFromTopology(enabled) method
+ * Interface::speed attribute
  */
-NXSL_METHOD_DEFINITION(Interface, setExcludeFromTopology)
+NXSL_ATTRIBUTE_DEFINITION(Interface, speed)
 {
-   Interface *iface = static_cast<shared_ptr<Interface>*>(object->getData())->get();
-   iface->setExcludeFromTopology(argv[0]->getValueAsBoolean());
-   *result = vm->createValue();
-   return 0;
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue(iface->getSpeed());
 }
 
 /**
- * Interface::setExpectedState(state) method
+ * Interface::stpState attribute
  */
-NXSL_METHOD_DEFINITION(Interface, setExpectedState)
+NXSL_ATTRIBUTE_DEFINITION(Interface, stpState)
 {
-   int state;
-   if (argv[0]->isInteger())
-   {
-      state = argv[0]->getValueAsInt32();
-   }
-   else if (argv[0]->isString())
-   {
-      static const TCHAR *stateNames[] = { _T("UP"), _T("DOWN"), _T("IGNORE"), nullptr };
-      const TCHAR *name = argv[0]->getValueAsCString();
-      for(state = 0; stateNames[state] != nullptr; state++)
-         if (!_tcsicmp(stateNames[state], name))
-            break;
-   }
-   else
-   {
-      return NXSL_ERR_NOT_STRING;
-   }
-
-   if ((state >= 0) && (state <= 2))
-      static_cast<shared_ptr<Interface>*>(object->getData())->get()->setExpectedState(state);
-
-   *result = vm->createValue();
-   return 0;
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue(static_cast<int32_t>(iface->getSTPPortState()));
 }
 
 /**
- * Interface::setIncludeInIcmpPoll(enabled) method
+ * Interface::stpStateText attribute
  */
-NXSL_METHOD_DEFINITION(Interface, setIncludeInIcmpPoll)
+NXSL_ATTRIBUTE_DEFINITION(Interface, stpStateText)
 {
-   Interface *iface = static_cast<shared_ptr<Interface>*>(object->getData())->get();
-   iface->setIncludeInIcmpPoll(argv[0]->getValueAsBoolean());
-   *result = vm->createValue();
-   return 0;
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue(STPPortStateToText(iface->getSTPPortState()));
 }
 
 /**
- * NXSL class Interface: constructor
+ * Interface::vlans attribute
  */
-NXSL_InterfaceClass::NXSL_InterfaceClass() : NXSL_NetObjClass()
+NXSL_ATTRIBUTE_DEFINITION(Interface, vlans)
 {
-   setName(_T("Interface"));
-
-   NXSL_REGISTER_METHOD(Interface, enableAgentStatusPolling, 1);
-   NXSL_REGISTER_METHOD(Interface, enableICMPStatusPolling, 1);
-   NXSL_REGISTER_METHOD(Interface, enableSNMPStatusPolling, 1);
-   NXSL_REGISTER_METHOD(Interface, setExcludeFromTopology, 1);
-   NXSL_REGISTER_METHOD(Interface, setExpectedState, 1);
-   NXSL_REGISTER_METHOD(Interface, setIncludeInIcmpPoll, 1);
+   auto iface = SharedObjectFromData<Interface>(object);
+   return iface->getVlanListForNXSL(vm);
 }
 
 /**
- * Get ICMP statistic for interface
+ * Interface::zone attribute
  */
-static NXSL_Value *GetInterfaceIcmpStatistic(const Interface *iface, IcmpStatFunction function, NXSL_VM *vm)
+NXSL_ATTRIBUTE_DEFINITION(Interface, zone)
 {
-   NXSL_Value *value;
-   auto parentNode = iface->getParentNode();
-   if (parentNode != nullptr)
+   auto iface = SharedObjectFromData<Interface>(object);
+   NXSL_Value *value = nullptr;
+   if (g_flags & AF_ENABLE_ZONING)
    {
-      TCHAR target[MAX_OBJECT_NAME + 5], buffer[MAX_RESULT_LENGTH];
-      _sntprintf(target, MAX_OBJECT_NAME + 4, _T("X(N:%s)"), iface->getName());
-      if (parentNode->getIcmpStatistic(target, function, buffer) == DCE_SUCCESS)
+      shared_ptr<Zone> zone = FindZoneByUIN(iface->getZoneUIN());
+      if (zone != nullptr)
       {
-         value = vm->createValue(buffer);
+         value = zone->createNXSLObject(vm);
       }
       else
       {
          value = vm->createValue();
       }
    }
-   else
-   {
-      value = vm->createValue();
-   }
-   return value;
-}
-
-/**
- * NXSL class Interface: get attribute
- */
-NXSL_Value *NXSL_InterfaceClass::getAttr(NXSL_Object *object, const NXSL_Identifier& attr)
-{
-   NXSL_Value *value = NXSL_NetObjClass::getAttr(object, attr);
-   if (value != nullptr)
-      return value;
-
-   NXSL_VM *vm = object->vm();
-   auto iface = SharedObjectFromData<Interface>(object);
-   if (NXSL_COMPARE_ATTRIBUTE_NAME("adminState"))
-   {
-		value = vm->createValue((LONG)iface->getAdminState());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("bridgePortNumber"))
-   {
-		value = vm->createValue(iface->getBridgePortNumber());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("chassis"))
-   {
-      value = vm->createValue(iface->getChassis());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("description"))
-   {
-      value = vm->createValue(iface->getDescription());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("dot1xBackendAuthState"))
-   {
-		value = vm->createValue((LONG)iface->getDot1xBackendAuthState());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("dot1xPaeAuthState"))
-   {
-		value = vm->createValue((LONG)iface->getDot1xPaeAuthState());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("expectedState"))
-   {
-		value = vm->createValue((iface->getFlags() & IF_EXPECTED_STATE_MASK) >> 28);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("flags"))
-   {
-		value = vm->createValue(iface->getFlags());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("icmpAverageRTT"))
-   {
-      value = GetInterfaceIcmpStatistic(iface, IcmpStatFunction::AVERAGE, vm);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("icmpLastRTT"))
-   {
-      value = GetInterfaceIcmpStatistic(iface, IcmpStatFunction::LAST, vm);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("icmpMaxRTT"))
-   {
-      value = GetInterfaceIcmpStatistic(iface, IcmpStatFunction::MAX, vm);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("icmpMinRTT"))
-   {
-      value = GetInterfaceIcmpStatistic(iface, IcmpStatFunction::MIN, vm);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("icmpPacketLoss"))
-   {
-      value = GetInterfaceIcmpStatistic(iface, IcmpStatFunction::LOSS, vm);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("ifAlias"))
-   {
-      value = vm->createValue(iface->getIfAlias());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("ifIndex"))
-   {
-		value = vm->createValue(iface->getIfIndex());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("ifName"))
-   {
-      value = vm->createValue(iface->getIfName());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("ifType"))
-   {
-		value = vm->createValue(iface->getIfType());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("inboundUtilization"))
-   {
-      value = vm->createValue(iface->getInboundUtilization());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("ipAddressList"))
-   {
-      const InetAddressList *addrList = iface->getIpAddressList();
-      NXSL_Array *a = new NXSL_Array(vm);
-      for(int i = 0; i < addrList->size(); i++)
-      {
-         a->append(NXSL_InetAddressClass::createObject(vm, addrList->get(i)));
-      }
-      value = vm->createValue(a);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isExcludedFromTopology"))
-   {
-      value = vm->createValue(iface->isExcludedFromTopology());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isIncludedInIcmpPoll"))
-   {
-      value = vm->createValue(iface->isIncludedInIcmpPoll());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isLoopback"))
-   {
-		value = vm->createValue(iface->isLoopback());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isManuallyCreated"))
-   {
-		value = vm->createValue(iface->isManuallyCreated());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isOSPF"))
-   {
-      value = vm->createValue(iface->isOSPF());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isPhysicalPort"))
-   {
-		value = vm->createValue(iface->isPhysicalPort());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("macAddress") || NXSL_COMPARE_ATTRIBUTE_NAME("macAddr"))
-   {
-		TCHAR buffer[256];
-		value = vm->createValue(iface->getMacAddress().toString(buffer));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("module"))
-   {
-      value = vm->createValue(iface->getModule());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("mtu"))
-   {
-      value = vm->createValue(iface->getMTU());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("node"))
-	{
-      shared_ptr<Node> parentNode = iface->getParentNode();
-		if (parentNode != nullptr)
-		{
-         value = parentNode->createNXSLObject(vm);
-		}
-		else
-		{
-			value = vm->createValue();
-		}
-	}
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("operState"))
-   {
-		value = vm->createValue((LONG)iface->getOperState());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("ospfAreaId"))
-   {
-      TCHAR buffer[16];
-      value = vm->createValue(IpToStr(iface->getOSPFArea(), buffer));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("ospfState"))
-   {
-      value = vm->createValue(static_cast<int32_t>(iface->getOSPFState()));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("ospfStateText"))
-   {
-      value = vm->createValue(OSPFInterfaceStateToText(iface->getOSPFState()));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("ospfType"))
-   {
-      value = vm->createValue(static_cast<int32_t>(iface->getOSPFType()));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("ospfTypeText"))
-   {
-      value = vm->createValue(OSPFInterfaceTypeToText(iface->getOSPFType()));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("outboundUtilization"))
-   {
-      value = vm->createValue(iface->getOutboundUtilization());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("peerInterface"))
-   {
-      shared_ptr<NetObj> peerIface = FindObjectById(iface->getPeerInterfaceId(), OBJECT_INTERFACE);
-		if (peerIface != nullptr)
-		{
-			if (g_flags & AF_CHECK_TRUSTED_OBJECTS)
-			{
-			   shared_ptr<Node> parentNode = iface->getParentNode();
-				shared_ptr<Node> peerNode = static_cast<Interface*>(peerIface.get())->getParentNode();
-				if ((parentNode != nullptr) && (peerNode != nullptr))
-				{
-					if (peerNode->isTrustedObject(parentNode->getId()))
-					{
-						value = peerIface->createNXSLObject(vm);
-					}
-					else
-					{
-						// No access, return null
-						value = vm->createValue();
-						nxlog_debug_tag(_T("nxsl.objects"), 4, _T("NXSL::Interface::peerInterface(%s [%u]): access denied for node %s [%u]"),
-									 iface->getName(), iface->getId(), peerNode->getName(), peerNode->getId());
-					}
-				}
-				else
-				{
-					value = vm->createValue();
-					nxlog_debug_tag(_T("nxsl.objects"), 4, _T("NXSL::Interface::peerInterface(%s [%u]): parentNode=% [%u] peerNode=%s [%u]"),
-                     iface->getName(), iface->getId(), parentNode->getName(), parentNode->getId(), peerNode->getName(), peerNode->getId());
-				}
-			}
-			else
-			{
-				value = peerIface->createNXSLObject(vm);
-			}
-		}
-		else
-		{
-			value = vm->createValue();
-		}
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("peerNode"))
-   {
-      shared_ptr<NetObj> peerNode = FindObjectById(iface->getPeerNodeId());
-		if (peerNode != nullptr)
-		{
-			if (g_flags & AF_CHECK_TRUSTED_OBJECTS)
-			{
-			   shared_ptr<Node> parentNode = iface->getParentNode();
-				if ((parentNode != nullptr) && (peerNode->isTrustedObject(parentNode->getId())))
-				{
-					value = peerNode->createNXSLObject(vm);
-				}
-				else
-				{
-					// No access, return null
-					value = vm->createValue();
-					nxlog_debug_tag(_T("nxsl.objects"), 4, _T("NXSL::Interface::peerNode(%s [%d]): access denied for node %s [%d]"),
-					          iface->getName(), iface->getId(), peerNode->getName(), peerNode->getId());
-				}
-			}
-			else
-			{
-				value = peerNode->createNXSLObject(vm);
-			}
-		}
-		else
-		{
-			value = vm->createValue();
-		}
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("pic"))
-   {
-      value = vm->createValue(iface->getPIC());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("port"))
-   {
-      value = vm->createValue(iface->getPort());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("speed"))
-   {
-      value = vm->createValue(iface->getSpeed());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("stpState"))
-   {
-      value = vm->createValue(static_cast<int32_t>(iface->getSTPPortState()));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("stpStateText"))
-   {
-      value = vm->createValue(STPPortStateToText(iface->getSTPPortState()));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("vlans"))
-   {
-      value = iface->getVlanListForNXSL(vm);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("zone"))
-	{
-      if (g_flags & AF_ENABLE_ZONING)
-      {
-         shared_ptr<Zone> zone = FindZoneByUIN(iface->getZoneUIN());
-		   if (zone != nullptr)
-		   {
-			   value = zone->createNXSLObject(vm);
-		   }
-		   else
-		   {
-			   value = vm->createValue();
-		   }
-	   }
-	   else
-	   {
-		   value = vm->createValue();
-	   }
-	}
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("zoneUIN"))
-	{
-      value = vm->createValue(iface->getZoneUIN());
+   else
+   {
+      value = vm->createValue();
    }
    return value;
 }
 
+/**
+ * Interface::zoneUIN attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, zoneUIN)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue(iface->getZoneUIN());
+}
+
+/**
+ * NXSL class Interface: constructor
+ */
+NXSL_InterfaceClass::NXSL_InterfaceClass() : NXSL_NetObjClass()
+{
+   setName(_T("Interface"));
+
+   NXSL_REGISTER_METHOD(Interface, enableAgentStatusPolling, 1);
+   NXSL_REGISTER_METHOD(Interface, enableICMPStatusPolling, 1);
+   NXSL_REGISTER_METHOD(Interface, enableSNMPStatusPolling, 1);
+   NXSL_REGISTER_METHOD(Interface, setExcludeFromTopology, 1);
+   NXSL_REGISTER_METHOD(Interface, setExpectedState, 1);
+   NXSL_REGISTER_METHOD(Interface, setIncludeInIcmpPoll, 1);
+
+   NXSL_REGISTER_ATTRIBUTE(Interface, adminState);
+   NXSL_REGISTER_ATTRIBUTE(Interface, bridgePortNumber);
+   NXSL_REGISTER_ATTRIBUTE(Interface, chassis);
+   NXSL_REGISTER_ATTRIBUTE(Interface, description);
+   NXSL_REGISTER_ATTRIBUTE(Interface, dot1xBackendAuthState);
+   NXSL_REGISTER_ATTRIBUTE(Interface, dot1xPaeAuthState);
+   NXSL_REGISTER_ATTRIBUTE(Interface, expectedState);
+   NXSL_REGISTER_ATTRIBUTE(Interface, flags);
+   NXSL_REGISTER_ATTRIBUTE(Interface, icmpAverageRTT);
+   NXSL_REGISTER_ATTRIBUTE(Interface, icmpLastRTT);
+   NXSL_REGISTER_ATTRIBUTE(Interface, icmpMaxRTT);
+   NXSL_REGISTER_ATTRIBUTE(Interface, icmpMinRTT);
+   NXSL_REGISTER_ATTRIBUTE(Interface, icmpPacketLoss);
+   NXSL_REGISTER_ATTRIBUTE(Interface, ifAlias);
+   NXSL_REGISTER_ATTRIBUTE(Interface, ifIndex);
+   NXSL_REGISTER_ATTRIBUTE(Interface, ifName);
+   NXSL_REGISTER_ATTRIBUTE(Interface, ifType);
+   NXSL_REGISTER_ATTRIBUTE(Interface, inboundUtilization);
+   NXSL_REGISTER_ATTRIBUTE(Interface, ipAddressList);
+   NXSL_REGISTER_ATTRIBUTE(Interface, isExcludedFromTopology);
+   NXSL_REGISTER_ATTRIBUTE(Interface, isIncludedInIcmpPoll);
+   NXSL_REGISTER_ATTRIBUTE(Interface, isLoopback);
+   NXSL_REGISTER_ATTRIBUTE(Interface, isManuallyCreated);
+   NXSL_REGISTER_ATTRIBUTE(Interface, isOSPF);
+   NXSL_REGISTER_ATTRIBUTE(Interface, isPhysicalPort);
+   NXSL_REGISTER_ATTRIBUTE(Interface, macAddress);
+   NXSL_REGISTER_ATTRIBUTE_ALIAS(Interface, macAddr, macAddress);
+   NXSL_REGISTER_ATTRIBUTE(Interface, module);
+   NXSL_REGISTER_ATTRIBUTE(Interface, mtu);
+   NXSL_REGISTER_ATTRIBUTE(Interface, node);
+   NXSL_REGISTER_ATTRIBUTE(Interface, operState);
+   NXSL_REGISTER_ATTRIBUTE(Interface, ospfAreaId);
+   NXSL_REGISTER_ATTRIBUTE(Interface, ospfState);
+   NXSL_REGISTER_ATTRIBUTE(Interface, ospfStateText);
+   NXSL_REGISTER_ATTRIBUTE(Interface, ospfType);
+   NXSL_REGISTER_ATTRIBUTE(Interface, ospfTypeText);
+   NXSL_REGISTER_ATTRIBUTE(Interface, outboundUtilization);
+   NXSL_REGISTER_ATTRIBUTE(Interface, peerInterface);
+   NXSL_REGISTER_ATTRIBUTE(Interface, peerNode);
+   NXSL_REGISTER_ATTRIBUTE(Interface, pic);
+   NXSL_REGISTER_ATTRIBUTE(Interface, port);
+   NXSL_REGISTER_ATTRIBUTE(Interface, speed);
+   NXSL_REGISTER_ATTRIBUTE(Interface, stpState);
+   NXSL_REGISTER_ATTRIBUTE(Interface, stpStateText);
+   NXSL_REGISTER_ATTRIBUTE(Interface, vlans);
+   NXSL_REGISTER_ATTRIBUTE(Interface, zone);
+   NXSL_REGISTER_ATTRIBUTE(Interface, zoneUIN);
+}
+
 /**
  * NXSL class AccessPoint: constructor
  */
@@ -5132,6 +6333,7 @@ NXSL_METHOD_DEFINITION(DCI, forcePoll)
       if (dcObject != nullptr)
       {
          dcObject->requestForcePoll(nullptr);
+         ScheduleDataCollection(dcObject, time(nullptr));
       }
    }
    *result = vm->createValue();
@@ -5139,153 +6341,304 @@ NXSL_METHOD_DEFINITION(DCI, forcePoll)
 }
 
 /**
- * Implementation of "DCI" class: constructor
+ * Object destructor
  */
-NXSL_DciClass::NXSL_DciClass() : NXSL_Class()
+void NXSL_DciClass::onObjectDelete(NXSL_Object *object)
 {
-   setName(_T("DCI"));
-
-   NXSL_REGISTER_METHOD(DCI, forcePoll, 0);
+   delete static_cast<shared_ptr<DCObjectInfo>*>(object->getData());
 }
 
 /**
- * Object destructor
+ * DCI::activeThresholdSeverity attribute
  */
-void NXSL_DciClass::onObjectDelete(NXSL_Object *object)
+NXSL_ATTRIBUTE_DEFINITION(DCI, activeThresholdSeverity)
 {
-   delete static_cast<shared_ptr<DCObjectInfo>*>(object->getData());
+   const DCObjectInfo *dci = SharedObjectFromData<DCObjectInfo>(object);
+   return vm->createValue(dci->getThresholdSeverity());
 }
 
 /**
- * Implementation of "DCI" class: get attribute
+ * DCI::comments attribute
  */
-NXSL_Value *NXSL_DciClass::getAttr(NXSL_Object *object, const NXSL_Identifier& attr)
+NXSL_ATTRIBUTE_DEFINITION(DCI, comments)
 {
-   NXSL_Value *value = NXSL_Class::getAttr(object, attr);
-   if (value != nullptr)
-      return value;
+   const DCObjectInfo *dci = SharedObjectFromData<DCObjectInfo>(object);
+   return vm->createValue(dci->getComments());
+}
 
-   NXSL_VM *vm = object->vm();
+/**
+ * DCI::dataType attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(DCI, dataType)
+{
    const DCObjectInfo *dci = SharedObjectFromData<DCObjectInfo>(object);
-   if (NXSL_COMPARE_ATTRIBUTE_NAME("activeThresholdSeverity"))
-   {
-      value = vm->createValue(dci->getThresholdSeverity());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("comments"))
-   {
-		value = vm->createValue(dci->getComments());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("dataType") && (dci->getType() == DCO_TYPE_ITEM))
-   {
-		value = vm->createValue(dci->getDataType());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("description"))
-   {
-		value = vm->createValue(dci->getDescription());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("errorCount"))
-   {
-		value = vm->createValue(dci->getErrorCount());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("flags"))
-   {
-      value = vm->createValue(dci->getFlags());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("hasActiveThreshold"))
-   {
-      value = vm->createValue(dci->hasActiveThreshold());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("id"))
-   {
-		value = vm->createValue(dci->getId());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("instance"))
-   {
-      value = vm->createValue(dci->getInstanceData());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("instanceName"))
-   {
-		value = vm->createValue(dci->getInstanceName());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("lastCollectionTime"))
-   {
-      value = vm->createValue(static_cast<int64_t>(dci->getLastCollectionTime()));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("lastPollTime"))
-   {
-		value = vm->createValue(static_cast<int64_t>(dci->getLastPollTime()));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("name"))
-   {
-		value = vm->createValue(dci->getName());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("origin"))
-   {
-		value = vm->createValue(dci->getOrigin());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("pollingInterval"))
-   {
-      value = vm->createValue(dci->getPollingInterval());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("pollingSchedules"))
-   {
-      value = vm->createValue(new NXSL_Array(vm, dci->getPollingSchedules()));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("pollingScheduleType"))
-   {
-      value = vm->createValue(dci->getPollingScheduleType());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("relatedObject"))
-   {
-      if (dci->getRelatedObject() != 0)
-      {
-         shared_ptr<NetObj> object = FindObjectById(dci->getRelatedObject());
-         value = (object != nullptr) ? object->createNXSLObject(vm) : vm->createValue();
-      }
-      else
-      {
-         value = vm->createValue();
-      }
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("status"))
+   NXSL_Value *value = nullptr;
+   if (dci->getType() == DCO_TYPE_ITEM)
    {
-		value = vm->createValue((LONG)dci->getStatus());
+      value = vm->createValue(dci->getDataType());
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("systemTag"))
+   return value;
+}
+
+/**
+ * DCI::description attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(DCI, description)
+{
+   const DCObjectInfo *dci = SharedObjectFromData<DCObjectInfo>(object);
+   return vm->createValue(dci->getDescription());
+}
+
+/**
+ * DCI::errorCount attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(DCI, errorCount)
+{
+   const DCObjectInfo *dci = SharedObjectFromData<DCObjectInfo>(object);
+   return vm->createValue(dci->getErrorCount());
+}
+
+/**
+ * DCI::flags attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(DCI, flags)
+{
+   const DCObjectInfo *dci = SharedObjectFromData<DCObjectInfo>(object);
+   return vm->createValue(dci->getFlags());
+}
+
+/**
+ * DCI::hasActiveThreshold attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(DCI, hasActiveThreshold)
+{
+   const DCObjectInfo *dci = SharedObjectFromData<DCObjectInfo>(object);
+   return vm->createValue(dci->hasActiveThreshold());
+}
+
+/**
+ * DCI::id attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(DCI, id)
+{
+   const DCObjectInfo *dci = SharedObjectFromData<DCObjectInfo>(object);
+   return vm->createValue(dci->getId());
+}
+
+/**
+ * DCI::instance attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(DCI, instance)
+{
+   const DCObjectInfo *dci = SharedObjectFromData<DCObjectInfo>(object);
+   return vm->createValue(dci->getInstanceData());
+}
+
+/**
+ * DCI::instanceName attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(DCI, instanceName)
+{
+   const DCObjectInfo *dci = SharedObjectFromData<DCObjectInfo>(object);
+   return vm->createValue(dci->getInstanceName());
+}
+
+/**
+ * DCI::lastCollectionTime attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(DCI, lastCollectionTime)
+{
+   const DCObjectInfo *dci = SharedObjectFromData<DCObjectInfo>(object);
+   return vm->createValue(static_cast<int64_t>(dci->getLastCollectionTime()));
+}
+
+/**
+ * DCI::lastPollTime attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(DCI, lastPollTime)
+{
+   const DCObjectInfo *dci = SharedObjectFromData<DCObjectInfo>(object);
+   return vm->createValue(static_cast<int64_t>(dci->getLastPollTime()));
+}
+
+/**
+ * DCI::name attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(DCI, name)
+{
+   const DCObjectInfo *dci = SharedObjectFromData<DCObjectInfo>(object);
+   return vm->createValue(dci->getName());
+}
+
+/**
+ * DCI::origin attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(DCI, origin)
+{
+   const DCObjectInfo *dci = SharedObjectFromData<DCObjectInfo>(object);
+   return vm->createValue(dci->getOrigin());
+}
+
+/**
+ * DCI::pollingInterval attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(DCI, pollingInterval)
+{
+   const DCObjectInfo *dci = SharedObjectFromData<DCObjectInfo>(object);
+   return vm->createValue(dci->getPollingInterval());
+}
+
+/**
+ * DCI::pollingSchedules attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(DCI, pollingSchedules)
+{
+   const DCObjectInfo *dci = SharedObjectFromData<DCObjectInfo>(object);
+   return vm->createValue(new NXSL_Array(vm, dci->getPollingSchedules()));
+}
+
+/**
+ * DCI::pollingScheduleType attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(DCI, pollingScheduleType)
+{
+   const DCObjectInfo *dci = SharedObjectFromData<DCObjectInfo>(object);
+   return vm->createValue(dci->getPollingScheduleType());
+}
+
+/**
+ * DCI::relatedObject attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(DCI, relatedObject)
+{
+   const DCObjectInfo *dci = SharedObjectFromData<DCObjectInfo>(object);
+   NXSL_Value *value = nullptr;
+   if (dci->getRelatedObject() != 0)
    {
-		value = vm->createValue(dci->getSystemTag());
+      shared_ptr<NetObj> relatedObject = FindObjectById(dci->getRelatedObject());
+      value = (relatedObject != nullptr) ? relatedObject->createNXSLObject(vm) : vm->createValue();
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("template"))
+   else
    {
-      if (dci->getTemplateId() != 0)
-      {
-         shared_ptr<NetObj> object = FindObjectById(dci->getTemplateId());
-         value = (object != nullptr) ? object->createNXSLObject(vm) : vm->createValue();
-      }
-      else
-      {
-         value = vm->createValue();
-      }
+      value = vm->createValue();
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("templateId"))
+   return value;
+}
+
+/**
+ * DCI::status attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(DCI, status)
+{
+   const DCObjectInfo *dci = SharedObjectFromData<DCObjectInfo>(object);
+   return vm->createValue((LONG)dci->getStatus());
+}
+
+/**
+ * DCI::systemTag attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(DCI, systemTag)
+{
+   const DCObjectInfo *dci = SharedObjectFromData<DCObjectInfo>(object);
+   return vm->createValue(dci->getSystemTag());
+}
+
+/**
+ * DCI::template attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(DCI, template)
+{
+   const DCObjectInfo *dci = SharedObjectFromData<DCObjectInfo>(object);
+   NXSL_Value *value = nullptr;
+   if (dci->getTemplateId() != 0)
    {
-      value = vm->createValue(dci->getTemplateId());
+      shared_ptr<NetObj> templateObject = FindObjectById(dci->getTemplateId());
+      value = (templateObject != nullptr) ? templateObject->createNXSLObject(vm) : vm->createValue();
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("templateItemId"))
+   else
    {
-      value = vm->createValue(dci->getTemplateItemId());
+      value = vm->createValue();
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("transformedDataType") && (dci->getType() == DCO_TYPE_ITEM))
+   return value;
+}
+
+/**
+ * DCI::templateId attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(DCI, templateId)
+{
+   const DCObjectInfo *dci = SharedObjectFromData<DCObjectInfo>(object);
+   return vm->createValue(dci->getTemplateId());
+}
+
+/**
+ * DCI::templateItemId attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(DCI, templateItemId)
+{
+   const DCObjectInfo *dci = SharedObjectFromData<DCObjectInfo>(object);
+   return vm->createValue(dci->getTemplateItemId());
+}
+
+/**
+ * DCI::transformedDataType attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(DCI, transformedDataType)
+{
+   const DCObjectInfo *dci = SharedObjectFromData<DCObjectInfo>(object);
+   NXSL_Value *value = nullptr;
+   if (dci->getType() == DCO_TYPE_ITEM)
    {
       value = vm->createValue(dci->getTransformedDataType());
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("type"))
-   {
-		value = vm->createValue((LONG)dci->getType());
-   }
    return value;
 }
 
+/**
+ * DCI::type attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(DCI, type)
+{
+   const DCObjectInfo *dci = SharedObjectFromData<DCObjectInfo>(object);
+   return vm->createValue((LONG)dci->getType());
+}
+
+/**
+ * Implementation of "DCI" class: constructor
+ */
+NXSL_DciClass::NXSL_DciClass() : NXSL_Class()
+{
+   setName(_T("DCI"));
+
+   NXSL_REGISTER_METHOD(DCI, forcePoll, 0);
+
+   NXSL_REGISTER_ATTRIBUTE(DCI, activeThresholdSeverity);
+   NXSL_REGISTER_ATTRIBUTE(DCI, comments);
+   NXSL_REGISTER_ATTRIBUTE(DCI, dataType);
+   NXSL_REGISTER_ATTRIBUTE(DCI, description);
+   NXSL_REGISTER_ATTRIBUTE(DCI, errorCount);
+   NXSL_REGISTER_ATTRIBUTE(DCI, flags);
+   NXSL_REGISTER_ATTRIBUTE(DCI, hasActiveThreshold);
+   NXSL_REGISTER_ATTRIBUTE(DCI, id);
+   NXSL_REGISTER_ATTRIBUTE(DCI, instance);
+   NXSL_REGISTER_ATTRIBUTE(DCI, instanceName);
+   NXSL_REGISTER_ATTRIBUTE(DCI, lastCollectionTime);
+   NXSL_REGISTER_ATTRIBUTE(DCI, lastPollTime);
+   NXSL_REGISTER_ATTRIBUTE(DCI, name);
+   NXSL_REGISTER_ATTRIBUTE(DCI, origin);
+   NXSL_REGISTER_ATTRIBUTE(DCI, pollingInterval);
+   NXSL_REGISTER_ATTRIBUTE(DCI, pollingSchedules);
+   NXSL_REGISTER_ATTRIBUTE(DCI, pollingScheduleType);
+   NXSL_REGISTER_ATTRIBUTE(DCI, relatedObject);
+   NXSL_REGISTER_ATTRIBUTE(DCI, status);
+   NXSL_REGISTER_ATTRIBUTE(DCI, systemTag);
+   NXSL_REGISTER_ATTRIBUTE(DCI, template);
+   NXSL_REGISTER_ATTRIBUTE(DCI, templateId);
+   NXSL_REGISTER_ATTRIBUTE(DCI, templateItemId);
+   NXSL_REGISTER_ATTRIBUTE(DCI, transformedDataType);
+   NXSL_REGISTER_ATTRIBUTE(DCI, type);
+}
+
 /**
  * Implementation of "ScoredDciValue" class: constructor
  */
@@ -242,8 +242,8 @@ static void QueueForPolling(NetObj *object, void *data)
    if (pollableObject == nullptr)
       return;
 
-   TCHAR threadKey[32];
-   _sntprintf(threadKey, 32, _T("POLL_%u"), object->getId());
+   // All polls for same object are serialized
+   uint64_t threadKey = object->getId();
 
    if (pollableObject->isStatusPollAvailable() && pollableObject->lockForStatusPoll())
    {
@@ -43,7 +43,6 @@ struct SnmpTrap;
  */
 extern ObjectQueue<SnmpTrap> g_snmpTrapProcessorQueue;
 extern ObjectQueue<SnmpTrap> g_snmpTrapWriterQueue;
-extern ObjectQueue<SyslogMessage> g_syslogProcessingQueue;
 extern ObjectQueue<SyslogMessage> g_syslogWriteQueue;
 extern ObjectQueue<WindowsEvent> g_windowsEventProcessingQueue;
 extern ObjectQueue<WindowsEvent> g_windowsEventWriterQueue;
@@ -53,6 +52,7 @@ extern ThreadPool *g_schedulerThreadPool;
 
 int64_t GetEventLogWriterQueueSize();
 int64_t GetEventProcessorQueueSize();
+int64_t GetSyslogProcessingQueueSize();
 
 /**
  * Internal queue statistic
@@ -129,7 +129,7 @@ void ServerStatCollector()
    AddQueueToCollector(_T("Scheduler"), g_schedulerThreadPool);
    AddQueueToCollector(_T("SNMPTrapProcessor"), &g_snmpTrapProcessorQueue);
    AddQueueToCollector(_T("SNMPTrapWriter"), &g_snmpTrapWriterQueue);
-   AddQueueToCollector(_T("SyslogProcessor"), &g_syslogProcessingQueue);
+   AddQueueToCollector(_T("SyslogProcessor"), GetSyslogProcessingQueueSize);
    AddQueueToCollector(_T("SyslogWriter"), &g_syslogWriteQueue);
    AddQueueToCollector(_T("TemplateUpdater"), &g_templateUpdateQueue);
    AddQueueToCollector(_T("WindowsEventProcessor"), &g_windowsEventProcessingQueue);
@@ -223,7 +223,7 @@ uint64_t GetDCICacheMemoryUsage()
 {
    uint64_t dciCache = 0;
    g_idxObjectById.forEach(GetCacheMemoryUsage, &dciCache);
-   return dciCache;
+   return dciCache + GetDCIStringStoreMemoryUsage();
 }
 
 /**
@@ -4760,6 +4760,7 @@ void ClientSession::forceDCIPoll(const NXCPMessage& request)
 				   if (dci->hasAccess(m_userId))
 				   {
                   dci->requestForcePoll(this);
+                  ScheduleDataCollection(dci, time(nullptr));
                   response.setField(VID_RCC, RCC_SUCCESS);
                   debugPrintf(4, _T("ForceDCIPoll: DCI %d at node %d"), dciId, object->getId());
                   writeAuditLog(AUDIT_OBJECTS, true, object->getId(), _T("Forced DCI poll initiated for DCI \"%s\" [%u]"), dci->getDescription().cstr(), dci->getId());
@@ -9243,17 +9244,21 @@ void ClientSession::killSession(const NXCPMessage& request)
 /**
  * Handler for new syslog messages
  */
-void ClientSession::onSyslogMessage(const SyslogMessage *sm)
+void ClientSession::onSyslogMessages(const ObjectArray<SyslogMessage>& messages)
 {
    if (isAuthenticated() && isSubscribedTo(NXC_CHANNEL_SYSLOG) && (m_systemAccessRights & SYSTEM_ACCESS_VIEW_SYSLOG))
    {
-      shared_ptr<Node> node = sm->getNode();
-      // If can't find object - just send to all sessions, if object found send to those who have rights
-      if ((node == nullptr) || node->checkAccessRights(m_userId, OBJECT_ACCESS_READ_ALARMS))
+      for(int i = 0; i < messages.size(); i++)
       {
-         NXCPMessage msg(CMD_SYSLOG_RECORDS, 0);
-         sm->fillNXCPMessage(&msg);
-         postMessage(&msg);
+         const SyslogMessage *sm = messages.get(i);
+         shared_ptr<Node> node = sm->getNode();
+         // If can't find object - just send to all sessions, if object found send to those who have rights
+         if ((node == nullptr) || node->checkAccessRights(m_userId, OBJECT_ACCESS_READ_ALARMS))
+         {
+            NXCPMessage msg(CMD_SYSLOG_RECORDS, 0);
+            sm->fillNXCPMessage(&msg);
+            postMessage(&msg);
+         }
       }
    }
 }
@@ -28,11 +28,103 @@
 #define BY_OBJECT_ID 0
 #define BY_POSITION 1
 
+/**
+ * Trap mapping index. Index is immutable and is replaced with new one on every change
+ * in trap mapping list, so lookups can be done without locking trap mapping list.
+ */
+struct TrapMappingIndex
+{
+   SharedObjectArray<SNMPTrapMapping> mappings;
+   OIDPrefixTree tree;
+
+   TrapMappingIndex() : mappings(64, 64) { }
+};
+
 /**
  * Static data
  */
 static Mutex s_trapMappingLock(MutexType::FAST);
 static SharedObjectArray<SNMPTrapMapping> s_trapMappings(16, 16);
+static shared_ptr<TrapMappingIndex> s_trapMappingIndex = make_shared<TrapMappingIndex>();
+
+/**
+ * Destroy child nodes of given OID prefix tree node
+ */
+void OIDPrefixTree::destroyNode(Node *node)
+{
+   if (node->children == nullptr)
+      return;
+   for(int i = 0; i < node->children->size(); i++)
+      destroyNode(node->children->get(i));
+   delete node->children;
+   node->children = nullptr;
+}
+
+/**
+ * Add OID to prefix tree. If given OID already has value, existing value is kept.
+ * Returns value associated with OID after the call.
+ */
+int OIDPrefixTree::add(const SNMP_ObjectId& oid, int value)
+{
+   Node *node = &m_root;
+   const uint32_t *e = oid.value();
+   for(size_t i = 0; i < oid.length(); i++)
+   {
+      if (node->children == nullptr)
+         node->children = new ObjectArray<Node>(0, 4, Ownership::True);
+
+      // Find insertion point
+      int l = 0, r = node->children->size() - 1;
+      Node *child = nullptr;
+      while(l <= r)
+      {
+         int m = (l + r) / 2;
+         Node *c = node->children->get(m);
+         if (c->element == e[i])
+         {
+            child = c;
+            break;
+         }
+         if (c->element < e[i])
+            l = m + 1;
+         else
+            r = m - 1;
+      }
+
+      if (child == nullptr)
+      {
+         child = new Node;
+         child->element = e[i];
+         child->value = -1;
+         child->children = nullptr;
+         node->children->insert(l, child);
+      }
+      node = child;
+   }
+
+   if ((node != &m_root) && (node->value == -1))
+      node->value = value;
+   return node->value;
+}
+
+/**
+ * Rebuild trap mapping index. Trap mapping lock must be held by caller.
+ */
+static void RebuildTrapMappingIndex()
+{
+   auto index = make_shared<TrapMappingIndex>();
+   for(int i = 0; i < s_trapMappings.size(); i++)
+   {
+      const shared_ptr<SNMPTrapMapping>& tm = s_trapMappings.getShared(i);
+      if (tm->getOid().length() == 0)
+         continue;
+      // When several mappings have same OID first one is used
+      if (index->tree.add(tm->getOid(), index->mappings.size()) == index->mappings.size())
+         index->mappings.add(tm);
+   }
+   std::atomic_store(&s_trapMappingIndex, index);
+   nxlog_debug_tag(DEBUG_TAG, 5, _T("Trap mapping index rebuilt (%d mappings)"), index->mappings.size());
+}
 
 /**
  * Collects information about all SNMPTraps that are using specified event
@@ -62,6 +154,7 @@ SNMPTrapMapping::SNMPTrapMapping() : m_objectId(), m_mappings(8, 8, Ownership::T
    m_description = nullptr;
    m_scriptSource = nullptr;
    m_script = nullptr;
+   m_parameterAliases = nullptr;
 }
 
 /**
@@ -78,6 +171,7 @@ SNMPTrapMapping::SNMPTrapMapping(DB_RESULT trapResult, DB_HANDLE hdb, DB_STATEME
    m_guid = DBGetFieldGUID(trapResult, row, 5);
    m_scriptSource = DBGetField(trapResult, row, 6, nullptr, 0);
    m_script = nullptr;
+   m_parameterAliases = nullptr;
 
    DB_RESULT mapResult;
    if (stmt != nullptr)
@@ -102,6 +196,7 @@ SNMPTrapMapping::SNMPTrapMapping(DB_RESULT trapResult, DB_HANDLE hdb, DB_STATEME
       DBFreeResult(mapResult);
    }
 
+   buildParameterIndex();
    compileScript();
 }
 
@@ -128,6 +223,7 @@ SNMPTrapMapping::SNMPTrapMapping(const ConfigEntry& entry, const uuid& guid, uin
       m_scriptSource = MemCopyString(output);
    }
    m_script = nullptr;
+   m_parameterAliases = nullptr;
 
    const ConfigEntry *parametersRoot = entry.findEntry(_T("parameters"));
    if (parametersRoot != nullptr)
@@ -145,6 +241,7 @@ SNMPTrapMapping::SNMPTrapMapping(const ConfigEntry& entry, const uuid& guid, uin
       }
    }
 
+   buildParameterIndex();
    compileScript();
 }
 
@@ -163,6 +260,7 @@ SNMPTrapMapping::SNMPTrapMapping(const NXCPMessage& msg) : m_mappings(8, 8, Owne
    m_eventTag = msg.getFieldAsString(VID_USER_TAG);
    m_scriptSource = msg.getFieldAsString(VID_TRANSFORMATION_SCRIPT);
    m_script = nullptr;
+   m_parameterAliases = nullptr;
 
    // Read new mappings from message
    int count = msg.getFieldAsInt32(VID_TRAP_NUM_MAPS);
@@ -172,6 +270,7 @@ SNMPTrapMapping::SNMPTrapMapping(const NXCPMessage& msg) : m_mappings(8, 8, Owne
       m_mappings.add(new SNMPTrapParameterMapping(msg, base));
    }
 
+   buildParameterIndex();
    compileScript();
 }
 
@@ -183,9 +282,26 @@ SNMPTrapMapping::~SNMPTrapMapping()
    MemFree(m_description);
    MemFree(m_eventTag);
    MemFree(m_scriptSource);
+   MemFree(m_parameterAliases);
    delete m_script;
 }
 
+/**
+ * Build index of parameter mappings by varbind OID
+ */
+void SNMPTrapMapping::buildParameterIndex()
+{
+   if (m_mappings.isEmpty())
+      return;
+
+   m_parameterAliases = MemAllocArrayNoInit<int>(m_mappings.size());
+   for(int i = 0; i < m_mappings.size(); i++)
+   {
+      const SNMPTrapParameterMapping *pm = m_mappings.get(i);
+      m_parameterAliases[i] = (!pm->isPositional() && pm->getOid()->isValid()) ? m_parameterIndex.add(*pm->getOid(), i) : i;
+   }
+}
+
 /**
  * Compile transformation script
  */
@@ -424,6 +540,10 @@ void LoadTrapMappings()
          }
          if (hStmt != nullptr)
             DBFreeStatement(hStmt);
+
+         s_trapMappingLock.lock();
+         RebuildTrapMappingIndex();
+         s_trapMappingLock.unlock();
       }
       DBFreeResult(hResult);
    }
@@ -501,6 +621,7 @@ uint32_t DeleteTrapMapping(uint32_t id)
                if (DBExecute(hStmtCfg) && DBExecute(hStmtMap))
                {
                   s_trapMappings.remove(i);
+                  RebuildTrapMappingIndex();
                   NotifyOnTrapMappingDelete(id);
                   rcc = RCC_SUCCESS;
                   DBCommit(hdb);
@@ -710,11 +831,13 @@ void AddTrapMappingToList(const shared_ptr<SNMPTrapMapping>& tm)
       if (s_trapMappings.get(i)->getId() == tm->getId())
       {
          s_trapMappings.replace(i, tm);
+         RebuildTrapMappingIndex();
          return;
       }
    }
 
    s_trapMappings.add(tm);
+   RebuildTrapMappingIndex();
 }
 
 /**
@@ -722,28 +845,7 @@ void AddTrapMappingToList(const shared_ptr<SNMPTrapMapping>& tm)
  */
 shared_ptr<SNMPTrapMapping> FindBestMatchTrapMapping(const SNMP_ObjectId& oid)
 {
-   LockGuard lockGuard(s_trapMappingLock);
-
-   // Try to find closest match
-   size_t matchLen = 0;
-   int matchIndex = -1;
-   for(int i = 0; i < s_trapMappings.size(); i++)
-   {
-      const SNMPTrapMapping *tm = s_trapMappings.get(i);
-      if (tm->getOid().length() > 0)
-      {
-         int result = oid.compare(tm->getOid());
-         if (result == OID_EQUAL)
-         {
-            return s_trapMappings.getShared(i); // Found exact match
-         }
-         if ((result == OID_LONGER) && (tm->getOid().length() > matchLen))
-         {
-            matchLen = tm->getOid().length();
-            matchIndex = i;
-         }
-      }
-   }
-
-   return (matchLen > 0) ? s_trapMappings.getShared(matchIndex) : shared_ptr<SNMPTrapMapping>();
+   shared_ptr<TrapMappingIndex> index = std::atomic_load(&s_trapMappingIndex);
+   int i = index->tree.findLongestPrefix(oid);
+   return (i != -1) ? index->mappings.getShared(i) : shared_ptr<SNMPTrapMapping>();
 }
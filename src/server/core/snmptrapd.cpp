@@ -44,6 +44,7 @@ struct SnmpTrap
    bool isInformRq;
    StringBuffer varbinds;
    uint32_t nodeId;
+   int64_t queueTime;
 
    SnmpTrap(SNMP_PDU *_pdu, const InetAddress& _addr, int32_t _zoneUIN, uint16_t _port, bool _isInformRq) : addr(_addr)
    {
@@ -54,6 +55,7 @@ struct SnmpTrap
       port = _port;
       isInformRq = _isInformRq;
       nodeId = 0;
+      queueTime = GetCurrentTimeMs();
    }
 
    ~SnmpTrap()
@@ -80,6 +82,15 @@ VolatileCounter64 g_snmpTrapsReceived = 0;
 ObjectQueue<SnmpTrap> g_snmpTrapProcessorQueue(1024, Ownership::False);
 ObjectQueue<SnmpTrap> g_snmpTrapWriterQueue(1024, Ownership::False);
 
+/**
+ * Trap processor statistics
+ */
+static uint64_t s_processedTraps = 0;
+static int64_t s_averageWaitTime = 0;
+static int64_t s_averageProcessingTime = 0;
+static uint32_t s_maxWaitTime = 0;
+static uint32_t s_maxProcessingTime = 0;
+
 /**
  * Get last SNMP Trap id
  */
@@ -88,6 +99,19 @@ int64_t GetLastSnmpTrapId()
    return s_trapId;
 }
 
+/**
+ * Get trap processor statistics
+ */
+void GetSNMPTrapProcessorStatistics(SNMPTrapProcessorStats *stats)
+{
+   stats->processedTraps = s_processedTraps;
+   stats->averageWaitTime = static_cast<double>(s_averageWaitTime) / EMA_FP_1;
+   stats->averageProcessingTime = static_cast<double>(s_averageProcessingTime) / EMA_FP_1;
+   stats->maxWaitTime = s_maxWaitTime;
+   stats->maxProcessingTime = s_maxProcessingTime;
+   stats->queueSize = static_cast<uint32_t>(g_snmpTrapProcessorQueue.size());
+}
+
 /**
  * Generate event for matched trap
  */
@@ -100,8 +124,23 @@ static void GenerateTrapEvent(SnmpTrap *trap, const shared_ptr<Node>& node, cons
    event.tag(mapping.getEventTag());
    event.param(_T("oid"), pdu->getTrapId().toString());
 
-   // Extract varbinds from trap and add them as event's parameters
+   // Find first matching varbind for each parameter mapping by varbind OID
    int numMaps = mapping.getParameterMappingCount();
+   int *varbindIndex = static_cast<int*>(MemAllocLocal(sizeof(int) * std::max(numMaps, 1)));
+   for(int i = 0; i < numMaps; i++)
+      varbindIndex[i] = -1;
+   int numVarbinds = pdu->getNumVariables();
+   for(int j = 0; j < numVarbinds; j++)
+   {
+      mapping.getParameterIndex().forEachPrefix(pdu->getVariable(j)->getName(),
+         [varbindIndex, j] (int i) -> void
+         {
+            if (varbindIndex[i] == -1)
+               varbindIndex[i] = j;
+         });
+   }
+
+   // Extract varbinds from trap and add them as event's parameters
    for(int i = 0; i < numMaps; i++)
    {
       const SNMPTrapParameterMapping *pm = mapping.getParameterMapping(i);
@@ -126,25 +165,21 @@ static void GenerateTrapEvent(SnmpTrap *trap, const shared_ptr<Node>& node, cons
       }
       else
       {
-         // Extract by varbind OID
-         int count = pdu->getNumVariables();
-         for(int j = 0; j < count; j++)
+         // Extract by varbind OID (mappings with same OID share index entry)
+         int j = varbindIndex[mapping.getParameterAlias(i)];
+         if (j != -1)
          {
             SNMP_Variable *varbind = pdu->getVariable(j);
-            int result = varbind->getName().compare(*(pm->getOid()));
-            if ((result == OID_EQUAL) || (result == OID_LONGER))
-            {
-               bool convertToHex = true;
-               TCHAR buffer[3072];
-               event.param(varbind->getName().toString(),
-                  ((g_flags & AF_ALLOW_TRAP_VARBIND_CONVERSION) && !(pm->getFlags() & TRAP_VARBIND_FORCE_TEXT)) ?
-                     varbind->getValueAsPrintableString(buffer, 3072, &convertToHex) :
-                     varbind->getValueAsString(buffer, 3072));
-               break;
-            }
+            bool convertToHex = true;
+            TCHAR buffer[3072];
+            event.param(varbind->getName().toString(),
+               ((g_flags & AF_ALLOW_TRAP_VARBIND_CONVERSION) && !(pm->getFlags() & TRAP_VARBIND_FORCE_TEXT)) ?
+                  varbind->getValueAsPrintableString(buffer, 3072, &convertToHex) :
+                  varbind->getValueAsString(buffer, 3072));
          }
       }
    }
+   MemFreeLocal(varbindIndex);
 
    event.param(_T("sourcePort"), trap->port);
 
@@ -336,7 +371,19 @@ static void ProcessorThread()
       SnmpTrap *trap = g_snmpTrapProcessorQueue.getOrBlock();
       if (trap == INVALID_POINTER_VALUE)
          break;
-      ProcessTrap(trap);
+
+      int64_t startTime = GetCurrentTimeMs();
+      uint32_t waitTime = static_cast<uint32_t>(startTime - trap->queueTime);
+      ProcessTrap(trap);  // Trap object may be destroyed or passed to writer at this point
+      uint32_t processingTime = static_cast<uint32_t>(GetCurrentTimeMs() - startTime);
+
+      UpdateExpMovingAverage(s_averageWaitTime, EMA_EXP_180, static_cast<int64_t>(waitTime));
+      UpdateExpMovingAverage(s_averageProcessingTime, EMA_EXP_180, static_cast<int64_t>(processingTime));
+      if (waitTime > s_maxWaitTime)
+         s_maxWaitTime = waitTime;
+      if (processingTime > s_maxProcessingTime)
+         s_maxProcessingTime = processingTime;
+      s_processedTraps++;
    }
 
    nxlog_debug_tag(DEBUG_TAG, 1, _T("SNMP trap processor stopped"));
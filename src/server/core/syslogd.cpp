@@ -33,9 +33,18 @@
 #define MAX_SYSLOG_MSG_LEN    1024
 
 /**
- * Queues
+ * Max number of datagrams received by single system call
+ */
+#define SYSLOG_RECEIVE_BATCH_SIZE   64
+
+/**
+ * Max number of messages processed by processing thread before broadcasting them to clients
+ */
+#define SYSLOG_PROCESSING_BATCH_SIZE   256
+
+/**
+ * Writer queue
  */
-ObjectQueue<SyslogMessage> g_syslogProcessingQueue(1024, Ownership::False);
 ObjectQueue<SyslogMessage> g_syslogWriteQueue(1024, Ownership::False);
 
 /**
@@ -55,12 +64,12 @@ enum NodeMatchingPolicy
 /**
  * Static data
  */
-static uint64_t s_msgId = 1;  // Next available message ID
-static LogParser *s_parser = nullptr;
+static VolatileCounter64 s_msgId = 1;  // Next available message ID
+static LogParser *s_parser = nullptr;  // Parser created from configuration, processing threads are using its copies
 static Mutex s_parserLock(MutexType::FAST);
 static NodeMatchingPolicy s_nodeMatchingPolicy = SOURCE_IP_THEN_HOSTNAME;
-static THREAD s_receiverThread = INVALID_THREAD_HANDLE;
-static THREAD s_processingThread = INVALID_THREAD_HANDLE;
+static THREAD *s_receiverThreads = nullptr;
+static int s_receiverThreadCount = 0;
 static THREAD s_writerThread = INVALID_THREAD_HANDLE;
 static bool s_running = true;
 static bool s_alwaysUseServerTime = false;
@@ -352,10 +361,10 @@ bool SyslogMessage::bindToNode()
 /**
  * Handler for EnumerateSessions()
  */
-static void BroadcastSyslogMessage(ClientSession *session, SyslogMessage *msg)
+static void BroadcastSyslogMessages(ClientSession *session, ObjectArray<SyslogMessage> *messages)
 {
    if (session->isAuthenticated())
-      session->onSyslogMessage(msg);
+      session->onSyslogMessages(*messages);
 }
 
 /**
@@ -427,94 +436,192 @@ static void SyslogWriterThread()
 }
 
 /**
- * Process syslog message
+ * Syslog processing thread. Messages are distributed between processing threads by source address,
+ * so messages from same source are always processed in order of arrival.
  */
-static void ProcessSyslogMessage(SyslogMessage *msg)
+struct SyslogProcessingThread
+{
+   ObjectQueue<SyslogMessage> queue;
+   THREAD thread;
+   LogParser *parser;   // Thread's own copy of syslog parser
+   Mutex parserLock;    // Guards parser replacement and access to parser counters from other threads
+   int id;
+
+   SyslogProcessingThread() : queue(1024, Ownership::False), parserLock(MutexType::FAST)
+   {
+      thread = INVALID_THREAD_HANDLE;
+      parser = nullptr;
+      id = 0;
+   }
+
+   ~SyslogProcessingThread()
+   {
+      delete parser;
+   }
+
+   bool processMessage(SyslogMessage *msg, bool *writeToDatabase);
+   void run();
+};
+
+/**
+ * Syslog processing threads
+ */
+static SyslogProcessingThread *s_processingThreads = nullptr;
+static int s_processingThreadCount = 0;
+
+/**
+ * Process syslog message. Returns true if message was accepted (and should be sent to clients).
+ * Message is destroyed if it was not accepted.
+ */
+bool SyslogProcessingThread::processMessage(SyslogMessage *msg, bool *writeToDatabase)
 {
 	nxlog_debug_tag(DEBUG_TAG, 6, _T("ProcessSyslogMessage: Raw syslog message to process:\n%hs"), msg->getRawData());
-   if (msg->parse())
+   if (!msg->parse())
    {
-      InterlockedIncrement64(&g_syslogMessagesReceived);
+      nxlog_debug_tag(DEBUG_TAG, 6, _T("ProcessSyslogMessage: Cannot parse syslog message"));
+      delete msg;
+      return false;
+   }
 
-      if (!msg->bindToNode() && !s_allowUnknownSources)
-      {
-         nxlog_debug_tag(DEBUG_TAG, 6, _T("ProcessSyslogMessage: message from unknown source ignored"));
-         delete msg;
-         return;
-      }
+   InterlockedIncrement64(&g_syslogMessagesReceived);
 
-      msg->setId(s_msgId++);
-      const char *codepage = (s_syslogCodepage[0] != 0) ? s_syslogCodepage : nullptr;
-      if (msg->getNodeId() != 0)
-      {
-         const char *nodecp = msg->getNode()->getSyslogCodepage();
-         if (nodecp[0] != 0)
-            codepage = nodecp;
-      }
-      msg->convertRawMessage(codepage);
+   if (!msg->bindToNode() && !s_allowUnknownSources)
+   {
+      nxlog_debug_tag(DEBUG_TAG, 6, _T("ProcessSyslogMessage: message from unknown source ignored"));
+      delete msg;
+      return false;
+   }
 
-		TCHAR ipAddr[64];
-		nxlog_debug_tag(DEBUG_TAG, 6, _T("Syslog message: ipAddr=%s zone=%d objectId=%u tag=\"%hs\" msg=\"%s\""),
-		            msg->getSourceAddress().toString(ipAddr), msg->getZoneUIN(), msg->getNodeId(), msg->getTag(), msg->getMessage());
+   msg->setId(InterlockedIncrement64(&s_msgId) - 1);
+   const char *codepage = (s_syslogCodepage[0] != 0) ? s_syslogCodepage : nullptr;
+   if (msg->getNodeId() != 0)
+   {
+      const char *nodecp = msg->getNode()->getSyslogCodepage();
+      if (nodecp[0] != 0)
+         codepage = nodecp;
+   }
+   msg->convertRawMessage(codepage);
 
-		bool writeToDatabase = true;
-		s_parserLock.lock();
-		if (((msg->getNodeId() != 0) || s_parseUnknownSources) && (s_parser != nullptr))
-		{
+   TCHAR ipAddr[64];
+   nxlog_debug_tag(DEBUG_TAG, 6, _T("Syslog message: ipAddr=%s zone=%d objectId=%u tag=\"%hs\" msg=\"%s\""),
+               msg->getSourceAddress().toString(ipAddr), msg->getZoneUIN(), msg->getNodeId(), msg->getTag(), msg->getMessage());
+
+   *writeToDatabase = true;
+   if ((msg->getNodeId() != 0) || s_parseUnknownSources)
+   {
+      // Lock is only contended when parser is being replaced or counters are read
+      parserLock.lock();
+      if (parser != nullptr)
+      {
 #ifdef UNICODE
-			WCHAR wtag[MAX_SYSLOG_TAG_LEN];
-			mbcp_to_wchar(msg->getTag(), -1, wtag, MAX_SYSLOG_TAG_LEN, codepage);
-			s_parser->matchEvent(wtag, msg->getFacility(), 1 << msg->getSeverity(), msg->getMessage(), nullptr, 0, msg->getNodeId(), 0, ipAddr, &writeToDatabase);
+         WCHAR wtag[MAX_SYSLOG_TAG_LEN];
+         mbcp_to_wchar(msg->getTag(), -1, wtag, MAX_SYSLOG_TAG_LEN, codepage);
+         parser->matchEvent(wtag, msg->getFacility(), 1 << msg->getSeverity(), msg->getMessage(), nullptr, 0, msg->getNodeId(), 0, ipAddr, writeToDatabase);
 #else
-			s_parser->matchEvent(msg->getTag(), msg->getFacility(), 1 << msg->getSeverity(), msg->getMessage(), nullptr, 0, msg->getNodeId(), 0, ipAddr, &writeToDatabase);
+         parser->matchEvent(msg->getTag(), msg->getFacility(), 1 << msg->getSeverity(), msg->getMessage(), nullptr, 0, msg->getNodeId(), 0, ipAddr, writeToDatabase);
 #endif
-		}
-		s_parserLock.unlock();
-
-      // Send message to all connected clients
-      EnumerateClientSessions(BroadcastSyslogMessage, msg);
-
-	   if ((msg->getNodeId() == 0) && (g_flags & AF_SYSLOG_DISCOVERY))  // unknown node, discovery enabled
-	   {
-	      nxlog_debug_tag(DEBUG_TAG, 4, _T("ProcessSyslogMessage: source not matched to node, adding new IP address %s for discovery"),
-	               msg->getSourceAddress().toString(ipAddr));
-	      CheckPotentialNode(msg->getSourceAddress(), msg->getZoneUIN(), DA_SRC_SYSLOG, 0);
-	   }
+      }
+      parserLock.unlock();
+   }
 
-	   if (writeToDatabase && s_enableStorage)
-         g_syslogWriteQueue.put(msg);
-	   else
-	      delete msg;
+   if ((msg->getNodeId() == 0) && (g_flags & AF_SYSLOG_DISCOVERY))  // unknown node, discovery enabled
+   {
+      nxlog_debug_tag(DEBUG_TAG, 4, _T("ProcessSyslogMessage: source not matched to node, adding new IP address %s for discovery"),
+               msg->getSourceAddress().toString(ipAddr));
+      CheckPotentialNode(msg->getSourceAddress(), msg->getZoneUIN(), DA_SRC_SYSLOG, 0);
    }
-	else
-	{
-		nxlog_debug_tag(DEBUG_TAG, 6, _T("ProcessSyslogMessage: Cannot parse syslog message"));
-		delete msg;
-	}
+
+   return true;
 }
 
 /**
- * Syslog processing thread
+ * Syslog processing thread main loop. All messages available in the queue are processed
+ * as one batch and then sent to connected clients with single pass over client sessions.
  */
-static void SyslogProcessingThread()
+void SyslogProcessingThread::run()
 {
-   ThreadSetName("SyslogProcessor");
-   while(true)
+   char tname[32];
+   snprintf(tname, 32, "SyslogProc-%d", id);
+   ThreadSetName(tname);
+
+   ObjectArray<SyslogMessage> processed(SYSLOG_PROCESSING_BATCH_SIZE, SYSLOG_PROCESSING_BATCH_SIZE, Ownership::False);
+   ObjectArray<SyslogMessage> stored(SYSLOG_PROCESSING_BATCH_SIZE, SYSLOG_PROCESSING_BATCH_SIZE, Ownership::False);
+   ObjectArray<SyslogMessage> discarded(SYSLOG_PROCESSING_BATCH_SIZE, SYSLOG_PROCESSING_BATCH_SIZE, Ownership::True);
+   bool shutdown = false;
+   while(!shutdown)
    {
-      SyslogMessage *msg = g_syslogProcessingQueue.getOrBlock();
-      if (msg == INVALID_POINTER_VALUE)
-         break;
+      SyslogMessage *msg = queue.getOrBlock();
+      while(true)
+      {
+         if (msg == INVALID_POINTER_VALUE)
+         {
+            shutdown = true;
+            break;
+         }
 
-      ProcessSyslogMessage(msg);
+         bool writeToDatabase;
+         if (processMessage(msg, &writeToDatabase))
+         {
+            processed.add(msg);
+            if (writeToDatabase && s_enableStorage)
+               stored.add(msg);
+            else
+               discarded.add(msg);
+         }
+
+         if (processed.size() == SYSLOG_PROCESSING_BATCH_SIZE)
+            break;
+         msg = queue.get();
+         if (msg == nullptr)
+            break;
+      }
+
+      if (processed.isEmpty())
+         continue;
+
+      // Send messages to all connected clients
+      EnumerateClientSessions(BroadcastSyslogMessages, &processed);
+
+      for(int i = 0; i < stored.size(); i++)
+         g_syslogWriteQueue.put(stored.get(i));
+      processed.clear();
+      stored.clear();
+      discarded.clear();
    }
 }
 
 /**
- * Queue syslog message for processing
+ * Queue syslog message for processing by thread selected by message source address
  */
-static void QueueSyslogMessage(char *msg, int msgLen, const InetAddress& sourceAddr)
+static void QueueSyslogMessage(SyslogMessage *msg)
 {
-   g_syslogProcessingQueue.put(new SyslogMessage(sourceAddr, msg, msgLen));
+   if (s_processingThreadCount == 0)
+   {
+      delete msg;
+      return;
+   }
+
+   int index;
+   if (s_processingThreadCount > 1)
+   {
+      const InetAddress& addr = msg->getSourceAddress();
+      uint32_t hash;
+      if (addr.getFamily() == AF_INET)
+      {
+         uint32_t a = addr.getAddressV4();
+         hash = CalculateDJB2Hash(&a, sizeof(uint32_t));
+      }
+      else
+      {
+         hash = CalculateDJB2Hash(addr.getAddressV6(), 16);
+      }
+      index = static_cast<int>(hash % static_cast<uint32_t>(s_processingThreadCount));
+   }
+   else
+   {
+      index = 0;
+   }
+   s_processingThreads[index].queue.put(msg);
 }
 
 /**
@@ -522,7 +629,18 @@ static void QueueSyslogMessage(char *msg, int msgLen, const InetAddress& sourceA
  */
 void QueueProxiedSyslogMessage(const InetAddress &addr, int32_t zoneUIN, uint32_t nodeId, time_t timestamp, const char *msg, int msgLen)
 {
-   g_syslogProcessingQueue.put(new SyslogMessage(addr, timestamp, zoneUIN, nodeId, msg, msgLen));
+   QueueSyslogMessage(new SyslogMessage(addr, timestamp, zoneUIN, nodeId, msg, msgLen));
+}
+
+/**
+ * Get total size of syslog processing queues
+ */
+int64_t GetSyslogProcessingQueueSize()
+{
+   int64_t size = 0;
+   for(int i = 0; i < s_processingThreadCount; i++)
+      size += s_processingThreads[i].queue.size();
+   return size;
 }
 
 /**
@@ -596,14 +714,95 @@ static void CreateParserFromConfig()
 		delete parsers;
 	}
 	delete prev;
+
+   // Replace parser copies used by processing threads
+   for(int i = 0; i < s_processingThreadCount; i++)
+   {
+      SyslogProcessingThread *t = &s_processingThreads[i];
+      LogParser *parser = (s_parser != nullptr) ? new LogParser(s_parser) : nullptr;
+      t->parserLock.lock();
+      if ((parser != nullptr) && (t->parser != nullptr))
+         parser->restoreCounters(t->parser);
+      delete t->parser;
+      t->parser = parser;
+      t->parserLock.unlock();
+   }
+}
+
+/**
+ * Receive buffer for syslog receiver thread
+ */
+struct SyslogReceiveBuffer
+{
+   char data[SYSLOG_RECEIVE_BATCH_SIZE][MAX_SYSLOG_MSG_LEN + 1];
+   SockAddrBuffer addr[SYSLOG_RECEIVE_BATCH_SIZE];
+#if HAVE_RECVMMSG
+   struct mmsghdr headers[SYSLOG_RECEIVE_BATCH_SIZE];
+   struct iovec iov[SYSLOG_RECEIVE_BATCH_SIZE];
+#endif
+};
+
+/**
+ * Receive available datagrams from socket and queue them for processing. Returns number of received datagrams or -1 on error.
+ */
+static int ReceiveSyslogMessages(SOCKET s, SyslogReceiveBuffer *buffer)
+{
+#if HAVE_RECVMMSG
+   for(int i = 0; i < SYSLOG_RECEIVE_BATCH_SIZE; i++)
+   {
+      buffer->iov[i].iov_base = buffer->data[i];
+      buffer->iov[i].iov_len = MAX_SYSLOG_MSG_LEN;
+      memset(&buffer->headers[i], 0, sizeof(struct mmsghdr));
+      buffer->headers[i].msg_hdr.msg_name = &buffer->addr[i];
+      buffer->headers[i].msg_hdr.msg_namelen = sizeof(SockAddrBuffer);
+      buffer->headers[i].msg_hdr.msg_iov = &buffer->iov[i];
+      buffer->headers[i].msg_hdr.msg_iovlen = 1;
+   }
+
+   int count = recvmmsg(s, buffer->headers, SYSLOG_RECEIVE_BATCH_SIZE, MSG_DONTWAIT, nullptr);
+   if (count <= 0)
+      return ((count == 0) || (errno == EAGAIN) || (errno == EWOULDBLOCK)) ? 0 : -1;
+
+   for(int i = 0; i < count; i++)
+   {
+      int bytes = static_cast<int>(buffer->headers[i].msg_len);
+      buffer->data[i][bytes] = 0;
+      QueueSyslogMessage(new SyslogMessage(InetAddress::createFromSockaddr((struct sockaddr *)&buffer->addr[i]), buffer->data[i], bytes));
+   }
+   return count;
+#else
+   socklen_t addrLen = sizeof(SockAddrBuffer);
+   int bytes = recvfrom(s, buffer->data[0], MAX_SYSLOG_MSG_LEN, 0, (struct sockaddr *)&buffer->addr[0], &addrLen);
+   if (bytes <= 0)
+      return -1;
+   buffer->data[0][bytes] = 0;
+   QueueSyslogMessage(new SyslogMessage(InetAddress::createFromSockaddr((struct sockaddr *)&buffer->addr[0]), buffer->data[0], bytes));
+   return 1;
+#endif
+}
+
+/**
+ * Allow multiple receiver threads to bind to same port (kernel will distribute incoming datagrams between sockets)
+ */
+static inline void SetSocketReusePortFlag(SOCKET s)
+{
+#ifdef SO_REUSEPORT
+   if ((s != INVALID_SOCKET) && (s_receiverThreadCount > 1))
+   {
+      int on = 1;
+      setsockopt(s, SOL_SOCKET, SO_REUSEPORT, (char *)&on, sizeof(int));
+   }
+#endif
 }
 
 /**
  * Syslog messages receiver thread
  */
-static void SyslogReceiver()
+static void SyslogReceiver(int id)
 {
-   ThreadSetName("SyslogReceiver");
+   char tname[32];
+   snprintf(tname, 32, "SyslogRecv-%d", id);
+   ThreadSetName(tname);
 
    SOCKET hSocket = CreateSocket(AF_INET, SOCK_DGRAM, 0);
 #ifdef WITH_IPV6
@@ -623,6 +822,7 @@ static void SyslogReceiver()
 
 	SetSocketExclusiveAddrUse(hSocket);
 	SetSocketReuseFlag(hSocket);
+   SetSocketReusePortFlag(hSocket);
 #ifndef _WIN32
    fcntl(hSocket, F_SETFD, fcntl(hSocket, F_GETFD) | FD_CLOEXEC);
 #endif
@@ -630,6 +830,7 @@ static void SyslogReceiver()
 #ifdef WITH_IPV6
    SetSocketExclusiveAddrUse(hSocket6);
    SetSocketReuseFlag(hSocket6);
+   SetSocketReusePortFlag(hSocket6);
 #ifndef _WIN32
    fcntl(hSocket6, F_SETFD, fcntl(hSocket6, F_GETFD) | FD_CLOEXEC);
 #endif
@@ -727,13 +928,13 @@ static void SyslogReceiver()
       return;
    }
 
-   if (hSocket != INVALID_SOCKET)
+   if ((hSocket != INVALID_SOCKET) && (id == 1))
    {
       TCHAR ipAddrText[64];
       nxlog_write(NXLOG_INFO, _T("Listening for syslog messages on UDP socket %s:%u"), InetAddress(ntohl(servAddr.sin_addr.s_addr)).toString(ipAddrText), port);
    }
 #ifdef WITH_IPV6
-   if (hSocket6 != INVALID_SOCKET)
+   if ((hSocket6 != INVALID_SOCKET) && (id == 1))
    {
       TCHAR ipAddrText[64];
       nxlog_write(NXLOG_INFO, _T("Listening for syslog messages on UDP socket %s:%u"), InetAddress(servAddr6.sin6_addr.s6_addr).toString(ipAddrText), port);
@@ -741,8 +942,9 @@ static void SyslogReceiver()
 #endif
 
    SocketPoller sp;
+   SyslogReceiveBuffer *receiveBuffer = MemAllocStruct<SyslogReceiveBuffer>();
 
-   nxlog_debug_tag(DEBUG_TAG, 1, _T("Syslog receiver thread started"));
+   nxlog_debug_tag(DEBUG_TAG, 1, _T("Syslog receiver thread #%d started"), id);
 
    // Wait for packets
    while(s_running)
@@ -758,21 +960,18 @@ static void SyslogReceiver()
       int rc = sp.poll(1000);
       if (rc > 0)
       {
-         char syslogMessage[MAX_SYSLOG_MSG_LEN + 1];
-         SockAddrBuffer addr;
-         socklen_t addrLen = sizeof(SockAddrBuffer);
 #ifdef WITH_IPV6
          SOCKET s = sp.isSet(hSocket) ? hSocket : hSocket6;
 #else
          SOCKET s = hSocket;
 #endif
-         int bytes = recvfrom(s, syslogMessage, MAX_SYSLOG_MSG_LEN, 0, (struct sockaddr *)&addr, &addrLen);
-         if (bytes > 0)
+         // Keep reading while socket buffer is full to avoid extra poll calls under high load
+         int count;
+         do
          {
-            syslogMessage[bytes] = 0;
-            QueueSyslogMessage(syslogMessage, bytes, InetAddress::createFromSockaddr((struct sockaddr *)&addr));
-         }
-         else
+            count = ReceiveSyslogMessages(s, receiveBuffer);
+         } while((count == SYSLOG_RECEIVE_BATCH_SIZE) && s_running);
+         if (count < 0)
          {
             // Sleep on error
             ThreadSleepMs(100);
@@ -785,6 +984,8 @@ static void SyslogReceiver()
       }
    }
 
+   MemFree(receiveBuffer);
+
    if (hSocket != INVALID_SOCKET)
       closesocket(hSocket);
 #ifdef WITH_IPV6
@@ -792,7 +993,7 @@ static void SyslogReceiver()
       closesocket(hSocket6);
 #endif
 
-   nxlog_debug_tag(DEBUG_TAG, 1, _T("Syslog receiver thread stopped"));
+   nxlog_debug_tag(DEBUG_TAG, 1, _T("Syslog receiver thread #%d stopped"), id);
 }
 
 /**
@@ -835,6 +1036,27 @@ void OnSyslogConfigurationChange(const TCHAR *name, const TCHAR *value)
    }
 }
 
+/**
+ * Get total value of rule check or match counter from all processing threads
+ */
+static int GetSyslogRuleCounter(const TCHAR *ruleName, uint32_t objectId, bool matchCount)
+{
+   int total = -1;
+   for(int i = 0; i < s_processingThreadCount; i++)
+   {
+      SyslogProcessingThread *t = &s_processingThreads[i];
+      t->parserLock.lock();
+      if (t->parser != nullptr)
+      {
+         int count = matchCount ? t->parser->getRuleMatchCount(ruleName, objectId) : t->parser->getRuleCheckCount(ruleName, objectId);
+         if (count >= 0)
+            total = std::max(total, 0) + count;
+      }
+      t->parserLock.unlock();
+   }
+   return total;
+}
+
 /**
  * Get syslog rule check count in NXSL
  */
@@ -862,9 +1084,7 @@ int F_GetSyslogRuleCheckCount(int argc, NXSL_Value **argv, NXSL_Value **result,
       }
    }
 
-   s_parserLock.lock();
-   *result = vm->createValue((s_parser != nullptr) ? s_parser->getRuleCheckCount(argv[0]->getValueAsCString(), objectId) : -1);
-   s_parserLock.unlock();
+   *result = vm->createValue(GetSyslogRuleCounter(argv[0]->getValueAsCString(), objectId, false));
    return 0;
 }
 
@@ -892,9 +1112,7 @@ int F_GetSyslogRuleMatchCount(int argc, NXSL_Value **argv, NXSL_Value **result,
       }
    }
 
-   s_parserLock.lock();
-   *result = vm->createValue((s_parser != nullptr) ? s_parser->getRuleMatchCount(argv[0]->getValueAsCString(), objectId) : -1);
-   s_parserLock.unlock();
+   *result = vm->createValue(GetSyslogRuleCounter(argv[0]->getValueAsCString(), objectId, true));
    return 0;
 }
 
@@ -903,7 +1121,7 @@ int F_GetSyslogRuleMatchCount(int argc, NXSL_Value **argv, NXSL_Value **result,
  */
 uint64_t GetNextSyslogId()
 {
-   return s_msgId;
+   return static_cast<uint64_t>(s_msgId);
 }
 
 /**
@@ -920,7 +1138,7 @@ void StartSyslogServer()
 
    // Determine first available message id
    uint64_t id = ConfigReadUInt64(_T("FirstFreeSyslogId"), s_msgId);
-   if (id > s_msgId)
+   if (id > static_cast<uint64_t>(s_msgId))
       s_msgId = id;
    DB_HANDLE hdb = DBConnectionPoolAcquireConnection();
    DB_RESULT hResult = DBSelect(hdb, _T("SELECT max(msg_id) FROM syslog"));
@@ -928,7 +1146,7 @@ void StartSyslogServer()
    {
       if (DBGetNumRows(hResult) > 0)
       {
-         s_msgId = std::max(DBGetFieldUInt64(hResult, 0, 0) + 1, s_msgId);
+         s_msgId = std::max(DBGetFieldInt64(hResult, 0, 0) + 1, static_cast<int64_t>(s_msgId));
       }
       DBFreeResult(hResult);
    }
@@ -936,15 +1154,44 @@ void StartSyslogServer()
 
    InitLogParserLibrary();
 
-   // Create message parser
+   int processingThreadCount = ConfigReadInt(_T("Syslog.ProcessingThreads"), 1);
+   if (processingThreadCount < 1)
+      processingThreadCount = 1;
+   else if (processingThreadCount > 64)
+      processingThreadCount = 64;
+   s_processingThreads = new SyslogProcessingThread[processingThreadCount];
+   for(int i = 0; i < processingThreadCount; i++)
+      s_processingThreads[i].id = i + 1;
+   s_processingThreadCount = processingThreadCount;
+
+   // Create message parser (processing threads will get their own copies)
    CreateParserFromConfig();
 
-   // Start processing thread
-   s_processingThread = ThreadCreateEx(SyslogProcessingThread);
+   // Start processing threads
+   for(int i = 0; i < processingThreadCount; i++)
+      s_processingThreads[i].thread = ThreadCreateEx(&s_processingThreads[i], &SyslogProcessingThread::run);
    s_writerThread = ThreadCreateEx(SyslogWriterThread);
 
    if (ConfigReadBoolean(_T("Syslog.EnableListener"), false))
-      s_receiverThread = ThreadCreateEx(SyslogReceiver);
+   {
+      int receiverThreadCount = ConfigReadInt(_T("Syslog.ReceiverThreads"), 1);
+#ifdef SO_REUSEPORT
+      if (receiverThreadCount < 1)
+         receiverThreadCount = 1;
+      else if (receiverThreadCount > 16)
+         receiverThreadCount = 16;
+#else
+      if (receiverThreadCount > 1)
+         nxlog_write_tag(NXLOG_WARNING, DEBUG_TAG, _T("Multiple syslog receiver threads are not supported on this platform"));
+      receiverThreadCount = 1;
+#endif
+      s_receiverThreadCount = receiverThreadCount;
+      s_receiverThreads = MemAllocArrayNoInit<THREAD>(receiverThreadCount);
+      for(int i = 0; i < receiverThreadCount; i++)
+         s_receiverThreads[i] = ThreadCreateEx(SyslogReceiver, i + 1);
+   }
+
+   nxlog_debug_tag(DEBUG_TAG, 2, _T("Syslog server started (%d receiver threads, %d processing threads)"), s_receiverThreadCount, s_processingThreadCount);
 }
 
 /**
@@ -953,16 +1200,25 @@ void StartSyslogServer()
 void StopSyslogServer()
 {
    s_running = false;
-   ThreadJoin(s_receiverThread);
-
-   // Stop processing thread
-   g_syslogProcessingQueue.put(INVALID_POINTER_VALUE);
-   ThreadJoin(s_processingThread);
-
-   // Stop writer thread - it must be done after processing thread already finished
+   for(int i = 0; i < s_receiverThreadCount; i++)
+      ThreadJoin(s_receiverThreads[i]);
+   MemFreeAndNull(s_receiverThreads);
+   s_receiverThreadCount = 0;
+
+   // Stop processing threads
+   for(int i = 0; i < s_processingThreadCount; i++)
+      s_processingThreads[i].queue.put(INVALID_POINTER_VALUE);
+   for(int i = 0; i < s_processingThreadCount; i++)
+      ThreadJoin(s_processingThreads[i].thread);
+
+   // Stop writer thread - it must be done after processing threads already finished
    g_syslogWriteQueue.put(INVALID_POINTER_VALUE);
    ThreadJoin(s_writerThread);
 
+   s_processingThreadCount = 0;
+   delete[] s_processingThreads;
+   s_processingThreads = nullptr;
+
    delete s_parser;
    CleanupLogParserLibrary();
 }
@@ -1027,7 +1027,7 @@ class NXCORE_EXPORTABLE ClientSession : public GenericClientSession
    void updateSystemAccessRights();
 
    void onNewEvent(Event *pEvent);
-   void onSyslogMessage(const SyslogMessage *sm);
+   void onSyslogMessages(const ObjectArray<SyslogMessage>& messages);
    void onNewSNMPTrap(NXCPMessage *pMsg);
    void onObjectChange(const shared_ptr<NetObj>& object);
    void onAlarmUpdate(UINT32 dwCode, const Alarm *alarm);
@@ -1080,6 +1080,95 @@ class ServerCommandExecutor : public ProcessExecutor
    static shared_ptr<ServerCommandExecutor> createFromMessage(const NXCPMessage& request, Alarm *alarm, ClientSession *session);
 };
 
+/**
+ * OID prefix tree. Maps OIDs to integer values (usually indexes in some list) and allows
+ * to find values set for all prefixes of given OID with single pass over OID elements.
+ */
+class OIDPrefixTree
+{
+private:
+   struct Node
+   {
+      uint32_t element;
+      int value;
+      ObjectArray<Node> *children;  // Sorted by element
+   };
+
+   Node m_root;
+
+   static void destroyNode(Node *node);
+
+   static const Node *findChild(const Node *node, uint32_t element)
+   {
+      if (node->children == nullptr)
+         return nullptr;
+      int l = 0, r = node->children->size() - 1;
+      while(l <= r)
+      {
+         int m = (l + r) / 2;
+         const Node *c = node->children->get(m);
+         if (c->element == element)
+            return c;
+         if (c->element < element)
+            l = m + 1;
+         else
+            r = m - 1;
+      }
+      return nullptr;
+   }
+
+public:
+   OIDPrefixTree()
+   {
+      m_root.element = 0;
+      m_root.value = -1;
+      m_root.children = nullptr;
+   }
+   OIDPrefixTree(const OIDPrefixTree& src) = delete;
+   ~OIDPrefixTree()
+   {
+      destroyNode(&m_root);
+   }
+
+   int add(const SNMP_ObjectId& oid, int value);
+
+   /**
+    * Find value set for longest prefix of given OID (including OID itself). Returns -1 if there is no such value.
+    */
+   int findLongestPrefix(const SNMP_ObjectId& oid) const
+   {
+      int value = -1;
+      const Node *node = &m_root;
+      const uint32_t *e = oid.value();
+      for(size_t i = 0; i < oid.length(); i++)
+      {
+         node = findChild(node, e[i]);
+         if (node == nullptr)
+            break;
+         if (node->value != -1)
+            value = node->value;
+      }
+      return value;
+   }
+
+   /**
+    * Call given callback for all values set for prefixes of given OID (including OID itself), from shortest to longest
+    */
+   template<typename C> void forEachPrefix(const SNMP_ObjectId& oid, C callback) const
+   {
+      const Node *node = &m_root;
+      const uint32_t *e = oid.value();
+      for(size_t i = 0; i < oid.length(); i++)
+      {
+         node = findChild(node, e[i]);
+         if (node == nullptr)
+            break;
+         if (node->value != -1)
+            callback(node->value);
+      }
+   }
+};
+
 /**
  * SNMP Trap parameter map object
  */
@@ -1124,8 +1213,11 @@ class SNMPTrapMapping
    TCHAR *m_scriptSource;
    NXSL_Program *m_script;
    ObjectArray<SNMPTrapParameterMapping> m_mappings;
+   OIDPrefixTree m_parameterIndex;    // Index of parameter mappings by varbind OID
+   int *m_parameterAliases;           // For each parameter mapping - index of first mapping with same varbind OID
 
    void compileScript();
+   void buildParameterIndex();
 
 public:
    SNMPTrapMapping();
@@ -1144,6 +1236,8 @@ class SNMPTrapMapping
    const SNMP_ObjectId& getOid() const { return m_objectId; }
    const SNMPTrapParameterMapping *getParameterMapping(int index) const { return m_mappings.get(index); }
    int getParameterMappingCount() const { return m_mappings.size(); }
+   const OIDPrefixTree& getParameterIndex() const { return m_parameterIndex; }
+   int getParameterAlias(int index) const { return m_parameterAliases[index]; }
    uint32_t getEventCode() const { return m_eventCode; }
    const TCHAR *getEventTag() const { return m_eventTag; }
    const TCHAR *getDescription() const { return m_description; }
@@ -1428,6 +1522,21 @@ uint32_t ResolveTrapMappingGuid(const uuid& guid);
 void AddTrapMappingToList(const shared_ptr<SNMPTrapMapping>& tm);
 shared_ptr<SNMPTrapMapping> FindBestMatchTrapMapping(const SNMP_ObjectId& oid);
 
+/**
+ * SNMP trap processor statistics
+ */
+struct SNMPTrapProcessorStats
+{
+   uint64_t processedTraps;
+   double averageWaitTime;
+   double averageProcessingTime;
+   uint32_t maxWaitTime;
+   uint32_t maxProcessingTime;
+   uint32_t queueSize;
+};
+
+void GetSNMPTrapProcessorStatistics(SNMPTrapProcessorStats *stats);
+
 bool NXCORE_EXPORTABLE IsTableTool(uint32_t toolId);
 bool NXCORE_EXPORTABLE CheckObjectToolAccess(uint32_t toolId, uint32_t userId);
 uint32_t ExecuteTableTool(uint32_t toolId, const shared_ptr<Node>& node, uint32_t requestId, ClientSession *session);
@@ -1685,11 +1794,14 @@ extern time_t g_serverStartTime;
 extern uint32_t g_agentCommandTimeout;
 extern uint32_t g_agentRestartWaitTime;
 extern uint32_t g_thresholdRepeatInterval;
+extern uint32_t g_anomalyModelRefreshInterval;
 extern uint32_t g_requiredPolls;
 extern uint32_t g_offlineDataRelevanceTime;
 extern int32_t g_instanceRetentionTime;
 extern uint32_t g_snmpTrapStormCountThreshold;
 extern uint32_t g_snmpTrapStormDurationThreshold;
+extern uint32_t g_snmpMaxVarbinds;
+extern uint32_t g_snmpBulkMaxRepetitions;
 extern uint32_t g_pollsBetweenPrimaryIpUpdate;
 extern PrimaryIPUpdateMode g_primaryIpUpdateMode;
 extern char g_snmpCodepage[16];
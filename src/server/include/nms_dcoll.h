@@ -28,6 +28,12 @@
  */
 #define MAX_NPE_NAME_LEN            16
 
+/**
+ * Interval (in seconds) for re-checking data collection objects which cannot be polled
+ * because of their own or owning object's state (disabled, busy, unmanaged, etc.)
+ */
+#define DC_SCHEDULER_RECHECK_INTERVAL  60
+
 /**
  * Interface for objects that can be searched
  */
@@ -136,6 +142,192 @@ class NXCORE_EXPORTABLE ItemValue
    ItemValue& operator=(uint64_t value) { set(value); return *this; }
 };
 
+/**
+ * Compact ring buffer for DCI value cache. Numeric samples are stored as (timestamp, value) pairs,
+ * values of string DCIs are kept in shared string store (identical strings are stored only once).
+ * Exact string representation is kept only for most recent value. Element with index 0 is most recent value.
+ */
+class NXCORE_EXPORTABLE DCItemValueCache
+{
+private:
+   struct Sample
+   {
+      time_t timestamp;
+      union
+      {
+         int64_t i;
+         double d;
+         const TCHAR *s;
+      } value;
+   };
+
+   /**
+    * Monotonic queue of sample sequence numbers (ring buffer of fixed capacity), used for sliding window minimum and maximum
+    */
+   class SequenceQueue
+   {
+   private:
+      uint64_t *m_data;
+      uint32_t m_capacity;
+      uint32_t m_head;
+      uint32_t m_size;
+
+   public:
+      SequenceQueue(uint32_t capacity)
+      {
+         m_capacity = std::max(capacity, 1u);
+         m_data = MemAllocArrayNoInit<uint64_t>(m_capacity);
+         m_head = 0;
+         m_size = 0;
+      }
+      SequenceQueue(const SequenceQueue& src)
+      {
+         m_capacity = src.m_capacity;
+         m_data = MemCopyArray(src.m_data, m_capacity);
+         m_head = src.m_head;
+         m_size = src.m_size;
+      }
+      ~SequenceQueue() { MemFree(m_data); }
+
+      SequenceQueue& operator=(const SequenceQueue& src) = delete;
+
+      bool isEmpty() const { return m_size == 0; }
+      uint64_t front() const { return m_data[m_head]; }
+      uint64_t back() const { return m_data[(m_head + m_size - 1) % m_capacity]; }
+      void pushBack(uint64_t seq) { m_data[(m_head + m_size) % m_capacity] = seq; m_size++; }
+      void popBack() { m_size--; }
+      void popFront() { m_head = (m_head + 1) % m_capacity; m_size--; }
+      void clear() { m_head = 0; m_size = 0; }
+      uint32_t capacity() const { return m_capacity; }
+   };
+
+   /**
+    * Rolling aggregates (sum, sum of squares, minimum and maximum) of given number of most recent values.
+    * Windows are maintained only for numbers of values registered with setAggregateWindows() and updated
+    * in constant (amortized) time on every push, so users of same window (for example, several thresholds)
+    * share one set of aggregates.
+    */
+   struct AggregateWindow
+   {
+      uint32_t count;         // Number of most recent values covered
+      uint32_t placeholders;  // Number of placeholders within covered values
+      uint32_t updates;       // Number of incremental updates since last full recalculation
+      bool valid;
+      uint64_t isum;
+      double dsum;
+      double sumOfSquares;
+      SequenceQueue minQueue; // Sequence numbers of candidates for minimum (values are increasing)
+      SequenceQueue maxQueue; // Sequence numbers of candidates for maximum (values are decreasing)
+
+      AggregateWindow(uint32_t _count) : minQueue(_count), maxQueue(_count)
+      {
+         count = _count;
+         placeholders = 0;
+         updates = 0;
+         valid = false;
+         isum = 0;
+         dsum = 0;
+         sumOfSquares = 0;
+      }
+   };
+
+   Sample *m_samples;
+   uint32_t m_capacity;
+   uint32_t m_size;
+   uint32_t m_head;        // Position of most recent sample
+   int m_dataType;
+   TCHAR *m_lastString;    // Exact string representation of most recent value
+   size_t m_lastStringCapacity;
+   uint64_t m_sequence;    // Sequence number of most recent sample
+   ObjectArray<AggregateWindow> *m_windows;
+
+   const Sample& sample(uint32_t index) const { return m_samples[(m_head + index) % m_capacity]; }
+   Sample& sample(uint32_t index) { return m_samples[(m_head + index) % m_capacity]; }
+
+   bool isStringType() const { return (m_dataType == DCI_DT_STRING) || (m_dataType == DCI_DT_NULL); }
+   bool isUnsignedType() const { return (m_dataType == DCI_DT_UINT) || (m_dataType == DCI_DT_UINT64) || (m_dataType == DCI_DT_COUNTER32) || (m_dataType == DCI_DT_COUNTER64); }
+   void setSample(Sample *s, const ItemValue& value);
+   void setSample(Sample *s, const TCHAR *value, time_t timestamp);
+   void releaseSample(Sample *s);
+   void setLastString(const TCHAR *value);
+   void updateLastString();
+   void linearize(uint32_t capacity);
+   double sampleAsDouble(const Sample& s) const;
+   bool isLess(const Sample& a, const Sample& b) const;
+   const Sample& sampleBySequence(uint64_t seq) const { return sample(static_cast<uint32_t>(m_sequence - seq)); }
+   const AggregateWindow *getAggregateWindow(uint32_t count) const;
+   void recalculateAggregateWindow(AggregateWindow *w) const;
+   void addToAggregateWindow(AggregateWindow *w, const Sample& s, uint64_t seq) const;
+   void invalidateAggregateWindows();
+   uint32_t findExtremum(uint32_t count, bool maximum) const;
+
+public:
+   DCItemValueCache(int dataType = DCI_DT_STRING);
+   DCItemValueCache(const DCItemValueCache& src);
+   ~DCItemValueCache();
+
+   DCItemValueCache& operator=(const DCItemValueCache& src) = delete;
+
+   uint32_t size() const { return m_size; }
+   uint32_t capacity() const { return m_capacity; }
+   bool isEmpty() const { return m_size == 0; }
+
+   void setDataType(int dataType);
+   void resize(uint32_t capacity);
+   void clear();
+
+   void push(const ItemValue& value);
+   void append(const TCHAR *value, time_t timestamp);
+   void appendPlaceholders(uint32_t count);
+   bool remove(time_t timestamp);
+
+   time_t getTimeStamp(uint32_t index) const { return sample(index).timestamp; }
+   bool isPlaceholder(uint32_t index) const { return sample(index).timestamp == 1; } // Timestamp 1 means placeholder value inserted by cache loader
+   int32_t getInt32(uint32_t index) const { return static_cast<int32_t>(getInt64(index)); }
+   uint32_t getUInt32(uint32_t index) const { return static_cast<uint32_t>(getUInt64(index)); }
+   int64_t getInt64(uint32_t index) const;
+   uint64_t getUInt64(uint32_t index) const;
+   double getDouble(uint32_t index) const;
+   const TCHAR *getLastString() const { return (m_size > 0) ? m_lastString : nullptr; }
+   ItemValue get(uint32_t index) const;
+
+   template<typename T> T getAs(uint32_t index) const;
+   void setAggregateWindows(const IntegerArray<uint32_t>& counts);
+   template<typename T> T getSum(uint32_t count) const;
+   template<typename T> T getMin(uint32_t count) const { return (m_size > 0) ? getAs<T>(findExtremum(count, false)) : 0; }
+   template<typename T> T getMax(uint32_t count) const { return (m_size > 0) ? getAs<T>(findExtremum(count, true)) : 0; }
+   double getStandardDeviation(uint32_t count) const;
+   uint32_t getPlaceholderCount(uint32_t count) const;
+
+   uint64_t getMemoryUsage() const;
+};
+
+template<> inline int32_t DCItemValueCache::getAs<int32_t>(uint32_t index) const { return getInt32(index); }
+template<> inline uint32_t DCItemValueCache::getAs<uint32_t>(uint32_t index) const { return getUInt32(index); }
+template<> inline int64_t DCItemValueCache::getAs<int64_t>(uint32_t index) const { return getInt64(index); }
+template<> inline uint64_t DCItemValueCache::getAs<uint64_t>(uint32_t index) const { return getUInt64(index); }
+template<> inline double DCItemValueCache::getAs<double>(uint32_t index) const { return getDouble(index); }
+
+/**
+ * Get sum of given number of most recent values. Aggregate window is used if one is registered for given
+ * number of values and requested type matches value storage format.
+ */
+template<typename T> T DCItemValueCache::getSum(uint32_t count) const
+{
+   if (count == 0)
+      return 0;
+
+   const AggregateWindow *w = (std::is_floating_point<T>::value == (m_dataType == DCI_DT_FLOAT)) ? getAggregateWindow(count) : nullptr;
+   if (w != nullptr)
+      return std::is_floating_point<T>::value ? static_cast<T>(w->dsum) : static_cast<T>(w->isum);
+
+   T sum = 0;
+   uint32_t n = std::min(count, m_size);
+   for(uint32_t i = 0; i < n; i++)
+      sum += getAs<T>(i);
+   return sum;
+}
+
 class DCItem;
 class DataCollectionTarget;
 
@@ -170,10 +362,10 @@ class NXCORE_EXPORTABLE Threshold
 	TCHAR *m_lastEventMessage;
 
    const ItemValue& value() const { return m_value; }
-   void calculateAverage(ItemValue *result, const ItemValue &lastValue, ItemValue **ppPrevValues);
-   void calculateTotal(ItemValue *result, const ItemValue &lastValue, ItemValue **ppPrevValues);
-   void calculateAbsoluteDeviation(ItemValue *result, const ItemValue &lastValue, ItemValue **ppPrevValues);
-   void calculateMeanDeviation(ItemValue *result, const ItemValue &lastValue, ItemValue **ppPrevValues);
+   void calculateAverage(ItemValue *result, const ItemValue &lastValue, const DCItemValueCache& prevValues);
+   void calculateTotal(ItemValue *result, const ItemValue &lastValue, const DCItemValueCache& prevValues);
+   void calculateAbsoluteDeviation(ItemValue *result, const ItemValue &lastValue, const DCItemValueCache& prevValues);
+   void calculateMeanDeviation(ItemValue *result, const ItemValue &lastValue, const DCItemValueCache& prevValues);
    void setScript(TCHAR *script);
 
 public:
@@ -208,7 +400,7 @@ class NXCORE_EXPORTABLE Threshold
    void setLastCheckedValue(const ItemValue &value) { m_lastCheckValue = value; }
 
    bool saveToDB(DB_HANDLE hdb, uint32_t index);
-   ThresholdCheckResult check(ItemValue &value, ItemValue **ppPrevValues, ItemValue &fvalue, ItemValue &tvalue, shared_ptr<NetObj> target, DCItem *dci);
+   ThresholdCheckResult check(ItemValue &value, const DCItemValueCache& prevValues, ItemValue &fvalue, ItemValue &tvalue, shared_ptr<NetObj> target, DCItem *dci);
    ThresholdCheckResult checkError(uint32_t errorCount);
 
    void fillMessage(NXCPMessage *msg, uint32_t baseId) const;
@@ -217,6 +409,10 @@ class NXCORE_EXPORTABLE Threshold
 
    void createId();
    uint32_t getRequiredCacheSize() { return ((m_function == F_LAST) || (m_function == F_ERROR)) ? 0 : m_sampleCount; }
+   uint32_t getAggregateWindow() const
+   {
+      return (((m_function == F_AVERAGE) || (m_function == F_SUM) || (m_function == F_MEAN_DEVIATION) || (m_function == F_ABS_DEVIATION)) && (m_sampleCount > 1)) ? m_sampleCount - 1 : 0;
+   }
 
    bool equals(const Threshold& t) const;
 
@@ -315,6 +511,9 @@ class NXCORE_EXPORTABLE DCObject : public enable_shared_from_this<DCObject>, pub
 	TCHAR *m_pszPerfTabSettings;
    TCHAR *m_transformationScriptSource;   // Transformation script (source code)
    NXSL_Program *m_transformationScript;  // Compiled transformation script
+   uint32_t m_transformationScriptVersion;   // Incremented on each transformation script change
+   NXSL_VM *m_transformationVM;           // VM kept from previous transformation script run
+   uint64_t m_transformationVMVersion;    // Transformation script and script library versions for cached VM
    time_t m_lastScriptErrorReport;
    SharedString m_comments;
 	bool m_doForcePoll;                    // Force poll indicator
@@ -329,6 +528,7 @@ class NXCORE_EXPORTABLE DCObject : public enable_shared_from_this<DCObject>, pub
    int32_t m_instanceRetentionTime;      // Retention time if instance is not found
    time_t m_startTime;                 // Time to start data collection
    uint32_t m_relatedObject;
+   time_t m_scheduledCheckTime;        // Time of next check by data collection scheduler (protected by scheduler lock)
 
    void lock() const { m_mutex.lock(); }
    bool tryLock() const { return m_mutex.tryLock(); }
@@ -343,6 +543,8 @@ class NXCORE_EXPORTABLE DCObject : public enable_shared_from_this<DCObject>, pub
 	StringBuffer expandMacros(const TCHAR *src, size_t dstLen);
 
    void setTransformationScript(TCHAR *source);
+   ScriptVMHandle acquireTransformationVM(uint64_t *version);
+   void releaseTransformationVM(NXSL_VM *vm, uint64_t version);
 
 	virtual bool isCacheLoaded();
    virtual shared_ptr<DCObjectInfo> createDescriptorInternal() const;
@@ -423,6 +625,9 @@ class NXCORE_EXPORTABLE DCObject : public enable_shared_from_this<DCObject>, pub
 
 	bool matchClusterResource();
    bool isReadyForPolling(time_t currTime);
+   time_t getNextPollCheckTime(time_t currTime);
+   time_t getScheduledCheckTime() const { return m_scheduledCheckTime; }
+   void setScheduledCheckTime(time_t t) { m_scheduledCheckTime = t; }
 	bool isScheduledForDeletion() const { return m_scheduledForDeletion ? true : false; }
    void setLastPollTime(time_t lastPoll) { m_lastPoll = lastPoll; }
    void setStatus(int status, bool generateEvent, bool userChange = false);
@@ -495,9 +700,8 @@ class NXCORE_EXPORTABLE DCItem : public DCObject
    BYTE m_transformedDataType;   // Data type after transformation
 	int m_sampleCount;            // Number of samples required to calculate value
 	ObjectArray<Threshold> *m_thresholds;
-   uint32_t m_cacheSize;          // Number of items in cache
    uint32_t m_requiredCacheSize;
-   ItemValue **m_ppValueCache;
+   DCItemValueCache m_valueCache;
    ItemValue m_prevRawValue;     // Previous raw value (used for delta calculation)
    uint64_t m_prevDeltaValue;    // Previous delta value for counter types
    time_t m_prevValueTimeStamp;
@@ -513,6 +717,7 @@ class NXCORE_EXPORTABLE DCItem : public DCObject
    void checkThresholds(ItemValue &value);
    void updateCacheSizeInternal(bool allowLoad);
    void clearCache();
+   void getCachedValues(ObjectArray<ItemValue> *values, int count) const;
 
    bool hasScriptThresholds() const;
    Threshold *getThresholdById(uint32_t id) const;
@@ -994,6 +1199,8 @@ static inline uint32_t RCCFromDCIError(DataCollectionError error)
  * Functions
  */
 void InitDataCollector();
+void ScheduleDataCollection(const shared_ptr<DCObject>& dcObject, time_t checkTime);
+void CancelScheduledDataCollection(DCObject *dcObject);
 void WriteFullParamListToMessage(NXCPMessage *msg, int origin, uint16_t flags);
 int GetDCObjectType(uint32_t nodeId, uint32_t dciId);
 
@@ -1001,11 +1208,14 @@ bool ParseModbusMetric(const TCHAR *metric, uint16_t *unitId, const TCHAR **sour
 
 void CalculateItemValueDiff(ItemValue *result, int dataType, const ItemValue &value1, const ItemValue &value2);
 void CalculateItemValueAverage(ItemValue *result, int dataType, const ItemValue * const *valueList, size_t sampleCount);
+void CalculateItemValueAverage(ItemValue *result, int dataType, const DCItemValueCache& cache, uint32_t sampleCount);
 void CalculateItemValueMeanDeviation(ItemValue *result, int dataType, const ItemValue * const *valueList, size_t sampleCount);
 void CalculateItemValueTotal(ItemValue *result, int dataType, const ItemValue *const *valueList, size_t sampleCount);
 void CalculateItemValueMin(ItemValue *result, int dataType, const ItemValue *const *valueList, size_t sampleCount);
 void CalculateItemValueMax(ItemValue *result, int dataType, const ItemValue *const *valueList, size_t sampleCount);
 
+uint64_t GetDCIStringStoreMemoryUsage();
+
 unique_ptr<StructArray<ScoredDciValue>> DetectAnomalies(const DataCollectionTarget& dcTarget, uint32_t dciId, time_t timeFrom, time_t timeTo, double threshold = 0.75);
 bool IsAnomalousValue(const DataCollectionTarget& dcTarget, const DCObject& dci, double value, double threshold, int period, int depth, int width);
 
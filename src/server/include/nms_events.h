@@ -121,6 +121,20 @@ struct EventProcessingThreadStats
    uint32_t bindings;
 };
 
+/**
+ * Event log writer statistics
+ */
+struct EventLogWriterStats
+{
+   uint64_t loggedEvents;
+   uint64_t transactions;
+   uint64_t failedEvents;
+   uint32_t averageWaitTime;
+   uint32_t maxWaitTime;
+   uint32_t queueSize;
+   int writers;
+};
+
 class EventBuilder;
 
 #ifdef _WIN32
@@ -606,6 +620,8 @@ class TimeFrame
    uint64_t getDateFilter() const { return m_dateFilter; }
 };
 
+struct EPRuleMatchContext;
+
 /**
  * Event policy rule
  */
@@ -643,7 +659,10 @@ class EPRule
    StringMap m_customAttributeSetActions;
    StringList m_customAttributeDeleteActions;
 
-   bool matchSource(const shared_ptr<NetObj>& object) const;
+   mutable VolatileCounter64 m_matchCount;   // Number of events matched by this rule
+   mutable VolatileCounter64 m_skipCount;    // Number of events checked but not matched by this rule
+
+   bool matchSource(EPRuleMatchContext *context) const;
    bool matchEvent(uint32_t eventCode) const;
    bool matchSeverity(uint32_t severity) const;
    bool matchScript(Event *event) const;
@@ -664,7 +683,7 @@ class EPRule
    void setId(uint32_t newId) { m_id = newId; }
    bool loadFromDB(DB_HANDLE hdb);
 	bool saveToDB(DB_HANDLE hdb) const;
-   bool processEvent(Event *event) const;
+   bool processEvent(Event *event, EPRuleMatchContext *context) const;
    void createMessage(NXCPMessage *msg) const;
    void createExportRecord(TextFileWriter& xml) const;
    void createOrderingExportRecord(TextFileWriter& xml) const;
@@ -676,6 +695,11 @@ class EPRule
 
    bool isUsingEvent(uint32_t eventCode) const { return m_events.contains(eventCode); }
    const TCHAR *getComments() const { return m_comments; }
+   uint32_t getFlags() const { return m_flags; }
+   const IntegerArray<uint32_t>& getEvents() const { return m_events; }
+
+   uint64_t getMatchCount() const { return m_matchCount; }
+   uint64_t getSkipCount() const { return m_skipCount; }
 };
 
 /**
@@ -778,15 +802,18 @@ class EventPolicy
 {
 private:
    ObjectArray<EPRule> m_rules;
+   HashMap<uint32_t, IntegerArray<int32_t>> m_eventIndex;  // Rule positions by event code
+   IntegerArray<int32_t> m_wildcardRules;                  // Positions of rules that can match any event code
    RWLock m_rwlock;
 
    void readLock() const { m_rwlock.readLock(); }
    void writeLock() { m_rwlock.writeLock(); }
    void unlock() const { m_rwlock.unlock(); }
    int findRuleIndexByGuid(const uuid& guid, int shift = 0) const;
+   void buildIndex();
 
 public:
-   EventPolicy() : m_rules(128, 128, Ownership::True) { }
+   EventPolicy() : m_rules(128, 128, Ownership::True), m_eventIndex(Ownership::True), m_wildcardRules(0, 64) { }
 
    uint32_t getNumRules() const { return m_rules.size(); }
    bool loadFromDB();
@@ -804,6 +831,7 @@ class EventPolicy
    bool isCategoryInUse(uint32_t categoryId) const;
 
    void getEventReferences(uint32_t eventCode, ObjectArray<EventReference>* eventReferences) const;
+   void showStatistics(ServerConsole *console) const;
 };
 
 /**
@@ -821,6 +849,7 @@ void CorrelateEvent(Event *event);
 Event *LoadEventFromDatabase(uint64_t eventId);
 Event *FindEventInLoggerQueue(uint64_t eventId);
 StructArray<EventProcessingThreadStats> *GetEventProcessingThreadStats();
+void GetEventLogWriterStatistics(EventLogWriterStats *stats);
 
 bool EventNameFromCode(uint32_t eventCode, TCHAR *buffer);
 uint32_t NXCORE_EXPORTABLE EventCodeFromName(const TCHAR *name, uint32_t defaultValue = 0);
@@ -1829,10 +1829,28 @@ class NXCORE_EXPORTABLE IcmpStatCollector
    static IcmpStatCollector *loadFromDatabase(DB_HANDLE hdb, uint32_t objectId, const TCHAR *target, int period);
 };
 
+/**
+ * Entry in DC object name or template item ID index. Refers to first object with given key in owner's DC object list.
+ */
+struct DCObjectIndexEntry
+{
+   DCObject *object;
+   int count;
+
+   DCObjectIndexEntry(DCObject *_object)
+   {
+      object = _object;
+      count = 1;
+   }
+};
+
 #ifdef _WIN32
 template class NXCORE_TEMPLATE_EXPORTABLE shared_ptr<DCObject>;
 template class NXCORE_TEMPLATE_EXPORTABLE ObjectMemoryPool<shared_ptr<DCObject>>;
 template class NXCORE_TEMPLATE_EXPORTABLE SharedObjectArray<DCObject>;
+template class NXCORE_TEMPLATE_EXPORTABLE HashMap<uint32_t, DCObject>;
+template class NXCORE_TEMPLATE_EXPORTABLE HashMap<uint32_t, DCObjectIndexEntry>;
+template class NXCORE_TEMPLATE_EXPORTABLE StringObjectMap<DCObjectIndexEntry>;
 #endif
 
 /**
@@ -1843,6 +1861,17 @@ class NXCORE_EXPORTABLE DataCollectionOwner : public NetObj
 private:
    typedef NetObj super;
 
+   HashMap<uint32_t, DCObject> m_dcObjectIdIndex;
+   HashMap<uint32_t, DCObjectIndexEntry> m_dcObjectTemplateItemIndex;
+   StringObjectMap<DCObjectIndexEntry> m_dcObjectNameIndex;
+
+   DCObject *findFirstDCObjectByName(const TCHAR *name, const DCObject *exclude) const;
+   DCObject *findFirstDCObjectByTemplateItemId(uint32_t templateItemId, const DCObject *exclude) const;
+   void addToNameIndex(DCObject *object, bool appended);
+   void removeFromNameIndex(const TCHAR *name, const DCObject *object);
+   void addToTemplateItemIndex(DCObject *object, bool appended);
+   void removeFromTemplateItemIndex(uint32_t templateItemId, const DCObject *object);
+
 protected:
    SharedObjectArray<DCObject> m_dcObjects;
    RWLock m_dciAccessLock;
@@ -1869,6 +1898,12 @@ class NXCORE_EXPORTABLE DataCollectionOwner : public NetObj
    void deleteChildDCIs(uint32_t dcObjectId);
    void deleteDCObject(DCObject *object);
 
+   void addDCObjectToList(const shared_ptr<DCObject>& object);
+   void removeDCObjectFromList(int index);
+   void updateDCObjectIndex(DCObject *object, const TCHAR *oldName, uint32_t oldTemplateItemId);
+   DCObject *findDCObjectById(uint32_t id) const { return m_dcObjectIdIndex.get(id); }
+   DCObject *findDCObjectByTemplateItem(uint32_t templateId, uint32_t templateItemId) const;
+
 public:
    DataCollectionOwner();
    DataCollectionOwner(const TCHAR *name, const uuid& guid = uuid::NULL_UUID);
@@ -2605,6 +2640,8 @@ class NXCORE_EXPORTABLE DataCollectionTarget : public DataCollectionOwner, publi
    virtual bool isDataCollectionTarget() const override;
    virtual bool isEventSource() const override;
 
+   virtual bool setMgmtStatus(bool isManaged) override;
+
    virtual void enterMaintenanceMode(uint32_t userId, const TCHAR *comments) override;
    virtual void leaveMaintenanceMode(uint32_t userId) override;
 
@@ -2651,7 +2688,9 @@ class NXCORE_EXPORTABLE DataCollectionTarget : public DataCollectionOwner, publi
    void reloadDCItemCache(uint32_t dciId);
    void cleanDCIData(DB_HANDLE hdb);
    void calculateDciCutoffTimes(time_t *cutoffTimeIData, time_t *cutoffTimeTData);
-   void queueItemsForPolling();
+   bool isDataCollectionActive() { return (m_status != STATUS_UNMANAGED) && !isDataCollectionDisabled() && !m_isDeleted; }
+   bool queueItemForPolling(const shared_ptr<DCObject>& object, time_t currTime, HashMap<uint64_t, SharedObjectArray<DCObject>> *batches = nullptr);
+   void scheduleItemsForPolling(time_t checkTime);
    bool processNewDCValue(const shared_ptr<DCObject>& dco, time_t currTime, const TCHAR *itemValue, const shared_ptr<Table>& tableValue);
    void scheduleItemDataCleanup(uint32_t dciId);
    void scheduleTableDataCleanup(uint32_t dciId);
@@ -3485,6 +3524,8 @@ class NXCORE_EXPORTABLE Node : public DataCollectionTarget
    int64_t m_snmpTrapLastTotal;
    time_t m_snmpTrapStormLastCheckTime;
    uint32_t m_snmpTrapStormActualDuration;
+   std::atomic<int> m_snmpMaxVarbinds;  // Learned limit for number of variables in single SNMP request (0 if not known yet, doubled on each configuration poll)
+   int m_snmpBulkMaxRepetitions;  // Learned max-repetitions for GETBULK requests (0 if GETBULK is not supported, -1 if not known yet)
    SharedString m_sshLogin;
    SharedString m_sshPassword;
    uint32_t m_sshKeyId;
@@ -3857,10 +3898,13 @@ class NXCORE_EXPORTABLE Node : public DataCollectionTarget
    virtual DataCollectionError getInternalTable(const TCHAR *name, shared_ptr<Table> *result) override;
 
    DataCollectionError getMetricFromSNMP(uint16_t port, SNMP_Version version, const TCHAR *metric, TCHAR *buffer, size_t size, int interpretRawValue);
+   void getMetricsFromSNMP(uint16_t port, SNMP_Version version, const StringList& names, const int *interpretRawValue,
+            std::function<void (StringList*, DataCollectionError*)> callback);
    DataCollectionError getTableFromSNMP(uint16_t port, SNMP_Version version, const TCHAR *oid, const ObjectArray<DCTableColumn> &columns, shared_ptr<Table> *table);
    DataCollectionError getListFromSNMP(uint16_t port, SNMP_Version version, const TCHAR *oid, StringList **list);
    DataCollectionError getOIDSuffixListFromSNMP(uint16_t port, SNMP_Version version, const TCHAR *oid, StringMap **values);
    DataCollectionError getMetricFromAgent(const TCHAR *metric, TCHAR *buffer, size_t size);
+   void getMetricsFromAgent(const StringList& names, StringList *values, DataCollectionError *errors);
    DataCollectionError getTableFromAgent(const TCHAR *metric, shared_ptr<Table> *table);
    DataCollectionError getListFromAgent(const TCHAR *metric, StringList **list);
    DataCollectionError getMetricFromSMCLP(const TCHAR *metric, TCHAR *buffer, size_t size);
@@ -54,8 +54,6 @@ class NXSL_DCTargetClass : public NXSL_NetObjClass
 {
 public:
    NXSL_DCTargetClass();
-
-   virtual NXSL_Value *getAttr(NXSL_Object *object, const NXSL_Identifier& attr) override;
 };
 
 /**
@@ -65,8 +63,6 @@ class NXSL_NodeClass : public NXSL_DCTargetClass
 {
 public:
    NXSL_NodeClass();
-
-   virtual NXSL_Value *getAttr(NXSL_Object *object, const NXSL_Identifier& attr) override;
 };
 
 /**
@@ -87,8 +83,6 @@ class NXSL_InterfaceClass : public NXSL_NetObjClass
 {
 public:
    NXSL_InterfaceClass();
-
-   virtual NXSL_Value *getAttr(NXSL_Object *object, const NXSL_Identifier& attr) override;
 };
 
 /**
@@ -336,7 +330,6 @@ class NXSL_DciClass : public NXSL_Class
 public:
    NXSL_DciClass();
 
-   virtual NXSL_Value *getAttr(NXSL_Object *object, const NXSL_Identifier& attr) override;
    virtual void onObjectDelete(NXSL_Object *object) override;
 };
 
@@ -657,6 +657,7 @@ class LIBNXSRV_EXPORTABLE NObject : public enable_shared_from_this<NObject>
    bool isDirectChild(uint32_t id) const;
    bool isParent(uint32_t id) const;
    bool isDirectParent(uint32_t id) const;
+   void collectAncestors(HashSet<uint32_t> *ancestors) const;
 
    int getChildCount() const { return m_childList.size(); }
    int getParentCount() const { return m_parentList.size(); }
@@ -1042,11 +1043,13 @@ class LIBNXSRV_EXPORTABLE AgentConnection : public enable_shared_from_this<Agent
 	bool m_fileUploadInProgress;
 	bool m_fileUpdateConnection;
 	bool m_allowCompression;
+	bool m_multipleParametersSupported;
 	VolatileCounter m_bulkDataProcessing;
 
    uint32_t setupEncryption(RSA_KEY serverKey);
    uint32_t authenticate(BOOL bProxyData);
    uint32_t setupProxyConnection();
+   uint32_t getMultipleParametersBlock(const StringList& names, int start, int count, StringList *values, uint32_t *rcc);
    uint32_t prepareFileDownload(const TCHAR *fileName, uint32_t rqId, bool append, std::function<void (size_t)> downloadProgressCallback, std::function<void (NXCPMessage*)> fileResendCallback);
    void processFileData(NXCPMessage *msg);
    void processFileTransferAbort(NXCPMessage *msg);
@@ -1126,6 +1129,7 @@ class LIBNXSRV_EXPORTABLE AgentConnection : public enable_shared_from_this<Agent
    InterfaceList *getInterfaceList();
    RoutingTable *getRoutingTable();
    uint32_t getParameter(const TCHAR *param, TCHAR *buffer, size_t size);
+   uint32_t getMultipleParameters(const StringList& names, StringList *values, uint32_t *rcc);
    uint32_t getList(const TCHAR *param, StringList **list);
    uint32_t getTable(const TCHAR *param, Table **table);
    uint32_t queryWebService(WebServiceRequestType requestType, const TCHAR *url, HttpRequestMethod httpRequestMethod, const TCHAR *requestData,
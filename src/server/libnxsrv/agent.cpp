@@ -77,6 +77,14 @@ void LIBNXSRV_EXPORTABLE DisableAgentConnections()
    s_pollerListLock.unlock();
 }
 
+/**
+ * Create integer key for serialized execution in thread pool from key type and object address or ID
+ */
+static inline uint64_t CreateThreadPoolKey(char type, uint64_t id)
+{
+   return (static_cast<uint64_t>(type) << 56) | (id & _ULL(0x00FFFFFFFFFFFFFF));
+}
+
 /**
  * Agent connection receiver
  */
@@ -87,7 +95,7 @@ class AgentConnectionReceiver : public enable_shared_from_this<AgentConnectionRe
    uint32_t m_debugId;
    uint32_t m_recvTimeout;
    shared_ptr<AbstractCommChannel> m_channel;
-   TCHAR m_threadPoolKey[16];
+   uint64_t m_threadPoolKey;
    bool m_attached;
 
    void debugPrintf(int level, const TCHAR *format, ...);
@@ -107,7 +115,7 @@ class AgentConnectionReceiver : public enable_shared_from_this<AgentConnectionRe
       m_debugId = connection->m_debugId;
       m_messageReceiver = new CommChannelMessageReceiver(m_channel, 4096, MAX_MSG_SIZE);
       m_recvTimeout = connection->m_recvTimeout;
-      _sntprintf(m_threadPoolKey, 16, _T("RECV-%u"), m_debugId);
+      m_threadPoolKey = CreateThreadPoolKey('R', m_debugId);
       m_attached = true;
    }
 
@@ -183,12 +191,9 @@ bool AgentConnectionReceiver::readChannel()
 /**
  * Create key for callback processing in thread pool
  */
-static inline void CreateCallbackKey(TCHAR prefix, AgentConnectionReceiver *receiver, TCHAR *key)
+static inline uint64_t CreateCallbackKey(char prefix, AgentConnectionReceiver *receiver)
 {
-   key[0] = 'C';
-   key[1] = prefix;
-   key[2] = '-';
-   IntegerToString(CAST_FROM_POINTER(receiver, uint64_t), &key[3]);
+   return CreateThreadPoolKey(prefix, CAST_FROM_POINTER(receiver, uint64_t));
 }
 
 /**
@@ -255,8 +260,7 @@ MessageReceiverResult AgentConnectionReceiver::readMessage(bool allowChannelRead
       {
          if (g_agentConnectionThreadPool != nullptr)
          {
-            TCHAR key[64];
-            _sntprintf(key, 64, _T("FileTransfer_%p"), this);
+            uint64_t key = CreateThreadPoolKey('D', CAST_FROM_POINTER(this, uint64_t));
             ThreadPoolExecuteSerialized(g_agentConnectionThreadPool, key, connection, &AgentConnection::processFileData, msg);
          }
          else
@@ -269,8 +273,7 @@ MessageReceiverResult AgentConnectionReceiver::readMessage(bool allowChannelRead
       {
          if (g_agentConnectionThreadPool != nullptr)
          {
-            TCHAR key[64];
-            _sntprintf(key, 64, _T("FileTransfer_%p"), this);
+            uint64_t key = CreateThreadPoolKey('D', CAST_FROM_POINTER(this, uint64_t));
             ThreadPoolExecuteSerialized(g_agentConnectionThreadPool, key, connection, &AgentConnection::processFileTransferAbort, msg);
          }
          else
@@ -312,8 +315,7 @@ MessageReceiverResult AgentConnectionReceiver::readMessage(bool allowChannelRead
          case CMD_TRAP:
             if (g_agentConnectionThreadPool != nullptr)
             {
-               TCHAR key[64];
-               CreateCallbackKey('E', this, key);
+               uint64_t key = CreateCallbackKey('E', this);
                ThreadPoolExecuteSerialized(g_agentConnectionThreadPool, key, connection, &AgentConnection::onTrapCallback, msg);
             }
             else
@@ -324,8 +326,7 @@ MessageReceiverResult AgentConnectionReceiver::readMessage(bool allowChannelRead
          case CMD_SYSLOG_RECORDS:
             if (g_agentConnectionThreadPool != nullptr)
             {
-               TCHAR key[64];
-               CreateCallbackKey('Y', this, key);
+               uint64_t key = CreateCallbackKey('Y', this);
                ThreadPoolExecuteSerialized(g_agentConnectionThreadPool, key, connection, &AgentConnection::onSyslogMessageCallback, msg);
             }
             else
@@ -336,8 +337,7 @@ MessageReceiverResult AgentConnectionReceiver::readMessage(bool allowChannelRead
          case CMD_WINDOWS_EVENT:
             if (g_agentConnectionThreadPool != nullptr)
             {
-               TCHAR key[64];
-               CreateCallbackKey('W', this, key);
+               uint64_t key = CreateCallbackKey('W', this);
                ThreadPoolExecuteSerialized(g_agentConnectionThreadPool, key, connection, &AgentConnection::onWindowsEventCallback, msg);
             }
             else
@@ -358,7 +358,16 @@ MessageReceiverResult AgentConnectionReceiver::readMessage(bool allowChannelRead
          case CMD_DCI_DATA:
             if (g_agentConnectionThreadPool != nullptr)
             {
-               ThreadPoolExecute(g_agentConnectionThreadPool, connection, &AgentConnection::processCollectedDataCallback, msg);
+               if (msg->getFieldAsBoolean(VID_BULK_DATA_PUSH))
+               {
+                  // Batches pushed by agent should be processed in order they were sent
+                  uint64_t key = CreateCallbackKey('D', this);
+                  ThreadPoolExecuteSerialized(g_agentConnectionThreadPool, key, connection, &AgentConnection::processCollectedDataCallback, msg);
+               }
+               else
+               {
+                  ThreadPoolExecute(g_agentConnectionThreadPool, connection, &AgentConnection::processCollectedDataCallback, msg);
+               }
             }
             else
             {
@@ -384,8 +393,7 @@ MessageReceiverResult AgentConnectionReceiver::readMessage(bool allowChannelRead
          case CMD_FILE_MONITORING:
             if (g_agentConnectionThreadPool != nullptr)
             {
-               TCHAR key[64];
-               CreateCallbackKey('F', this, key);
+               uint64_t key = CreateCallbackKey('F', this);
                ThreadPoolExecuteSerialized(g_agentConnectionThreadPool, key, connection, &AgentConnection::onFileMonitoringDataCallback, msg);
             }
             else
@@ -396,8 +404,7 @@ MessageReceiverResult AgentConnectionReceiver::readMessage(bool allowChannelRead
          case CMD_SNMP_TRAP:
             if (g_agentConnectionThreadPool != nullptr)
             {
-               TCHAR key[64];
-               CreateCallbackKey('T', this, key);
+               uint64_t key = CreateCallbackKey('T', this);
                ThreadPoolExecuteSerialized(g_agentConnectionThreadPool, key, connection, &AgentConnection::onSnmpTrapCallback, msg);
             }
             else
@@ -412,8 +419,7 @@ MessageReceiverResult AgentConnectionReceiver::readMessage(bool allowChannelRead
          case CMD_NOTIFY:
             if (g_agentConnectionThreadPool != nullptr)
             {
-               TCHAR key[64];
-               CreateCallbackKey('N', this, key);
+               uint64_t key = CreateCallbackKey('N', this);
                ThreadPoolExecuteSerialized(g_agentConnectionThreadPool, key, connection, &AgentConnection::onNotifyCallback, msg);
             }
             else
@@ -520,6 +526,7 @@ AgentConnection::AgentConnection(const InetAddress& addr, uint16_t port, const T
    m_fileDownloadSucceeded = false;
 	m_fileUploadInProgress = false;
    m_fileUpdateConnection = false;
+   m_multipleParametersSupported = true;
    m_downloadRequestId = 0;
    m_downloadActivityTimestamp = 0;
    m_bulkDataProcessing = 0;
@@ -1135,6 +1142,117 @@ uint32_t AgentConnection::getParameter(const TCHAR *param, TCHAR *buffer, size_t
    return rcc;
 }
 
+/**
+ * Number of metrics in multiple metrics request covered by single command timeout
+ */
+#define METRICS_PER_COMMAND_TIMEOUT   32
+
+/**
+ * Get values of given range of parameters with single request. Request timeout is scaled with number of parameters.
+ */
+uint32_t AgentConnection::getMultipleParametersBlock(const StringList& names, int start, int count, StringList *values, uint32_t *rcc)
+{
+   uint32_t requestId = generateRequestId();
+   NXCPMessage msg(CMD_GET_MULTIPLE_PARAMETERS, requestId, m_nProtocolVersion);
+   msg.setField(VID_NUM_PARAMETERS, static_cast<uint32_t>(count));
+   uint32_t fieldId = VID_PARAM_LIST_BASE;
+   for(int i = 0; i < count; i++)
+      msg.setField(fieldId++, names.get(start + i));
+   if (!sendMessage(&msg))
+      return ERR_CONNECTION_BROKEN;
+
+   uint32_t timeout = m_commandTimeout * (1 + (count - 1) / METRICS_PER_COMMAND_TIMEOUT);
+   NXCPMessage *response = waitForMessage(CMD_REQUEST_COMPLETED, requestId, timeout);
+   if (response == nullptr)
+      return ERR_REQUEST_TIMEOUT;
+
+   uint32_t result = response->getFieldAsUInt32(VID_RCC);
+   if (result == ERR_SUCCESS)
+   {
+      if (response->getFieldAsInt32(VID_NUM_PARAMETERS) == count)
+      {
+         fieldId = VID_PARAM_LIST_BASE;
+         for(int i = 0; i < count; i++, fieldId += 2)
+         {
+            rcc[i] = response->getFieldAsUInt32(fieldId);
+            if (rcc[i] == ERR_SUCCESS)
+            {
+               TCHAR buffer[MAX_RESULT_LENGTH];
+               values->add(response->getFieldAsString(fieldId + 1, buffer, MAX_RESULT_LENGTH));
+            }
+            else
+            {
+               values->add(_T(""));
+            }
+         }
+      }
+      else
+      {
+         result = ERR_MALFORMED_RESPONSE;
+         debugPrintf(3, _T("Malformed response to CMD_GET_MULTIPLE_PARAMETERS"));
+      }
+   }
+   delete response;
+   return result;
+}
+
+/**
+ * Get values of multiple parameters with single request. Values for failed parameters are
+ * set to empty strings and individual error codes are stored in "rcc" array (should be at
+ * least names.size() elements). Large sets are split into several requests, and if some of
+ * them time out, only parameters from those requests get ERR_REQUEST_TIMEOUT error code.
+ * Falls back to individual requests if agent does not support multiple parameters request.
+ */
+uint32_t AgentConnection::getMultipleParameters(const StringList& names, StringList *values, uint32_t *rcc)
+{
+   if (!m_isConnected)
+      return ERR_NOT_CONNECTED;
+
+   if (!m_multipleParametersSupported)
+   {
+      for(int i = 0; i < names.size(); i++)
+      {
+         TCHAR buffer[MAX_RESULT_LENGTH];
+         rcc[i] = getParameter(names.get(i), buffer, MAX_RESULT_LENGTH);
+         if ((rcc[i] == ERR_NOT_CONNECTED) || (rcc[i] == ERR_CONNECTION_BROKEN) || (rcc[i] == ERR_REQUEST_TIMEOUT))
+            return rcc[i];
+         values->add((rcc[i] == ERR_SUCCESS) ? buffer : _T(""));
+      }
+      return ERR_SUCCESS;
+   }
+
+   bool received = (names.size() == 0);
+   for(int start = 0; start < names.size(); start += MAX_MULTIPLE_METRICS)
+   {
+      int count = std::min(names.size() - start, MAX_MULTIPLE_METRICS);
+      uint32_t result = getMultipleParametersBlock(names, start, count, values, &rcc[start]);
+      if (result == ERR_SUCCESS)
+      {
+         received = true;
+      }
+      else if (result == ERR_REQUEST_TIMEOUT)
+      {
+         debugPrintf(4, _T("Request timeout for metrics %d..%d in multiple metrics request"), start, start + count - 1);
+         for(int i = start; i < start + count; i++)
+         {
+            rcc[i] = ERR_REQUEST_TIMEOUT;
+            values->add(_T(""));
+         }
+      }
+      else if ((result == ERR_UNKNOWN_COMMAND) && (start == 0))
+      {
+         debugPrintf(4, _T("Agent does not support multiple parameters request, falling back to individual requests"));
+         m_multipleParametersSupported = false;
+         return getMultipleParameters(names, values, rcc);
+      }
+      else
+      {
+         return result;
+      }
+   }
+   return received ? ERR_SUCCESS : ERR_REQUEST_TIMEOUT;
+}
+
 /**
  * Query web service. Request type determines if parameter or list mode will be used.
  * Only first element of "pathList" will be used for list request.
@@ -1312,6 +1430,7 @@ uint32_t AgentConnection::setServerCapabilities()
    msg.setField(VID_ENABLED, true);   // Enables IPv6 on pre-2.0 agents
    msg.setField(VID_IPV6_SUPPORT, true);
    msg.setField(VID_BULK_RECONCILIATION, true);
+   msg.setField(VID_BULK_DATA_PUSH, true);
    msg.setField(VID_ENABLE_COMPRESSION, m_allowCompression);
    msg.setField(VID_ACCEPT_KEEPALIVE, true);
    msg.setId(requestId);
@@ -1433,8 +1552,7 @@ void AgentConnection::postMessageCallback(NXCPMessage *msg)
  */
 void AgentConnection::postMessage(NXCPMessage *msg)
 {
-   TCHAR key[64];
-   _sntprintf(key, 64, _T("PostMessage_%p"), this);
+   uint64_t key = CreateThreadPoolKey('P', CAST_FROM_POINTER(this, uint64_t));
    ThreadPoolExecuteSerialized(g_agentConnectionThreadPool, key, shared_from_this(), &AgentConnection::postMessageCallback, msg);
 }
 
@@ -1491,8 +1609,7 @@ void AgentConnection::postRawMessageCallback(NXCP_MESSAGE *msg)
  */
 void AgentConnection::postRawMessage(NXCP_MESSAGE *msg)
 {
-   TCHAR key[64];
-   _sntprintf(key, 64, _T("PostMessage_%p"), this);
+   uint64_t key = CreateThreadPoolKey('P', CAST_FROM_POINTER(this, uint64_t));
    ThreadPoolExecuteSerialized(g_agentConnectionThreadPool, key, shared_from_this(), &AgentConnection::postRawMessageCallback, msg);
 }
 
@@ -2999,7 +3116,12 @@ void AgentConnection::processCollectedDataCallback(NXCPMessage *msg)
 {
    NXCPMessage response(CMD_REQUEST_COMPLETED, msg->getId(), m_nProtocolVersion);
 
-   if (msg->getFieldAsBoolean(VID_BULK_RECONCILIATION))
+   if (msg->getFieldAsBoolean(VID_BULK_DATA_PUSH))
+   {
+      // Pushed batches are already serialized per connection and can be processed concurrently with reconciliation
+      response.setField(VID_RCC, processBulkCollectedData(msg, &response));
+   }
+   else if (msg->getFieldAsBoolean(VID_BULK_RECONCILIATION))
    {
       // Check that only one bulk data processor is running
       if (InterlockedIncrement(&m_bulkDataProcessing) == 1)
@@ -221,6 +221,26 @@ bool NObject::isParent(uint32_t id) const
    return result;
 }
 
+/**
+ * Collect IDs of all parents (direct and indirect) of this object
+ *
+ * @param ancestors set to add parent IDs to
+ */
+void NObject::collectAncestors(HashSet<uint32_t> *ancestors) const
+{
+   readLockParentList();
+   for(int i = 0; i < m_parentList.size(); i++)
+   {
+      NObject *parent = m_parentList.get(i);
+      if (!ancestors->contains(parent->getId()))
+      {
+         ancestors->put(parent->getId());
+         parent->collectAncestors(ancestors);
+      }
+   }
+   unlockParentList();
+}
+
 /**
  * Check if given object is our direct parent
  *
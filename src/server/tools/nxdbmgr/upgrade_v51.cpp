@@ -23,6 +23,113 @@
 #include "nxdbmgr.h"
 #include <nxevent.h>
 
+/**
+ * Upgrade from 51.26 to 51.27
+ */
+static bool H_UpgradeFromV26()
+{
+   CHK_EXEC(CreateConfigParam(_T("Syslog.ProcessingThreads"),
+                              _T("1"),
+                              _T("Number of syslog processing threads. Messages from same source are always processed by same thread."),
+                              _T("threads"), 'I', true, true, false, false));
+   CHK_EXEC(CreateConfigParam(_T("Syslog.ReceiverThreads"),
+                              _T("1"),
+                              _T("Number of syslog receiver threads (each thread uses own socket bound to syslog port)."),
+                              _T("threads"), 'I', true, true, false, false));
+   CHK_EXEC(SetMinorSchemaVersion(27));
+   return true;
+}
+
+/**
+ * Upgrade from 51.25 to 51.26
+ */
+static bool H_UpgradeFromV25()
+{
+   CHK_EXEC(CreateConfigParam(_T("DataCollection.AnomalyDetection.ModelRefreshInterval"),
+                              _T("900"),
+                              _T("Interval between retraining of cached anomaly detection models. New values are scored against cached model."),
+                              _T("seconds"), 'I', true, false, false, false));
+   CHK_EXEC(SetMinorSchemaVersion(26));
+   return true;
+}
+
+/**
+ * Upgrade from 51.24 to 51.25
+ */
+static bool H_UpgradeFromV24()
+{
+   CHK_EXEC(CreateConfigParam(_T("Events.LogWriter.MaxBatchAge"),
+                              _T("500"),
+                              _T("Maximum time event log writer waits for more events before writing collected batch to database."),
+                              _T("milliseconds"), 'I', true, true, false, false));
+   CHK_EXEC(CreateConfigParam(_T("Events.LogWriter.MaxRecordsPerStatement"),
+                              _T("100"),
+                              _T("Maximum number of records per one SQL statement (multi-row INSERT or array bind) written by event log writer."),
+                              _T("records/statement"), 'I', true, true, false, false));
+   CHK_EXEC(CreateConfigParam(_T("Events.LogWriter.MaxRecordsPerTransaction"),
+                              _T("500"),
+                              _T("Maximum number of records per one transaction written by event log writer."),
+                              _T("records/transaction"), 'I', true, true, false, false));
+   CHK_EXEC(CreateConfigParam(_T("Events.LogWriter.Threads"),
+                              _T("1"),
+                              _T("Number of event log writer threads."),
+                              _T("threads"), 'I', true, true, false, false));
+   CHK_EXEC(SetMinorSchemaVersion(25));
+   return true;
+}
+
+/**
+ * Upgrade from 51.23 to 51.24
+ */
+static bool H_UpgradeFromV23()
+{
+   CHK_EXEC(CreateConfigParam(_T("SNMP.RequestEngine.Sockets"),
+                              _T("4"),
+                              _T("Number of shared UDP sockets used by server for sending SNMP requests and receiving responses. Setting this to 0 disables shared sockets and each SNMP transport will use its own socket."),
+                              nullptr, 'I', true, true, false, false));
+   CHK_EXEC(SetMinorSchemaVersion(24));
+   return true;
+}
+
+/**
+ * Upgrade from 51.22 to 51.23
+ */
+static bool H_UpgradeFromV22()
+{
+   CHK_EXEC(CreateConfigParam(_T("SNMP.Walk.BulkMaxRepetitions"),
+                              _T("25"),
+                              _T("Maximum number of repetitions in GETBULK requests used for walking SNMP tables on SNMPv2c and SNMPv3 devices. Value is reduced automatically for devices that cannot handle it. Setting this to 0 disables use of GETBULK requests."),
+                              nullptr, 'I', true, false, false, false));
+   CHK_EXEC(SetMinorSchemaVersion(23));
+   return true;
+}
+
+/**
+ * Upgrade from 51.21 to 51.22
+ */
+static bool H_UpgradeFromV21()
+{
+   CHK_EXEC(CreateConfigParam(_T("SNMP.Collection.MaxVarbinds"),
+                              _T("32"),
+                              _T("Maximum number of variables in single SNMP GET request used for collecting SNMP DCIs which are due at the same time on same node. Setting this to 1 disables request coalescing."),
+                              nullptr, 'I', true, false, false, false));
+   CHK_EXEC(SetMinorSchemaVersion(22));
+   return true;
+}
+
+/**
+ * Upgrade from 51.20 to 51.21
+ */
+static bool H_UpgradeFromV20()
+{
+   CHK_EXEC(CreateConfigParam(_T("DBWriter.UseBulkLoad"),
+                              _T("1"),
+                              _T("Use bulk load interface (COPY) for writing collected DCI data if supported by database driver (only valid for PostgreSQL and TimescaleDB)."),
+                              nullptr, 'B', true, true, false, false));
+   CHK_EXEC(SetMinorSchemaVersion(21));
+   return true;
+}
+
 /**
  * Upgrade from 51.19 to 51.20
  */
@@ -458,6 +565,13 @@ static struct
    int nextMinor;
    bool (*upgradeProc)();
 } s_dbUpgradeMap[] = {
+   { 26, 51, 27, H_UpgradeFromV26 },
+   { 25, 51, 26, H_UpgradeFromV25 },
+   { 24, 51, 25, H_UpgradeFromV24 },
+   { 23, 51, 24, H_UpgradeFromV23 },
+   { 22, 51, 23, H_UpgradeFromV22 },
+   { 21, 51, 22, H_UpgradeFromV21 },
+   { 20, 51, 21, H_UpgradeFromV20 },
    { 19, 51, 20, H_UpgradeFromV19 },
    { 18, 51, 19, H_UpgradeFromV18 },
    { 17, 51, 18, H_UpgradeFromV17 },
@@ -0,0 +1,558 @@
+/*
+** NetXMS - Network Management System
+** SNMP support library
+** Copyright (C) 2003-2024 Victor Kirhenshtein
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as published by
+** the Free Software Foundation; either version 3 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** File: engine.cpp
+**
+**/
+
+#include "libnxsnmp.h"
+
+#define DEBUG_TAG _T("snmp.engine")
+
+/**
+ * Max number of shared sockets per address family
+ */
+#define MAX_ENGINE_SOCKETS    16
+
+/**
+ * Max wait time in receiver loop (milliseconds)
+ */
+#define MAX_ENGINE_WAIT_TIME  100
+
+/**
+ * Engine state
+ */
+static SOCKET s_sockets4[MAX_ENGINE_SOCKETS];
+static int s_socketCount4 = 0;
+static SOCKET s_sockets6[MAX_ENGINE_SOCKETS];
+static int s_socketCount6 = 0;
+static VolatileCounter s_nextSocket = 0;
+static SharedHashMap<uint32_t, SNMP_EngineRequest> s_requests;
+static Mutex s_requestLock(MutexType::FAST);
+static RWLock s_engineLock;   // Held for reading while shared sockets are in use, for writing while engine state changes
+static THREAD s_engineThread = INVALID_THREAD_HANDLE;
+static uint32_t s_engineThreadId = 0;
+static bool s_engineRunning = false;
+static bool s_engineShutdown = false;
+
+/**
+ * Engine request destructor
+ */
+SNMP_EngineRequest::~SNMP_EngineRequest()
+{
+   MemFree(response);
+   MemFree(packet);
+   delete securityContext;
+}
+
+/**
+ * Extract request ID (or message ID for SNMPv3) from raw packet without full parsing
+ */
+static bool ExtractRequestId(const BYTE *packet, size_t size, uint32_t *id)
+{
+   uint32_t type;
+   size_t length, idLength;
+   const BYTE *content;
+   if (!BER_DecodeIdentifier(packet, size, &type, &length, &content, &idLength) || (type != ASN_SEQUENCE))
+      return false;
+
+   // Version
+   const BYTE *pos = content;
+   size_t remaining = length;
+   if (!BER_DecodeIdentifier(pos, remaining, &type, &length, &content, &idLength) || (type != ASN_INTEGER))
+      return false;
+   uint32_t version;
+   if (!BER_DecodeContent(type, content, length, reinterpret_cast<BYTE*>(&version)))
+      return false;
+   pos = content + length;
+   remaining -= length + idLength;
+
+   if (version == SNMP_VERSION_3)
+   {
+      // Message ID is first element of header sequence
+      if (!BER_DecodeIdentifier(pos, remaining, &type, &length, &content, &idLength) || (type != ASN_SEQUENCE))
+         return false;
+      if (!BER_DecodeIdentifier(content, length, &type, &length, &content, &idLength) || (type != ASN_INTEGER))
+         return false;
+      return BER_DecodeContent(type, content, length, reinterpret_cast<BYTE*>(id));
+   }
+
+   // Community string
+   if (!BER_DecodeIdentifier(pos, remaining, &type, &length, &content, &idLength) || (type != ASN_OCTET_STRING))
+      return false;
+   pos = content + length;
+   remaining -= length + idLength;
+
+   // Request ID is first element of PDU
+   if (!BER_DecodeIdentifier(pos, remaining, &type, &length, &content, &idLength))
+      return false;
+   if (!BER_DecodeIdentifier(content, length, &type, &length, &content, &idLength) || (type != ASN_INTEGER))
+      return false;
+   return BER_DecodeContent(type, content, length, reinterpret_cast<BYTE*>(id));
+}
+
+/**
+ * Complete asynchronous request
+ */
+static void CompleteAsyncRequest(SNMP_EngineRequest *request, uint32_t rc)
+{
+   SNMP_PDU *pdu = nullptr;
+   if (rc == SNMP_ERR_SUCCESS)
+   {
+      pdu = new SNMP_PDU();
+      if (pdu->parse(request->response, request->responseSize, request->securityContext, false))
+      {
+         if (!request->codepage.isNull())
+            pdu->setCodepage(request->codepage);
+         if (pdu->getCommand() != SNMP_RESPONSE)
+            rc = SNMP_ERR_BAD_RESPONSE;
+      }
+      else
+      {
+         rc = SNMP_ERR_PARSE;
+      }
+      if (rc != SNMP_ERR_SUCCESS)
+         delete_and_null(pdu);
+   }
+   request->callback(rc, pdu);
+}
+
+/**
+ * Process incoming packet
+ */
+static void ProcessIncomingPacket(const BYTE *packet, size_t size, const SockAddrBuffer& sender)
+{
+   uint32_t id;
+   if (!ExtractRequestId(packet, size, &id))
+   {
+      nxlog_debug_tag(DEBUG_TAG, 7, _T("Cannot extract request ID from incoming packet"));
+      return;
+   }
+
+   // Response can come from different port (some devices do that), so only address is checked
+   InetAddress addr = InetAddress::createFromSockaddr(reinterpret_cast<const struct sockaddr*>(&sender));
+   s_requestLock.lock();
+   shared_ptr<SNMP_EngineRequest> request = s_requests.getShared(id);
+   if ((request == nullptr) || !request->peer.equals(addr))
+   {
+      s_requestLock.unlock();
+      nxlog_debug_tag(DEBUG_TAG, 7, _T("Unexpected response with request ID %u"), id);
+      return;
+   }
+   s_requests.remove(id);
+   s_requestLock.unlock();
+
+   request->response = MemCopyBlock(packet, size);
+   request->responseSize = size;
+   memcpy(&request->sender, &sender, sizeof(SockAddrBuffer));
+   if (request->async)
+      CompleteAsyncRequest(request.get(), SNMP_ERR_SUCCESS);
+   else
+      request->completed.set();
+}
+
+/**
+ * Retransmit timed out asynchronous requests and complete ones without retries left. Packets are
+ * sent after request lock is released (shared sockets are closed only after engine thread stops).
+ */
+static int64_t ProcessTimeouts(int64_t now)
+{
+   int64_t nextDeadline = now + MAX_ENGINE_WAIT_TIME;
+   std::vector<shared_ptr<SNMP_EngineRequest>> expired;
+   std::vector<shared_ptr<SNMP_EngineRequest>> retransmits;
+   s_requestLock.lock();
+   s_requests.forEach(
+      [now, &nextDeadline, &expired, &retransmits] (const uint32_t& id, const shared_ptr<SNMP_EngineRequest>& request) -> EnumerationCallbackResult
+      {
+         if (!request->async)
+            return _CONTINUE;
+
+         if (request->deadline <= now)
+         {
+            if (request->retries <= 0)
+            {
+               expired.push_back(request);
+               return _CONTINUE;
+            }
+            request->retries--;
+            request->deadline = now + request->timeout;
+            retransmits.push_back(request);
+         }
+         if (request->deadline < nextDeadline)
+            nextDeadline = request->deadline;
+         return _CONTINUE;
+      });
+   for(const shared_ptr<SNMP_EngineRequest>& request : expired)
+      s_requests.remove(request->id);
+   s_requestLock.unlock();
+
+   for(const shared_ptr<SNMP_EngineRequest>& request : retransmits)
+   {
+      sendto(request->hSocket, reinterpret_cast<char*>(request->packet), static_cast<int>(request->packetSize), 0,
+               reinterpret_cast<struct sockaddr*>(&request->peerAddr), SA_LEN(reinterpret_cast<struct sockaddr*>(&request->peerAddr)));
+   }
+
+   for(const shared_ptr<SNMP_EngineRequest>& request : expired)
+      CompleteAsyncRequest(request.get(), SNMP_ERR_TIMEOUT);
+   return nextDeadline;
+}
+
+/**
+ * Engine thread - receives responses on all shared sockets and handles retransmissions
+ */
+static void EngineThread()
+{
+   ThreadSetName("SNMPEngine");
+   s_engineThreadId = GetCurrentThreadId();
+   nxlog_debug_tag(DEBUG_TAG, 2, _T("SNMP request engine thread started"));
+
+   BYTE *buffer = MemAllocArrayNoInit<BYTE>(SNMP_DEFAULT_MSG_MAX_SIZE);
+   SocketPoller sp;
+   while(!s_engineShutdown)
+   {
+      int64_t now = GetCurrentTimeMs();
+      int64_t nextDeadline = ProcessTimeouts(now);
+
+      sp.reset();
+      for(int i = 0; i < s_socketCount4; i++)
+         sp.add(s_sockets4[i]);
+      for(int i = 0; i < s_socketCount6; i++)
+         sp.add(s_sockets6[i]);
+      if (sp.poll(static_cast<uint32_t>(std::max(nextDeadline - now, static_cast<int64_t>(1)))) <= 0)
+         continue;
+
+      for(int f = 0; f < 2; f++)
+      {
+         SOCKET *sockets = (f == 0) ? s_sockets4 : s_sockets6;
+         int count = (f == 0) ? s_socketCount4 : s_socketCount6;
+         for(int i = 0; i < count; i++)
+         {
+            if (!sp.isSet(sockets[i]))
+               continue;
+
+            SockAddrBuffer sender;
+            socklen_t addrSize = sizeof(SockAddrBuffer);
+            int bytes = recvfrom(sockets[i], reinterpret_cast<char*>(buffer), static_cast<int>(SNMP_DEFAULT_MSG_MAX_SIZE), 0, reinterpret_cast<struct sockaddr*>(&sender), &addrSize);
+            if (bytes > 0)
+               ProcessIncomingPacket(buffer, bytes, sender);
+         }
+      }
+   }
+   MemFree(buffer);
+
+   nxlog_debug_tag(DEBUG_TAG, 2, _T("SNMP request engine thread stopped"));
+}
+
+/**
+ * Create and bind shared socket for given address family
+ */
+static SOCKET CreateEngineSocket(int family)
+{
+   SOCKET s = CreateSocket(family, SOCK_DGRAM, 0);
+   if (s == INVALID_SOCKET)
+      return INVALID_SOCKET;
+
+   SockAddrBuffer localAddr;
+   memset(&localAddr, 0, sizeof(SockAddrBuffer));
+   if (family == AF_INET)
+   {
+      localAddr.sa4.sin_family = AF_INET;
+      localAddr.sa4.sin_addr.s_addr = htonl(INADDR_ANY);
+   }
+#ifdef WITH_IPV6
+   else
+   {
+      localAddr.sa6.sin6_family = AF_INET6;
+   }
+#endif
+
+   if (bind(s, reinterpret_cast<struct sockaddr*>(&localAddr), SA_LEN(reinterpret_cast<struct sockaddr*>(&localAddr))) != 0)
+   {
+      closesocket(s);
+      return INVALID_SOCKET;
+   }
+   return s;
+}
+
+/**
+ * Start shared SNMP request engine. After engine is started, UDP transports created with
+ * SNMP_UDPTransport::createUDPTransport will use shared sockets instead of creating own socket.
+ */
+bool LIBNXSNMP_EXPORTABLE SnmpStartRequestEngine(int numSockets)
+{
+   s_engineLock.writeLock();
+   if (s_engineRunning)
+   {
+      s_engineLock.unlock();
+      return true;
+   }
+
+   numSockets = std::min(std::max(numSockets, 1), MAX_ENGINE_SOCKETS);
+   for(int i = 0; i < numSockets; i++)
+   {
+      SOCKET s = CreateEngineSocket(AF_INET);
+      if (s != INVALID_SOCKET)
+         s_sockets4[s_socketCount4++] = s;
+#ifdef WITH_IPV6
+      s = CreateEngineSocket(AF_INET6);
+      if (s != INVALID_SOCKET)
+         s_sockets6[s_socketCount6++] = s;
+#endif
+   }
+   if (s_socketCount4 + s_socketCount6 == 0)
+   {
+      s_engineLock.unlock();
+      nxlog_write_tag(NXLOG_ERROR, DEBUG_TAG, _T("Cannot create sockets for SNMP request engine"));
+      return false;
+   }
+
+   s_engineShutdown = false;
+   s_engineThread = ThreadCreateEx(EngineThread);
+   s_engineRunning = true;
+   s_engineLock.unlock();
+   nxlog_debug_tag(DEBUG_TAG, 2, _T("SNMP request engine started (%d IPv4 sockets, %d IPv6 sockets)"), s_socketCount4, s_socketCount6);
+   return true;
+}
+
+/**
+ * Stop shared SNMP request engine. All outstanding requests are cancelled. Requests sent after
+ * this call will fail with socket error.
+ */
+void LIBNXSNMP_EXPORTABLE SnmpStopRequestEngine()
+{
+   // Once running flag is cleared under write lock no new requests can be registered
+   // and no sender can still be using shared sockets
+   s_engineLock.writeLock();
+   if (!s_engineRunning)
+   {
+      s_engineLock.unlock();
+      return;
+   }
+   s_engineRunning = false;
+   s_engineShutdown = true;
+   s_engineLock.unlock();
+
+   ThreadJoin(s_engineThread);
+   s_engineThread = INVALID_THREAD_HANDLE;
+
+   std::vector<shared_ptr<SNMP_EngineRequest>> requests;
+   s_requestLock.lock();
+   s_requests.forEach(
+      [&requests] (const uint32_t& id, const shared_ptr<SNMP_EngineRequest>& request) -> EnumerationCallbackResult
+      {
+         requests.push_back(request);
+         return _CONTINUE;
+      });
+   s_requests.clear();
+   s_requestLock.unlock();
+
+   for(const shared_ptr<SNMP_EngineRequest>& request : requests)
+   {
+      if (request->async)
+         CompleteAsyncRequest(request.get(), SNMP_ERR_ABORTED);
+      else
+         request->completed.set();
+   }
+
+   s_engineLock.writeLock();
+   for(int i = 0; i < s_socketCount4; i++)
+      closesocket(s_sockets4[i]);
+   s_socketCount4 = 0;
+   for(int i = 0; i < s_socketCount6; i++)
+      closesocket(s_sockets6[i]);
+   s_socketCount6 = 0;
+   s_engineLock.unlock();
+   nxlog_debug_tag(DEBUG_TAG, 2, _T("SNMP request engine stopped"));
+}
+
+/**
+ * Check if shared request engine can be used for given address family
+ */
+bool SnmpEngineIsAvailable(int family)
+{
+   s_engineLock.readLock();
+   bool available = s_engineRunning && (((family == AF_INET) && (s_socketCount4 > 0)) || ((family != AF_INET) && (s_socketCount6 > 0)));
+   s_engineLock.unlock();
+   return available;
+}
+
+/**
+ * Select shared socket for given peer address. Caller must hold engine lock for reading.
+ * Returns INVALID_SOCKET if engine is not running.
+ */
+static SOCKET SelectSocket(const SockAddrBuffer *peer)
+{
+   if (!s_engineRunning)
+      return INVALID_SOCKET;
+
+   uint32_t index = static_cast<uint32_t>(InterlockedIncrement(&s_nextSocket));
+   if (peer->sa4.sin_family == AF_INET)
+   {
+      int count = s_socketCount4;
+      return (count > 0) ? s_sockets4[index % count] : INVALID_SOCKET;
+   }
+   int count = s_socketCount6;
+   return (count > 0) ? s_sockets6[index % count] : INVALID_SOCKET;
+}
+
+/**
+ * Register request in engine. Caller must hold request lock.
+ * Returns false if another request with same ID is already registered.
+ */
+static bool RegisterRequest(const shared_ptr<SNMP_EngineRequest>& request)
+{
+   if (s_requests.contains(request->id))
+   {
+      nxlog_debug_tag(DEBUG_TAG, 6, _T("Request ID %u already in use"), request->id);
+      return false;
+   }
+   s_requests.set(request->id, request);
+   return true;
+}
+
+/**
+ * Register synchronous request in engine. Returned object can be used for waiting for response.
+ * Returns nullptr if engine is not running or given ID is already in use by another request
+ * (caller should assign new ID to request and try again).
+ */
+shared_ptr<SNMP_EngineRequest> SnmpEngineRegisterRequest(uint32_t id, const SockAddrBuffer *peer)
+{
+   shared_ptr<SNMP_EngineRequest> request;
+   s_engineLock.readLock();
+   if (s_engineRunning)
+   {
+      request = make_shared<SNMP_EngineRequest>(id, InetAddress::createFromSockaddr(reinterpret_cast<const struct sockaddr*>(peer)));
+      s_requestLock.lock();
+      if (!RegisterRequest(request))
+         request.reset();
+      s_requestLock.unlock();
+   }
+   s_engineLock.unlock();
+   return request;
+}
+
+/**
+ * Send packet via shared socket. Returns number of bytes sent or -1 on error (including engine not running).
+ */
+int SnmpEngineSendPacket(const SockAddrBuffer *peer, const BYTE *packet, size_t size)
+{
+   s_engineLock.readLock();
+   SOCKET s = SelectSocket(peer);
+   int bytes = (s != INVALID_SOCKET) ?
+            sendto(s, reinterpret_cast<const char*>(packet), static_cast<int>(size), 0, reinterpret_cast<const struct sockaddr*>(peer), SA_LEN(reinterpret_cast<const struct sockaddr*>(peer))) : -1;
+   s_engineLock.unlock();
+   return bytes;
+}
+
+/**
+ * Send asynchronous request via shared socket. Callback will be called from engine thread when response
+ * is received or request times out (or from calling thread if request cannot be sent).
+ * Returns false if given ID is already in use by another request - in that case engine does not take
+ * ownership of packet and security context and callback is not called (caller should assign new ID to
+ * request and try again). Otherwise engine takes ownership of encoded packet and security context.
+ */
+bool SnmpEngineSendAsyncRequest(uint32_t id, const SockAddrBuffer *peer, BYTE *packet, size_t size, SNMP_SecurityContext *securityContext,
+         const SNMP_Codepage& codepage, uint32_t timeout, int numRetries, std::function<void (uint32_t, SNMP_PDU*)> callback)
+{
+   auto request = make_shared<SNMP_EngineRequest>(id, InetAddress::createFromSockaddr(reinterpret_cast<const struct sockaddr*>(peer)));
+   request->async = true;
+   memcpy(&request->peerAddr, peer, sizeof(SockAddrBuffer));
+   request->codepage = codepage;
+   request->timeout = timeout;
+   request->retries = numRetries - 1;
+   request->deadline = GetCurrentTimeMs() + timeout;
+   request->callback = callback;
+
+   s_engineLock.readLock();
+   request->hSocket = SelectSocket(peer);
+   if (request->hSocket == INVALID_SOCKET)
+   {
+      s_engineLock.unlock();
+      request->packet = packet;
+      request->securityContext = securityContext;
+      CompleteAsyncRequest(request.get(), SNMP_ERR_SOCKET);
+      return true;
+   }
+
+   // Request should be complete before it becomes visible to engine thread
+   request->packet = packet;
+   request->packetSize = size;
+   request->securityContext = securityContext;
+
+   s_requestLock.lock();
+   bool registered = RegisterRequest(request);
+   s_requestLock.unlock();
+   if (!registered)
+   {
+      s_engineLock.unlock();
+      request->packet = nullptr;   // Ownership stays with caller
+      request->securityContext = nullptr;
+      return false;
+   }
+
+   bool sent = (sendto(request->hSocket, reinterpret_cast<char*>(packet), static_cast<int>(size), 0,
+            reinterpret_cast<struct sockaddr*>(&request->peerAddr), SA_LEN(reinterpret_cast<struct sockaddr*>(&request->peerAddr))) > 0);
+   s_engineLock.unlock();
+
+   if (!sent)
+   {
+      s_requestLock.lock();
+      registered = (s_requests.get(id) == request.get());
+      if (registered)
+         s_requests.remove(id);
+      s_requestLock.unlock();
+      if (registered)
+         CompleteAsyncRequest(request.get(), SNMP_ERR_COMM);
+   }
+   return true;
+}
+
+/**
+ * Cancel registered request (response, if received later, will be ignored)
+ */
+void SnmpEngineCancelRequest(const shared_ptr<SNMP_EngineRequest>& request)
+{
+   s_requestLock.lock();
+   if (s_requests.get(request->id) == request.get())
+      s_requests.remove(request->id);
+   s_requestLock.unlock();
+}
+
+/**
+ * Cancel asynchronous request with given ID sent to given peer. Returns true if request was cancelled (callback
+ * will not be called) and false if request is not registered (already completed or being completed by engine).
+ */
+bool SnmpEngineCancelAsyncRequest(uint32_t id, const InetAddress& peer)
+{
+   s_requestLock.lock();
+   shared_ptr<SNMP_EngineRequest> request = s_requests.getShared(id);
+   bool cancelled = (request != nullptr) && request->async && request->peer.equals(peer);
+   if (cancelled)
+      s_requests.remove(id);
+   s_requestLock.unlock();
+   return cancelled;
+}
+
+/**
+ * Check if calling thread is engine thread
+ */
+bool SnmpEngineIsEngineThread()
+{
+   return s_engineRunning && (s_engineThreadId == GetCurrentThreadId());
+}
@@ -141,4 +141,60 @@ bool BER_DecodeIdentifier(const BYTE *rawData, size_t rawSize, uint32_t *type, s
 bool BER_DecodeContent(uint32_t type, const BYTE *data, size_t length, BYTE *buffer);
 size_t BER_Encode(uint32_t type, const BYTE *data, size_t dataLength, BYTE *buffer, size_t bufferSize);
 
+/**
+ * Request registered in shared request engine
+ */
+struct SNMP_EngineRequest
+{
+   uint32_t id;
+   InetAddress peer;
+   Condition completed;
+   BYTE *response;
+   size_t responseSize;
+   SockAddrBuffer sender;
+
+   // Fields below are used only by asynchronous requests
+   bool async;
+   SOCKET hSocket;
+   SockAddrBuffer peerAddr;
+   BYTE *packet;
+   size_t packetSize;
+   SNMP_SecurityContext *securityContext;
+   SNMP_Codepage codepage;
+   uint32_t timeout;
+   int retries;
+   int64_t deadline;
+   std::function<void (uint32_t, SNMP_PDU*)> callback;
+
+   SNMP_EngineRequest(uint32_t _id, const InetAddress& _peer) : peer(_peer), completed(true)
+   {
+      id = _id;
+      response = nullptr;
+      responseSize = 0;
+      memset(&sender, 0, sizeof(SockAddrBuffer));
+      async = false;
+      hSocket = INVALID_SOCKET;
+      memset(&peerAddr, 0, sizeof(SockAddrBuffer));
+      packet = nullptr;
+      packetSize = 0;
+      securityContext = nullptr;
+      timeout = 0;
+      retries = 0;
+      deadline = 0;
+   }
+   ~SNMP_EngineRequest();
+};
+
+/**
+ * Shared request engine functions
+ */
+bool SnmpEngineIsAvailable(int family);
+shared_ptr<SNMP_EngineRequest> SnmpEngineRegisterRequest(uint32_t id, const SockAddrBuffer *peer);
+int SnmpEngineSendPacket(const SockAddrBuffer *peer, const BYTE *packet, size_t size);
+bool SnmpEngineSendAsyncRequest(uint32_t id, const SockAddrBuffer *peer, BYTE *packet, size_t size, SNMP_SecurityContext *securityContext,
+         const SNMP_Codepage& codepage, uint32_t timeout, int numRetries, std::function<void (uint32_t, SNMP_PDU*)> callback);
+void SnmpEngineCancelRequest(const shared_ptr<SNMP_EngineRequest>& request);
+bool SnmpEngineCancelAsyncRequest(uint32_t id, const InetAddress& peer);
+bool SnmpEngineIsEngineThread();
+
 #endif   /* _libnxsnmp_h_ */
@@ -23,6 +23,16 @@
 
 #include "libnxsnmp.h"
 
+/**
+ * Max number of attempts to register request in shared engine with unique request ID
+ */
+#define MAX_REQUEST_ID_ATTEMPTS  8
+
+/**
+ * Additional time (milliseconds) to wait for completion of synchronous request executed by shared engine
+ */
+#define SYNC_REQUEST_WAIT_MARGIN 5000
+
 /**
  * Report to SNMP error mapping
  */
@@ -78,6 +88,7 @@ SNMP_Transport::SNMP_Transport()
 	m_updatePeerOnRecv = false;
 	m_reliable = false;
 	m_snmpVersion = SNMP_VERSION_2C;
+   m_bulkMaxRepetitions = SNMP_DEFAULT_BULK_MAX_REPETITIONS;
 }
 
 /**
@@ -90,6 +101,18 @@ SNMP_Transport::~SNMP_Transport()
 	delete m_securityContext;
 }
 
+/**
+ * Update max-repetitions value for GETBULK requests after adaptation to agent's capabilities
+ */
+void SNMP_Transport::updateBulkMaxRepetitions(int maxRepetitions)
+{
+   if (maxRepetitions == m_bulkMaxRepetitions)
+      return;
+   m_bulkMaxRepetitions = maxRepetitions;
+   if (m_bulkCapabilityUpdateHandler)
+      m_bulkCapabilityUpdateHandler(maxRepetitions);
+}
+
 /**
  * Set security context. Previous security context will be destroyed.
  *
@@ -146,6 +169,37 @@ uint32_t SNMP_Transport::doRequest(SNMP_PDU *request, SNMP_PDU **response, uint3
 
    *response = nullptr;
 
+   // Requests that can be handled by shared request engine are executed through it, so all
+   // outstanding requests are tracked and retransmitted by engine thread
+   if (!engineIdDiscoveryOnly && isAsyncRequestSupported(request))
+   {
+      // Engine thread cannot wait for completion of request it should process itself
+      assert(!SnmpEngineIsEngineThread());
+
+      Condition completed(true);
+      uint32_t rc = SNMP_ERR_SUCCESS;
+      doRequestAsync(request,
+         [&completed, &rc, response] (uint32_t result, SNMP_PDU *pdu) -> void
+         {
+            rc = result;
+            *response = pdu;
+            completed.set();
+         }, timeout, numRetries);
+
+      // Engine completes request after last retry times out, so this wait should not normally expire
+      uint32_t requestTimeout = (timeout != 0) ? timeout : SnmpGetDefaultTimeout();
+      if (!completed.wait(requestTimeout * numRetries + SYNC_REQUEST_WAIT_MARGIN))
+      {
+         if (SnmpEngineCancelAsyncRequest(request->getRequestId(), getPeerIpAddress()))
+         {
+            nxlog_debug_tag(LIBNXSNMP_DEBUG_TAG, 5, _T("SNMP_Transport::doRequest: request %u was not completed by request engine in time and was cancelled"), request->getRequestId());
+            return SNMP_ERR_TIMEOUT;
+         }
+         completed.wait(INFINITE);  // Request is being completed by engine thread, callback will be called shortly
+      }
+      return rc;
+   }
+
 	// Create dummy context
 	if (m_securityContext == nullptr)
 		m_securityContext = new SNMP_SecurityContext();
@@ -333,6 +387,26 @@ uint32_t SNMP_Transport::doRequest(SNMP_PDU *request, SNMP_PDU **response, uint3
    return rc;
 }
 
+/**
+ * Check if given request can be executed asynchronously without blocking calling thread.
+ * Default implementation always returns false.
+ */
+bool SNMP_Transport::isAsyncRequestSupported(SNMP_PDU *request)
+{
+   return false;
+}
+
+/**
+ * Send a request and call provided callback when response is received or request fails.
+ * Callback takes ownership of response PDU. Default implementation executes request synchronously.
+ */
+void SNMP_Transport::doRequestAsync(SNMP_PDU *request, std::function<void (uint32_t, SNMP_PDU*)> callback, uint32_t timeout, int numRetries)
+{
+   SNMP_PDU *response;
+   uint32_t rc = doRequest(request, &response, (timeout != 0) ? timeout : SnmpGetDefaultTimeout(), (numRetries > 0) ? numRetries : s_defaultRetryCount);
+   callback(rc, response);
+}
+
 /**
  * Send TRAP or INFORM REQUEST message
  */
@@ -387,6 +461,7 @@ SNMP_UDPTransport::SNMP_UDPTransport() : SNMP_Transport()
    m_dwBytesInBuffer = 0;
    m_pBuffer = (BYTE *)MemAlloc(m_dwBufferSize);
 	m_connected = false;
+   m_sharedEngine = false;
 }
 
 /**
@@ -401,6 +476,7 @@ SNMP_UDPTransport::SNMP_UDPTransport(SOCKET hSocket) : SNMP_Transport()
    m_dwBytesInBuffer = 0;
    m_pBuffer = (BYTE *)MemAlloc(m_dwBufferSize);
 	m_connected = false;
+   m_sharedEngine = false;
 }
 
 /**
@@ -422,6 +498,14 @@ uint32_t SNMP_UDPTransport::createUDPTransport(const InetAddress& hostAddr, uint
    m_port = port;
    hostAddr.fillSockAddr(&m_peerAddr, port);
 
+   // Use shared sockets if request engine is running
+   if (SnmpEngineIsAvailable(hostAddr.getFamily()))
+   {
+      m_sharedEngine = true;
+      m_connected = true;
+      return SNMP_ERR_SUCCESS;
+   }
+
    uint32_t result;
 
    // Create and connect socket
@@ -477,6 +561,8 @@ uint32_t SNMP_UDPTransport::createUDPTransport(const InetAddress& hostAddr, uint
  */
 SNMP_UDPTransport::~SNMP_UDPTransport()
 {
+   if (m_pendingRequest != nullptr)
+      SnmpEngineCancelRequest(m_pendingRequest);
    MemFree(m_pBuffer);
    if (m_hSocket != -1)
       closesocket(m_hSocket);
@@ -496,6 +582,9 @@ void SNMP_UDPTransport::clearBuffer()
  */
 int SNMP_UDPTransport::recvData(UINT32 dwTimeout, struct sockaddr *pSender, socklen_t *piAddrSize)
 {
+   if (m_sharedEngine)
+      return recvDataFromEngine(dwTimeout, pSender, piAddrSize);
+
    SockAddrBuffer srcAddrBuffer;
 
 retry_wait:
@@ -535,6 +624,35 @@ int SNMP_UDPTransport::recvData(UINT32 dwTimeout, struct sockaddr *pSender, sock
 	return rc;
 }
 
+/**
+ * Receive response to pending request from shared request engine
+ */
+int SNMP_UDPTransport::recvDataFromEngine(uint32_t timeout, struct sockaddr *sender, socklen_t *addrSize)
+{
+   if (m_pendingRequest == nullptr)
+      return -1;
+
+   if (!m_pendingRequest->completed.wait(timeout))
+      return 0;
+
+   shared_ptr<SNMP_EngineRequest> request = m_pendingRequest;
+   m_pendingRequest.reset();
+   if (request->response == nullptr)
+      return -1;  // Engine stopped
+
+   size_t bytes = std::min(request->responseSize, m_dwBufferSize - (m_dwBufferPos + m_dwBytesInBuffer));
+   memcpy(&m_pBuffer[m_dwBufferPos + m_dwBytesInBuffer], request->response, bytes);
+
+   struct sockaddr *senderAddr = reinterpret_cast<struct sockaddr*>(&request->sender);
+   if (sender != nullptr)
+      memcpy(sender, senderAddr, std::min(static_cast<socklen_t>(SA_LEN(senderAddr)), (addrSize != nullptr) ? *addrSize : static_cast<socklen_t>(sizeof(SockAddrBuffer))));
+   if (addrSize != nullptr)
+      *addrSize = SA_LEN(senderAddr);
+   if (m_updatePeerOnRecv)
+      memcpy(&m_peerAddr, senderAddr, SA_LEN(senderAddr));
+   return static_cast<int>(bytes);
+}
+
 /**
  * Pre-parse PDU
  */
@@ -622,14 +740,52 @@ int SNMP_UDPTransport::readMessage(SNMP_PDU **pdu, uint32_t timeout, struct sock
  */
 int SNMP_UDPTransport::sendMessage(SNMP_PDU *pdu, uint32_t timeout)
 {
+   if (m_sharedEngine)
+   {
+      if (m_pendingRequest != nullptr)
+      {
+         SnmpEngineCancelRequest(m_pendingRequest);
+         m_pendingRequest.reset();
+      }
+      clearBuffer();
+
+      // Only requests expect response - register them in engine so response will be routed back to this transport
+      uint32_t command = pdu->getCommand();
+      if ((command != SNMP_TRAP) && (command != SNMP_RESPONSE) && (command != SNMP_REPORT))
+      {
+         for(int attempt = 0; attempt < MAX_REQUEST_ID_ATTEMPTS; attempt++)
+         {
+            m_pendingRequest = SnmpEngineRegisterRequest((pdu->getVersion() == SNMP_VERSION_3) ? pdu->getMessageId() : pdu->getRequestId(), &m_peerAddr);
+            if ((m_pendingRequest != nullptr) || !SnmpEngineIsAvailable(m_peerAddr.sa4.sin_family))
+               break;
+
+            // ID already used by request from another transport
+            if (pdu->getVersion() == SNMP_VERSION_3)
+               pdu->setMessageId(SnmpNewRequestId());
+            else
+               pdu->setRequestId(SnmpNewRequestId());
+         }
+         if (m_pendingRequest == nullptr)
+            return -1;
+      }
+   }
+
    int bytes = 0;
    BYTE *buffer;
    size_t size = pdu->encode(&buffer, m_securityContext);
    if (size != 0)
    {
-      bytes = sendto(m_hSocket, (char *)buffer, (int)size, 0, (struct sockaddr *)&m_peerAddr, SA_LEN((struct sockaddr *)&m_peerAddr));
+      if (m_sharedEngine)
+         bytes = SnmpEngineSendPacket(&m_peerAddr, buffer, size);
+      else
+         bytes = sendto(m_hSocket, (char *)buffer, (int)size, 0, (struct sockaddr *)&m_peerAddr, SA_LEN((struct sockaddr *)&m_peerAddr));
       MemFree(buffer);
    }
+   if ((bytes <= 0) && (m_pendingRequest != nullptr))
+   {
+      SnmpEngineCancelRequest(m_pendingRequest);
+      m_pendingRequest.reset();
+   }
    return bytes;
 }
 
@@ -656,3 +812,50 @@ bool SNMP_UDPTransport::isProxyTransport()
 {
    return false;
 }
+
+/**
+ * Check if given request can be executed asynchronously through shared request engine. SNMPv3 requests are
+ * always executed synchronously because they may require engine ID discovery and time synchronization.
+ */
+bool SNMP_UDPTransport::isAsyncRequestSupported(SNMP_PDU *request)
+{
+   return m_sharedEngine && !m_updatePeerOnRecv && (request->getVersion() != SNMP_VERSION_3);
+}
+
+/**
+ * Send a request asynchronously. If shared request engine is used, request will be sent without
+ * blocking calling thread and callback will be called from engine thread.
+ */
+void SNMP_UDPTransport::doRequestAsync(SNMP_PDU *request, std::function<void (uint32_t, SNMP_PDU*)> callback, uint32_t timeout, int numRetries)
+{
+   if (!isAsyncRequestSupported(request))
+   {
+      SNMP_Transport::doRequestAsync(request, callback, timeout, numRetries);
+      return;
+   }
+
+   if (m_securityContext == nullptr)
+      m_securityContext = new SNMP_SecurityContext();
+
+   for(int attempt = 0; attempt < MAX_REQUEST_ID_ATTEMPTS; attempt++)
+   {
+      BYTE *packet;
+      size_t size = request->encode(&packet, m_securityContext);
+      if (size == 0)
+      {
+         callback(SNMP_ERR_PARAM, nullptr);
+         return;
+      }
+
+      SNMP_SecurityContext *securityContext = new SNMP_SecurityContext(m_securityContext);
+      if (SnmpEngineSendAsyncRequest(request->getRequestId(), &m_peerAddr, packet, size, securityContext, m_codepage,
+               (timeout != 0) ? timeout : SnmpGetDefaultTimeout(), (numRetries > 0) ? numRetries : s_defaultRetryCount, callback))
+         return;
+
+      // Request ID already used by another outstanding request, retry with new one
+      MemFree(packet);
+      delete securityContext;
+      request->setRequestId(SnmpNewRequestId());
+   }
+   callback(SNMP_ERR_COMM, nullptr);
+}
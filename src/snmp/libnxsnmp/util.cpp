@@ -258,6 +258,222 @@ uint32_t LIBNXSNMP_EXPORTABLE SnmpGetEx(SNMP_Transport *pTransport, const TCHAR
    return result;
 }
 
+/**
+ * State of multi-variable GET operation
+ */
+class SnmpGetMultipleOperation
+{
+private:
+   SNMP_Transport *m_transport;
+   SNMP_ObjectId *m_oids;
+   int m_count;
+   SNMP_Variable **m_values;
+   uint32_t *m_rcc;
+   int *m_pending;
+   int m_pendingCount;
+   int m_pos;
+   int m_chunkSize;
+   int m_maxVarbinds;
+   std::function<void (uint32_t, SNMP_Variable**, uint32_t*, int)> m_callback;
+
+   void processResponse(uint32_t result, SNMP_PDU *response);
+   void complete(uint32_t result);
+
+public:
+   SnmpGetMultipleOperation(SNMP_Transport *transport, const SNMP_ObjectId *oids, int count, int maxVarbinds, std::function<void (uint32_t, SNMP_Variable**, uint32_t*, int)> callback);
+   ~SnmpGetMultipleOperation();
+
+   void sendNextRequest();
+};
+
+/**
+ * Create multi-variable GET operation
+ */
+SnmpGetMultipleOperation::SnmpGetMultipleOperation(SNMP_Transport *transport, const SNMP_ObjectId *oids, int count, int maxVarbinds,
+         std::function<void (uint32_t, SNMP_Variable**, uint32_t*, int)> callback) : m_callback(callback)
+{
+   m_transport = transport;
+   m_count = count;
+   m_oids = new SNMP_ObjectId[count];
+   m_values = MemAllocArray<SNMP_Variable*>(count);
+   m_rcc = MemAllocArrayNoInit<uint32_t>(count);
+   m_pending = MemAllocArrayNoInit<int>(count);
+   m_pendingCount = 0;
+   for(int i = 0; i < count; i++)
+   {
+      m_oids[i] = oids[i];
+      if (oids[i].isValid())
+      {
+         m_pending[m_pendingCount++] = i;
+      }
+      else
+      {
+         m_rcc[i] = SNMP_ERR_BAD_OID;
+      }
+   }
+   m_pos = 0;
+   m_chunkSize = 0;
+   m_maxVarbinds = std::max(maxVarbinds, 1);
+}
+
+/**
+ * Destroy multi-variable GET operation
+ */
+SnmpGetMultipleOperation::~SnmpGetMultipleOperation()
+{
+   delete[] m_oids;
+   MemFree(m_values);
+   MemFree(m_rcc);
+   MemFree(m_pending);
+}
+
+/**
+ * Send request for next chunk of pending variables or complete operation if there are no more pending variables
+ */
+void SnmpGetMultipleOperation::sendNextRequest()
+{
+   if (m_pos >= m_pendingCount)
+   {
+      complete(SNMP_ERR_SUCCESS);
+      return;
+   }
+
+   m_chunkSize = std::min(m_maxVarbinds, m_pendingCount - m_pos);
+   SNMP_PDU request(SNMP_GET_REQUEST, SnmpNewRequestId(), m_transport->getSnmpVersion());
+   for(int i = 0; i < m_chunkSize; i++)
+      request.bindVariable(new SNMP_Variable(m_oids[m_pending[m_pos + i]]));
+   m_transport->doRequestAsync(&request,
+      [this] (uint32_t result, SNMP_PDU *response) -> void
+      {
+         processResponse(result, response);
+      });
+}
+
+/**
+ * Process response to request for current chunk
+ */
+void SnmpGetMultipleOperation::processResponse(uint32_t result, SNMP_PDU *response)
+{
+   if (result != SNMP_ERR_SUCCESS)
+   {
+      for(int i = m_pos; i < m_pendingCount; i++)
+         m_rcc[m_pending[i]] = result;
+      complete(result);
+      return;
+   }
+
+   SNMP_ErrorCode errorCode = response->getErrorCode();
+   if (errorCode == SNMP_PDU_ERR_SUCCESS)
+   {
+      if (response->getNumVariables() == m_chunkSize)
+      {
+         for(int i = 0; i < m_chunkSize; i++)
+         {
+            int index = m_pending[m_pos + i];
+            SNMP_Variable *v = response->getVariable(i);
+            if ((v->getType() != ASN_NO_SUCH_OBJECT) && (v->getType() != ASN_NO_SUCH_INSTANCE) &&
+                (v->getType() != ASN_END_OF_MIBVIEW))
+            {
+               m_values[index] = new SNMP_Variable(v);
+               m_rcc[index] = SNMP_ERR_SUCCESS;
+            }
+            else
+            {
+               m_rcc[index] = SNMP_ERR_NO_OBJECT;
+            }
+         }
+      }
+      else
+      {
+         for(int i = 0; i < m_chunkSize; i++)
+            m_rcc[m_pending[m_pos + i]] = SNMP_ERR_BAD_RESPONSE;
+      }
+      m_pos += m_chunkSize;
+   }
+   else if ((errorCode == SNMP_PDU_ERR_TOO_BIG) && (m_chunkSize > 1))
+   {
+      // Retry same variables with smaller requests
+      m_maxVarbinds = m_chunkSize / 2;
+      nxlog_debug_tag(LIBNXSNMP_DEBUG_TAG, 6, _T("SnmpGetMultiple: response too big, max varbinds per request reduced to %d"), m_maxVarbinds);
+   }
+   else if ((errorCode == SNMP_PDU_ERR_NO_SUCH_NAME) && (response->getErrorIndex() > 0) && (response->getErrorIndex() <= static_cast<uint32_t>(m_chunkSize)))
+   {
+      // Exclude failed variable and repeat request for the rest of the chunk
+      int failed = m_pos + static_cast<int>(response->getErrorIndex()) - 1;
+      m_rcc[m_pending[failed]] = SNMP_ERR_NO_OBJECT;
+      memmove(&m_pending[failed], &m_pending[failed + 1], (m_pendingCount - failed - 1) * sizeof(int));
+      m_pendingCount--;
+   }
+   else
+   {
+      for(int i = 0; i < m_chunkSize; i++)
+         m_rcc[m_pending[m_pos + i]] = (errorCode == SNMP_PDU_ERR_NO_SUCH_NAME) ? SNMP_ERR_NO_OBJECT : SNMP_ERR_AGENT;
+      m_pos += m_chunkSize;
+   }
+   delete response;
+
+   sendNextRequest();
+}
+
+/**
+ * Complete operation. Operation object is destroyed after callback returns.
+ */
+void SnmpGetMultipleOperation::complete(uint32_t result)
+{
+   m_callback(result, m_values, m_rcc, m_maxVarbinds);
+   delete this;
+}
+
+/**
+ * Get values for multiple SNMP variables asynchronously using as few GET requests as possible. Each request
+ * contains up to maxVarbinds variables; limit is reduced if agent responds with tooBig error and final value
+ * is passed to callback. Variables reported by SNMPv1 agent as noSuchName are excluded and request is repeated
+ * for remaining variables. Callback receives overall result (transport error if communication with agent failed,
+ * SNMP_ERR_SUCCESS otherwise), array of received variables (callback takes ownership of variables but not of
+ * array itself) and array of individual result codes. If transport uses shared request engine, callback is
+ * called from engine thread, otherwise all requests are executed synchronously in calling thread.
+ * Transport must remain valid until callback is called.
+ */
+void LIBNXSNMP_EXPORTABLE SnmpGetMultipleAsync(SNMP_Transport *transport, const SNMP_ObjectId *oids, int count, int maxVarbinds,
+         std::function<void (uint32_t, SNMP_Variable**, uint32_t*, int)> callback)
+{
+   if ((transport == nullptr) || (count <= 0))
+   {
+      callback((transport == nullptr) ? SNMP_ERR_COMM : SNMP_ERR_SUCCESS, nullptr, nullptr, maxVarbinds);
+      return;
+   }
+   (new SnmpGetMultipleOperation(transport, oids, count, maxVarbinds, callback))->sendNextRequest();
+}
+
+/**
+ * Get values for multiple SNMP variables using as few GET requests as possible. Each request
+ * contains up to maxVarbinds variables; limit is reduced (and stored back) if agent responds with
+ * tooBig error. Variables reported by SNMPv1 agent as noSuchName are excluded and request is repeated
+ * for remaining variables. On return values[i] contains received variable (caller is responsible
+ * for destroying it) or null, and rcc[i] contains individual result code. Function returns
+ * transport error if communication with agent failed (results for not yet requested variables are
+ * set to same error), and SNMP_ERR_SUCCESS otherwise.
+ */
+uint32_t LIBNXSNMP_EXPORTABLE SnmpGetMultiple(SNMP_Transport *transport, const SNMP_ObjectId *oids, int count, SNMP_Variable **values, uint32_t *rcc, int *maxVarbinds)
+{
+   if ((transport == nullptr) || (count <= 0))
+      return (transport == nullptr) ? SNMP_ERR_COMM : SNMP_ERR_SUCCESS;
+
+   Condition completed(true);
+   uint32_t result = SNMP_ERR_SUCCESS;
+   SnmpGetMultipleAsync(transport, oids, count, *maxVarbinds,
+      [&completed, &result, values, rcc, count, maxVarbinds] (uint32_t rc, SNMP_Variable **v, uint32_t *r, int learnedMaxVarbinds) -> void
+      {
+         memcpy(values, v, count * sizeof(SNMP_Variable*));
+         memcpy(rcc, r, count * sizeof(uint32_t));
+         *maxVarbinds = learnedMaxVarbinds;
+         result = rc;
+         completed.set();
+      });
+   completed.wait(INFINITE);
+   return result;
+}
+
 /**
  * Check if specified SNMP variable set to specified value.
  * If variable doesn't exist at all, will return false
@@ -307,7 +523,13 @@ uint32_t LIBNXSNMP_EXPORTABLE SnmpWalk(SNMP_Transport *transport, const TCHAR *r
 }
 
 /**
- * Enumerate multiple values by walking through MIB, starting at given root
+ * Enumerate multiple values by walking through MIB, starting at given root. GETBULK requests are used
+ * for SNMPv2c and SNMPv3 unless disabled for transport. Number of repetitions is reduced if agent responds
+ * with tooBig error or does not respond in time. If GETBULK request with single repetition times out or agent
+ * responds to GETBULK with noSuchName error, same step is repeated with GETNEXT request, and GETBULK is disabled
+ * if GETNEXT request succeeds. Walk falls back to GETNEXT requests immediately if agent responds to GETBULK
+ * with other error. Adjusted capabilities are reported back to transport, so subsequent walks do not repeat
+ * failed GETBULK requests.
  */
 uint32_t LIBNXSNMP_EXPORTABLE SnmpWalk(SNMP_Transport *transport, const uint32_t *rootOid, size_t rootOidLen, std::function<uint32_t (SNMP_Variable*)> handler, bool logErrors, bool failOnShutdown)
 {
@@ -319,6 +541,9 @@ uint32_t LIBNXSNMP_EXPORTABLE SnmpWalk(SNMP_Transport *transport, const uint32_t
    memcpy(pdwName, rootOid, rootOidLen * sizeof(UINT32));
    size_t nameLength = rootOidLen;
 
+   int maxRepetitions = transport->getBulkMaxRepetitions();
+   bool bulkRetry = false;   // true if GETNEXT request is sent after timeout or noSuchName response to GETBULK
+
    // Walk the MIB
    uint32_t result;
    bool running = true;
@@ -332,54 +557,118 @@ uint32_t LIBNXSNMP_EXPORTABLE SnmpWalk(SNMP_Transport *transport, const uint32_t
          break;
       }
 
-      SNMP_PDU requestPDU(SNMP_GET_NEXT_REQUEST, static_cast<uint32_t>(InterlockedIncrement(&s_requestId)) & 0x7FFFFFFF, transport->getSnmpVersion());
+      bool bulk = (maxRepetitions > 0);
+      SNMP_PDU requestPDU(bulk ? SNMP_GET_BULK_REQUEST : SNMP_GET_NEXT_REQUEST, static_cast<uint32_t>(InterlockedIncrement(&s_requestId)) & 0x7FFFFFFF, transport->getSnmpVersion());
+      if (bulk)
+         requestPDU.setBulkParameters(0, maxRepetitions);
       requestPDU.bindVariable(new SNMP_Variable(pdwName, nameLength));
       SNMP_PDU *responsePDU;
       result = transport->doRequest(&requestPDU, &responsePDU);
 
+      if (bulk && (result == SNMP_ERR_TIMEOUT))
+      {
+         if (maxRepetitions > 1)
+         {
+            // Agent may not be able to produce large response in time
+            maxRepetitions /= 2;
+            nxlog_debug_tag(LIBNXSNMP_DEBUG_TAG, 6, _T("SnmpWalk: timeout on GETBULK request, maxRepetitions reduced to %d"), maxRepetitions);
+            transport->updateBulkMaxRepetitions(maxRepetitions);
+         }
+         else
+         {
+            // Agent may not handle GETBULK at all - repeat same request with GETNEXT to find out
+            nxlog_debug_tag(LIBNXSNMP_DEBUG_TAG, 6, _T("SnmpWalk: timeout on GETBULK request with single repetition, retrying with GETNEXT"));
+            maxRepetitions = 0;
+            bulkRetry = true;
+         }
+         continue;
+      }
+      if (bulk && (result == SNMP_ERR_SUCCESS))
+      {
+         if ((responsePDU->getErrorCode() == SNMP_PDU_ERR_TOO_BIG) && (maxRepetitions > 1))
+         {
+            maxRepetitions /= 2;
+            nxlog_debug_tag(LIBNXSNMP_DEBUG_TAG, 6, _T("SnmpWalk: response to GETBULK request is too big, maxRepetitions reduced to %d"), maxRepetitions);
+            transport->updateBulkMaxRepetitions(maxRepetitions);
+            delete responsePDU;
+            continue;
+         }
+         if (responsePDU->getErrorCode() == SNMP_PDU_ERR_NO_SUCH_NAME)
+         {
+            // Could be either end of MIB or agent not handling GETBULK - repeat same request with GETNEXT to find out
+            nxlog_debug_tag(LIBNXSNMP_DEBUG_TAG, 6, _T("SnmpWalk: noSuchName response to GETBULK request, retrying with GETNEXT"));
+            maxRepetitions = 0;
+            bulkRetry = true;
+            delete responsePDU;
+            continue;
+         }
+         if ((responsePDU->getErrorCode() != SNMP_PDU_ERR_SUCCESS) || (responsePDU->getNumVariables() == 0))
+         {
+            // Broken GETBULK implementation
+            nxlog_debug_tag(LIBNXSNMP_DEBUG_TAG, 6, _T("SnmpWalk: invalid response to GETBULK request (error code %d), switching to GETNEXT"), responsePDU->getErrorCode());
+            transport->updateBulkMaxRepetitions(0);
+            maxRepetitions = 0;
+            delete responsePDU;
+            continue;
+         }
+      }
+      else if (bulkRetry && (result == SNMP_ERR_SUCCESS))
+      {
+         if ((responsePDU->getErrorCode() == SNMP_PDU_ERR_SUCCESS) && (responsePDU->getNumVariables() > 0))
+         {
+            // GETNEXT works where GETBULK failed - agent does not support GETBULK
+            nxlog_debug_tag(LIBNXSNMP_DEBUG_TAG, 6, _T("SnmpWalk: GETNEXT request succeeded after failed GETBULK request, switching to GETNEXT"));
+            transport->updateBulkMaxRepetitions(0);
+         }
+         bulkRetry = false;
+      }
+
       // Analyze response
       if (result == SNMP_ERR_SUCCESS)
       {
          if ((responsePDU->getNumVariables() > 0) &&
              (responsePDU->getErrorCode() == SNMP_PDU_ERR_SUCCESS))
          {
-            SNMP_Variable *var = responsePDU->getVariable(0);
-
-            if ((var->getType() != ASN_NO_SUCH_OBJECT) &&
-                (var->getType() != ASN_NO_SUCH_INSTANCE) &&
-                (var->getType() != ASN_END_OF_MIBVIEW))
+            for(int i = 0; running && (i < responsePDU->getNumVariables()); i++)
             {
-               // Should we stop walking?
-               // Some buggy SNMP agents may return first value after last one
-               // (Toshiba Strata CTX do that for example), so last check is here
-               if ((var->getName().length() < rootOidLen) ||
-                   (memcmp(rootOid, var->getName().value(), rootOidLen * sizeof(UINT32))) ||
-                   (var->getName().compare(pdwName, nameLength) == OID_EQUAL) ||
-                   (var->getName().compare(firstObjectName, firstObjectNameLen) == OID_EQUAL))
-               {
-                  delete responsePDU;
-                  break;
-               }
-               nameLength = var->getName().length();
-               memcpy(pdwName, var->getName().value(), nameLength * sizeof(UINT32));
-               if (firstObjectNameLen == 0)
+               SNMP_Variable *var = responsePDU->getVariable(i);
+
+               if ((var->getType() != ASN_NO_SUCH_OBJECT) &&
+                   (var->getType() != ASN_NO_SUCH_INSTANCE) &&
+                   (var->getType() != ASN_END_OF_MIBVIEW))
                {
-                  firstObjectNameLen = nameLength;
-                  memcpy(firstObjectName, pdwName, nameLength * sizeof(UINT32));
-               }
+                  // Should we stop walking?
+                  // Some buggy SNMP agents may return first value after last one
+                  // (Toshiba Strata CTX do that for example), so last check is here
+                  if ((var->getName().length() < rootOidLen) ||
+                      (memcmp(rootOid, var->getName().value(), rootOidLen * sizeof(UINT32))) ||
+                      (var->getName().compare(pdwName, nameLength) == OID_EQUAL) ||
+                      (var->getName().compare(firstObjectName, firstObjectNameLen) == OID_EQUAL))
+                  {
+                     running = false;
+                     break;
+                  }
+                  nameLength = var->getName().length();
+                  memcpy(pdwName, var->getName().value(), nameLength * sizeof(UINT32));
+                  if (firstObjectNameLen == 0)
+                  {
+                     firstObjectNameLen = nameLength;
+                     memcpy(firstObjectName, pdwName, nameLength * sizeof(UINT32));
+                  }
 
-               // Call user's callback function for processing
-               result = handler(var);
-               if (result != SNMP_ERR_SUCCESS)
+                  // Call user's callback function for processing
+                  result = handler(var);
+                  if (result != SNMP_ERR_SUCCESS)
+                  {
+                     running = false;
+                  }
+               }
+               else
                {
+                  // Consider no object/no instance as end of walk signal instead of failure
                   running = false;
                }
             }
-            else
-            {
-               // Consider no object/no instance as end of walk signal instead of failure
-               running = false;
-            }
          }
          else
          {
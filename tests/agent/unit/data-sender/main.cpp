@@ -0,0 +1,126 @@
+#include <nms_common.h>
+#include <nms_util.h>
+#include <nms_agent.h>
+#include <testtools.h>
+#include <netxms-version.h>
+
+#include "../../src/agent/core/datasender.h"
+
+NETXMS_EXECUTABLE_HEADER(test-unit-data-sender)
+
+/**
+ * Test value (only timestamp is relevant)
+ */
+struct TestElement
+{
+   uint64_t serverId;
+   time_t timestamp;
+
+   TestElement(uint64_t _serverId, time_t _timestamp)
+   {
+      serverId = _serverId;
+      timestamp = _timestamp;
+   }
+};
+
+/**
+ * Test batch
+ */
+struct TestBatch
+{
+   uint64_t serverId;
+   ObjectArray<TestElement> elements;
+
+   TestBatch(uint64_t _serverId, time_t firstTimestamp, int count) : elements(count, 16, Ownership::True)
+   {
+      serverId = _serverId;
+      for(int i = 0; i < count; i++)
+         elements.add(new TestElement(serverId, firstTimestamp + i));
+   }
+};
+
+/**
+ * Test retry in the middle of acknowledgement window
+ */
+static void TestRetryInWindow()
+{
+   StartTest(_T("Data sender: retry in the middle of window"));
+
+   // Window with 4 batches for server 1 (timestamps 100..139) and one batch for server 2 in between
+   ObjectArray<TestBatch> inFlight(8, 8, Ownership::True);
+   inFlight.add(new TestBatch(1, 100, 10));
+   inFlight.add(new TestBatch(1, 110, 10));
+   inFlight.add(new TestBatch(2, 500, 10));
+   inFlight.add(new TestBatch(1, 120, 10));
+   inFlight.add(new TestBatch(1, 130, 10));
+
+   ObjectArray<TestElement> queue(64, 64, Ownership::True);
+   std::function<void (TestElement*)> requeue = [&queue] (TestElement *e) -> void { queue.add(e); };
+
+   // First batch fully accepted
+   BYTE status[MAX_BULK_DATA_BLOCK_SIZE];
+   memset(status, BULK_DATA_REC_SUCCESS, sizeof(status));
+   AssertEquals(CompleteDataSenderBatch<TestBatch, TestElement>(&inFlight, status, requeue), 0);
+   AssertEquals(inFlight.size(), 4);
+   AssertEquals(queue.size(), 0);
+
+   // Second batch has values with retry status (for example, server was busy)
+   status[3] = BULK_DATA_REC_RETRY;
+   status[7] = BULK_DATA_REC_RETRY;
+   AssertEquals(CompleteDataSenderBatch<TestBatch, TestElement>(&inFlight, status, requeue), 22);
+
+   // Later batches for same server should be revoked, batch for other server should stay in window
+   AssertEquals(inFlight.size(), 1);
+   AssertEquals(inFlight.get(0)->serverId, static_cast<uint64_t>(2));
+
+   // Local queue should contain retried values followed by all values from later batches in original order
+   AssertEquals(queue.size(), 22);
+   AssertEquals(queue.get(0)->timestamp, static_cast<time_t>(113));
+   AssertEquals(queue.get(1)->timestamp, static_cast<time_t>(117));
+   for(int i = 2; i < queue.size(); i++)
+   {
+      AssertEquals(queue.get(i)->serverId, static_cast<uint64_t>(1));
+      AssertTrue(queue.get(i)->timestamp == static_cast<time_t>(118 + i));
+   }
+
+   EndTest();
+}
+
+/**
+ * Test timeout on acknowledgement
+ */
+static void TestAcknowledgementTimeout()
+{
+   StartTest(_T("Data sender: acknowledgement timeout"));
+
+   ObjectArray<TestBatch> inFlight(8, 8, Ownership::True);
+   inFlight.add(new TestBatch(1, 100, 5));
+   inFlight.add(new TestBatch(1, 105, 5));
+
+   ObjectArray<TestElement> queue(64, 64, Ownership::True);
+   std::function<void (TestElement*)> requeue = [&queue] (TestElement *e) -> void { queue.add(e); };
+
+   // No response - all values have retry status
+   BYTE status[MAX_BULK_DATA_BLOCK_SIZE];
+   memset(status, BULK_DATA_REC_RETRY, sizeof(status));
+   AssertEquals(CompleteDataSenderBatch<TestBatch, TestElement>(&inFlight, status, requeue), 10);
+   AssertTrue(inFlight.isEmpty());
+   AssertEquals(queue.size(), 10);
+   for(int i = 0; i < queue.size(); i++)
+      AssertTrue(queue.get(i)->timestamp == static_cast<time_t>(100 + i));
+
+   EndTest();
+}
+
+/**
+ * main()
+ */
+int main(int argc, char *argv[])
+{
+   InitNetXMSProcess(true);
+
+   TestRetryInWindow();
+   TestAcknowledgementTimeout();
+
+   return 0;
+}
@@ -0,0 +1,248 @@
+#include <nms_core.h>
+#include <testtools.h>
+#include <netxms-version.h>
+
+NETXMS_EXECUTABLE_HEADER(test-unit-dci-value-cache)
+
+/**
+ * Cache capacity used in tests
+ */
+#define CACHE_SIZE   1000
+
+/**
+ * Number of values pushed during benchmark
+ */
+#define BENCHMARK_VALUES   200000
+
+/**
+ * Windows used in tests (typical threshold windows and one large window)
+ */
+static const uint32_t s_windows[] = { 1, 29, 59, 999 };
+
+/**
+ * Create value of given type
+ */
+static ItemValue CreateValue(int dataType, uint32_t seed)
+{
+   ItemValue value;
+   switch(dataType)
+   {
+      case DCI_DT_INT64:
+         value.set(static_cast<int64_t>(seed % 2001) - 1000);
+         break;
+      case DCI_DT_UINT64:
+         value.set(static_cast<uint64_t>(seed % 100000));
+         break;
+      case DCI_DT_FLOAT:
+         value.set(static_cast<double>(seed % 100000) / 7.0 - 5000.0);
+         break;
+   }
+   value.setTimeStamp(static_cast<time_t>(seed) + 2);
+   return value;
+}
+
+/**
+ * Check aggregates provided by cache against values calculated by scanning all cached values
+ */
+template<typename T> static void CheckAggregates(const DCItemValueCache& cache, uint32_t count)
+{
+   uint32_t n = std::min(count, cache.size());
+   T sum = 0, minValue = cache.getAs<T>(0), maxValue = cache.getAs<T>(0);
+   double dsum = 0, sumOfSquares = 0;
+   for(uint32_t i = 0; i < n; i++)
+   {
+      T v = cache.getAs<T>(i);
+      sum += v;
+      if (v < minValue)
+         minValue = v;
+      if (v > maxValue)
+         maxValue = v;
+      dsum += static_cast<double>(v);
+      sumOfSquares += static_cast<double>(v) * static_cast<double>(v);
+   }
+   double mean = dsum / n;
+   double variance = sumOfSquares / n - mean * mean;
+   double stddev = (variance > 0) ? sqrt(variance) : 0;
+
+   if (std::is_floating_point<T>::value)
+      AssertTrue(fabs(static_cast<double>(cache.getSum<T>(count) - sum)) < 1e-6 * std::max(1.0, fabs(static_cast<double>(sum))));
+   else
+      AssertTrue(cache.getSum<T>(count) == sum);
+   AssertTrue(cache.getMin<T>(count) == minValue);
+   AssertTrue(cache.getMax<T>(count) == maxValue);
+   AssertTrue(fabs(cache.getStandardDeviation(count) - stddev) < 1e-6 * std::max(1.0, stddev));
+   AssertTrue(cache.getPlaceholderCount(count) == 0);
+}
+
+/**
+ * Test rolling aggregates for given data type
+ */
+template<typename T> static void TestRollingAggregates(const TCHAR *name, int dataType)
+{
+   StartTest(_T("Rolling aggregates"), name);
+
+   DCItemValueCache cache(dataType);
+   cache.resize(CACHE_SIZE);
+   IntegerArray<uint32_t> windows;
+   for(size_t i = 0; i < sizeof(s_windows) / sizeof(uint32_t); i++)
+      windows.add(s_windows[i]);
+   cache.setAggregateWindows(windows);
+
+   uint32_t seed = 12345;
+   for(int i = 0; i < CACHE_SIZE * 3; i++)
+   {
+      seed = seed * 1103515245 + 12345;
+      cache.push(CreateValue(dataType, seed >> 8));
+      if ((i % 7 == 0) || (i < 64))
+      {
+         for(size_t j = 0; j < sizeof(s_windows) / sizeof(uint32_t); j++)
+            CheckAggregates<T>(cache, s_windows[j]);
+         CheckAggregates<T>(cache, 17);   // Not registered, calculated by scanning
+      }
+   }
+
+   // Copy should carry aggregate state
+   DCItemValueCache copy(cache);
+   for(size_t j = 0; j < sizeof(s_windows) / sizeof(uint32_t); j++)
+      CheckAggregates<T>(copy, s_windows[j]);
+
+   // Shrinking cache invalidates windows
+   cache.resize(40);
+   for(size_t j = 0; j < sizeof(s_windows) / sizeof(uint32_t); j++)
+      CheckAggregates<T>(cache, s_windows[j]);
+   for(int i = 0; i < 100; i++)
+   {
+      seed = seed * 1103515245 + 12345;
+      cache.push(CreateValue(dataType, seed >> 8));
+      for(size_t j = 0; j < sizeof(s_windows) / sizeof(uint32_t); j++)
+         CheckAggregates<T>(cache, s_windows[j]);
+   }
+
+   EndTest();
+}
+
+/**
+ * Test that string representation of cached floating point values is not truncated
+ */
+static void TestFloatPrecision()
+{
+   StartTest(_T("Floating point value precision"));
+
+   DCItemValueCache cache(DCI_DT_FLOAT);
+   cache.resize(4);
+   cache.append(_T("0.1"), 100);
+   cache.append(_T("1.0000000001234567"), 99);
+   cache.append(_T("123456789.123"), 98);
+   cache.append(_T("1e-12"), 97);
+
+   // Older values are converted from cached double value
+   AssertTrue(_tcstod(cache.get(1).getString(), nullptr) == 1.0000000001234567);
+   AssertEquals(cache.get(2).getString(), _T("123456789.123"));
+   AssertEquals(cache.get(3).getString(), _T("1e-12"));
+
+   // Most recent value is removed, so string should be re-created from cached double value
+   AssertTrue(cache.remove(100));
+   AssertTrue(_tcstod(cache.getLastString(), nullptr) == 1.0000000001234567);
+   AssertTrue(cache.remove(99));
+   AssertEquals(cache.getLastString(), _T("123456789.123"));
+   AssertTrue(cache.remove(98));
+   AssertEquals(cache.getLastString(), _T("1e-12"));
+
+   // Conversion to string type
+   cache.append(_T("0.1"), 96);
+   cache.setDataType(DCI_DT_STRING);
+   AssertEquals(cache.getLastString(), _T("1e-12"));
+   AssertEquals(cache.get(1).getString(), _T("0.1"));
+
+   EndTest();
+}
+
+/**
+ * Push values and calculate aggregates for several thresholds after each push
+ */
+static int64_t RunBenchmark(bool registerWindows, uint32_t window)
+{
+   DCItemValueCache cache(DCI_DT_FLOAT);
+   cache.resize(window + 1);
+   if (registerWindows)
+   {
+      IntegerArray<uint32_t> windows;
+      windows.add(window);
+      cache.setAggregateWindows(windows);
+   }
+
+   double result = 0;
+   uint32_t seed = 12345;
+   int64_t startTime = GetCurrentTimeMs();
+   for(int i = 0; i < BENCHMARK_VALUES; i++)
+   {
+      seed = seed * 1103515245 + 12345;
+      cache.push(CreateValue(DCI_DT_FLOAT, seed >> 8));
+
+      // Three thresholds (average, sum, and range check) on same window
+      result += cache.getSum<double>(window) / window;
+      result += cache.getSum<double>(window);
+      result += cache.getMax<double>(window) - cache.getMin<double>(window);
+   }
+   int64_t elapsed = GetCurrentTimeMs() - startTime;
+   AssertTrue(!std::isnan(result));
+   return elapsed;
+}
+
+/**
+ * Benchmark rolling aggregates against scanning for large windows
+ */
+static void BenchmarkRollingAggregates()
+{
+   static const uint32_t windows[] = { 59, 999 };
+   for(size_t i = 0; i < sizeof(windows) / sizeof(uint32_t); i++)
+   {
+      TCHAR name[64];
+      _sntprintf(name, 64, _T("window %u, scan"), windows[i]);
+      StartTest(_T("Rolling aggregates benchmark"), name);
+      EndTest(RunBenchmark(false, windows[i]));
+
+      _sntprintf(name, 64, _T("window %u, rolling"), windows[i]);
+      StartTest(_T("Rolling aggregates benchmark"), name);
+      EndTest(RunBenchmark(true, windows[i]));
+   }
+}
+
+/**
+ * Debug writer for logger
+ */
+static void DebugWriter(const TCHAR *tag, const TCHAR *format, va_list args)
+{
+   if (tag != NULL)
+      _tprintf(_T("[DEBUG/%-20s] "), tag);
+   else
+      _tprintf(_T("[DEBUG%-21s] "), _T(""));
+   _vtprintf(format, args);
+   _fputtc(_T('\n'), stdout);
+}
+
+/**
+ * main()
+ */
+int main(int argc, char *argv[])
+{
+   InitNetXMSProcess(true);
+   if (argc > 1)
+   {
+      if (!strcmp(argv[1], "-debug"))
+      {
+         nxlog_set_debug_writer(DebugWriter);
+         nxlog_set_debug_level(9);
+      }
+   }
+
+   TestRollingAggregates<int64_t>(_T("INT64"), DCI_DT_INT64);
+   TestRollingAggregates<uint64_t>(_T("UINT64"), DCI_DT_UINT64);
+   TestRollingAggregates<double>(_T("FLOAT"), DCI_DT_FLOAT);
+   TestFloatPrecision();
+   BenchmarkRollingAggregates();
+
+   InitiateProcessShutdown();
+
+   return 0;
+}
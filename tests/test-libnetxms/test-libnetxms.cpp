@@ -16,6 +16,7 @@ void TestMemoryPool();
 void TestObjectMemoryPool();
 void TestThreadPool();
 void TestThreadPoolDelayedExecution();
+void TestThreadPoolWorkStealing();
 void TestQueue();
 void TestSharedObjectQueue();
 void TestMsgWaitQueue();
@@ -25,6 +26,7 @@ void TestUniqueLock();
 void TestCondition();
 void TestRWLock();
 void TestThreadCountAndMaxWaitTime();
+void TestThreadPoolIntegerKeySerialization();
 void TestProcessExecutor(const char *procname);
 void TestProcessExecutorWorker();
 void TestStringConversion();
@@ -2933,6 +2935,36 @@ static void TestDebugTags()
    EndTest(GetMonotonicClockTime() - startTime);
 #endif
 
+   StartTest(_T("Debug tags: cached debug level"));
+   std::atomic<uint64_t> tag5Cache(0);
+   AssertEquals(nxlog_get_debug_level_tag_cached(_T("test.tag5.subtag5"), &tag5Cache), 7);
+   AssertEquals(nxlog_get_debug_level_tag_cached(_T("test.tag5.subtag5"), &tag5Cache), 7);
+   nxlog_set_debug_level_tag(_T("test.tag5.subtag5"), 3);
+   AssertEquals(nxlog_get_debug_level_tag_cached(_T("test.tag5.subtag5"), &tag5Cache), 3);
+   nxlog_set_debug_level(2);
+   AssertEquals(nxlog_get_debug_level_tag_cached(_T("test.tag5.subtag5"), &tag5Cache), 3);
+   nxlog_set_debug_level_tag(_T("test.tag5.subtag5"), -1);
+   AssertEquals(nxlog_get_debug_level_tag_cached(_T("test.tag5.subtag5"), &tag5Cache), 2);
+   nxlog_set_debug_level(9);
+   AssertEquals(nxlog_get_debug_level_tag_cached(_T("test.tag5.subtag5"), &tag5Cache), 9);
+   EndTest();
+
+#if !WITH_ADDRESS_SANITIZER
+   StartTest(_T("nxlog_get_debug_level_tag performance with multiple tags"));
+   startTime = GetMonotonicClockTime();
+   for(int i = 0; i < 1000000; i++)
+      nxlog_get_debug_level_tag(_T("test.tag3.subtag3"));
+   EndTest(GetMonotonicClockTime() - startTime);
+
+   StartTest(_T("nxlog_get_debug_level_tag_cached performance with multiple tags"));
+   std::atomic<uint64_t> tag3Cache(0);   // Each tag (call site) has its own cache
+   AssertEquals(nxlog_get_debug_level_tag_cached(_T("test.tag3.subtag3"), &tag3Cache), nxlog_get_debug_level_tag(_T("test.tag3.subtag3")));
+   startTime = GetMonotonicClockTime();
+   for(int i = 0; i < 1000000; i++)
+      nxlog_get_debug_level_tag_cached(_T("test.tag3.subtag3"), &tag3Cache);
+   EndTest(GetMonotonicClockTime() - startTime);
+#endif
+
    StartTest(_T("Debug tags: reset"));
    nxlog_reset_debug_level_tags();
    AssertEquals(nxlog_get_debug_level_tag(_T("test.tag1.subtag1")), nxlog_get_debug_level());
@@ -3058,7 +3090,9 @@ int main(int argc, char *argv[])
    TestSubProcess(argv[0], debug);
    TestThreadPool();
    TestThreadPoolDelayedExecution();
+   TestThreadPoolWorkStealing();
    TestThreadCountAndMaxWaitTime();
+   TestThreadPoolIntegerKeySerialization();
 
    InitiateProcessShutdown();
 
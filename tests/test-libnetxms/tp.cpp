@@ -153,6 +153,53 @@ void TestThreadPoolDelayedExecution()
    EndTest();
 }
 
+static VolatileCounter s_workStealingCounter;
+
+static void WorkStealingSubtask()
+{
+   ThreadSleepMs(1);
+   InterlockedIncrement(&s_workStealingCounter);
+}
+
+static void WorkStealingTask(void *arg)
+{
+   ThreadPool *p = static_cast<ThreadPool*>(arg);
+   for(int i = 0; i < 10; i++)
+   {
+      ThreadPoolExecute(p, WorkStealingSubtask);
+   }
+   InterlockedIncrement(&s_workStealingCounter);
+}
+
+void TestThreadPoolWorkStealing()
+{
+   StartTest(_T("Thread pool - work stealing"));
+   ThreadPoolSetWorkStealingMode(true);
+   ThreadPool *p = ThreadPoolCreate(_T("TEST3"), 8, 16, 0);
+   ThreadPoolSetWorkStealingMode(false);
+
+   s_workStealingCounter = 0;
+   for(int i = 0; i < 100; i++)
+      ThreadPoolExecute(p, WorkStealingTask, p);
+
+   ThreadPoolInfo info;
+   for(int i = 0; i < 500; i++)
+   {
+      ThreadSleepMs(10);
+      ThreadPoolGetInfo(p, &info);
+      if (info.activeRequests == 0)
+         break;
+   }
+
+   AssertEquals(static_cast<int32_t>(s_workStealingCounter), 1100);
+   AssertEquals(info.activeRequests, 0);
+   AssertEquals(info.totalRequests, _ULL(1100));
+   AssertEquals(info.minThreads, 8);
+
+   ThreadPoolDestroy(p);
+   EndTest();
+}
+
 static Mutex s_waitTimeTestLock1;
 static Mutex s_waitTimeTestLock2;
 
@@ -194,3 +241,52 @@ void TestThreadCountAndMaxWaitTime()
    ThreadPoolDestroy(threadPool);
    EndTest();
 }
+
+static VolatileCounter s_serializedActive;
+static VolatileCounter s_serializedMaxActive;
+static VolatileCounter s_serializedCompleted;
+
+static void IntegerKeySerializedTask()
+{
+   int32_t active = InterlockedIncrement(&s_serializedActive);
+   if (active > s_serializedMaxActive)
+      s_serializedMaxActive = active;
+   ThreadSleepMs(2);
+   InterlockedDecrement(&s_serializedActive);
+   InterlockedIncrement(&s_serializedCompleted);
+}
+
+void TestThreadPoolIntegerKeySerialization()
+{
+   StartTest(_T("Thread pool - serialized execution with integer key"));
+   ThreadPool *p = ThreadPoolCreate(_T("TEST4"), 8, 16, 0);
+
+   s_serializedActive = 0;
+   s_serializedMaxActive = 0;
+   s_serializedCompleted = 0;
+   for(int i = 0; i < 50; i++)
+      ThreadPoolExecuteSerialized(p, _ULL(0x100000001), IntegerKeySerializedTask);
+
+   ThreadSleepMs(20);
+   AssertTrue(ThreadPoolGetSerializedRequestCount(p, _ULL(0x100000001)) > 0);
+   AssertEquals(ThreadPoolGetSerializedRequestCount(p, _ULL(0x100000002)), 0);
+
+   for(int i = 0; (i < 500) && (s_serializedCompleted < 50); i++)
+      ThreadSleepMs(10);
+
+   AssertEquals(static_cast<int32_t>(s_serializedCompleted), 50);
+   AssertEquals(static_cast<int32_t>(s_serializedMaxActive), 1);
+   ThreadSleepMs(50);
+   AssertEquals(ThreadPoolGetSerializedRequestCount(p, _ULL(0x100000001)), 0);
+
+   // Queue objects should be reused for next burst
+   s_serializedCompleted = 0;
+   for(int i = 0; i < 10; i++)
+      ThreadPoolExecuteSerialized(p, static_cast<uint64_t>(i), IntegerKeySerializedTask);
+   for(int i = 0; (i < 500) && (s_serializedCompleted < 10); i++)
+      ThreadSleepMs(10);
+   AssertEquals(static_cast<int32_t>(s_serializedCompleted), 10);
+
+   ThreadPoolDestroy(p);
+   EndTest();
+}
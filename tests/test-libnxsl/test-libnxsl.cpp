@@ -83,6 +83,65 @@ static void TestStop()
    EndTest();
 }
 
+/**
+ * Script used for VM reuse benchmark (typical transformation script)
+ */
+static const TCHAR *s_transformationScript = _T("v = $1 * 8; if (v > 1000) v = 1000; global g = v; return v;");
+
+/**
+ * Test NXSL VM reuse and compare performance with creating new VM for each run
+ */
+static void TestVMReuse()
+{
+   StartTest(_T("NXSL_VM reuse"));
+
+   NXSL_Environment compileTimeEnvironment;
+   NXSL_CompilationDiagnostic compileDiag;
+   NXSL_Program *program = NXSLCompile(s_transformationScript, &compileTimeEnvironment, &compileDiag);
+   AssertNotNull(program);
+
+   NXSL_VM *vm = new NXSL_VM(new NXSL_Environment());
+   AssertTrue(vm->load(program));
+   for(int i = 1; i <= 3; i++)
+   {
+      NXSL_Value *arg = vm->createValue(i);
+      AssertTrue(vm->run(1, &arg));
+      AssertEquals(vm->getResult()->getValueAsInt32(), i * 8);
+      AssertNull(vm->findGlobalVariable("g"));   // Globals should be reset between runs
+   }
+   delete vm;
+
+   EndTest();
+
+#if !WITH_ADDRESS_SANITIZER
+   StartTest(_T("NXSL_VM cold create performance"));
+   int64_t start = GetCurrentTimeMs();
+   for(int i = 0; i < 100000; i++)
+   {
+      vm = new NXSL_VM(new NXSL_Environment());
+      vm->load(program);
+      NXSL_Value *arg = vm->createValue(i);
+      vm->run(1, &arg);
+      delete vm;
+   }
+   EndTest(GetCurrentTimeMs() - start);
+
+   StartTest(_T("NXSL_VM warm reuse performance"));
+   start = GetCurrentTimeMs();
+   vm = new NXSL_VM(new NXSL_Environment());
+   vm->load(program);
+   for(int i = 0; i < 100000; i++)
+   {
+      NXSL_Value *arg = vm->createValue(i);
+      vm->run(1, &arg);
+   }
+   delete vm;
+   EndTest(GetCurrentTimeMs() - start);
+#endif   /* !WITH_ADDRESS_SANITIZER */
+
+   delete program;
+}
+
 /**
  * Run test NXSL script
  */
@@ -161,6 +220,7 @@ int main(int argc, char *argv[])
 
    TestCompiler();
    TestStop();
+   TestVMReuse();
    RunTestScript(_T("addr.nxsl"));
    RunTestScript(_T("arrays.nxsl"));
    RunTestScript(_T("base64.nxsl"));